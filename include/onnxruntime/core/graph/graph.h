@@ -1170,12 +1170,15 @@ class Graph {
   virtual ~Graph();
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
+  // If can_use_flatbuffer_for_initializers is true, large initializers refer to their data in the flatbuffer
+  // instead of copying it, so the flatbuffer bytes must outlive the Graph. Subgraphs use the same setting.
   static common::Status LoadFromOrtFormat(
       const onnxruntime::experimental::fbs::Graph& fbs_graph, const Model& owning_model,
       const std::unordered_map<std::string, int>& domain_to_version,
 #if !defined(ORT_MINIMAL_BUILD)
       IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+      bool can_use_flatbuffer_for_initializers,
       const logging::Logger& logger, std::unique_ptr<Graph>& graph);
 
   // deserialize a subgraph
@@ -1497,6 +1500,11 @@ class Graph {
 
   // distinguishes between graph loaded from model file and graph created from scratch
   const bool is_loaded_from_model_file_;
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // initializers loaded from ORT format refer to the data in the flatbuffer. see LoadFromOrtFormat.
+  bool can_use_flatbuffer_for_initializers_ = false;
+#endif
 };
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -25,6 +25,7 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
 #include <memory>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
@@ -62,6 +63,17 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With an adaptive spin policy (ThreadOptions::spin_policy), the
+//   time spent spinning is also bounded by a budget derived from the
+//   recent inter-arrival times of parallel work on the pool (see
+//   SpinBudgetNanos).
+//
+// - Work carries the priority of the thread that submitted it (see
+//   ThreadPoolWorkContext).  Each worker has a second RunQueue for
+//   high-priority work, which workers serve ahead of their ordinary
+//   queues, including by stealing it from other workers.  Helper
+//   threads in normal-priority parallel loops yield to pending
+//   high-priority work between chunks of iterations (ShouldYield).
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -136,6 +148,16 @@
 //   active threads over time (when the entire pool is not needed),
 //   and to allow concurrent requests to submit works to their own
 //   respective sets of preferred workers.
+//
+// - The workers may be partitioned into domains, typically one per
+//   NUMA node, via ThreadOptions::domains.  Work scheduled by a
+//   worker stays on the queues of its own domain, idle workers steal
+//   from their own domain before looking further afield, and the
+//   initial preferred workers enumerate the workers domain by domain
+//   so that consecutive loop-local thread IDs (and hence contiguous
+//   ranges of loop iterations) land on the same domain.  Without
+//   explicit domains, all of the workers form a single domain and
+//   none of this changes the behavior described above.
 
 namespace onnxruntime {
 namespace concurrency {
@@ -215,6 +237,7 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
   void LogRun(int){};
+  void LogSpinBudget(int, uint64_t){};
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -241,6 +264,7 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t block_size);  //called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 //called in child thread to log its id
   void LogRun(int thread_idx);                      //called in child thread to log num of run
+  void LogSpinBudget(int thread_idx, uint64_t spin_budget_ns);  //called in child thread to log its spin budget
   std::string DumpChildThreadStat();                //return all child statitics collected so far
 
  private:
@@ -265,6 +289,7 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  //core that the child thread is running on
+    int64_t spin_budget_us_ = -1;  //last spin budget chosen by an adaptive spin policy
     PaddingToAvoidFalseSharing padding_; //to prevent false sharing
   };
   std::vector<ChildThreadStat> child_thread_stats_;
@@ -272,6 +297,55 @@ class ThreadPoolProfiler {
 };
 #endif
 
+// The priority and optional deadline of the work being submitted or
+// run by the current thread.  ThreadPool::PriorityScope sets this on
+// threads that submit work, and the thread pool carries it with the
+// work to the threads that run it (and hence to any work that they
+// submit in turn).  Work whose deadline has passed is treated as high
+// priority, so that normal-priority work is not starved indefinitely.
+
+struct ThreadPoolWorkContext {
+  ThreadPoolPriority priority{ThreadPoolPriority::Normal};
+  uint64_t deadline_ns{0};  // steady_clock time in nanoseconds, or 0 for no deadline
+
+  bool IsDefault() const {
+    return priority == ThreadPoolPriority::Normal && deadline_ns == 0;
+  }
+
+  bool IsHighPriority() const {
+    if (priority == ThreadPoolPriority::High) {
+      return true;
+    }
+    return deadline_ns != 0 &&
+           static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count()) >= deadline_ns;
+  }
+
+  static ThreadPoolWorkContext& Current() {
+    static thread_local ThreadPoolWorkContext current;
+    return current;
+  }
+};
+
+// Install a work context on the current thread for the lifetime of
+// the object, restoring the previous one on exit.
+
+class ScopedWorkContext {
+ public:
+  explicit ScopedWorkContext(const ThreadPoolWorkContext& context) : saved_(ThreadPoolWorkContext::Current()) {
+    ThreadPoolWorkContext::Current() = context;
+  }
+
+  ~ScopedWorkContext() {
+    ThreadPoolWorkContext::Current() = saved_;
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedWorkContext);
+  const ThreadPoolWorkContext saved_;
+};
+
 // Extended Eigen thread pool interface, avoiding the need to modify
 // the ThreadPoolInterface.h header from the external Eigen
 // repository.
@@ -317,6 +391,21 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
                              unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling()  = 0;
   virtual std::string StopProfiling() = 0;
+
+  // Mark the start and end of a Run using the thread pool, for the
+  // ThreadPoolSpinPolicy::DuringRun spin policy.
+  virtual void StartRun() = 0;
+  virtual void EndRun() = 0;
+
+  // Return the number of NUMA or cache domains the worker threads
+  // are partitioned into.
+  virtual unsigned NumDomains() const = 0;
+
+  // Return true if the calling thread is running normal-priority work
+  // while high-priority work is waiting in the pool.  Helper threads
+  // in parallel loops use this to give up their remaining iterations
+  // to the other threads in the loop.
+  virtual bool ShouldYield() const = 0;
 };
 
 
@@ -338,6 +427,13 @@ class ThreadPoolParallelSection {
   // and in the dispatcher.
   unsigned current_dop;
 
+  // Work context of the main thread when the section started, and
+  // whether the section's tasks use the high-priority queues.  These
+  // are set before any tasks are pushed, and are read-only in the
+  // worker threads.
+  ThreadPoolWorkContext context;
+  bool high_priority;
+
   // State shared between the main thread and worker threads
   // -------------------------------------------------------
 
@@ -679,6 +775,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return profiler_.Stop();
   }
 
+  void StartRun() override {
+    active_runs_++;
+  }
+
+  void EndRun() override {
+    active_runs_--;
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -722,6 +826,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        spin_policy_(thread_options.spin_policy),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -739,6 +844,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    InitializeDomains(thread_options.domains);
+
     worker_data_.resize(num_threads_);
     for (auto i = 0u; i < num_threads_; i++) {
       worker_data_[i].thread.reset(env_.CreateThread(name, i, WorkerLoop, this, thread_options));
@@ -763,15 +870,38 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // reject work if the queue of pending work is full.
 
   void Schedule(std::function<void()> fn) override {
+    RecordArrival();
     PerThread* pt = GetPerThread();
-    int q_idx = Rand(&pt->rand) % num_threads_;
+    // Work scheduled from one of our own workers stays within its domain
+    const auto& candidates = (pt->pool == this) ? domain_workers_[worker_domain_[pt->thread_id]] : domain_order_;
+    int q_idx = candidates[Rand(&pt->rand) % candidates.size()];
     WorkerData &td = worker_data_[q_idx];
-    Queue& q = td.queue;
-    fn = q.PushBack(std::move(fn));
+
+    // Carry a non-default work context with the work, and select the
+    // queue for its priority
+    const ThreadPoolWorkContext& context = ThreadPoolWorkContext::Current();
+    const bool high_priority = context.IsHighPriority();
+    if (!context.IsDefault()) {
+      fn = [context, fn = std::move(fn)]() {
+        ScopedWorkContext scope(context);
+        fn();
+      };
+    }
+    if (high_priority) {
+      high_pending_++;
+    }
+    fn = LaneQueue(td, high_priority).PushBack(std::move(fn));
     if (!fn) {
-      // The queue accepted the work; ensure that the thread will pick it up
+      // The queue accepted the work; ensure that the thread will pick it up.
+      // If the thread is busy, also wake another to steal high-priority work.
       td.EnsureAwake();
+      if (high_priority && td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        WakeDomainWorker(*pt, q_idx);
+      }
     } else {
+      if (high_priority) {
+        high_pending_--;
+      }
       // Run the work directly if the queue rejected the work
       fn();
     }
@@ -816,6 +946,8 @@ void StartParallelSectionInternal(PerThread &pt,
   ps.work_done = false;
   ps.tasks_revoked = 0;
   ps.current_dop = 1;
+  ps.context = ThreadPoolWorkContext::Current();
+  ps.high_priority = ps.context.IsHighPriority();
   ps.active = true;
 }
 
@@ -843,8 +975,7 @@ void EndParallelSectionInternal(PerThread &pt,
   // not the dispatch task itself has started -- if it has not started
   // then it cannot have pushed tasks.
   if (ps.dispatch_q_idx != -1) {
-    Queue& q = worker_data_[ps.dispatch_q_idx].queue;
-    if (q.RevokeWithTag(pt.tag, ps.dispatch_w_idx)) {
+    if (RevokeWithTag(worker_data_[ps.dispatch_q_idx], ps, pt.tag, ps.dispatch_w_idx)) {
       if (!ps.dispatch_started.load(std::memory_order_acquire)) {
         // We successfully revoked a task, and saw the dispatch task
         // not started.  Hence we know we revoked the dispatch task.
@@ -879,8 +1010,7 @@ void EndParallelSectionInternal(PerThread &pt,
   unsigned tasks_started = static_cast<unsigned>(ps.tasks.size());
   while (!ps.tasks.empty()) {
     const auto& item = ps.tasks.back();
-    Queue& q = worker_data_[item.first].queue;
-    if (q.RevokeWithTag(pt.tag, item.second)) {
+    if (RevokeWithTag(worker_data_[item.first], ps, pt.tag, item.second)) {
       ps.tasks_revoked++;
     }
     ps.tasks.pop_back();
@@ -1014,9 +1144,11 @@ void EndParallelSection(ThreadPoolParallelSection &ps) override {
 void InitializePreferredWorkers(std::vector<int> &preferred_workers) {
   static std::atomic<unsigned> next_worker;
   // preferred_workers maps from a par_idx to a q_idx, hence we
-  // initialize slots in the range [0,num_threads_]
+  // initialize slots in the range [0,num_threads_].  The workers are
+  // enumerated domain by domain, so that consecutive par_idx values
+  // are placed on the same domain.
   while (preferred_workers.size() <= num_threads_) {
-    preferred_workers.push_back(next_worker++ % num_threads_);
+    preferred_workers.push_back(domain_order_[next_worker++ % num_threads_]);
   }
 }
 
@@ -1046,11 +1178,11 @@ void ScheduleOnPreferredWorkers(PerThread& pt,
     unsigned q_idx = preferred_workers[par_idx] % num_threads_;
     assert(q_idx < num_threads_);
     WorkerData& td = worker_data_[q_idx];
-    Queue& q = td.queue;
     unsigned w_idx;
 
     // Attempt to enqueue the task
-    auto push_status = q.PushBackWithTag([worker_fn, par_idx, &preferred_workers, &ps, this]() {
+    auto push_status = PushBackWithTag(td, ps, [worker_fn, par_idx, &preferred_workers, &ps, this]() {
+        ScopedWorkContext scope(ps.context);
         // Record the worker thread that actually runs this task.
         // This will form the preferred worker for the next loop.
         UpdatePreferredWorker(preferred_workers, par_idx);
@@ -1067,7 +1199,7 @@ void ScheduleOnPreferredWorkers(PerThread& pt,
       ps.tasks.push_back({q_idx, w_idx});
       td.EnsureAwake();
       if (push_status == PushResult::ACCEPTED_BUSY) {
-        worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+        WakeDomainWorker(pt, q_idx);
       }
     }
   }
@@ -1142,6 +1274,7 @@ void RunInParallelInternal(PerThread& pt,
         // revokes a task, and then sees dispatch_started=true, then
         // it knows it revoked a worker task. ]
         ps.dispatch_started.store(true, std::memory_order_seq_cst);
+        ScopedWorkContext scope(ps.context);
 
         // Schedule tasks par_idx=[current_dop+1,new_dop)
         ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop+1, new_dop, worker_fn);
@@ -1161,17 +1294,16 @@ void RunInParallelInternal(PerThread& pt,
       profiler_.LogStart();
       ps.dispatch_q_idx = preferred_workers[current_dop] % num_threads_;
       WorkerData& dispatch_td = worker_data_[ps.dispatch_q_idx];
-      Queue& dispatch_que = dispatch_td.queue;
 
       // assign dispatch task to selected dispatcher
-      auto push_status = dispatch_que.PushBackWithTag(dispatch_task, pt.tag, ps.dispatch_w_idx);
+      auto push_status = PushBackWithTag(dispatch_td, ps, dispatch_task, pt.tag, ps.dispatch_w_idx);
       // Queue accepted the task; wake the thread that owns the queue.
       // In addition, if the queue was non-empty, attempt to wake
       // another thread (which may then steal the task).
       if (push_status == PushResult::ACCEPTED_IDLE || push_status == PushResult::ACCEPTED_BUSY) {
         dispatch_td.EnsureAwake();
         if (push_status == PushResult::ACCEPTED_BUSY) {
-          worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+          WakeDomainWorker(pt, ps.dispatch_q_idx);
         }
       } else {
         ps.dispatch_q_idx = -1;  // failed to enqueue dispatch_task
@@ -1194,6 +1326,7 @@ void RunInParallelSection(ThreadPoolParallelSection &ps,
                           unsigned n,
                           std::ptrdiff_t block_size) override {
   ORT_ENFORCE(n <= num_threads_+1, "More work items than threads");
+  RecordArrival();
   profiler_.LogStartAndCoreAndBlock(block_size);
   PerThread* pt = GetPerThread();
   assert(pt->leading_par_section && "RunInParallel, but not in parallel section");
@@ -1207,10 +1340,16 @@ void RunInParallelSection(ThreadPoolParallelSection &ps,
   ps.current_loop = &loop;
 
   // Increase the worker count if needed.  Each worker will pick up
-  // loops to execute from the current parallel section.
-  std::function<void(unsigned)> worker_fn = [&ps](unsigned par_idx) {
+  // loops to execute from the current parallel section.  A worker
+  // waiting between the loops of a normal-priority section leaves it
+  // if high-priority work is pending; later loops in the section
+  // then run with fewer helpers.
+  std::function<void(unsigned)> worker_fn = [&ps, this](unsigned par_idx) {
     while (ps.active) {
       if (!ps.current_loop) {
+        if (ShouldYield()) {
+          break;
+        }
         onnxruntime::concurrency::SpinPause();
       } else {
         ps.workers_in_loop++;
@@ -1252,6 +1391,7 @@ void RunInParallelSection(ThreadPoolParallelSection &ps,
 //  1. run fn(...);
 void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
   ORT_ENFORCE(n <= num_threads_+1, "More work items than threads");
+  RecordArrival();
   profiler_.LogStartAndCoreAndBlock(block_size);
   PerThread* pt = GetPerThread();
   ThreadPoolParallelSection ps;
@@ -1268,6 +1408,14 @@ int NumThreads() const final {
   return num_threads_;
 }
 
+unsigned NumDomains() const final {
+  return static_cast<unsigned>(domain_workers_.size());
+}
+
+bool ShouldYield() const final {
+  return high_pending_ > 0 && !ThreadPoolWorkContext::Current().IsHighPriority();
+}
+
 int CurrentThreadId() const final {
   const PerThread* pt = const_cast<ThreadPoolTempl*>(this)->GetPerThread();
   if (pt->pool == this) {
@@ -1325,10 +1473,11 @@ int CurrentThreadId() const final {
   };
 
   struct WorkerData {
-    constexpr WorkerData() : thread(), queue() {
+    constexpr WorkerData() : thread(), queue(), high_queue() {
     }
     std::unique_ptr<Thread> thread;
     Queue queue;
+    Queue high_queue;  // Work submitted with high priority
 
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
@@ -1419,11 +1568,161 @@ int CurrentThreadId() const final {
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const ThreadPoolSpinPolicy spin_policy_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+  std::vector<unsigned> worker_domain_;                // Domain of each worker
+  std::vector<std::vector<unsigned>> domain_workers_;  // Workers of each domain
+  std::vector<unsigned> domain_order_;                 // All workers, enumerated domain by domain
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
+  std::atomic<int> high_pending_{0};  // Count of tasks in the high-priority queues
+
+  // Return the queue of td used for work of the given priority
+
+  static Queue& LaneQueue(WorkerData& td, bool high_priority) {
+    return high_priority ? td.high_queue : td.queue;
+  }
+
+  // Push and revoke the tasks of a parallel section, on the queues
+  // for the section's priority.
+
+  PushResult PushBackWithTag(WorkerData& td, ThreadPoolParallelSection& ps, Task t, Tag tag, unsigned& w_idx) {
+    if (!ps.high_priority) {
+      return td.queue.PushBackWithTag(std::move(t), tag, w_idx);
+    }
+    high_pending_++;
+    PushResult push_status = td.high_queue.PushBackWithTag(std::move(t), tag, w_idx);
+    if (push_status == PushResult::REJECTED) {
+      high_pending_--;
+    }
+    return push_status;
+  }
+
+  bool RevokeWithTag(WorkerData& td, ThreadPoolParallelSection& ps, Tag tag, unsigned w_idx) {
+    if (!LaneQueue(td, ps.high_priority).RevokeWithTag(tag, w_idx)) {
+      return false;
+    }
+    if (ps.high_priority) {
+      high_pending_--;
+    }
+    return true;
+  }
+
+  // Pop a task for the worker td to run.  While high-priority work is
+  // pending, serve it first: from td's own high-priority queue, and
+  // then from those of the other workers.
+
+  Task PopTask(WorkerData& td) {
+    if (high_pending_ > 0) {
+      Task t = td.high_queue.PopFront();
+      for (unsigned i = 0; !t && i < num_threads_; i++) {
+        t = worker_data_[i].high_queue.PopBack();
+      }
+      if (t) {
+        high_pending_--;
+        return t;
+      }
+    }
+    return td.queue.PopFront();
+  }
+
+  // State for the adaptive spin policies: the number of active Runs,
+  // the time at which parallel work last arrived, and the moving
+  // average of the time between arrivals.
+  std::atomic<int> active_runs_{0};
+  std::atomic<uint64_t> last_arrival_ns_{0};
+  std::atomic<uint64_t> mean_interarrival_ns_{0};
+
+  // Bounds of the adaptive spin budget.  Spinning for less than the
+  // cost of blocking and waking a thread gains nothing, and beyond
+  // the upper bound we would rather block and pay the wake-up cost.
+  static constexpr uint64_t min_spin_ns = 20 * 1000;
+  static constexpr uint64_t max_spin_ns = 10 * 1000 * 1000;
+
+  static uint64_t NowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+  // Record the arrival of parallel work, updating an exponential
+  // moving average (weight 1/8) of the inter-arrival times.  The
+  // updates from concurrent arrivals may race, which only perturbs
+  // the average.  Samples are capped so that a single long pause
+  // disables spinning without taking long to recover from.
+
+  void RecordArrival() {
+    if (spin_policy_ == ThreadPoolSpinPolicy::Fixed) {
+      return;
+    }
+    const uint64_t now = NowNanos();
+    const uint64_t last = last_arrival_ns_.exchange(now, std::memory_order_relaxed);
+    if (last != 0 && now > last) {
+      const uint64_t sample = std::min(now - last, 4 * max_spin_ns);
+      const uint64_t mean = mean_interarrival_ns_.load(std::memory_order_relaxed);
+      mean_interarrival_ns_.store(mean == 0 ? sample : mean - mean / 8 + sample / 8, std::memory_order_relaxed);
+    }
+  }
+
+  // Return how long an idle worker should spin before blocking.  If
+  // work has been arriving at short intervals we spin through about
+  // twice the expected gap, so that the next arrival usually finds
+  // the worker spinning.  Otherwise we spin only briefly.
+
+  uint64_t SpinBudgetNanos() const {
+    if (spin_policy_ == ThreadPoolSpinPolicy::DuringRun && active_runs_.load(std::memory_order_relaxed) == 0) {
+      return 0;
+    }
+    const uint64_t mean = mean_interarrival_ns_.load(std::memory_order_relaxed);
+    if (mean == 0 || mean > max_spin_ns / 2) {
+      return min_spin_ns;
+    }
+    return std::max(min_spin_ns, 2 * mean);
+  }
+
+  // Partition the workers into domains.  The caller's domain IDs are
+  // arbitrary integers, which we renumber densely in increasing order.
+
+  void InitializeDomains(const std::vector<int>& domains) {
+    ORT_ENFORCE(domains.empty() || domains.size() >= num_threads_,
+                "Expected a domain for each of the ", num_threads_, " threads, got ", domains.size());
+    std::vector<int> ids;
+    if (!domains.empty()) {
+      ids.assign(domains.begin(), domains.begin() + num_threads_);
+      std::sort(ids.begin(), ids.end());
+      ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    } else {
+      ids.push_back(0);
+    }
+
+    worker_domain_.resize(num_threads_);
+    domain_workers_.resize(ids.size());
+    for (auto i = 0u; i < num_threads_; i++) {
+      unsigned domain = 0;
+      if (!domains.empty()) {
+        domain = static_cast<unsigned>(std::lower_bound(ids.begin(), ids.end(), domains[i]) - ids.begin());
+      }
+      worker_domain_[i] = domain;
+      domain_workers_[domain].push_back(i);
+    }
+    for (const auto& workers : domain_workers_) {
+      domain_order_.insert(domain_order_.end(), workers.begin(), workers.end());
+    }
+  }
+
+  // Wake a worker that may steal the work just pushed to the busy
+  // queue q_idx, preferring the workers in the same domain.
+
+  void WakeDomainWorker(PerThread& pt, unsigned q_idx) {
+    const auto& workers = domain_workers_[worker_domain_[q_idx]];
+    if (workers.size() > 1) {
+      worker_data_[workers[Rand(&pt.rand) % workers.size()]].EnsureAwake();
+    } else {
+      worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+    }
+  }
 
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
@@ -1440,7 +1739,6 @@ int CurrentThreadId() const final {
   void WorkerLoop(int thread_id) {
     PerThread* pt = GetPerThread();
     WorkerData& td = worker_data_[thread_id];
-    Queue& q = td.queue;
     bool should_exit = false;
     pt->pool = this;
     pt->thread_id = thread_id;
@@ -1450,19 +1748,32 @@ int CurrentThreadId() const final {
     const int log2_spin = 20;
     const int spin_count = allow_spinning_ ? (1ull<<log2_spin) : 0;
     const int steal_count = spin_count/100;
+    const bool adaptive_spin = spin_count != 0 && spin_policy_ != ThreadPoolSpinPolicy::Fixed;
 
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
-      Task t = q.PopFront();
+      Task t = PopTask(td);
       if (!t) {
-        // Spin waiting for work.
+        // Spin waiting for work.  With an adaptive spin policy, the
+        // clock is checked every 64 iterations against the budget.
+        uint64_t spin_deadline = 0;
+        if (adaptive_spin) {
+          const uint64_t spin_budget = SpinBudgetNanos();
+          profiler_.LogSpinBudget(thread_id, spin_budget);
+          spin_deadline = NowNanos() + spin_budget;
+        }
         for (int i = 0; i < spin_count && !t && !done_; i++) {
+          if (adaptive_spin && (i % 64) == 0 &&
+              (NowNanos() >= spin_deadline ||
+               (spin_policy_ == ThreadPoolSpinPolicy::DuringRun && active_runs_.load(std::memory_order_relaxed) == 0))) {
+            break;
+          }
           if (((i+1)%steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
           } else {
-            t = q.PopFront();
+            t = PopTask(td);
           }
           onnxruntime::concurrency::SpinPause();
         }
@@ -1488,7 +1799,7 @@ int CurrentThreadId() const final {
                           //
                           // If #A if after #2 then #B will see #1, and we abandon blocking
                           assert(!t);
-                          t = q.PopFront();
+                          t = PopTask(td);
                           if (t) {
                             should_block = false;
                           }
@@ -1528,7 +1839,7 @@ int CurrentThreadId() const final {
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
-          if (!t) t = q.PopFront();
+          if (!t) t = PopTask(td);
           if (!t) t = Steal(StealAttemptKind::TRY_ALL);
         }
       }
@@ -1553,19 +1864,33 @@ int CurrentThreadId() const final {
   // is that the thread is busy with other work, and we will avoid
   // "snatching" work from a thread which is just about to notice the
   // work itself.
+  //
+  // When the pool is partitioned into domains, we first try the
+  // threads in the thief's own domain, and only then the whole pool.
 
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
-    unsigned size = num_threads_;
+    if (domain_workers_.size() > 1 && pt->pool == this) {
+      Task t = StealFrom(*pt, domain_workers_[worker_domain_[pt->thread_id]], steal_kind);
+      if (t) {
+        return t;
+      }
+    }
+    return StealFrom(*pt, domain_order_, steal_kind);
+  }
+
+  Task StealFrom(PerThread& pt, const std::vector<unsigned>& victims, StealAttemptKind steal_kind) {
+    unsigned size = static_cast<unsigned>(victims.size());
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
-    unsigned r = Rand(&pt->rand);
+    unsigned r = Rand(&pt.rand);
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
     
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
-      if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
+      WorkerData& td = worker_data_[victims[victim]];
+      if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = td.queue.PopBack();
         if (t) {
           return t;
         }
@@ -1586,7 +1911,7 @@ int CurrentThreadId() const final {
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      if (!worker_data_[victim].queue.Empty()) {
+      if (!worker_data_[victim].queue.Empty() || !worker_data_[victim].high_queue.Empty()) {
         return victim;
       }
       victim += inc;
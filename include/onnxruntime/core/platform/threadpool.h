@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <chrono>
 #include <string>
 #include <vector>
 #include <functional>
@@ -222,6 +223,38 @@ class ThreadPool {
                   "Per-thread state should be trivially destructible");
   };
 
+  // Set the priority, and optionally a deadline, for the work that the
+  // current thread submits to thread pools, for the lifetime of the
+  // PriorityScope object.  For instance, a session Run serving an
+  // interactive request may use:
+  //
+  // {
+  //   onnxruntime::concurrency::ThreadPool::PriorityScope scope(ThreadPoolPriority::High);
+  //   ... run the graph ...
+  // }
+  //
+  // Workers serve high-priority work ahead of normal-priority work,
+  // and helper threads in normal-priority parallel loops yield to
+  // pending high-priority work at chunk boundaries.  Work whose
+  // deadline has passed is treated as high priority.  The setting is
+  // carried with the work, so it also applies to work submitted from
+  // within tasks passed to Schedule and from within parallel loops.
+  //
+  // Priorities are only implemented with the Eigen threadpool.  They
+  // have no effect when using OpenMP.
+
+  class PriorityScope {
+   public:
+    explicit PriorityScope(ThreadPoolPriority priority,
+                           std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point());
+    ~PriorityScope();
+
+   private:
+    ThreadPoolPriority saved_priority_;
+    uint64_t saved_deadline_ns_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PriorityScope);
+  };
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -384,6 +417,12 @@ class ThreadPool {
   static void StartProfiling(concurrency::ThreadPool* tp);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
+  // StartRun and EndRun bracket a session Run using the pool.  They are used by
+  // ThreadPoolSpinPolicy::DuringRun to let idle workers spin only while a Run is
+  // active, and have no effect under other spin policies.
+  static void StartRun(concurrency::ThreadPool* tp);
+  static void EndRun(concurrency::ThreadPool* tp);
+
  private:
   friend class LoopCounter;
 
@@ -433,6 +472,10 @@ class ThreadPool {
 
   std::string StopProfiling();
 
+  void StartRun();
+
+  void EndRun();
+
   ThreadOptions thread_options_;
 
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
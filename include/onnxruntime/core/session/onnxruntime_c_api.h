@@ -278,6 +278,17 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+/** \brief Callback invoked when a run scheduled with OrtApi::RunAsync has completed
+*
+* \param[in] user_data The user_data passed to OrtApi::RunAsync
+* \param[in] outputs The outputs array passed to OrtApi::RunAsync. If the run succeeded it is filled in the same
+*     way as by OrtApi::Run.
+* \param[in] num_outputs Number of elements in the outputs array
+* \param[in] status nullptr if the run succeeded. Owned by onnxruntime and released when the callback returns.
+*/
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                               OrtStatus* status);
+
 /** \brief Graph optimization level
 *
 * Refer to https://www.onnxruntime.ai/docs/resources/graph-optimizations.html
@@ -2570,6 +2581,9 @@ struct OrtApi {
   *  Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
   *  Ultimately, the allocation size is determined by the allocation memory request.
   *  Further allocation sizes are governed by the arena extend strategy.
+  * "max_thread_cache_bytes": Maximum bytes of freed small chunks kept in each per-thread cache in front of the arena.
+  *  Allocations served from these caches do not take the arena lock. Use -1 to allow ORT to choose the default.
+  *  Use 0 to disable the caches.
   *
   * \param[in] arena_config_keys Keys to configure the arena
   * \param[in] arena_config_values Values to configure the arena
@@ -3023,6 +3037,64 @@ struct OrtApi {
   */
   ORT_API2_STATUS(GetSparseTensorIndices, _In_ const OrtValue* ort_value, enum OrtSparseIndicesFormat indices_format, _Out_ size_t* num_indices, _Outptr_ const void** indices);
 
+  /// @}
+  /// \name OrtSession
+  /// @{
+
+  /** \brief Run the model in an ::OrtSession without waiting for it to complete
+  *
+  * Schedules the run on the session's inter-op thread pool, or on its intra-op thread pool if the session
+  * has no inter-op thread pool (::ExecutionMode::ORT_SEQUENTIAL), and returns. The thread pool must have at
+  * least one worker thread. When the run completes, run_async_callback is invoked on a thread pool thread.
+  *
+  * The input names, input ::OrtValue%s and output names are copied and can be released once this returns. Input data
+  * the caller created a tensor over, run_options and the outputs array must remain valid until the callback has been
+  * invoked. The session must not be released from within the callback, and releasing it waits for all pending runs
+  * to complete.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+  * \param[in] inputs Array of ::OrtValue%s of the input values
+  * \param[in] input_len Number of elements in the input_names and inputs arrays
+  * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+  * \param[in] output_names_len Number of elements in the output_names and outputs array
+  * \param[out] outputs Array of ::OrtValue%s that the outputs are stored in when the run completes. This can also be
+  *     an array of nullptr values, in this case ::OrtValue objects will be allocated and pointers
+  *     to them will be set into the `outputs` array.
+  * \param[in] run_async_callback Function invoked when the run has completed
+  * \param[in] user_data Passed to run_async_callback
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  * If an error is returned the run was not scheduled and run_async_callback will not be invoked.
+  */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** outputs,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /** \brief Create an ::OrtSession that shares the model, kernels and initializers of an existing ::OrtSession
+  *
+  * The new session is created without loading, optimizing or partitioning the model again. It uses the execution
+  * providers (and their allocators), kernels, initializers and pre-packed weights of the source session and a copy
+  * of its execution plans. Thread pools, logging, profiling and memory pattern settings are taken from options.
+  * Execution providers appended to options and graph optimization settings are ignored, and the execution mode
+  * and memory reuse settings of the source session are kept.
+  *
+  * The source session must not be released before all sessions cloned from it.
+  *
+  * \param[in] env
+  * \param[in] session An initialized session to clone
+  * \param[in] options If nullptr, will use a default ::OrtSessionOptions
+  * \param[out] out Returned newly created OrtSession. Must be freed with OrtApi::ReleaseSession
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  */
+  ORT_API2_STATUS(CloneSession, _In_ const OrtEnv* env, _In_ const OrtSession* session,
+                  _In_opt_ const OrtSessionOptions* options, _Outptr_ OrtSession** out);
+
   /// @}
 };
 
@@ -16,6 +16,7 @@
 #include "onnxruntime_c_api.h"
 #include <cstddef>
 #include <array>
+#include <future>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -374,6 +375,15 @@ struct Session : Base<OrtSession> {
   Session(Env& env, const ORTCHAR_T* model_path, const SessionOptions& options); ///< Wraps OrtApi::CreateSession
   Session(Env& env, const ORTCHAR_T* model_path, const SessionOptions& options, OrtPrepackedWeightsContainer* prepacked_weights_container); ///< Wraps OrtApi::CreateSessionWithPrepackedWeightsContainer
   Session(Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options); ///< Wraps OrtApi::CreateSessionFromArray
+  explicit Session(OrtSession* p) : Base<OrtSession>{p} {} ///< Used for interop with the C API
+
+  /** \brief Create a Session that shares the model, kernels and initializers of this Session
+  *
+  * Wraps OrtApi::CloneSession
+  *
+  * This Session must not be released before the returned one.
+  */
+  Session Clone(Env& env, const SessionOptions& options) const;
 
   /** \brief Run the model returning results in an Ort allocated vector.
   * 
@@ -403,6 +413,28 @@ struct Session : Base<OrtSession> {
 
   void Run(const RunOptions& run_options, const struct IoBinding&); ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model without waiting for it to complete, returning results in user provided outputs
+  *
+  * Wraps OrtApi::RunAsync
+  *
+  * callback is invoked on a thread pool thread when the run has completed.
+  * run_options and output_values must remain valid until then.
+  */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count,
+                RunAsyncCallbackFn callback, void* user_data);
+
+#ifndef ORT_NO_EXCEPTIONS
+  /** \brief Run the model without waiting for it to complete, returning results through a std::future
+  *
+  * Same as RunAsync(const RunOptions&, const char* const*, const Value*, size_t, const char* const*, Value*, size_t, RunAsyncCallbackFn, void*)
+  *
+  * run_options must remain valid until the future is ready. If the run fails the future holds an Ort::Exception.
+  */
+  std::future<std::vector<Value>> RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                                           size_t input_count, const char* const* output_names, size_t output_count);
+#endif
+
   size_t GetInputCount() const; ///< Returns the number of model inputs
   size_t GetOutputCount() const; ///< Returns the number of model outputs
   size_t GetOverridableInitializerCount() const; ///< Returns the number of inputs that have defaults that can be overridden
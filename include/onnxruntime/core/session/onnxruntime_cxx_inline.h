@@ -528,6 +528,12 @@ inline Session::Session(Env& env, const void* model_data, size_t model_data_leng
   ThrowOnError(GetApi().CreateSessionFromArray(env, model_data, model_data_length, options, &p_));
 }
 
+inline Session Session::Clone(Env& env, const SessionOptions& options) const {
+  OrtSession* out;
+  ThrowOnError(GetApi().CloneSession(env, p_, options, &out));
+  return Session{out};
+}
+
 inline std::vector<Value> Session::Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                                        const char* const* output_names, size_t output_names_count) {
   std::vector<Ort::Value> output_values;
@@ -549,6 +555,48 @@ inline void Session::Run(const RunOptions& run_options, const IoBinding& io_bind
   ThrowOnError(GetApi().RunWithBinding(p_, run_options, io_binding));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                              const char* const* output_names, Value* output_values, size_t output_count,
+                              RunAsyncCallbackFn callback, void* user_data) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count, ort_output_values,
+                                 callback, user_data));
+}
+
+#ifndef ORT_NO_EXCEPTIONS
+namespace detail {
+// Outputs and promise of a run started by the std::future returning Session::RunAsync
+struct RunAsyncPromise {
+  std::vector<Value> outputs;
+  std::promise<std::vector<Value>> promise;
+};
+
+inline void ORT_API_CALL RunAsyncPromiseCallback(void* user_data, OrtValue** /*outputs*/, size_t /*num_outputs*/, OrtStatus* status) {
+  std::unique_ptr<RunAsyncPromise> run{static_cast<RunAsyncPromise*>(user_data)};
+  if (status != nullptr) {
+    run->promise.set_exception(std::make_exception_ptr(Exception(GetApi().GetErrorMessage(status), GetApi().GetErrorCode(status))));
+  } else {
+    run->promise.set_value(std::move(run->outputs));
+  }
+}
+}  // namespace detail
+
+inline std::future<std::vector<Value>> Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                                                         size_t input_count, const char* const* output_names, size_t output_count) {
+  auto run = std::make_unique<detail::RunAsyncPromise>();
+  for (size_t i = 0; i < output_count; i++)
+    run->outputs.emplace_back(nullptr);
+  auto result = run->promise.get_future();
+  RunAsync(run_options, input_names, input_values, input_count, output_names, run->outputs.data(), output_count,
+           detail::RunAsyncPromiseCallback, run.get());
+  // owned by the callback from here on
+  run.release();
+  return result;
+}
+#endif
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(GetApi().SessionGetInputCount(p_, &out));
@@ -25,3 +25,13 @@
 // Example usage: "cpu:0;gpu:0" (or) "gpu:0"
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
+
+// Priority of the thread pool work of the Run.
+// "normal": default
+// "high": the Run's work is served ahead of the work of normal-priority Runs sharing the same thread pools,
+// which yield to it at the chunk boundaries of their parallel loops. Use this for latency-sensitive requests.
+static const char* const kOrtRunOptionsConfigPriority = "run.priority";
+
+// Optional deadline of the Run, in microseconds from the start of the Run. Once the deadline has passed, the
+// Run's thread pool work is treated as high priority. By default there is no deadline.
+static const char* const kOrtRunOptionsConfigDeadlineUs = "run.deadline_us";
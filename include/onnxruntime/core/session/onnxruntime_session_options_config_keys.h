@@ -51,6 +51,12 @@ static const char* const kOrtSessionOptionsDisableQuantQDQ = "session.disable_qu
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable fusing chains of elementwise operators into FusedElementwise nodes in graph optimization.
+// "0": disable; "1": enable. The default is "0".
+// The fused nodes hide Add and activation nodes from the layout transformers that run at a later level, which
+// can be slower for convolutional models. It is disabled by default due to this.
+static const char* const kOrtSessionOptionsEnableElementwiseFusion = "optimization.enable_elementwise_fusion";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -61,6 +67,12 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure how long idle intra_op threads spin before blocking, when spinning is allowed
+// "fixed": default, thread will spin a fixed number of times before blocking
+// "adaptive": thread will spin for a budget derived from the recent arrival rate of parallel work
+// "run": as "adaptive", but threads will only spin while a Run is active on the session
+static const char* const kOrtSessionOptionsConfigIntraOpSpinPolicy = "session.intra_op.spin_policy";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -69,6 +81,33 @@ static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session
 // has to guarantee that the model bytes are valid until the ORT session using the model bytes is destroyed.
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "session.use_ort_model_bytes_directly";
 
+// Key for memory mapping an ORT format model file
+// If a session is created from the path of an ORT format model and this is set to "1", the file is mapped into
+// memory instead of being read into a buffer. The mapping is kept until the session is destroyed, and the data of
+// large initializers that are used on CPU is used in place instead of being copied. The data is only read from disk
+// when it is used, and processes that map the same file can share its pages.
+// If the file cannot be mapped it is read into a buffer. The file must not be modified while the session exists.
+static const char* const kOrtSessionOptionsConfigMapOrtModelFile = "session.map_ort_model_file";
+
+// Maximum number of memory patterns cached by the session, one per distinct set of input shapes.
+// Once reached, the least recently used pattern is evicted. "0" means unlimited. The default is "128".
+// Lower this for models fed with highly variable shapes (e.g. NLP sequence lengths) to bound the memory used.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Path of a per-machine table of tuned MLAS GEMM thread partitionings.
+// The table is loaded at session initialization, if the file exists, and consulted by the CPU GEMM kernels for the
+// shapes it contains. If "session.gemm_autotune" is enabled, the table including the new entries is written back to
+// this path after tuning. The table is process wide, so entries loaded by one session are used by all sessions.
+static const char* const kOrtSessionOptionsConfigGemmTuningFile = "session.gemm_tuning_file";
+
+// Configure whether to benchmark candidate thread partitionings of the CPU GEMMs in the model at session
+// initialization. Only MatMul/Gemm style nodes whose input shapes are fully static are tuned, and shapes already in
+// the tuning table are skipped. This can add noticeable time to session initialization, so it is intended to be run
+// once per machine with "session.gemm_tuning_file" set, e.g. via onnxruntime_perf_test.
+// "0": default, do not tune.
+// "1": tune.
+static const char* const kOrtSessionOptionsConfigGemmAutotune = "session.gemm_autotune";
+
 // NNAPI EP keys begin
 // Note: These options should be specified prior to appending the NNAPI EP to the session options object in order for
 // them to take effect.
@@ -55,7 +55,8 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     float,
     kCpuExecutionProvider,
     KernelDefBuilder()
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayInplace(4, 1),
     Attention<float>);
 
 Status AttentionBase::CheckInputs(const TensorShape& input_shape,
@@ -63,7 +64,8 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
                                   const TensorShape& bias_shape,
                                   const Tensor*& mask_index,
                                   const Tensor* past,
-                                  const Tensor* extra_add_qk) const {
+                                  const Tensor* extra_add_qk,
+                                  const Tensor* past_seq_len) const {
   // Input shapes:
   //   input       : (batch_size, sequence_length, input_hidden_size)
   //   weights     : (input_hidden_size, 3 * hidden_size)
@@ -73,7 +75,9 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
   //                 or (batch_size, past_sequence_length + sequence_length)
   //                 or (batch_size, sequence_length, past_sequence_length + sequence_length)
   //   past        : (2, batch_size, num_heads, past_sequence_length, head_size)
+  //                 or (2, batch_size, num_heads, max_sequence_length, head_size) when past_present_share_buffer is 1
   //   extra_add_qk: (batch_size, num_heads, sequence_length, sequence_length)
+  //   past_seq_len: scalar, required when past_present_share_buffer is 1
   //
   // Where hidden_size = num_heads * head_size.
   // When a model is pruned (like some attention heads are removed), hidden_size < input_hidden_size.
@@ -173,6 +177,22 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs 'past' dimension 2 shall have length of ", hidden_size / num_heads_);
     }
     past_sequence_length = static_cast<int>(past_dims[3]);
+
+    if (past_present_share_buffer_) {
+      if (past_seq_len == nullptr || past_seq_len->Shape().Size() != 1) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Input 'past_sequence_length' shall be a scalar when past_present_share_buffer is 1");
+      }
+      const int max_sequence_length = past_sequence_length;
+      past_sequence_length = *past_seq_len->Data<int32_t>();
+      if (past_sequence_length < 0 || past_sequence_length + sequence_length > max_sequence_length) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Input 'past_sequence_length' plus sequence_length shall not exceed dimension 3 of 'past', got ",
+                               past_sequence_length, " + ", sequence_length, " > ", max_sequence_length);
+      }
+    }
+  } else if (past_present_share_buffer_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'past' is required when past_present_share_buffer is 1");
   }
 
   if (mask_index != nullptr) {  // mask_index is optional
@@ -248,6 +268,10 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "num_heads should be no larger than ", max_threads_per_block);
   }
 
+  if (past_present_share_buffer_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "past_present_share_buffer is only supported by the CPU kernel");
+  }
+
   return CheckInputs(input_shape, weights_shape, bias_shape, mask_index, past, extra_add_qk);
 }
 
@@ -256,16 +280,24 @@ Tensor* AttentionBase::GetPresent(OpKernelContext* context,
                                   int batch_size,
                                   int head_size,
                                   int sequence_length,
-                                  int& past_sequence_length) const {
+                                  int& past_sequence_length,
+                                  const Tensor* past_seq_len) const {
   // Input and output shapes:
   //   past        : (2, batch_size, num_heads, past_sequence_length, head_size)
   //   present     : (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)
+  // When past_present_share_buffer is 1, both have shape (2, batch_size, num_heads, max_sequence_length, head_size)
+  // and past_sequence_length is given by past_seq_len.
 
   std::vector<int64_t> present_dims{2, batch_size, num_heads_, sequence_length, head_size};
   if (nullptr != past) {
     const auto& past_dims = past->Shape().GetDims();
-    past_sequence_length = static_cast<int>(past_dims[3]);
-    present_dims[3] += past_dims[3];
+    if (past_present_share_buffer_) {
+      past_sequence_length = *past_seq_len->Data<int32_t>();
+      present_dims[3] = past_dims[3];
+    } else {
+      past_sequence_length = static_cast<int>(past_dims[3]);
+      present_dims[3] += past_dims[3];
+    }
   }
 
   TensorShape present_shape(present_dims);
@@ -414,6 +446,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* mask_index = context->Input<Tensor>(3);
   const Tensor* past = context->Input<Tensor>(4);
   const Tensor* extra_add_qk = context->Input<Tensor>(5);
+  const Tensor* past_seq_len = context->Input<Tensor>(6);
 
   const TensorShape& weights_shape = (weights ? weights->Shape() : weight_shape_);
   ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(),
@@ -421,7 +454,8 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
                                   bias->Shape(),
                                   mask_index,
                                   past,
-                                  extra_add_qk));
+                                  extra_add_qk,
+                                  past_seq_len));
 
   const auto& shape = input->Shape().GetDims();
   const int batch_size = static_cast<int>(shape[0]);
@@ -484,31 +518,18 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     const auto* weights_data = weights ? weights->template Data<T>() : nullptr;
     const auto* bias_data = bias->template Data<T>();
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(input_hidden_size);
-    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // broadcast NH -> (B.N.S.H) for each of Q, K, V so that the projections below accumulate into the bias
+    const double broadcast_cost = static_cast<double>(sequence_length) * static_cast<double>(head_size);
+    ThreadPool::TryParallelFor(tp, loop_len, broadcast_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const int batch_index = static_cast<int>((i / 3) / num_heads_);
         const int head_index = static_cast<int>((i / 3) % num_heads_);
         const int qkv_index = static_cast<int>(i % 3);
 
-        int input_offset = batch_index * sequence_length * input_hidden_size;
-
-        T* qkv_dest = QKV[qkv_index];
         int head_size = qkv_head_size[qkv_index];
-        int weights_offset = 0;
         int bias_offset = qkv_index * q_hidden_size + head_index * head_size;
-
-        if (!is_prepack_) {
-          weights_offset = bias_offset;
-        } else {
-          weights_offset = head_index * head_size;
-        }
-
         int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
 
-        // TODO!! memcpy here makes it not worthwhile to use Gemm batch. Possible to post process?
-        // broadcast NH -> (B.N.S.H) for each of Q, K, V
         const T* broadcast_data_src = bias_data + bias_offset;
         T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
 
@@ -516,55 +537,61 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
           memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
           broadcast_data_dest += head_size;
         }
+      }
+    });
 
-        //                   original           transposed            iteration
-        // A: input          (BxSxD)            (B.)S x D             S x D
-        // B: weights        (DxNxT)             D x (N.)T            D x H
-        // C: QKV[qkv_index] (BxNxSxT)          (B.N.)S x T           S x H
-        if (is_prepack_) {
-          uint8_t* packed_weight;
-          packed_weight = static_cast<uint8_t*>(packed_weights_[qkv_index].get()) + packed_weights_size_[qkv_index] * (weights_offset / head_size);
-
-          MlasGemm(
-              CblasNoTrans,               // TransA = no
-              sequence_length,            // M      = S
-              head_size,        // N      = H
-              input_hidden_size,          // K      = D
-              1.0f,                       // alpha
-              input_data + input_offset,  // A
-              input_hidden_size,          // lda    = D
-              packed_weight,              // B
-              1.0f,                       // beta
-              qkv_dest + qkv_offset,      // C
-              head_size,                  // ldc
-              nullptr);                   // use single-thread
-        } else {
-          math::GemmEx<float, ThreadPool>(
-              CblasNoTrans,                                 // TransA = no
-              CblasNoTrans,                                 // TransB = no
-              sequence_length,                              // M      = S
-              head_size,                                    // N      = H
-              input_hidden_size,                            // K      = D
-              1.0f,                                         // alpha
-              input_data + input_offset,                    // A
-              input_hidden_size,                            // lda    = D
-              weights_data + weights_offset,                // B
-              q_hidden_size + k_hidden_size + v_hidden_size,// ldb = NH1 + NH2 + NH3
-              1.0f,                                         // beta
-              qkv_dest + qkv_offset,                        // C
-              head_size,                                    // ldc
-              nullptr                                       // use single-thread
-          );
+    //                   original           transposed            iteration
+    // A: input          (BxSxD)            (B.)S x D             S x D
+    // B: weights        (DxNxT)             D x (N.)T            D x H
+    // C: QKV[qkv_index] (BxNxSxT)          (B.N.)S x T           S x H
+    //
+    // Each of Q, K, V is computed as one batch of N.B small GEMMs, which MLAS partitions across the batch first.
+    // The batch is ordered by head so that consecutive GEMMs share the weights of a head.
+    std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_data_vec(static_cast<size_t>(batch_size) * num_heads_);
+
+    for (int qkv_index = 0; qkv_index < 3; qkv_index++) {
+      const int head_size = qkv_head_size[qkv_index];
+
+      for (int head_index = 0; head_index < num_heads_; head_index++) {
+        for (int batch_index = 0; batch_index < batch_size; batch_index++) {
+          auto& gemm_data = gemm_data_vec[static_cast<size_t>(head_index) * batch_size + batch_index];
+
+          int input_offset = batch_index * sequence_length * input_hidden_size;
+          int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
+
+          gemm_data.A = input_data + input_offset;
+          gemm_data.lda = input_hidden_size;  // lda = D
+          if (is_prepack_) {
+            gemm_data.BIsPacked = true;
+            gemm_data.B = reinterpret_cast<const float*>(
+                static_cast<uint8_t*>(packed_weights_[qkv_index].get()) +
+                packed_weights_size_[qkv_index] * head_index);
+          } else {
+            int weights_offset = qkv_index * q_hidden_size + head_index * head_size;
+            gemm_data.B = weights_data + weights_offset;
+            gemm_data.ldb = q_hidden_size + k_hidden_size + v_hidden_size;  // ldb = NH1 + NH2 + NH3
+          }
+          gemm_data.C = QKV[qkv_index] + qkv_offset;
+          gemm_data.ldc = head_size;
+          gemm_data.alpha = 1.0f;
+          gemm_data.beta = 1.0f;
         }
       }
-    });
+
+      MlasGemmBatch(CblasNoTrans,       // TransA = no
+                    CblasNoTrans,       // TransB = no
+                    sequence_length,    // M      = S
+                    head_size,          // N      = H
+                    input_hidden_size,  // K      = D
+                    gemm_data_vec.data(), gemm_data_vec.size(), tp);
+    }
   }
 
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past, output,
                         batch_size, sequence_length,
                         qkv_head_size[0], qkv_head_size[2], v_hidden_size,
-                        extra_add_qk, context);
+                        extra_add_qk, past_seq_len, context);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
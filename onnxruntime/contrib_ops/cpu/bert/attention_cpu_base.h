@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 #include "attention_base.h"
 #include "attention_helper.h"
 
@@ -30,6 +33,7 @@ class AttentionCPUBase : public AttentionBase {
                         int v_head_size,             // head_size
                         int v_hidden_size,           // hidden_size
                         const Tensor* extra_add_qk,  // extra add in QK. Its size is BxNxSxS
+                        const Tensor* past_seq_len,  // valid length of past when past and present share buffer
                         OpKernelContext* context) const {
     AllocatorPtr allocator;
     ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
@@ -37,203 +41,325 @@ class AttentionCPUBase : public AttentionBase {
     auto* tp = context->GetOperatorThreadPool();
 
     int past_sequence_length = 0;
-    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length);
+    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length,
+                                 past_seq_len);
 
     // Total sequence length including that of past state: S* = S' + S
     const int all_sequence_length = past_sequence_length + sequence_length;
 
-    // Compute the attention score. It does 2 things:
-    //         I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
-    //                                           1 x mask_data(B, N, S, S*)
-    //         II.attention_probs(B, N, S, S*) = Softmax(attention_probs)
-    size_t attention_probs_bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * all_sequence_length * sizeof(T);
-    auto attention_probs = allocator->Alloc(attention_probs_bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
-    bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
-
-    void* mask_data = nullptr;
-    if (mask_index != nullptr || has_unidirectional) {
-      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * all_sequence_length * sizeof(T);
-      mask_data = allocator->Alloc(mask_data_bytes);
-      memset(mask_data, 0, mask_data_bytes);
+    // Sequence capacity of each head in present. It is larger than S* when past and present share one buffer
+    // with max_sequence_length, in which case only the first S* entries of each head are valid.
+    const int present_sequence_length = (past_present_share_buffer_ && present != nullptr)
+                                            ? static_cast<int>(present->Shape().GetDims()[3])
+                                            : all_sequence_length;
+
+    // Sequence capacity of each head in past. It is max_sequence_length when past and present share one buffer,
+    // even if present is not requested and the state is concatenated into a buffer of S* per head instead.
+    const int past_buffer_sequence_length = (past_present_share_buffer_ && past != nullptr)
+                                                ? static_cast<int>(past->Shape().GetDims()[3])
+                                                : present_sequence_length;
+
+    if (qk_head_size == 0) {
+      qk_head_size = v_head_size;
     }
-    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
 
-    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
+    // 4D mask in Megatron GPT2 is currently not support in CPU kernel
     const std::vector<int64_t>* mask_index_dims = mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr;
+    if (nullptr != mask_index_dims && mask_index_dims->size() == 4) {
+      ORT_NOT_IMPLEMENTED("4D mask in attention cpu kernel is not supported");
+    }
+
+    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
     const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
     T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
-
-    const T* extra_add_qk_data = nullptr;
-    if (extra_add_qk != nullptr) {
-      extra_add_qk_data = extra_add_qk->template Data<T>();
+    const T* extra_add_qk_data = extra_add_qk != nullptr ? extra_add_qk->template Data<T>() : nullptr;
+
+    // The past state still has to be attended to when the present output is not requested,
+    // so concatenate into a temporary buffer with the same layout as present.
+    void* kv_state = nullptr;
+    if (present_data == nullptr && past_data != nullptr) {
+      kv_state = allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * all_sequence_length *
+                                  (qk_head_size + v_head_size) * sizeof(T));
+      present_data = static_cast<T*>(kv_state);
     }
+    BufferUniquePtr kv_state_buffer(kv_state, BufferDeleter(allocator));
 
-    ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
-                             mask_index_data, mask_index_dims, static_cast<T*>(mask_data), has_unidirectional,
-                             batch_size, sequence_length, past_sequence_length, qk_head_size == 0 ? v_head_size : qk_head_size,
-                             past_data, present_data, tp, extra_add_qk_data);
-
-    // Compute the attentionScore * Value. It does: out_tmp(B, N, S, H) = attention_probs(B, N, S, S*) x V(B, N, S*, H)
-    auto out_tmp_data =
-        allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * v_head_size * sizeof(T));
-    BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
+    // Per key mask of shape BxS* for 1D and 2D masks. 3D masks are read directly.
+    void* key_mask = nullptr;
+    if (nullptr != mask_index_data && mask_index_dims->size() != 3) {
+      key_mask = allocator->Alloc(SafeInt<size_t>(batch_size) * all_sequence_length * sizeof(T));
+      PrepareKeyMask(mask_index_data, mask_index_dims, static_cast<T*>(key_mask), batch_size, all_sequence_length);
+    }
+    BufferUniquePtr key_mask_buffer(key_mask, BufferDeleter(allocator));
+
+    const T* k_data = K;
+    const T* v_data = V;
+    if (nullptr != present_data) {
+      if (past_present_share_buffer_) {
+        // Only the new K and V are written when past and present are bound to the same buffer. Otherwise only the
+        // valid entries of past are copied, not the whole capacity.
+        AppendToPresent(K, V, past_data != present_data ? past_data : nullptr, present_data, batch_size,
+                        sequence_length, past_sequence_length, past_buffer_sequence_length, present_sequence_length,
+                        qk_head_size, v_head_size, tp);
+      } else {
+        ConcatPastToPresent(K, V, past_data, present_data, batch_size, sequence_length, past_sequence_length,
+                            qk_head_size, v_head_size, tp);
+      }
+      k_data = present_data;
+      v_data = present_data + SafeInt<size_t>(batch_size) * num_heads_ * present_sequence_length * qk_head_size;
+    }
 
-    ComputeVxAttentionScore(output->template MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs), V,
-                            batch_size, sequence_length, past_sequence_length, v_head_size, v_hidden_size,
-                            past_data, present_data, tp);
+    ComputeFusedAttention(output->template MutableData<T>(), Q, k_data, v_data,
+                          mask_index_data, mask_index_dims, static_cast<const T*>(key_mask), extra_add_qk_data,
+                          batch_size, sequence_length, past_sequence_length, present_sequence_length,
+                          qk_head_size, v_head_size, v_hidden_size, allocator, tp);
 
     return Status::OK();
   }
 
  private:
-  // Helper function to compute the attention probs. It does 2 things:
-  //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
-  //                                    1 x mask_data(B, N, S, S*)
-  //  II.attention_probs(B, N, S, S*) = Softmax(attention_probs)
+  // Concatenate past and current K and V of each head into present: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
   template <typename T>
-  void ComputeAttentionProbs(T* attention_probs,                           // output buffer for the attention probs. Its size is BxNxSxS*
+  void ConcatPastToPresent(const T* K,                // K data. Its size is BxNxSxH
+                           const T* V,                // V data. Its size is BxNxSxH_v
+                           const T* past,             // past state. nullptr if there is no past
+                           T* present,                // present state with size 2xBxNxS*xH
+                           int batch_size,            // batch size
+                           int sequence_length,       // sequence length
+                           int past_sequence_length,  // sequence length in past state
+                           int qk_head_size,          // head size of Q and K
+                           int v_head_size,           // head size of V
+                           ThreadPool* tp) const {
+    const int all_sequence_length = past_sequence_length + sequence_length;
+    const size_t k_past_chunk_length = static_cast<size_t>(past_sequence_length) * qk_head_size;
+    const size_t k_input_chunk_length = static_cast<size_t>(sequence_length) * qk_head_size;
+    const size_t v_past_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+    const size_t v_input_chunk_length = static_cast<size_t>(sequence_length) * v_head_size;
+
+    const std::ptrdiff_t loop_len = static_cast<std::ptrdiff_t>(batch_size) * num_heads_;
+    const T* past_v = past != nullptr ? past + static_cast<size_t>(loop_len) * k_past_chunk_length : nullptr;
+    T* present_v = present + static_cast<size_t>(loop_len) * all_sequence_length * qk_head_size;
+
+    const double cost = static_cast<double>(all_sequence_length) * (qk_head_size + v_head_size);
+
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        ConcatStateChunk(past, K + k_input_chunk_length * i, present,
+                         k_past_chunk_length, k_past_chunk_length + k_input_chunk_length, i);
+        ConcatStateChunk(past_v, V + v_input_chunk_length * i, present_v,
+                         v_past_chunk_length, v_past_chunk_length + v_input_chunk_length, i);
+      }
+    });
+  }
+
+  // Write K and V of the current input after the first S' entries of each head in present:
+  // (BxNx)SxH -> (BxNx)[S', S' + S)xH. The past entries are read in place, or copied from past when it is a
+  // different buffer. past has capacity S_max per head, and present has either the same capacity or S* when it
+  // is a temporary buffer.
+  template <typename T>
+  void AppendToPresent(const T* K,                       // K data. Its size is BxNxSxH
+                       const T* V,                       // V data. Its size is BxNxSxH_v
+                       const T* past,                    // past state with size 2xBxNxS_maxxH, or nullptr if shared
+                       T* present,                       // present state with size 2xBxNxS_maxxH or 2xBxNxS*xH
+                       int batch_size,                   // batch size
+                       int sequence_length,              // sequence length
+                       int past_sequence_length,         // number of valid entries in present before this call
+                       int past_buffer_sequence_length,  // sequence capacity of each head in past
+                       int present_sequence_length,      // sequence capacity of each head in present
+                       int qk_head_size,                 // head size of Q and K
+                       int v_head_size,                  // head size of V
+                       ThreadPool* tp) const {
+    const size_t k_input_chunk_length = static_cast<size_t>(sequence_length) * qk_head_size;
+    const size_t v_input_chunk_length = static_cast<size_t>(sequence_length) * v_head_size;
+
+    const std::ptrdiff_t loop_len = static_cast<std::ptrdiff_t>(batch_size) * num_heads_;
+    T* present_v = present + static_cast<size_t>(loop_len) * present_sequence_length * qk_head_size;
+    const T* past_v = past != nullptr
+                          ? past + static_cast<size_t>(loop_len) * past_buffer_sequence_length * qk_head_size
+                          : nullptr;
+
+    const int copy_length = sequence_length + (past != nullptr ? past_sequence_length : 0);
+    const double cost = static_cast<double>(copy_length) * (qk_head_size + v_head_size);
+
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        T* k_head = present + static_cast<size_t>(i) * present_sequence_length * qk_head_size;
+        T* v_head = present_v + static_cast<size_t>(i) * present_sequence_length * v_head_size;
+        if (past != nullptr) {
+          memcpy(k_head, past + static_cast<size_t>(i) * past_buffer_sequence_length * qk_head_size,
+                 static_cast<size_t>(past_sequence_length) * qk_head_size * sizeof(T));
+          memcpy(v_head, past_v + static_cast<size_t>(i) * past_buffer_sequence_length * v_head_size,
+                 static_cast<size_t>(past_sequence_length) * v_head_size * sizeof(T));
+        }
+
+        T* k_dest = k_head + static_cast<size_t>(past_sequence_length) * qk_head_size;
+        T* v_dest = v_head + static_cast<size_t>(past_sequence_length) * v_head_size;
+        memcpy(k_dest, K + k_input_chunk_length * i, k_input_chunk_length * sizeof(T));
+        memcpy(v_dest, V + v_input_chunk_length * i, v_input_chunk_length * sizeof(T));
+      }
+    });
+  }
+
+  // Compute output(B, S, N, H_v) = Softmax(1/sqrt(H) x Q x K' + mask + extra_add_qk) x V without materializing
+  // the (B, N, S, S*) attention probs. Each work item is a block of query rows of one head, which walks over
+  // key blocks and keeps a running max and sum per row (online softmax), rescaling its partial output as the
+  // max grows. Scratch space is O(block size x (block size + H_v)) per work item.
+  template <typename T>
+  void ComputeFusedAttention(T* output,                                    // output with size BxSxNxH_v
                              const T* Q,                                   // Q data. Its size is BxNxSxH
-                             const T* K,                                   // k data. Its size is BxNxSxH
-                             const int32_t* mask_index,                    // mask index. nullptr if no mask or its size is B
+                             const T* K,                                   // K data. Its size is BxNxS_maxxH
+                             const T* V,                                   // V data. Its size is BxNxS_maxxH_v
+                             const int32_t* mask_index,                    // mask index. nullptr if no mask
                              const std::vector<int64_t>* mask_index_dims,  // mask index shape
-                             T* mask_data,                                 // buffer for mask data. It is nullptr if mask_index is nullptr and not unidirectional, otherwise its shape is BxSxS*
-                             bool has_unidirectional,                      // has unidirectional mask
-                             int batch_size,                               // batch size of self-attention
-                             int sequence_length,                          // sequence length of self-attention
-                             int past_sequence_length,                     // sequence length of past state
-                             int head_size,                                // head size of self-attention
-                             const T* past,                                // past state
-                             T* present,                                   // present state
-                             ThreadPool* tp,                               // thread pool
-                             const T* extra_add_qk_data                    // extra add matrix with shape BxNxSxS*
-  ) const {
-    const int all_sequence_length = past_sequence_length + sequence_length;                  // S* = S' + S
-    const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;  // S' x H
-    const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;      // S x H
-    const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
-
-    {
-      if (mask_data != nullptr) {
-        PrepareMask(mask_index, mask_index_dims, mask_data, has_unidirectional, batch_size, sequence_length, past_sequence_length);
-      } else {  // no any mask
-        memset(attention_probs, 0, static_cast<size_t>(batch_size) * num_heads_ * sequence_length * all_sequence_length * sizeof(T));
-      }
+                             const T* key_mask,                            // per key mask BxS* for 1D/2D masks, otherwise nullptr
+                             const T* extra_add_qk_data,                   // extra add matrix with shape BxNxSxS*
+                             int batch_size,                               // batch size
+                             int sequence_length,                          // sequence length
+                             int past_sequence_length,                     // sequence length in past state
+                             int kv_sequence_length,                       // S_max, sequence capacity of each head in K and V
+                             int qk_head_size,                             // head size of Q and K
+                             int v_head_size,                              // head size of V
+                             int v_hidden_size,                            // hidden size of output
+                             AllocatorPtr allocator,                       // allocator for scratch buffers
+                             ThreadPool* tp) const {
+    constexpr int kQueryBlockSize = 64;
+    constexpr int kKeyBlockSize = 256;
+    // Logits at or below the unidirectional mask value contribute exactly zero once the row max is this far above it.
+    constexpr float kMaskedLogitMargin = 128.0f;
+    constexpr float kMaskValue = -10000.0f;
+
+    const int all_sequence_length = past_sequence_length + sequence_length;
+    const bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
+    const bool has_3d_mask = (nullptr != mask_index && mask_index_dims->size() == 3);
+    const float alpha = 1.0f / sqrt(static_cast<float>(qk_head_size));
 
-      const int loop_len = batch_size * num_heads_;
-      const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+    const int query_blocks = (sequence_length + kQueryBlockSize - 1) / kQueryBlockSize;
+    const int q_rows_max = std::min(sequence_length, kQueryBlockSize);
+    const int k_cols_max = std::min(all_sequence_length, kKeyBlockSize);
+    const std::ptrdiff_t loop_len = static_cast<std::ptrdiff_t>(batch_size) * num_heads_ * query_blocks;
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size) * sequence_length * all_sequence_length;
+    const double cost = static_cast<double>(q_rows_max) * all_sequence_length * (qk_head_size + v_head_size);
 
-      ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-        for (std::ptrdiff_t i = begin; i != end; ++i) {
-          const int batch_index = static_cast<int>(i) / num_heads_;
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      const size_t scratch_elements = SafeInt<size_t>(q_rows_max) * (k_cols_max + v_head_size + 2);
+      auto* scratch = static_cast<T*>(allocator->Alloc(scratch_elements * sizeof(T)));
+      BufferUniquePtr scratch_buffer(scratch, BufferDeleter(allocator));
 
-          const int output_offset = static_cast<int>(i) * sequence_length * all_sequence_length;
-          const int mask_offset = batch_index * sequence_length * all_sequence_length;
-          T* output = attention_probs + output_offset;
+      T* scores = scratch;                          // q_rows x k_cols
+      T* out = scores + q_rows_max * k_cols_max;    // q_rows x H_v
+      T* row_max = out + q_rows_max * v_head_size;  // q_rows
+      T* row_sum = row_max + q_rows_max;            // q_rows
 
-          // Broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
-          if (mask_data != nullptr) {
-            memcpy(output, mask_data + mask_offset, sequence_length * all_sequence_length * sizeof(T));
+      for (std::ptrdiff_t work = begin; work != end; ++work) {
+        const std::ptrdiff_t i = work / query_blocks;  // index of (batch, head)
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int q_start = static_cast<int>(work % query_blocks) * kQueryBlockSize;
+        const int q_rows = std::min(kQueryBlockSize, sequence_length - q_start);
+
+        const T* q = Q + (static_cast<size_t>(i) * sequence_length + q_start) * qk_head_size;
+        const T* k = K + static_cast<size_t>(i) * kv_sequence_length * qk_head_size;
+        const T* v = V + static_cast<size_t>(i) * kv_sequence_length * v_head_size;
+
+        std::fill_n(out, static_cast<size_t>(q_rows) * v_head_size, static_cast<T>(0.0f));
+        std::fill_n(row_max, q_rows, std::numeric_limits<T>::lowest());
+        std::fill_n(row_sum, q_rows, static_cast<T>(0.0f));
+
+        for (int m_start = 0; m_start < all_sequence_length; m_start += kKeyBlockSize) {
+          const int k_cols = std::min(kKeyBlockSize, all_sequence_length - m_start);
+
+          // Keys after the diagonal of the last query row in this block are masked for every row.
+          const bool fully_masked = has_unidirectional && m_start > past_sequence_length + q_start + q_rows - 1;
+          if (fully_masked && extra_add_qk_data == nullptr &&
+              std::all_of(row_max, row_max + q_rows, [&](T x) { return x > kMaskValue + kMaskedLogitMargin; })) {
+            break;
           }
 
-          const T* k = K + input_chunk_length * i;
-          if (nullptr != present) {
-            // Concatenate past_K and K : (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-            k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
+          // scores(q_rows, k_cols) = 1/sqrt(H) x Q(q_rows, H) x K'(H, k_cols)
+          if (!fully_masked) {
+            math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, q_rows, k_cols, qk_head_size, alpha,
+                                      q, k + static_cast<size_t>(m_start) * qk_head_size, 0.0f,
+                                      scores, nullptr);
           }
 
-          // Compute Q*K' + AttentionMask
-          //                     original                 transposed             each iteration
-          // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
-          // B: K'               (B x N x) S* x H         (B x N x) H x S*       H x S*
-          // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x S*
-          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, alpha,
-                                    Q + input_chunk_length * i, k, 1.0,
-                                    output, nullptr);
-
-          // Fix unidirectional mask to be parity with huggingface implementation.
-          if (has_unidirectional) {
-            for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
-              for (int m_i = past_sequence_length + s_i + 1; m_i < all_sequence_length; m_i++) {
-                int j = s_i * all_sequence_length + m_i;
-                output[j] = mask_data[mask_offset + j];
+          for (int r = 0; r < q_rows; r++) {
+            const int s_i = q_start + r;
+            T* x = scores + r * k_cols;
+
+            const T* p_key_mask = key_mask != nullptr ? key_mask + batch_index * all_sequence_length + m_start : nullptr;
+            const int32_t* p_3d_mask =
+                has_3d_mask ? mask_index + (static_cast<size_t>(batch_index) * sequence_length + s_i) * all_sequence_length + m_start
+                            : nullptr;
+
+            // Keys past this row's diagonal take the mask value only, for parity with huggingface implementation.
+            int visible = k_cols;
+            if (has_unidirectional) {
+              visible = std::max(0, std::min(k_cols, past_sequence_length + s_i + 1 - m_start));
+            }
+
+            if (p_key_mask != nullptr) {
+              for (int j = 0; j < visible; j++) {
+                x[j] += p_key_mask[j];
+              }
+              for (int j = visible; j < k_cols; j++) {
+                x[j] = p_key_mask[j] + static_cast<T>(kMaskValue);
+              }
+            } else if (p_3d_mask != nullptr) {
+              for (int j = 0; j < visible; j++) {
+                x[j] += (p_3d_mask[j] > 0) ? static_cast<T>(0.0f) : static_cast<T>(kMaskValue);
+              }
+              for (int j = visible; j < k_cols; j++) {
+                x[j] = (p_3d_mask[j] > 0) ? static_cast<T>(kMaskValue) : static_cast<T>(2 * kMaskValue);
+              }
+            } else {
+              for (int j = visible; j < k_cols; j++) {
+                x[j] = static_cast<T>(kMaskValue);
               }
             }
-          }
 
-          if (extra_add_qk_data != nullptr) {
-            for (int j = 0; j < sequence_length * all_sequence_length; j++) {
-              output[j] += extra_add_qk_data[output_offset + j];
+            if (extra_add_qk_data != nullptr) {
+              const T* add = extra_add_qk_data + (static_cast<size_t>(i) * sequence_length + s_i) * all_sequence_length + m_start;
+              for (int j = 0; j < k_cols; j++) {
+                x[j] += add[j];
+              }
             }
-          }
-        }
-      });
-    }
 
-    //  attention_probs(B, N, S, S*) = Softmax(attention_probs)
-    {
-      const int N = batch_size * num_heads_ * sequence_length;
-      const int D = all_sequence_length;
-      ComputeAttentionSoftmaxInplace(attention_probs, N, D, tp);
-    }
-  }
+            // Online softmax: rescale the running sum and partial output when the max grows.
+            const T block_max = *std::max_element(x, x + k_cols);
+            const T new_max = std::max(row_max[r], block_max);
+            const T scale = static_cast<T>(expf(static_cast<float>(row_max[r] - new_max)));
+            row_max[r] = new_max;
 
-  template <typename T>
-  void ComputeVxAttentionScore(T* output,                 // buffer for the result with size BxSxNxH
-                               T* tmp_buffer,             // buffer for temp use with size is BxNxSxH
-                               const T* attention_probs,  // Attention probs with size BxNxSxS*
-                               const T* V,                // V value with size BxNxSxH
-                               int batch_size,            // batch size
-                               int sequence_length,       // sequence length
-                               int past_sequence_length,  // sequence length in past state
-                               int head_size,             // head size
-                               int hidden_size,           // hidden size
-                               const T* past,             // past state
-                               T* present,                // present state
-                               ThreadPool* tp) const {
-    const int all_sequence_length = past_sequence_length + sequence_length;                  // S* = S' + S
-    const size_t past_chunk_length = static_cast<size_t>(past_sequence_length * head_size);  // S' x H
-    const size_t input_chunk_length = static_cast<size_t>(sequence_length * head_size);      // S x H
-    const size_t present_chunk_length = past_chunk_length + input_chunk_length;              // S* x H
-
-    // Move the pointer of past and present to start of v values.
-    if (nullptr != past) {
-      past += batch_size * num_heads_ * past_sequence_length * head_size;
-    }
-    if (nullptr != present) {
-      present += batch_size * num_heads_ * all_sequence_length * head_size;
-    }
+            for (int j = 0; j < k_cols; j++) {
+              x[j] -= new_max;
+            }
+            ComputeAttentionExpInplace(x, k_cols);
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(sequence_length);
+            T sum = static_cast<T>(0.0f);
+            for (int j = 0; j < k_cols; j++) sum += x[j];
+            row_sum[r] = row_sum[r] * scale + sum;
 
-    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const T* v = V + input_chunk_length * i;
-        if (nullptr != present) {
-          // concatenate past_V and V: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH
-          v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
-        }
+            if (scale != static_cast<T>(1.0f)) {
+              T* o = out + r * v_head_size;
+              for (int h = 0; h < v_head_size; h++) o[h] *= scale;
+            }
+          }
 
-        T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + input_chunk_length * i;
-        math::MatMul<T>(sequence_length, head_size, all_sequence_length,
-                        attention_probs + sequence_length * all_sequence_length * i,
-                        v, current_tmp_data, nullptr);
+          // out(q_rows, H_v) += exp_scores(q_rows, k_cols) x V(k_cols, H_v)
+          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasNoTrans, q_rows, v_head_size, k_cols, 1.0f,
+                                    scores, v + static_cast<size_t>(m_start) * v_head_size, 1.0f,
+                                    out, nullptr);
+        }
 
-        // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-        const int batch_index = static_cast<int>(i / num_heads_);
-        const int head_index = static_cast<int>(i % num_heads_);
-        T* src = current_tmp_data;
-        T* dest = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-        const auto bytes_to_copy = SafeInt<size_t>(head_size) * sizeof(T);
-        for (int j = 0; j < sequence_length; j++) {
-          memcpy(dest, src, bytes_to_copy);
-          src += head_size;
-          dest += hidden_size;
+        // Normalize and transpose: output(B, S, N, H_v) = out(B, N, S, H_v) / row_sum
+        for (int r = 0; r < q_rows; r++) {
+          const T inv_sum = static_cast<T>(1.0f) / row_sum[r];
+          const T* src = out + r * v_head_size;
+          T* dest = output + (static_cast<size_t>(batch_index) * sequence_length + q_start + r) * v_hidden_size +
+                    static_cast<size_t>(head_index) * v_head_size;
+          for (int h = 0; h < v_head_size; h++) {
+            dest[h] = src[h] * inv_sum;
+          }
         }
       }
     });
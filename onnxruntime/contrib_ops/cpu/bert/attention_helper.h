@@ -60,90 +60,54 @@ inline void ComputeAttentionSoftmaxInplace(float* score, int N, int D, ThreadPoo
   MlasComputeSoftmax(score, score, N, D, false, tp);
 }
 
+// Computes e^x in place for a row of attention scores.
 template <typename T>
-void PrepareMask(const int32_t* mask_index,
-                 const std::vector<int64_t>* mask_index_dims,
-                 T* mask_data,
-                 bool is_unidirectional,
-                 int batch_size,
-                 int sequence_length,
-                 int past_sequence_length) {
-  const int all_sequence_length = past_sequence_length + sequence_length;
-
-  // mask_data has been filled with 0, and its shape is BxSxS*
-  T* p_mask = mask_data;
-
-  // 4D mask in Megatron GPT2 is currently not support in CPU kernel
-  if (nullptr != mask_index_dims && mask_index_dims->size() == 4) {
-    ORT_NOT_IMPLEMENTED("4D mask in attention cpu kernel is not supported");
+void ComputeAttentionExpInplace(T* x, int D) {
+  for (int i = 0; i < D; i++) {
+    x[i] = static_cast<T>(expf(static_cast<float>(x[i])));
   }
+}
 
-  // For 3D mask, convert values 0 to -10000.0, and 1 to 0.0, then apply unidirectional mask if any.
-  if (nullptr != mask_index_dims && mask_index_dims->size() == 3) {
-    for (int i = 0; i < batch_size * sequence_length * all_sequence_length; i++) {
-      p_mask[i] = (mask_index[i] > 0) ? static_cast<T>(0.0f) : static_cast<T>(-10000.0f);
-    }
-
-    if (is_unidirectional) {
-      for (int b_i = 0; b_i < batch_size; b_i++) {
-        for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
-          for (int m_i = past_sequence_length + s_i + 1; m_i < all_sequence_length; m_i++) {
-            p_mask[s_i * all_sequence_length + m_i] += static_cast<T>(-10000.0f);
-          }
-        }
-        p_mask += sequence_length * all_sequence_length;
-      }
-    }
-
-    return;
-  }
+template <>
+inline void ComputeAttentionExpInplace(float* x, int D) {
+  MlasComputeExp(x, x, static_cast<size_t>(D));
+}
 
+// Prepare the per key mask of shape BxS* for a 1D or 2D mask_index. Values are 0.0 for keys
+// that are attended to, and -10000.0 for masked keys. The mask is not broadcast over the
+// query sequence; the unidirectional mask is applied by the attention kernel.
+template <typename T>
+void PrepareKeyMask(const int32_t* mask_index,
+                    const std::vector<int64_t>* mask_index_dims,
+                    T* key_mask,
+                    int batch_size,
+                    int all_sequence_length) {
   bool is_raw_attention_mask = (nullptr != mask_index_dims && mask_index_dims->size() == 2);
   bool has_mask_start_position = (nullptr != mask_index_dims && mask_index_dims->size() == 1 && static_cast<int>(mask_index_dims->at(0)) == 2 * batch_size);
 
   for (int b_i = 0; b_i < batch_size; b_i++) {
-    // TODO: mask_index can be used in softmax to save some calculation.
-    if (nullptr != mask_index) {
-      if (is_raw_attention_mask) {
-        // Raw attention mask has value 0 or 1. Here we convert 0 to -10000.0, and 1 to 0.0.
-        const int32_t* raw_mask = mask_index + b_i * all_sequence_length;
-        for (int m_i = 0; m_i < all_sequence_length; m_i++) {
-          p_mask[m_i] = (raw_mask[m_i] > 0) ? static_cast<T>(0.0f) : static_cast<T>(-10000.0f);
-        }
-      } else {
-        // mask_index is 1D: (B) or (2B) => (Bx)S*
-
-        // Handle right-side padding: mask value at or after the end position will be -10000.0
-        int end_position = mask_index[b_i];
-        for (int m_i = end_position; m_i < all_sequence_length; m_i++) {
-          p_mask[m_i] = static_cast<T>(-10000.0f);
-        }
+    T* p_mask = key_mask + b_i * all_sequence_length;
 
-        // Handle left-side padding: mask value before the start position will be -10000.0
-        if (has_mask_start_position) {
-          int start_position = std::min(mask_index[b_i + batch_size], all_sequence_length);
-          for (int m_i = 0; m_i < start_position; m_i++) {
-            p_mask[m_i] = static_cast<T>(-10000.0f);
-          }
-        }
+    if (is_raw_attention_mask) {
+      // Raw attention mask has value 0 or 1. Here we convert 0 to -10000.0, and 1 to 0.0.
+      const int32_t* raw_mask = mask_index + b_i * all_sequence_length;
+      for (int m_i = 0; m_i < all_sequence_length; m_i++) {
+        p_mask[m_i] = (raw_mask[m_i] > 0) ? static_cast<T>(0.0f) : static_cast<T>(-10000.0f);
       }
+      continue;
     }
 
-    // Broadcast mask from (Bx)S* to (Bx)SxS*
-    for (int s_i = 1; s_i < sequence_length; s_i++) {
-      memcpy(p_mask + s_i * all_sequence_length, p_mask, all_sequence_length * sizeof(T));
+    // mask_index is 1D: (B) or (2B) => (Bx)S*
+    int end_position = std::max(std::min(mask_index[b_i], all_sequence_length), 0);
+    int start_position = 0;
+    if (has_mask_start_position) {
+      start_position = std::max(std::min(mask_index[b_i + batch_size], all_sequence_length), 0);
     }
 
-    // Apply unidirectional mask.
-    if (is_unidirectional) {
-      for (int s_i = 0; s_i < sequence_length - 1; s_i++) {
-        for (int m_i = past_sequence_length + s_i + 1; m_i < all_sequence_length; m_i++) {
-          p_mask[s_i * all_sequence_length + m_i] += static_cast<T>(-10000.0f);
-        }
-      }
+    for (int m_i = 0; m_i < all_sequence_length; m_i++) {
+      bool is_masked = (m_i >= end_position) || (m_i < start_position);
+      p_mask[m_i] = is_masked ? static_cast<T>(-10000.0f) : static_cast<T>(0.0f);
     }
-
-    p_mask += sequence_length * all_sequence_length;
   }
 }
 
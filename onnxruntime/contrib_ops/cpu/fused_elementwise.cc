@@ -0,0 +1,263 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of elements evaluated per step before moving to the next step. The operands and the
+// intermediate results of a block are small enough to stay in the L1 cache.
+constexpr int64_t kBlockSize = 512;
+
+bool IsUnaryOp(FusedElementwiseOp op) {
+  return op != FusedElementwiseOp::Add && op != FusedElementwiseOp::Sub &&
+         op != FusedElementwiseOp::Mul && op != FusedElementwiseOp::Div;
+}
+
+// Rough per element cost of each operator in cycles, used to size the parallel work items.
+double OpCost(FusedElementwiseOp op) {
+  switch (op) {
+    case FusedElementwiseOp::Sigmoid:
+    case FusedElementwiseOp::Tanh:
+    case FusedElementwiseOp::Erf:
+    case FusedElementwiseOp::Exp:
+    case FusedElementwiseOp::Log:
+      return 8.0;
+    case FusedElementwiseOp::Div:
+    case FusedElementwiseOp::Sqrt:
+    case FusedElementwiseOp::Reciprocal:
+      return 4.0;
+    default:
+      return 1.0;
+  }
+}
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  static const std::unordered_map<std::string, FusedElementwiseOp> op_map = {
+      {"Add", FusedElementwiseOp::Add},
+      {"Sub", FusedElementwiseOp::Sub},
+      {"Mul", FusedElementwiseOp::Mul},
+      {"Div", FusedElementwiseOp::Div},
+      {"Relu", FusedElementwiseOp::Relu},
+      {"Sigmoid", FusedElementwiseOp::Sigmoid},
+      {"Tanh", FusedElementwiseOp::Tanh},
+      {"Erf", FusedElementwiseOp::Erf},
+      {"Exp", FusedElementwiseOp::Exp},
+      {"Log", FusedElementwiseOp::Log},
+      {"Sqrt", FusedElementwiseOp::Sqrt},
+      {"Neg", FusedElementwiseOp::Neg},
+      {"Abs", FusedElementwiseOp::Abs},
+      {"Reciprocal", FusedElementwiseOp::Reciprocal},
+  };
+
+  num_inputs_ = static_cast<int64_t>(info.GetInputCount());
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK(), "FusedElementwise requires the 'ops' attribute.");
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK(),
+              "FusedElementwise requires the 'operands' attribute.");
+  ORT_ENFORCE(!ops.empty() && operands.size() == 2 * ops.size(),
+              "FusedElementwise expects two operands per step. Got ", ops.size(), " steps and ",
+              operands.size(), " operands.");
+
+  steps_.reserve(ops.size());
+  for (size_t k = 0; k < ops.size(); ++k) {
+    auto it = op_map.find(ops[k]);
+    ORT_ENFORCE(it != op_map.end(), "FusedElementwise does not support the operator ", ops[k]);
+
+    FusedElementwiseStep step{it->second, operands[2 * k], operands[2 * k + 1]};
+    // Operands may refer to an input or to the result of an earlier step.
+    const int64_t operand_limit = num_inputs_ + static_cast<int64_t>(k);
+    ORT_ENFORCE(step.a >= 0 && step.a < operand_limit, "Invalid first operand ", step.a, " for step ", k);
+    if (IsUnaryOp(step.op)) {
+      ORT_ENFORCE(step.b == -1, "Unary step ", k, " must not have a second operand.");
+    } else {
+      ORT_ENFORCE(step.b >= 0 && step.b < operand_limit, "Invalid second operand ", step.b, " for step ", k);
+    }
+    steps_.push_back(step);
+  }
+}
+
+void FusedElementwise::ComputeBlock(const float* const* inputs, const int64_t* input_sizes, float* scratch,
+                                    float* output, int64_t start, int64_t count) const {
+  const int64_t output_size = input_sizes[num_inputs_];
+
+  // Broadcast the inputs that do not cover the whole output into their scratch slots.
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const int64_t input_size = input_sizes[i];
+    if (input_size == output_size) {
+      continue;
+    }
+    float* slot = scratch + i * kBlockSize;
+    if (input_size == 1) {
+      std::fill_n(slot, count, inputs[i][0]);
+      continue;
+    }
+    int64_t offset = start % input_size;
+    for (int64_t filled = 0; filled < count;) {
+      const int64_t n = std::min(count - filled, input_size - offset);
+      std::copy_n(inputs[i] + offset, n, slot + filled);
+      filled += n;
+      offset = 0;
+    }
+  }
+
+  auto operand = [&](int64_t index) -> const float* {
+    if (index < num_inputs_ && input_sizes[index] == output_size) {
+      return inputs[index] + start;
+    }
+    return scratch + index * kBlockSize;
+  };
+
+  const size_t last_step = steps_.size() - 1;
+  for (size_t k = 0; k < steps_.size(); ++k) {
+    const auto& step = steps_[k];
+    float* y = (k == last_step) ? output + start : scratch + (num_inputs_ + static_cast<int64_t>(k)) * kBlockSize;
+    const float* a = operand(step.a);
+
+    EigenVectorArrayMap<float> ym(y, count);
+    ConstEigenVectorArrayMap<float> am(a, count);
+
+    switch (step.op) {
+      case FusedElementwiseOp::Add:
+        ym = am + ConstEigenVectorArrayMap<float>(operand(step.b), count);
+        break;
+      case FusedElementwiseOp::Sub:
+        ym = am - ConstEigenVectorArrayMap<float>(operand(step.b), count);
+        break;
+      case FusedElementwiseOp::Mul:
+        ym = am * ConstEigenVectorArrayMap<float>(operand(step.b), count);
+        break;
+      case FusedElementwiseOp::Div:
+        ym = am / ConstEigenVectorArrayMap<float>(operand(step.b), count);
+        break;
+      case FusedElementwiseOp::Relu:
+        ym = am.cwiseMax(0.0f);
+        break;
+      case FusedElementwiseOp::Sigmoid:
+        MlasComputeLogistic(a, y, static_cast<size_t>(count));
+        break;
+      case FusedElementwiseOp::Tanh:
+        MlasComputeTanh(a, y, static_cast<size_t>(count));
+        break;
+      case FusedElementwiseOp::Erf:
+        MlasComputeErf(a, y, static_cast<size_t>(count));
+        break;
+      case FusedElementwiseOp::Exp:
+        ym = am.exp();
+        break;
+      case FusedElementwiseOp::Log:
+        ym = am.log();
+        break;
+      case FusedElementwiseOp::Sqrt:
+        ym = am.sqrt();
+        break;
+      case FusedElementwiseOp::Neg:
+        ym = -am;
+        break;
+      case FusedElementwiseOp::Abs:
+        ym = am.abs();
+        break;
+      case FusedElementwiseOp::Reciprocal:
+        ym = am.inverse();
+        break;
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  std::vector<const Tensor*> input_tensors(static_cast<size_t>(num_inputs_));
+  std::vector<int64_t> output_dims;
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const Tensor* input = context->Input<Tensor>(static_cast<int>(i));
+    input_tensors[static_cast<size_t>(i)] = input;
+
+    // Multidirectional broadcast of all the input shapes.
+    const auto& dims = input->Shape().GetDims();
+    if (dims.size() > output_dims.size()) {
+      output_dims.insert(output_dims.begin(), dims.size() - output_dims.size(), 1);
+    }
+    const size_t offset = output_dims.size() - dims.size();
+    for (size_t d = 0; d < dims.size(); ++d) {
+      int64_t& output_dim = output_dims[offset + d];
+      if (output_dim == 1) {
+        output_dim = dims[d];
+      } else if (dims[d] != 1 && dims[d] != output_dim) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                               input->Shape(), " can not be broadcast to the other inputs.");
+      }
+    }
+  }
+
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  const int64_t output_size = output->Shape().Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  // The kernel indexes each input as input[i % input_size], which requires every input to match a
+  // trailing part of the output shape once its leading ones are dropped.
+  std::vector<const float*> inputs(static_cast<size_t>(num_inputs_));
+  std::vector<int64_t> input_sizes(static_cast<size_t>(num_inputs_) + 1);
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const Tensor* input = input_tensors[static_cast<size_t>(i)];
+    const auto& dims = input->Shape().GetDims();
+    auto first = std::find_if(dims.begin(), dims.end(), [](int64_t dim) { return dim != 1; });
+    const size_t trailing = static_cast<size_t>(dims.end() - first);
+    if (!std::equal(first, dims.end(), output_dims.end() - trailing)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                             input->Shape(), " must match the trailing dimensions of the output shape ",
+                             output->Shape());
+    }
+    inputs[static_cast<size_t>(i)] = input->Data<float>();
+    input_sizes[static_cast<size_t>(i)] = input->Shape().Size();
+  }
+  input_sizes[static_cast<size_t>(num_inputs_)] = output_size;
+
+  double compute_cost = 0.0;
+  for (const auto& step : steps_) {
+    compute_cost += OpCost(step.op);
+  }
+
+  float* output_data = output->MutableData<float>();
+  const size_t scratch_size = static_cast<size_t>((num_inputs_ + static_cast<int64_t>(steps_.size())) * kBlockSize);
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(output_size),
+      TensorOpCost{static_cast<double>(num_inputs_ * sizeof(float)), static_cast<double>(sizeof(float)),
+                   compute_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> scratch(scratch_size);
+        for (int64_t start = first; start < last; start += kBlockSize) {
+          const int64_t count = std::min<int64_t>(kBlockSize, last - start);
+          ComputeBlock(inputs.data(), input_sizes.data(), scratch.data(), output_data, start, count);
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
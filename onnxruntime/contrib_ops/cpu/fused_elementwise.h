@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+enum class FusedElementwiseOp : uint8_t {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Relu,
+  Sigmoid,
+  Tanh,
+  Erf,
+  Exp,
+  Log,
+  Sqrt,
+  Neg,
+  Abs,
+  Reciprocal,
+};
+
+struct FusedElementwiseStep {
+  FusedElementwiseOp op;
+  // Operand indices: [0, num_inputs) selects an input, num_inputs + k selects the result of step k.
+  int64_t a;
+  int64_t b;
+};
+
+/**
+@Class FusedElementwise
+Evaluates a chain or tree of elementwise operators produced by ElementwiseFusion block by block, so
+the intermediate results stay in cache and only the final result is written to memory.
+*/
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  void ComputeBlock(const float* const* inputs, const int64_t* input_sizes, float* scratch,
+                    float* output, int64_t start, int64_t count) const;
+
+  int64_t num_inputs_;
+  std::vector<FusedElementwiseStep> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
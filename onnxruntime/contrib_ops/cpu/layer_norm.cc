@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -34,6 +35,72 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+// Mean and InvStdDev are stored as float for half precision inputs.
+template <typename T>
+struct LayerNormStatType {
+  using type = T;
+};
+
+template <>
+struct LayerNormStatType<MLFloat16> {
+  using type = float;
+};
+
+template <typename T>
+void ComputeJob(const T* p_input, const T* scale_data, const T* bias_data, T* p_output, int64_t norm_size,
+                float epsilon, bool simplified, T* mean, T* inv_std_dev) {
+  T mean_value = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean_value += p_input[h];
+    mean_square += p_input[h] * p_input[h];
+  }
+
+  mean_value = mean_value / norm_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / norm_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / norm_size - mean_value * mean_value + epsilon);
+  }
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    if (simplified) {
+      p_output[h] = p_input[h] / mean_square * scale_data[h];
+    } else if (nullptr == bias_data) {
+      p_output[h] = (p_input[h] - mean_value) / mean_square * scale_data[h];
+    } else {
+      p_output[h] = (p_input[h] - mean_value) / mean_square * scale_data[h] + bias_data[h];
+    }
+  }
+
+  if (mean != nullptr) {
+    *mean = mean_value;
+  }
+  *inv_std_dev = 1 / mean_square;
+}
+
+void ComputeJob(const float* p_input, const float* scale_data, const float* bias_data, float* p_output,
+                int64_t norm_size, float epsilon, bool simplified, float* mean, float* inv_std_dev) {
+  MlasLayerNormalization(p_input, nullptr, nullptr, scale_data, bias_data, p_output,
+                         static_cast<size_t>(norm_size), epsilon, simplified, mean, inv_std_dev);
+}
+
+void ComputeJob(const MLFloat16* p_input, const MLFloat16* scale_data, const MLFloat16* bias_data,
+                MLFloat16* p_output, int64_t norm_size, float epsilon, bool simplified, float* mean,
+                float* inv_std_dev) {
+  MlasHalfLayerNormalization(reinterpret_cast<const uint16_t*>(p_input), nullptr, nullptr,
+                             reinterpret_cast<const uint16_t*>(scale_data),
+                             reinterpret_cast<const uint16_t*>(bias_data),
+                             reinterpret_cast<uint16_t*>(p_output),
+                             static_cast<size_t>(norm_size), epsilon, simplified, mean, inv_std_dev);
+}
+
+}  // namespace
 
 template <typename T, bool simplified>
 LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
@@ -70,10 +137,12 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
     }
   }
 
+  using U = typename LayerNormStatType<T>::type;
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
-  T* mean_data = nullptr;
+  U* mean_data = nullptr;
   BufferUniquePtr mean_data_buf_ptr;
 
   int output_index = 1;
@@ -81,61 +150,32 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   if (!simplified) {
     Tensor* mean = p_ctx->Output(output_index++, TensorShape(mean_inv_std_dev_dim));
     if (mean != nullptr) {
-      mean_data = mean->template MutableData<T>();
+      mean_data = mean->template MutableData<U>();
     } else {
-      auto mean_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * norm_count);
+      auto mean_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(U)) * norm_count);
       mean_data_buf_ptr = BufferUniquePtr(mean_data_buf, BufferDeleter(alloc));
-      mean_data = static_cast<T*>(mean_data_buf_ptr.get());
+      mean_data = static_cast<U*>(mean_data_buf_ptr.get());
     }
   }
 
-  T* inv_std_dev_data = nullptr;
+  U* inv_std_dev_data = nullptr;
   BufferUniquePtr inv_std_dev_data_buf_ptr;
 
   Tensor* inv_std_dev = p_ctx->Output(output_index, TensorShape(mean_inv_std_dev_dim));
   if (inv_std_dev != nullptr) {
-    inv_std_dev_data = inv_std_dev->template MutableData<T>();
+    inv_std_dev_data = inv_std_dev->template MutableData<U>();
   } else {
-    auto inv_std_dev_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * norm_count);
+    auto inv_std_dev_data_buf = alloc->Alloc(SafeInt<size_t>(sizeof(U)) * norm_count);
     inv_std_dev_data_buf_ptr = BufferUniquePtr(inv_std_dev_data_buf, BufferDeleter(alloc));
-    inv_std_dev_data = static_cast<T*>(inv_std_dev_data_buf_ptr.get());
+    inv_std_dev_data = static_cast<U*>(inv_std_dev_data_buf_ptr.get());
   }
 
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
       [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
-
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon_);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
-        }
-
-        for (int64_t h = 0; h < norm_size; h++) {
-          if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
-          } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-          }
-        }
-
-        if (mean_data != nullptr) {
-          mean_data[task_idx] = mean;
-        }
-        inv_std_dev_data[task_idx] = 1 / mean_square;
+        ComputeJob(X_data + task_idx * norm_size, scale_data, bias_data, Y_data + task_idx * norm_size, norm_size,
+                   epsilon_, simplified, mean_data != nullptr ? mean_data + task_idx : nullptr,
+                   inv_std_dev_data + task_idx);
       },
       0);
 
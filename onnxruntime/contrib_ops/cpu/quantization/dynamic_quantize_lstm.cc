@@ -53,7 +53,7 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
   }
 
   is_weight_signed = weights.IsDataType<int8_t>();
-  const size_t packed_weights_size = MlasGemmPackBSize(N, K, is_weight_signed);
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K, false, is_weight_signed);
   if (packed_weights_size == 0) {
     return Status::OK();
   }
@@ -73,7 +73,7 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
 
   const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw());
   for (int i = 0; i < num_directions_; i++) {
-    MlasGemmPackB(N, K, weights_data, N, is_weight_signed, packed_weights_data);
+    MlasGemmPackB(N, K, weights_data, N, false, is_weight_signed, packed_weights_data);
     packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
     weights_data += N * K;
   }
@@ -0,0 +1,199 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulNBits final : public OpKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info)
+      : OpKernel(info),
+        K_{static_cast<size_t>(info.GetAttrOrDefault<int64_t>("K", 0))},
+        N_{static_cast<size_t>(info.GetAttrOrDefault<int64_t>("N", 0))},
+        block_size_{static_cast<size_t>(info.GetAttrOrDefault<int64_t>("block_size", 0))},
+        nbits_{static_cast<size_t>(info.GetAttrOrDefault<int64_t>("bits", 4))} {
+    ORT_ENFORCE(K_ > 0 && N_ > 0, "MatMulNBits: attributes K and N must be positive");
+    ORT_ENFORCE(MlasIsQNBitGemmAvailable(nbits_, block_size_),
+                "MatMulNBits: unsupported quantization with bits=", nbits_, " and block_size=", block_size_,
+                ". bits must be 4 or 8 and block_size a power of 2 in [16, 256].");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  enum InputTensors : int {
+    IN_A = 0,
+    IN_B = 1,
+    IN_SCALES = 2,
+    IN_ZERO_POINTS = 3
+  };
+
+  Status ValidateQuantizedB(const Tensor& b, const Tensor& scales, const Tensor* zero_points) const;
+
+  const size_t K_;
+  const size_t N_;
+  const size_t block_size_;
+  const size_t nbits_;
+
+  BufferUniquePtr packed_b_;
+};
+
+Status MatMulNBits::ValidateQuantizedB(const Tensor& b, const Tensor& scales, const Tensor* zero_points) const {
+  const size_t block_count_k = (K_ + block_size_ - 1) / block_size_;
+  const size_t blob_size = block_size_ * nbits_ / 8;
+
+  ORT_RETURN_IF_NOT(b.SizeInBytes() == SafeInt<size_t>(N_) * block_count_k * blob_size,
+                    "MatMulNBits: input B must hold N * ceil(K / block_size) * block_size * bits / 8 bytes");
+  ORT_RETURN_IF_NOT(static_cast<size_t>(scales.Shape().Size()) == SafeInt<size_t>(N_) * block_count_k,
+                    "MatMulNBits: input scales must hold N * ceil(K / block_size) values");
+  if (zero_points != nullptr) {
+    ORT_RETURN_IF_NOT(zero_points->SizeInBytes() == SafeInt<size_t>(N_) * ((block_count_k * nbits_ + 7) / 8),
+                      "MatMulNBits: input zero_points must hold N * ceil(ceil(K / block_size) * bits / 8) bytes");
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (input_idx != IN_B) {
+    return Status::OK();
+  }
+
+  // The packed format interleaves the block scales and zero points with the quantized
+  // weights, so they must be constant as well.
+  const Tensor* scales = nullptr;
+  const Tensor* zero_points = nullptr;
+  const auto& input_defs = Info().node().InputDefs();
+  const bool has_zero_points = input_defs.size() > IN_ZERO_POINTS && input_defs[IN_ZERO_POINTS]->Exists();
+  if (!Info().TryGetConstantInput(IN_SCALES, &scales) ||
+      (has_zero_points && !Info().TryGetConstantInput(IN_ZERO_POINTS, &zero_points))) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(ValidateQuantizedB(tensor, *scales, zero_points));
+
+  const size_t packed_b_size = MlasQNBitGemmPackBSize(N_, K_, nbits_, block_size_);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasQNBitGemmPackB(N_, K_, nbits_, block_size_,
+                     static_cast<const uint8_t*>(tensor.DataRaw()),
+                     scales->Data<float>(),
+                     zero_points ? zero_points->Data<uint8_t>() : nullptr,
+                     packed_b_data);
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status MatMulNBits::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == IN_B) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(IN_A);
+  const auto& a_shape = a->Shape();
+  const size_t rank = a_shape.NumDimensions();
+
+  ORT_RETURN_IF_NOT(rank >= 1 && static_cast<size_t>(a_shape[rank - 1]) == K_,
+                    "MatMulNBits: the last dimension of input A must be equal to attribute K");
+
+  std::vector<int64_t> y_dims = a_shape.GetDims();
+  y_dims[rank - 1] = static_cast<int64_t>(N_);
+  Tensor* y = ctx->Output(0, TensorShape(y_dims));
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  // Weights that were not packed ahead of time are packed into a temporary buffer.
+  const void* packed_b = packed_b_.get();
+  BufferUniquePtr packed_b_holder;
+  if (packed_b == nullptr) {
+    const Tensor* b = ctx->Input<Tensor>(IN_B);
+    const Tensor* scales = ctx->Input<Tensor>(IN_SCALES);
+    const Tensor* zero_points = ctx->Input<Tensor>(IN_ZERO_POINTS);
+    ORT_RETURN_IF_ERROR(ValidateQuantizedB(*b, *scales, zero_points));
+
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+    const size_t packed_b_size = MlasQNBitGemmPackBSize(N_, K_, nbits_, block_size_);
+    auto* packed_b_data = allocator->Alloc(packed_b_size);
+    packed_b_holder = BufferUniquePtr(packed_b_data, BufferDeleter(allocator));
+    MlasQNBitGemmPackB(N_, K_, nbits_, block_size_,
+                       static_cast<const uint8_t*>(b->DataRaw()),
+                       scales->Data<float>(),
+                       zero_points ? zero_points->Data<uint8_t>() : nullptr,
+                       packed_b_data);
+    packed_b = packed_b_data;
+  }
+
+  // The weights are shared by all the rows of A, so the leading dimensions are
+  // folded into a single GEMM.
+  const size_t M = static_cast<size_t>(a_shape.SizeToDimension(rank - 1));
+
+  MLAS_QNBIT_GEMM_DATA_PARAMS data;
+  data.A = a->Data<float>();
+  data.lda = K_;
+  data.PackedB = packed_b;
+  data.C = y->MutableData<float>();
+  data.ldc = N_;
+
+  MlasQNBitGemmBatch(M, N_, K_, nbits_, block_size_, &data, 1, ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulNBits,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulNBits);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -23,6 +24,57 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+namespace {
+
+template <typename T>
+void ComputeJob(const T* p_input, const T* p_skip, const T* gamma_data, const T* beta_data, const T* bias_data,
+                T* p_output, int64_t hidden_size, float epsilon) {
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    T value = p_input[h] + p_skip[h];
+    if (nullptr != bias_data) {
+      value += bias_data[h];
+    }
+    p_output[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    if (nullptr == beta_data) {
+      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
+    } else {
+      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+    }
+  }
+}
+
+void ComputeJob(const float* p_input, const float* p_skip, const float* gamma_data, const float* beta_data,
+                const float* bias_data, float* p_output, int64_t hidden_size, float epsilon) {
+  MlasLayerNormalization(p_input, p_skip, bias_data, gamma_data, beta_data, p_output,
+                         static_cast<size_t>(hidden_size), epsilon, false, nullptr, nullptr);
+}
+
+void ComputeJob(const MLFloat16* p_input, const MLFloat16* p_skip, const MLFloat16* gamma_data,
+                const MLFloat16* beta_data, const MLFloat16* bias_data, MLFloat16* p_output, int64_t hidden_size,
+                float epsilon) {
+  MlasHalfLayerNormalization(reinterpret_cast<const uint16_t*>(p_input),
+                             reinterpret_cast<const uint16_t*>(p_skip),
+                             reinterpret_cast<const uint16_t*>(bias_data),
+                             reinterpret_cast<const uint16_t*>(gamma_data),
+                             reinterpret_cast<const uint16_t*>(beta_data),
+                             reinterpret_cast<uint16_t*>(p_output),
+                             static_cast<size_t>(hidden_size), epsilon, false, nullptr, nullptr);
+}
+
+}  // namespace
 
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
@@ -101,33 +153,8 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
       [&](ptrdiff_t task_idx) {
-        const T* p_input = input_data + task_idx * hidden_size;
-        const T* p_skip = skip_data + task_idx * hidden_size;
-        T* p_output = output_data + task_idx * hidden_size;
-
-        T mean = 0;
-        T mean_square = 0;
-
-        for (int64_t h = 0; h < hidden_size; h++) {
-          T value = p_input[h] + p_skip[h];
-          if (nullptr != bias_data) {
-            value += bias_data[h];
-          }
-          p_output[h] = value;
-          mean += value;
-          mean_square += value * value;
-        }
-
-        mean = mean / hidden_size;
-        mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-
-        for (int64_t h = 0; h < hidden_size; h++) {
-          if (nullptr == beta_data) {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-          } else {
-            p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-          }
-        }
+        ComputeJob(input_data + task_idx * hidden_size, skip_data + task_idx * hidden_size, gamma_data, beta_data,
+                   bias_data, output_data + task_idx * hidden_size, hidden_size, epsilon_);
       },
       0);
 
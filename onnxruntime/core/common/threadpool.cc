@@ -224,12 +224,19 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogSpinBudget(int thread_idx, uint64_t spin_budget_ns) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].spin_budget_us_ = static_cast<int64_t>(spin_budget_ns / 1000);
+  }
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
-       << "\"core\": " << child_thread_stats_[i].core_ << "}"
+       << "\"core\": " << child_thread_stats_[i].core_ << ", "
+       << "\"spin_budget_us\": " << child_thread_stats_[i].spin_budget_us_ << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
   return ss.str();
@@ -303,6 +310,16 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
     return idx % _num_shards;
   }
 
+  // Allocate home shards in contiguous runs of thread IDs instead.
+  // This is used on thread pools partitioned into NUMA domains, where
+  // consecutive thread IDs are placed on the same domain: each domain
+  // then starts on, and moves on to, adjacent shards, keeping a
+  // contiguous part of the iteration space within the domain.
+
+  unsigned GetHomeShard(unsigned idx, unsigned num_work_items) const {
+    return static_cast<unsigned>(static_cast<uint64_t>(idx) * _num_shards / num_work_items);
+  }
+
   // Attempt to claim iterations from the sharded counter.  The function either
   // returns true, along with a block of exactly block_size iterations, or it returns false
   // if all of the iterations have been claimed.
@@ -413,13 +430,21 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   assert(num_work_items > 0);
 
   LoopCounter lc(total, d_of_p, block_size);
+  const bool partitioned = underlying_threadpool_ && underlying_threadpool_->NumDomains() > 1;
   std::function<void(unsigned)> run_work = [&](unsigned idx) {
-    unsigned my_home_shard = lc.GetHomeShard(idx);
+    unsigned my_home_shard = partitioned ? lc.GetHomeShard(idx, static_cast<unsigned>(num_work_items))
+                                         : lc.GetHomeShard(idx);
     unsigned my_shard = my_home_shard;
     uint64_t my_iter_start, my_iter_end;
     while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end)) {
       fn(static_cast<std::ptrdiff_t>(my_iter_start),
          static_cast<std::ptrdiff_t>(my_iter_end));
+      // Helper threads yield to pending high-priority work between blocks.  The main
+      // thread (idx 0) claims iterations until the loop is complete, so the remaining
+      // iterations are still run.
+      if (idx != 0 && underlying_threadpool_->ShouldYield()) {
+        break;
+      }
     }
   };
 
@@ -459,6 +484,18 @@ std::string ThreadPool::StopProfiling() {
   }
 }
 
+void ThreadPool::StartRun() {
+  if (underlying_threadpool_) {
+    underlying_threadpool_->StartRun();
+  }
+}
+
+void ThreadPool::EndRun() {
+  if (underlying_threadpool_) {
+    underlying_threadpool_->EndRun();
+  }
+}
+
 thread_local ThreadPool::ParallelSection* ThreadPool::ParallelSection::current_parallel_section{nullptr};
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
@@ -489,6 +526,24 @@ ThreadPool::ParallelSection::~ParallelSection() {
 #endif
 }
 
+ThreadPool::PriorityScope::PriorityScope(ThreadPoolPriority priority, std::chrono::steady_clock::time_point deadline) {
+  ThreadPoolWorkContext& context = ThreadPoolWorkContext::Current();
+  saved_priority_ = context.priority;
+  saved_deadline_ns_ = context.deadline_ns;
+  context.priority = priority;
+  context.deadline_ns = 0;
+  if (deadline != std::chrono::steady_clock::time_point()) {
+    context.deadline_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count());
+  }
+}
+
+ThreadPool::PriorityScope::~PriorityScope() {
+  ThreadPoolWorkContext& context = ThreadPoolWorkContext::Current();
+  context.priority = saved_priority_;
+  context.deadline_ns = saved_deadline_ns_;
+}
+
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
     if (ThreadPool::ParallelSection::current_parallel_section) {
@@ -646,6 +701,18 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+void ThreadPool::StartRun(concurrency::ThreadPool* tp) {
+  if (tp) {
+    tp->StartRun();
+  }
+}
+
+void ThreadPool::EndRun(concurrency::ThreadPool* tp) {
+  if (tp) {
+    tp->EndRun();
+  }
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
@@ -1086,6 +1086,202 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Estimated size in bytes of the tensor produced for node_arg, based on the inferred shape.
+  // Symbolic dimensions are counted as 1, which keeps the relative size of tensors that share them.
+  // Returns 0 if node_arg is not a tensor or its shape is unknown.
+  size_t EstimateSizeInBytes(const onnxruntime::NodeArg& node_arg) const {
+    const auto* type_proto = node_arg.TypeAsProto();
+    if (!node_arg.Exists() || type_proto == nullptr || !utils::HasTensorType(*type_proto) ||
+        !utils::HasElemType(type_proto->tensor_type())) {
+      return 0;
+    }
+
+    const auto* shape = context_.GetShape(node_arg);
+    if (shape == nullptr) {
+      return 0;
+    }
+
+    size_t size = GetElementSize(node_arg.Type());
+    for (const auto& dim : shape->dim()) {
+      if (utils::HasDimValue(dim)) {
+        size *= static_cast<size_t>(dim.dim_value());
+      }
+    }
+
+    return size;
+  }
+
+  // Calls func once for each distinct input (explicit or implicit) of node that is produced by a node in the graph.
+  template <typename TFunc>
+  static void ForEachDistinctActivationInput(const Node& node,
+                                             const std::unordered_map<const NodeArg*, int>& remaining_uses,
+                                             TFunc&& func) {
+    std::vector<const NodeArg*> seen;
+    auto process = [&](const NodeArg* input) {
+      if (remaining_uses.find(input) == remaining_uses.end() ||
+          std::find(seen.cbegin(), seen.cend(), input) != seen.cend()) {
+        return;
+      }
+      seen.push_back(input);
+      func(input);
+    };
+
+    for (const auto* input : node.InputDefs()) process(input);
+    for (const auto* input : node.ImplicitInputDefs()) process(input);
+  }
+
+  // Number of nodes consuming each value produced by a node in the graph. Graph outputs get an extra use
+  // so they are never considered freed.
+  std::unordered_map<const NodeArg*, int> ComputeActivationUseCounts() const {
+    std::unordered_map<const NodeArg*, int> use_counts;
+    const auto& nodes = graph_viewer_.GetNodesInTopologicalOrder();
+    for (auto node_index : nodes) {
+      for (const auto* output : graph_viewer_.GetNode(node_index)->OutputDefs()) {
+        if (output->Exists()) {
+          use_counts[output] = 0;
+        }
+      }
+    }
+
+    for (auto node_index : nodes) {
+      ForEachDistinctActivationInput(*graph_viewer_.GetNode(node_index), use_counts,
+                                     [&use_counts](const NodeArg* input) { ++use_counts[input]; });
+    }
+
+    for (const auto* output : graph_viewer_.GetOutputs()) {
+      auto entry = use_counts.find(output);
+      if (entry != use_counts.end()) {
+        ++entry->second;
+      }
+    }
+
+    return use_counts;
+  }
+
+  // Topological order that greedily reduces the peak size of the live node outputs.
+  // At each step the ready node that grows the live activation memory the least (output bytes minus the bytes of
+  // the inputs it is the last consumer of) runs next. Ties go to the node consuming the most recently produced value,
+  // which finishes one branch before starting the next and keeps its data in cache, and then to the default order.
+  std::vector<NodeIndex> ComputeMemoryEfficientOrder() const {
+    const auto& default_order = graph_viewer_.GetNodesInTopologicalOrder();
+    const size_t max_node_index = static_cast<size_t>(graph_viewer_.MaxNodeIndex());
+
+    std::vector<size_t> position(max_node_index, 0);
+    std::vector<size_t> pending_inputs(max_node_index, 0);
+    for (size_t i = 0, end = default_order.size(); i < end; ++i) {
+      const Node& node = *graph_viewer_.GetNode(default_order[i]);
+      position[node.Index()] = i;
+      for (auto edge = node.InputEdgesBegin(), edge_end = node.InputEdgesEnd(); edge != edge_end; ++edge) {
+        if (graph_viewer_.GetNode(edge->GetNode().Index()) != nullptr) {
+          ++pending_inputs[node.Index()];
+        }
+      }
+    }
+
+    std::vector<NodeIndex> ready;
+    for (auto node_index : default_order) {
+      if (pending_inputs[node_index] == 0) {
+        ready.push_back(node_index);
+      }
+    }
+
+    auto remaining_uses = ComputeActivationUseCounts();
+    std::unordered_map<const NodeArg*, size_t> produced_at;  // step at which each value became available
+
+    std::vector<NodeIndex> order;
+    order.reserve(default_order.size());
+
+    while (!ready.empty()) {
+      size_t best = 0;
+      int64_t best_growth = 0;
+      int64_t best_locality = 0;
+      for (size_t r = 0, end = ready.size(); r < end; ++r) {
+        const Node& node = *graph_viewer_.GetNode(ready[r]);
+
+        int64_t growth = 0;
+        for (const auto* output : node.OutputDefs()) {
+          growth += static_cast<int64_t>(EstimateSizeInBytes(*output));
+        }
+
+        int64_t locality = -1;
+        ForEachDistinctActivationInput(node, remaining_uses, [&](const NodeArg* input) {
+          if (remaining_uses[input] == 1) {
+            growth -= static_cast<int64_t>(EstimateSizeInBytes(*input));
+          }
+          locality = std::max(locality, static_cast<int64_t>(produced_at[input]));
+        });
+
+        if (r == 0 || growth < best_growth ||
+            (growth == best_growth &&
+             (locality > best_locality ||
+              (locality == best_locality && position[ready[r]] < position[ready[best]])))) {
+          best = r;
+          best_growth = growth;
+          best_locality = locality;
+        }
+      }
+
+      const NodeIndex node_index = ready[best];
+      ready.erase(ready.begin() + best);
+
+      const Node& node = *graph_viewer_.GetNode(node_index);
+      for (const auto* output : node.OutputDefs()) {
+        if (output->Exists()) {
+          produced_at[output] = order.size();
+        }
+      }
+
+      ForEachDistinctActivationInput(node, remaining_uses, [&](const NodeArg* input) { --remaining_uses[input]; });
+
+      order.push_back(node_index);
+
+      for (auto edge = node.OutputEdgesBegin(), edge_end = node.OutputEdgesEnd(); edge != edge_end; ++edge) {
+        const auto consumer_index = edge->GetNode().Index();
+        if (graph_viewer_.GetNode(consumer_index) != nullptr && --pending_inputs[consumer_index] == 0) {
+          ready.push_back(consumer_index);
+        }
+      }
+    }
+
+    ORT_ENFORCE(order.size() == default_order.size(),
+                "Memory efficient ordering only scheduled ", order.size(), " of ", default_order.size(), " nodes.");
+
+    return order;
+  }
+
+  // Estimate the peak size of the live node outputs when running the nodes in plan_.execution_plan order.
+  // Outputs are counted from the step they are produced until their last consumer has run.
+  size_t EstimatePeakActivationBytes() const {
+    auto remaining_uses = ComputeActivationUseCounts();
+
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    for (const auto& step : plan_.execution_plan) {
+      const Node& node = *graph_viewer_.GetNode(step.node_index);
+      for (const auto* output : node.OutputDefs()) {
+        live_bytes += EstimateSizeInBytes(*output);
+      }
+
+      peak_bytes = std::max(peak_bytes, live_bytes);
+
+      ForEachDistinctActivationInput(node, remaining_uses, [&](const NodeArg* input) {
+        if (--remaining_uses[input] == 0) {
+          live_bytes -= EstimateSizeInBytes(*input);
+        }
+      });
+
+      // outputs nobody consumes are released straight away
+      for (const auto* output : node.OutputDefs()) {
+        auto entry = remaining_uses.find(output);
+        if (entry != remaining_uses.end() && entry->second == 0) {
+          live_bytes -= EstimateSizeInBytes(*output);
+        }
+      }
+    }
+
+    return peak_bytes;
+  }
+
   // Convert information in a freelist (about which ml-value becomes free when) into
   // a deallocation plan in the format required in an ExecutionPlan
   void GenerateDeallocationPlan() {
@@ -1161,14 +1357,21 @@ class PlannerImpl {
 };
 
 Status PlannerImpl::CreatePlan() {
-  auto& p_graph_nodes = graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
+  // Determine execution order: the topological sort order from the graph, or one that reduces the peak
+  // activation memory if requested.
+  std::vector<NodeIndex> memory_efficient_order;
+  if (context_.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT) {
+    memory_efficient_order = ComputeMemoryEfficientOrder();
+  }
+
+  const auto& p_graph_nodes = context_.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT
+                                  ? memory_efficient_order
+                                  : graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
 
   int num_ml_values = ort_value_name_idx_map_.MaxIdx() + 1;
 
   Initialize(p_graph_nodes.size(), static_cast<size_t>(num_ml_values));
 
-  // Determine execution order: we use the default topological sort order for now. We can later
-  // explore more efficient orderings (from a memory usage perspective).
   for (auto n : p_graph_nodes) {
     plan_.execution_plan.emplace_back(n);
   }
@@ -1195,6 +1398,8 @@ Status PlannerImpl::CreatePlan() {
   // convert information in the freelist_ into a deallocation plan in required format
   GenerateDeallocationPlan();
 
+  plan_.estimated_peak_activation_bytes = EstimatePeakActivationBytes();
+
   // Ensure Memory-Time schedule is valid. This should be called at the end because memory start/end timestamps
   // are updated until GenerateDeallocationPlan is finished.
   VerifyMemoryTimeSchedule();
@@ -23,6 +23,11 @@ struct AllocatorStats {
                                   // unknown.
   int64_t bytes_limit;
 
+  // Per-thread caches in front of an arena (Relevant only for arena based allocators with thread caches enabled)
+  int64_t num_thread_cache_hits;     // Number of allocations served from a thread cache.
+  int64_t num_thread_cache_flushes;  // Number of times a thread cache returned its chunks to the arena.
+  int64_t bytes_in_thread_caches;    // Number of freed bytes currently held by thread caches.
+
   AllocatorStats() { Clear(); }
 
   void Clear() {
@@ -35,6 +40,9 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_flushes = 0;
+    this->bytes_in_thread_caches = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +55,10 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheHits:       " << this->num_thread_cache_hits << "\n"
+       << "NumThreadCacheFlushes:    " << this->num_thread_cache_flushes << "\n"
+       << "BytesInThreadCaches:      " << this->bytes_in_thread_caches << "\n";
     return ss.str();
   }
 };
@@ -22,7 +22,7 @@ struct AllocatorCreationInfo {
   AllocatorCreationInfo(AllocatorFactory device_alloc_factory,
                         OrtDevice::DeviceId device_id = 0,
                         bool use_arena = true,
-                        OrtArenaCfg arena_cfg = {0, -1, -1, -1, -1})
+                        OrtArenaCfg arena_cfg = {0, -1, -1, -1, -1, -1})
       : device_alloc_factory(device_alloc_factory),
         device_id(device_id),
         use_arena(use_arena),
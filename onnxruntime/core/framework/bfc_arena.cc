@@ -3,6 +3,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -11,7 +12,8 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_growth_chunk_size_bytes)
+                   int initial_growth_chunk_size_bytes,
+                   int max_thread_cache_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -22,11 +24,13 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes) {
+      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
+      max_thread_cache_bytes_(max_thread_cache_bytes > 0 ? static_cast<size_t>(max_thread_cache_bytes) : 0) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
+                     << " max_thread_cache_bytes: " << max_thread_cache_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -71,6 +75,14 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  // Cached chunks are linked into free lists through their first bytes, which needs memory the CPU can access.
+  if (max_thread_cache_bytes_ > 0 && device_allocator_->Info().device.Type() == OrtDevice::CPU) {
+    static std::atomic<uint64_t> next_thread_cache_set_id{1};
+    thread_caches_ = std::make_shared<ThreadCacheSet>();
+    thread_caches_->id = next_thread_cache_set_id.fetch_add(1, std::memory_order_relaxed);
+    thread_cache_entries_ = std::make_unique<ThreadCacheEntry[]>(kThreadCacheTableSize);
+  }
 }
 
 BFCArena::~BFCArena() {
@@ -244,9 +256,257 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (thread_caches_ != nullptr) {
+    return AllocateWithThreadCache(size);
+  }
   return AllocateRawInternal(size, false);
 }
 
+BFCArena::ThreadCacheClaims::~ThreadCacheClaims() {
+  for (auto& claim : claims) {
+    if (claim.index == kNoThreadCache) {
+      continue;
+    }
+    // the cached chunks stay with the cache for the next thread that claims it
+    if (auto set = claim.set.lock()) {
+      set->caches[claim.index].claimed.store(false, std::memory_order_release);
+    }
+  }
+}
+
+BFCArena::ThreadCache* BFCArena::CurrentThreadCache(bool claim) {
+  static thread_local ThreadCacheClaims thread_claims;
+  auto& claims = thread_claims.claims;
+
+  const uint64_t set_id = thread_caches_->id;
+  for (const auto& c : claims) {
+    if (c.set_id == set_id) {
+      return c.index == kNoThreadCache ? nullptr : &thread_caches_->caches[c.index];
+    }
+  }
+
+  if (!claim) {
+    return nullptr;
+  }
+
+  // drop the claims of arenas that no longer exist
+  claims.erase(std::remove_if(claims.begin(), claims.end(),
+                              [](const ThreadCacheClaims::Claim& c) { return c.set.expired(); }),
+               claims.end());
+
+  uint32_t index = kNoThreadCache;
+  for (uint32_t i = 0; i < kMaxThreadCaches; ++i) {
+    bool expected = false;
+    if (thread_caches_->caches[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      index = i;
+      break;
+    }
+  }
+
+  // with more threads than caches the remaining threads use the bins directly
+  claims.push_back({set_id, thread_caches_, index});
+  return index == kNoThreadCache ? nullptr : &thread_caches_->caches[index];
+}
+
+BFCArena::ThreadCacheEntry* BFCArena::FindThreadCacheEntry(const void* p) const {
+  // the caller owns p, so its entry can't change concurrently. other entries may, which doesn't matter.
+  const size_t index = ThreadCacheTableIndex(p);
+  for (size_t i = 0; i < kThreadCacheTableProbes; ++i) {
+    auto& entry = thread_cache_entries_[(index + i) & (kThreadCacheTableSize - 1)];
+    if (entry.ptr.load(std::memory_order_relaxed) == p) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void BFCArena::RegisterThreadCacheChunk(void* p, size_t chunk_size, size_t requested_size, uint32_t owner) {
+  const size_t index = ThreadCacheTableIndex(p);
+  for (size_t i = 0; i < kThreadCacheTableProbes; ++i) {
+    auto& entry = thread_cache_entries_[(index + i) & (kThreadCacheTableSize - 1)];
+    void* expected = nullptr;
+    if (entry.ptr.load(std::memory_order_relaxed) == nullptr &&
+        entry.ptr.compare_exchange_strong(expected, p, std::memory_order_acquire)) {
+      entry.chunk_size = chunk_size;
+      entry.requested_size = requested_size;
+      entry.owner = owner;
+      return;
+    }
+  }
+}
+
+void* BFCArena::AllocateWithThreadCache(size_t num_bytes) {
+  static_assert(sizeof(CachedChunk) <= kMinAllocationSize, "CachedChunk must fit in the smallest chunk");
+
+  if (num_bytes == 0) {
+    return nullptr;
+  }
+
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  ThreadCache* cache = rounded_bytes <= kMaxThreadCachedBytes ? CurrentThreadCache(true) : nullptr;
+  if (cache == nullptr) {
+    return AllocateRawInternal(num_bytes, false);
+  }
+
+  CachedChunk* chunk = PopFromThreadCache(*cache, ThreadCacheSizeClass(rounded_bytes));
+  if (chunk != nullptr) {
+    chunk->entry->requested_size = num_bytes;
+    return chunk;
+  }
+
+  size_t chunk_size = 0;
+  void* ptr = AllocateRawInternal(num_bytes, false, &chunk_size);
+  if (ptr != nullptr && chunk_size <= kMaxThreadCachedBytes) {
+    RegisterThreadCacheChunk(ptr, chunk_size, num_bytes,
+                             static_cast<uint32_t>(cache - thread_caches_->caches.data()));
+  }
+  return ptr;
+}
+
+BFCArena::CachedChunk* BFCArena::PopFromThreadCache(ThreadCache& cache, size_t size_class) {
+  if (cache.drain_requested.load(std::memory_order_relaxed)) {
+    cache.drain_requested.store(false, std::memory_order_relaxed);
+    DrainThreadCache(cache);
+  }
+
+  CachedChunk* chunk = cache.free_lists[size_class];
+  if (chunk == nullptr) {
+    TakeRemoteFrees(cache);
+    chunk = cache.free_lists[size_class];
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+  }
+
+  // only the owner writes these, so there is no need for a read-modify-write
+  cache.free_lists[size_class] = chunk->next;
+  cache.cached_bytes.store(cache.cached_bytes.load(std::memory_order_relaxed) - chunk->entry->chunk_size,
+                           std::memory_order_relaxed);
+  cache.num_hits.store(cache.num_hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  return chunk;
+}
+
+void BFCArena::TakeRemoteFrees(ThreadCache& cache) {
+  CachedChunk* chunk = cache.remote_frees.exchange(nullptr, std::memory_order_acquire);
+  size_t bytes = 0;
+  while (chunk != nullptr) {
+    CachedChunk* next = chunk->next;
+    const size_t chunk_size = chunk->entry->chunk_size;
+    auto& free_list = cache.free_lists[ThreadCacheSizeClass(chunk_size)];
+    chunk->next = free_list;
+    free_list = chunk;
+    bytes += chunk_size;
+    chunk = next;
+  }
+
+  if (bytes > 0) {
+    // remote_bytes is raised before a chunk is pushed, so it never drops below zero here
+    cache.remote_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    cache.cached_bytes.store(cache.cached_bytes.load(std::memory_order_relaxed) + bytes,
+                             std::memory_order_relaxed);
+  }
+}
+
+void BFCArena::FreeToThreadCache(ThreadCacheEntry& entry, void* p) {
+  ThreadCache& owner = thread_caches_->caches[entry.owner];
+  const size_t chunk_size = entry.chunk_size;
+  auto* chunk = static_cast<CachedChunk*>(p);
+  chunk->entry = &entry;
+
+  if (&owner == CurrentThreadCache(false)) {
+    auto& free_list = owner.free_lists[ThreadCacheSizeClass(chunk_size)];
+    chunk->next = free_list;
+    free_list = chunk;
+    const size_t cached_bytes = owner.cached_bytes.load(std::memory_order_relaxed) + chunk_size;
+    owner.cached_bytes.store(cached_bytes, std::memory_order_relaxed);
+    if (cached_bytes > max_thread_cache_bytes_) {
+      DrainThreadCache(owner);
+    }
+    return;
+  }
+
+  // Freed by another thread, return the chunk to its owner so that a producer thread can reuse the
+  // buffers that its consumers release.
+  const size_t remote_bytes = owner.remote_bytes.fetch_add(chunk_size, std::memory_order_relaxed) + chunk_size;
+  chunk->next = owner.remote_frees.load(std::memory_order_relaxed);
+  while (!owner.remote_frees.compare_exchange_weak(chunk->next, chunk,
+                                                   std::memory_order_release, std::memory_order_relaxed)) {
+  }
+
+  // the owner may not allocate again for a while, e.g. if its thread exited
+  if (remote_bytes > max_thread_cache_bytes_) {
+    DrainRemoteFrees(owner);
+  }
+}
+
+void BFCArena::ReleaseCachedChunk(CachedChunk* chunk) {
+  // the entry must be free before the chunk can be handed out by the bins again
+  chunk->entry->ptr.store(nullptr, std::memory_order_release);
+  DeallocateRawInternal(chunk);
+}
+
+void BFCArena::DrainThreadCache(ThreadCache& cache) {
+  TakeRemoteFrees(cache);
+  if (cache.cached_bytes.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    for (auto& free_list : cache.free_lists) {
+      while (free_list != nullptr) {
+        CachedChunk* next = free_list->next;
+        ReleaseCachedChunk(free_list);
+        free_list = next;
+      }
+    }
+  }
+
+  cache.cached_bytes.store(0, std::memory_order_relaxed);
+  ++num_thread_cache_flushes_;
+}
+
+void BFCArena::DrainRemoteFrees(ThreadCache& cache) {
+  CachedChunk* chunk = cache.remote_frees.exchange(nullptr, std::memory_order_acquire);
+  if (chunk == nullptr) {
+    return;
+  }
+
+  size_t bytes = 0;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    while (chunk != nullptr) {
+      CachedChunk* next = chunk->next;
+      bytes += chunk->entry->chunk_size;
+      ReleaseCachedChunk(chunk);
+      chunk = next;
+    }
+  }
+
+  cache.remote_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  ++num_thread_cache_flushes_;
+}
+
+void BFCArena::DrainThreadCaches() {
+  ThreadCache* current = CurrentThreadCache(false);
+  for (auto& cache : thread_caches_->caches) {
+    if (&cache == current) {
+      DrainThreadCache(cache);
+      continue;
+    }
+
+    // a cache without an owner can be drained by claiming it for the duration
+    bool expected = false;
+    if (cache.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      DrainThreadCache(cache);
+      cache.claimed.store(false, std::memory_order_release);
+    } else {
+      DrainRemoteFrees(cache);
+      cache.drain_requested.store(true, std::memory_order_relaxed);
+    }
+  }
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -268,6 +528,12 @@ void* BFCArena::Reserve(size_t size) {
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  if (thread_caches_ != nullptr) {
+    if (const ThreadCacheEntry* entry = FindThreadCacheEntry(ptr)) {
+      return entry->requested_size;
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -276,6 +542,12 @@ size_t BFCArena::RequestedSize(const void* ptr) {
 }
 
 size_t BFCArena::AllocatedSize(const void* ptr) {
+  if (thread_caches_ != nullptr) {
+    if (const ThreadCacheEntry* entry = FindThreadCacheEntry(ptr)) {
+      return entry->chunk_size;
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -284,7 +556,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    size_t* allocated_bytes) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -298,8 +571,15 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+  auto chunk_size = [this](void* p) {
+    return ChunkFromHandle(region_manager_.get_handle(p))->size;
+  };
+
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
+    if (allocated_bytes != nullptr) {
+      *allocated_bytes = chunk_size(ptr);
+    }
     return ptr;
   }
 
@@ -311,6 +591,9 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   if (status.IsOK()) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
     if (ptr != nullptr) {
+      if (allocated_bytes != nullptr) {
+        *allocated_bytes = chunk_size(ptr);
+      }
       return ptr;
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -334,6 +617,20 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+
+  if (thread_caches_ == nullptr) {
+    return;
+  }
+
+  // Chunks held by the thread caches are in use for the bins but free for the caller.
+  for (const auto& cache : thread_caches_->caches) {
+    stats->num_thread_cache_hits += cache.num_hits.load(std::memory_order_relaxed);
+    stats->bytes_in_thread_caches += static_cast<int64_t>(cache.cached_bytes.load(std::memory_order_relaxed) +
+                                                          cache.remote_bytes.load(std::memory_order_relaxed));
+  }
+  stats->num_thread_cache_flushes = num_thread_cache_flushes_;
+  stats->num_allocs += stats->num_thread_cache_hits;
+  stats->bytes_in_use -= stats->bytes_in_thread_caches;
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -421,6 +718,14 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (thread_caches_ != nullptr) {
+    if (ThreadCacheEntry* entry = FindThreadCacheEntry(p)) {
+      FreeToThreadCache(*entry, p);
+      return;
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -434,6 +739,11 @@ void BFCArena::Free(void* p) {
 }
 
 Status BFCArena::Shrink() {
+  if (thread_caches_ != nullptr) {
+    // cached chunks would keep their regions alive
+    DrainThreadCaches();
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
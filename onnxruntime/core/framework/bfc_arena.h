@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -57,13 +60,15 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const int DEFAULT_MAX_THREAD_CACHE_BYTES = 0;
 
   BFCArena(std::unique_ptr<IAllocator> resource_allocator,
            size_t total_memory,
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+           int max_thread_cache_bytes = DEFAULT_MAX_THREAD_CACHE_BYTES);
 
   ~BFCArena() override;
 
@@ -97,9 +102,102 @@ class BFCArena : public IAllocator {
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, size_t* allocated_bytes = nullptr);
   void DeallocateRawInternal(void* ptr);
 
+  // Per-thread caches of freed small chunks.
+  //
+  // When enabled, allocations of up to kMaxThreadCachedBytes made by a thread that owns a cache are
+  // registered in thread_cache_entries_, a fixed size table keyed by the chunk address that records the
+  // size of the chunk and the cache that owns it, so Free needs no lookup under lock_. Allocations that
+  // are not registered, e.g. larger ones, have no extra cost beyond a miss in the table and use the bins
+  // as usual. Each thread claims its own cache and is the only one to touch its free lists, so
+  // registered chunks are reused without any locking. A chunk freed by another thread is pushed onto the
+  // lock-free remote list of its owner, which takes the whole list on its next miss. lock_ is only taken
+  // to allocate from or drain to the bins, e.g. once a cache holds more than max_thread_cache_bytes_.
+  // Chunks in a cache are still 'in use' as far as the bins are concerned. A cached chunk is linked into
+  // a free list through its first bytes, so the caches are only enabled for CPU accessible memory.
+  static constexpr size_t kMaxThreadCachedBytes = 64 * 1024;
+  static constexpr size_t kNumThreadCacheSizeClasses = kMaxThreadCachedBytes >> 8;  // kMinAllocationSize granularity
+  static constexpr size_t kThreadCacheTableSize = 8192;                             // must be a power of 2
+  static constexpr size_t kThreadCacheTableProbes = 8;
+  static constexpr size_t kMaxThreadCaches = 64;
+  static constexpr uint32_t kNoThreadCache = static_cast<uint32_t>(-1);
+
+  // Out of band record of a chunk that belongs to a thread cache. ptr is set while the chunk is
+  // registered, the other members are only accessed by the thread that currently holds the chunk.
+  struct ThreadCacheEntry {
+    std::atomic<void*> ptr{nullptr};
+    size_t chunk_size = 0;      // size of the underlying chunk
+    size_t requested_size = 0;  // size requested by the caller of the current allocation
+    uint32_t owner = 0;         // cache the chunk returns to when freed
+  };
+
+  // Written to the start of a chunk while it sits in a cache.
+  struct CachedChunk {
+    CachedChunk* next;
+    ThreadCacheEntry* entry;
+  };
+
+  struct alignas(64) ThreadCache {
+    // Set while a thread owns the cache. The free lists are only accessed by the owner, the counters
+    // are only written by the owner and are atomic so GetStats can read them.
+    std::atomic<bool> claimed{false};
+    std::atomic<bool> drain_requested{false};
+    std::array<CachedChunk*, kNumThreadCacheSizeClasses> free_lists{};
+    std::atomic<size_t> cached_bytes{0};
+    std::atomic<int64_t> num_hits{0};
+
+    // Chunks owned by this cache that were freed by other threads.
+    alignas(64) std::atomic<CachedChunk*> remote_frees{nullptr};
+    std::atomic<size_t> remote_bytes{0};
+  };
+
+  // Shared with the threads that claimed one of the caches so they can release it when they exit,
+  // which may be after the arena is gone.
+  struct ThreadCacheSet {
+    uint64_t id = 0;
+    std::array<ThreadCache, kMaxThreadCaches> caches;
+  };
+
+  // The caches claimed by the current thread in all arenas.
+  struct ThreadCacheClaims {
+    struct Claim {
+      uint64_t set_id;
+      std::weak_ptr<ThreadCacheSet> set;
+      uint32_t index;  // kNoThreadCache if all caches were taken
+    };
+    std::vector<Claim> claims;
+    ~ThreadCacheClaims();
+  };
+
+  static size_t ThreadCacheSizeClass(size_t chunk_size) {
+    return (chunk_size >> 8) - 1;
+  }
+  static size_t ThreadCacheTableIndex(const void* p) {
+    size_t h = reinterpret_cast<uintptr_t>(p) / kMinAllocationSize;
+    return (h ^ (h >> 13)) & (kThreadCacheTableSize - 1);
+  }
+  // Returns the cache owned by the current thread, claiming one if claim is true.
+  ThreadCache* CurrentThreadCache(bool claim);
+  // Returns the entry of a registered chunk, or nullptr if p does not belong to a thread cache.
+  ThreadCacheEntry* FindThreadCacheEntry(const void* p) const;
+  // Registers a chunk allocated from the bins. Does nothing if there is no free entry near p.
+  void RegisterThreadCacheChunk(void* p, size_t chunk_size, size_t requested_size, uint32_t owner);
+  void* AllocateWithThreadCache(size_t num_bytes);
+  void FreeToThreadCache(ThreadCacheEntry& entry, void* p);
+  CachedChunk* PopFromThreadCache(ThreadCache& cache, size_t size_class);
+  // Unregisters a cached chunk and returns it to the bins. lock_ must be held.
+  void ReleaseCachedChunk(CachedChunk* chunk);
+  // Moves the remote frees of a cache into its free lists. Must be called by the owner.
+  void TakeRemoteFrees(ThreadCache& cache);
+  // Returns all chunks of a cache to the bins. Must be called by the owner.
+  void DrainThreadCache(ThreadCache& cache);
+  // Returns the remote frees of a cache to the bins. May be called from any thread.
+  void DrainRemoteFrees(ThreadCache& cache);
+  // Drains the caches that are not in use by another thread and asks the others to drain themselves.
+  void DrainThreadCaches();
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -469,6 +567,11 @@ class BFCArena : public IAllocator {
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
 
+  const size_t max_thread_cache_bytes_;
+  std::shared_ptr<ThreadCacheSet> thread_caches_;
+  std::unique_ptr<ThreadCacheEntry[]> thread_cache_entries_;
+  std::atomic<int64_t> num_thread_cache_flushes_{0};
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
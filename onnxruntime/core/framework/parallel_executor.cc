@@ -3,6 +3,7 @@
 
 #include "core/framework/parallel_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -19,11 +20,16 @@
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+    : node_refs_(session_state.GetGraphViewer().MaxNodeIndex()),
+      num_workers_(static_cast<size_t>(
+          std::max(1, concurrency::ThreadPool::DegreeOfParallelism(session_state.GetInterOpThreadPool())))),
+      worker_queues_(new WorkerQueue[num_workers_]),
+      out_standings_(1),
+      terminate_flag_(terminate_flag),
+      executor_pool_(session_state.GetInterOpThreadPool()) {
   const auto& graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer.MaxNodeIndex());
   for (auto& node : graph_viewer.Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    node_refs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
   }
 }
 
@@ -40,20 +46,28 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 
   root_frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                          fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
+  // spread the root nodes over the worker queues, then start a worker for each of them up to the number of workers
+  size_t num_root_nodes = 0;
   for (auto node_index : session_state.GetGraphViewer().GetRootNodes()) {
     auto p_op_kernel = session_state.GetKernel(node_index);
     if (!p_op_kernel)
       continue;
 
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
-    EnqueueNode(node_index, session_state, logger);
+    worker_queues_[num_root_nodes % num_workers_].nodes.push_back(node_index);
+    ++num_root_nodes;
   }
 
+  for (size_t i = 0, end = std::min(num_root_nodes, num_workers_); i < end; ++i) {
+    StartWorker(session_state, logger);
+  }
+
+  // release the reference held while starting the first workers
+  FinishWorker(Status::OK());
+
   // Wait for finish.
   {
     std::unique_lock<OrtMutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    while (!finished_) complete_cv_.wait(lock);
   }
 
   Status status = Status::OK();
@@ -108,6 +122,7 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 }
 
 Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
+                                      size_t worker,
                                       const SessionState& session_state,
                                       const logging::Logger& logger) {
   LOGS(logger, INFO) << "Begin execution";
@@ -260,19 +275,21 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     keep_running = false;
 
     // Checking which output nodes ready for running.
+    // Only the thread that releases the last dependency of a node sees the count drop to zero, so no lock is needed.
+    // The first ready node continues on this thread to avoid a round trip through the worker queue, the others are
+    // pushed to the queue of this worker where idle workers can steal them.
     {
       auto begin = node.OutputEdgesBegin();
       auto end = node.OutputEdgesEnd();
 
-      std::lock_guard<OrtMutex> lock(ref_mutex_);
       for (auto it = begin; it != end; it++) {
         auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
+        if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
           if (!keep_running) {
             node_index = idx;
             keep_running = true;
           } else {
-            EnqueueNode(idx, session_state, logger);
+            PushNode(worker, idx, session_state, logger);
           }
         }
 
@@ -286,19 +303,12 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   return status;
 }
 
-void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<OrtMutex> lock(complete_mutex_);
-    // if there are errors there's no point queuing more work
-    if (!errors_.empty())
-      return;
-
-    out_standings_++;
-  }
-
-  onnxruntime::concurrency::ThreadPool::Schedule(executor_pool_, [this, p_node_index, &session_state, &logger]() {
-    auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
-      const auto* node = session_state.GetGraphViewer().GetNode(p_node_index);
+Status ParallelExecutor::RunWorker(size_t worker, const SessionState& session_state,
+                                   const logging::Logger& logger) {
+  NodeIndex node_index;
+  while (TryGetNode(worker, node_index)) {
+    auto create_exception_message = [node_index, &session_state](const std::exception* ex) {
+      const auto* node = session_state.GetGraphViewer().GetNode(node_index);
 
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
                              " node '", node->Name(), "'. ",
@@ -307,7 +317,7 @@ void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& sess
 
     Status status;
     ORT_TRY {
-      status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
+      status = RunNodeAsync(node_index, worker, session_state, logger);
     }
     ORT_CATCH(const std::exception& ex) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -319,7 +329,70 @@ void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& sess
       status = create_exception_message(nullptr);
     }
 
-    FinishNodeRun(status);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
+bool ParallelExecutor::TryGetNode(size_t worker, NodeIndex& node_index) {
+  // if there are errors there's no point running more nodes
+  if (has_errors_.load(std::memory_order_relaxed))
+    return false;
+
+  {
+    WorkerQueue& queue = worker_queues_[worker];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    if (!queue.nodes.empty()) {
+      node_index = queue.nodes.back();
+      queue.nodes.pop_back();
+      return true;
+    }
+  }
+
+  for (size_t i = 1; i < num_workers_; ++i) {
+    WorkerQueue& queue = worker_queues_[(worker + i) % num_workers_];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    if (!queue.nodes.empty()) {
+      node_index = queue.nodes.front();
+      queue.nodes.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ParallelExecutor::PushNode(size_t worker, NodeIndex node_index, const SessionState& session_state,
+                                const logging::Logger& logger) {
+  // if there are errors there's no point queuing more work
+  if (has_errors_.load(std::memory_order_relaxed))
+    return;
+
+  {
+    WorkerQueue& queue = worker_queues_[worker];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    queue.nodes.push_back(node_index);
+  }
+
+  // the node is run by this worker if no other worker takes it, as a worker only exits once all queues are empty
+  StartWorker(session_state, logger);
+}
+
+void ParallelExecutor::StartWorker(const SessionState& session_state, const logging::Logger& logger) {
+  size_t active_workers = active_workers_.load(std::memory_order_relaxed);
+  do {
+    if (active_workers >= num_workers_)
+      return;
+  } while (!active_workers_.compare_exchange_weak(active_workers, active_workers + 1, std::memory_order_relaxed));
+
+  out_standings_.fetch_add(1, std::memory_order_relaxed);
+  const size_t worker = next_worker_.fetch_add(1, std::memory_order_relaxed) % num_workers_;
+
+  onnxruntime::concurrency::ThreadPool::Schedule(executor_pool_, [this, worker, &session_state, &logger]() {
+    Status status = RunWorker(worker, session_state, logger);
+    active_workers_.fetch_sub(1, std::memory_order_relaxed);
+    FinishWorker(status);
   });
 }
 }  // namespace onnxruntime
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -31,33 +34,62 @@ class ParallelExecutor : public IExecutor {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelExecutor);
 
-  Status RunNodeAsync(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
+  // Ready nodes of one worker. The worker pushes and pops at the back, so it continues with the nodes it made ready
+  // most recently, while idle workers steal the oldest nodes from the front.
+  struct WorkerQueue {
+    OrtMutex mutex;
+    std::deque<NodeIndex> nodes;  // protected by mutex
+  };
 
-  void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
+  Status RunNodeAsync(size_t p_node_index, size_t worker, const SessionState& session_state,
+                      const logging::Logger& logger);
 
-  void FinishNodeRun(const Status& status) {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
+  // Run ready nodes from the worker's own queue, or stolen from the other queues, until none are left.
+  Status RunWorker(size_t worker, const SessionState& session_state, const logging::Logger& logger);
+
+  bool TryGetNode(size_t worker, NodeIndex& node_index);
+
+  void PushNode(size_t worker, NodeIndex node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  // Schedule another worker on the inter-op thread pool unless all workers are already running.
+  void StartWorker(const SessionState& session_state, const logging::Logger& logger);
+
+  void FinishWorker(const Status& status) {
+    if (!status.IsOK()) {
       std::lock_guard<OrtMutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-      if (!status.IsOK())
-        errors_.push_back(status);
+      errors_.push_back(status);
+      has_errors_.store(true, std::memory_order_relaxed);
     }
 
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
+    if (out_standings_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // notify while holding the lock. once Execute sees finished_ it may destroy this instance.
+      std::lock_guard<OrtMutex> lock(complete_mutex_);
+      finished_ = true;
       complete_cv_.notify_all();
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  OrtMutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+
+  // number of producers each node is still waiting for. the node becomes ready when it drops to zero.
+  std::vector<std::atomic<size_t>> node_refs_;
+
+  const size_t num_workers_;
+  std::unique_ptr<WorkerQueue[]> worker_queues_;
+  // number of workers that are scheduled or running
+  std::atomic<size_t> active_workers_{0};
+  // queue of the next worker that is started. workers that run at the same time may share a queue.
+  std::atomic<size_t> next_worker_{0};
+
+  // number of scheduled workers that have not completed yet, plus one held by Execute while starting the first
+  // workers so the count only drops to zero once.
+  std::atomic<int> out_standings_;
+  std::atomic<bool> has_errors_{false};
+
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
-  std::vector<Status> errors_;
+  bool finished_{false};        // protected by complete_mutex_
+  std::vector<Status> errors_;  // protected by complete_mutex_
 
   const bool& terminate_flag_;
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
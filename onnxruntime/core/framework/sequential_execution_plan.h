@@ -118,6 +118,11 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Estimated peak size in bytes of the node outputs that are alive at the same time when running the nodes
+  // in execution_plan order. Computed from the inferred shapes with symbolic dimensions counted as 1, and
+  // ignoring buffer reuse, so it is only meaningful to compare orderings of the same graph.
+  size_t estimated_peak_activation_bytes{0};
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
@@ -3,6 +3,7 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
@@ -425,14 +426,35 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
+static size_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
+  // combine the rank and dims so that e.g. {2, 3} and {3, 2}, or {6} and {6, 1} produce different keys
+  size_t key = shapes.size();
+  auto hash_combine = [&key](int64_t value) {
+    key ^= std::hash<int64_t>{}(value) + 0x9e3779b9 + (key << 6) + (key >> 2);
+  };
+
   for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+    const auto& dims = shape.get().GetDims();
+    hash_combine(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) hash_combine(dim);
   }
   return key;
 }
 
+static bool MatchesInputShapes(const std::vector<int64_t>& input_dims,
+                               const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
+  size_t pos = 0;
+  for (auto shape : shapes) {
+    const auto& dims = shape.get().GetDims();
+    if (pos + 1 + dims.size() > input_dims.size() || input_dims[pos] != static_cast<int64_t>(dims.size()) ||
+        !std::equal(dims.cbegin(), dims.cend(), input_dims.cbegin() + pos + 1)) {
+      return false;
+    }
+    pos += 1 + dims.size();
+  }
+  return pos == input_dims.size();
+}
+
 #ifdef ENABLE_TRAINING
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
@@ -652,22 +674,86 @@ Status SessionState::GeneratePatternGroupCache(const std::vector<std::reference_
 }
 #endif
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
-                                                              const std::vector<int>& feed_mlvalue_idxs,
-                                                              std::unordered_map<int, TensorShape>& inferred_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+const SessionState::MemoryPatternCacheEntry* SessionState::FindMemoryPatternCacheEntry(
+    MemoryPatternCacheShard& shard, size_t key,
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) {
+  auto range = shard.index.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto entry = it->second;
+    if (MatchesInputShapes(entry->input_dims, input_shapes)) {
+      // splice keeps the iterators in the index valid
+      shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+      return &*entry;
+    }
+  }
+
+  return nullptr;
+}
+
+SessionState::MemoryPatternCacheShard& SessionState::GetMemoryPatternCacheShard(size_t key,
+                                                                              size_t& shard_capacity) const {
+  const size_t num_shards = mem_pattern_cache_capacity_ == 0
+                                ? kNumMemoryPatternCacheShards
+                                : std::min(mem_pattern_cache_capacity_, kNumMemoryPatternCacheShards);
+  const size_t index = key % num_shards;
+  shard_capacity = mem_pattern_cache_capacity_ / num_shards +
+                   (index < mem_pattern_cache_capacity_ % num_shards ? 1 : 0);
+  return mem_pattern_cache_[index];
+}
+
+const SessionState::MemoryPatternCacheEntry& SessionState::InsertMemoryPatternCacheEntry(
+    MemoryPatternCacheShard& shard, size_t shard_capacity, size_t key,
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns,
+    const std::unordered_map<int, TensorShape>& inferred_shapes) {
+  const auto* existing = FindMemoryPatternCacheEntry(shard, key, input_shapes);
+  if (existing) {
+    return *existing;
+  }
+
+  if (shard_capacity != 0 && shard.entries.size() >= shard_capacity) {
+    // evict the least recently used entry. a Run that is using it keeps its own reference to the patterns.
+    const auto& lru = shard.entries.back();
+    auto range = shard.index.equal_range(lru.key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (&*it->second == &lru) {
+        shard.index.erase(it);
+        break;
+      }
+    }
+    shard.entries.pop_back();
+  }
+
+  std::vector<int64_t> input_dims;
+  for (auto shape : input_shapes) {
+    const auto& dims = shape.get().GetDims();
+    input_dims.push_back(static_cast<int64_t>(dims.size()));
+    input_dims.insert(input_dims.end(), dims.cbegin(), dims.cend());
+  }
+
+  shard.entries.push_front(MemoryPatternCacheEntry{key, std::move(input_dims), std::move(mem_patterns),
+                                                   inferred_shapes});
+  shard.index.emplace(key, shard.entries.begin());
+  return shard.entries.front();
+}
 
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs,
+    std::unordered_map<int, TensorShape>& inferred_shapes) const {
+  const size_t key = CalculateMemoryPatternsKey(input_shapes);
+  size_t shard_capacity;
+  auto& shard = GetMemoryPatternCacheShard(key, shard_capacity);
+
+  std::lock_guard<OrtMutex> lock(shard.lock);
+  const auto* entry = FindMemoryPatternCacheEntry(shard, key, input_shapes);
+  if (entry == nullptr) {
 #ifdef ENABLE_TRAINING
     auto mem_patterns = std::make_unique<MemoryPatternGroup>();
     if (GeneratePatternGroupCache(input_shapes, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
-      key = CalculateMemoryPatternsKey(input_shapes);
-      auto ptr = mem_patterns.get();
-      mem_patterns_[key] = std::move(mem_patterns);
-      shape_patterns_[key] = inferred_shapes;
-      return ptr;
+      return InsertMemoryPatternCacheEntry(shard, shard_capacity, key, input_shapes, std::move(mem_patterns),
+                                           inferred_shapes)
+          .mem_patterns;
     }
     return nullptr;
 #else
@@ -676,8 +762,8 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<
 #endif
   }
 
-  inferred_shapes = shape_patterns_[key];
-  return it->second.get();
+  inferred_shapes = entry->inferred_shapes;
+  return entry->mem_patterns;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -693,13 +779,12 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+  const size_t key = CalculateMemoryPatternsKey(input_shapes);
+  size_t shard_capacity;
+  auto& shard = GetMemoryPatternCacheShard(key, shard_capacity);
 
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
-  }
+  std::lock_guard<OrtMutex> lock(shard.lock);
+  InsertMemoryPatternCacheEntry(shard, shard_capacity, key, input_shapes, std::move(mem_patterns), {});
 
   return Status::OK();
 }
@@ -936,6 +1021,7 @@ Status SessionState::CreateSubgraphSessionState() {
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
+      subgraph_session_state->SetMemoryPatternCacheCapacity(mem_pattern_cache_capacity_);
 
       // recurse
       ORT_RETURN_IF_ERROR(subgraph_session_state->CreateSubgraphSessionState());
@@ -1040,6 +1126,60 @@ static void ComputeConstantInitializerUseCount(const Graph& graph, std::unordere
   }
 }
 
+Status SessionState::InitializeFromFinalizedSessionState(const SessionState& source) {
+  ORT_RETURN_IF_NOT(&source.graph_ == &graph_, "Source SessionState is for a different Graph instance.");
+  ORT_RETURN_IF_NOT(source.p_seq_exec_plan_ != nullptr, "Source SessionState has not been finalized.");
+
+  graph_viewer_ = std::make_unique<onnxruntime::GraphViewer>(graph_);
+
+  // add the names in index order so the OrtValue indices used by the shared kernels and the plan stay valid
+  for (int idx = 0, max_idx = source.ort_value_name_idx_map_.MaxIdx(); idx <= max_idx; ++idx) {
+    std::string name;
+    ORT_RETURN_IF_ERROR(source.ort_value_name_idx_map_.GetName(idx, name));
+    ort_value_name_idx_map_.Add(name);
+  }
+
+  kernel_create_info_map_ = source.kernel_create_info_map_;
+  session_kernels_ = source.session_kernels_;
+  owns_kernels_ = false;
+  fused_funcs_mgr_.SetFusedFuncs(source.fused_funcs_mgr_);
+  export_fused_dll_ = source.export_fused_dll_;
+
+  // OrtValue copies share the buffers, which remain owned by source
+  initialized_tensors_ = source.initialized_tensors_;
+  constant_initialized_tensors_ = source.constant_initialized_tensors_;
+#if !defined(DISABLE_SPARSE_TENSORS)
+  sparse_initialized_tensors_ = source.sparse_initialized_tensors_;
+#endif
+  number_of_prepacks_counter_ = source.number_of_prepacks_counter_;
+  used_shared_pre_packed_weights_counter_ = source.used_shared_pre_packed_weights_counter_;
+
+  p_seq_exec_plan_ = std::make_unique<SequentialExecutionPlan>(*source.p_seq_exec_plan_);
+  input_names_to_nodeinfo_mapping_ = source.input_names_to_nodeinfo_mapping_;
+  output_names_to_nodeinfo_mapping_ = source.output_names_to_nodeinfo_mapping_;
+  node_index_info_ = std::make_unique<NodeIndexInfo>(*graph_viewer_, ort_value_name_idx_map_);
+
+  for (const auto& node_entry : source.subgraph_session_states_) {
+    for (const auto& attr_entry : node_entry.second) {
+      const SessionState& source_subgraph_session_state = *attr_entry.second;
+
+      auto subgraph_session_state =
+          std::make_unique<SessionState>(source_subgraph_session_state.graph_, execution_providers_,
+                                         enable_mem_pattern_, thread_pool_, inter_op_thread_pool_,
+                                         data_transfer_mgr_, logger_, profiler_);
+      subgraph_session_state->SetMemoryPatternCacheCapacity(mem_pattern_cache_capacity_);
+
+      // recurse
+      ORT_RETURN_IF_ERROR(
+          subgraph_session_state->InitializeFromFinalizedSessionState(source_subgraph_session_state));
+
+      AddSubgraphSessionState(node_entry.first, attr_entry.first, std::move(subgraph_session_state));
+    }
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                           KernelRegistryManager& kernel_registry_manager,
                                           const SessionOptions& session_options,
@@ -1239,6 +1379,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                                     subgraphs_kernel_create_info_maps,
                                                     outer_scope_node_arg_to_location_map,
                                                     ort_value_name_idx_map_, context, p_seq_exec_plan_));
+  LOGS(logger_, INFO) << "Estimated peak activation memory of the execution plan: "
+                      << p_seq_exec_plan_->estimated_peak_activation_bytes << " bytes";
   //Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
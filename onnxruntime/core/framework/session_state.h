@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -111,8 +113,10 @@ class SessionState {
   }
 
   ~SessionState() {
-    for (auto* p : session_kernels_) {
-      delete p;
+    if (owns_kernels_) {
+      for (auto* p : session_kernels_) {
+        delete p;
+      }
     }
     for (auto& kvp : deleter_for_initialized_tensors_) {
       kvp.second.f(kvp.second.param);
@@ -208,9 +212,10 @@ class SessionState {
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
   /**
-  Get cached memory pattern based on input shapes
+  Get cached memory pattern based on input shapes.
+  The returned pattern stays valid for as long as the caller holds on to it, even if it is evicted from the cache.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
       const std::vector<int>& feed_mlvalue_idxs,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
@@ -222,6 +227,14 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Set the maximum number of memory patterns to cache. The least recently used pattern is evicted once it is reached.
+  0 means unlimited. Must be called before CreateSubgraphSessionState so subgraphs inherit the value.
+  */
+  void SetMemoryPatternCacheCapacity(size_t capacity) { mem_pattern_cache_capacity_ = capacity; }
+
+  static constexpr size_t kDefaultMemoryPatternCacheCapacity = 128;
+
   bool GetUseDeterministicCompute() const { return use_deterministic_compute_; }
 
   /**
@@ -306,6 +319,15 @@ class SessionState {
                            const KernelRegistryManager& kernel_registry_manager);
 #endif
 
+  /**
+  Initialize this SessionState from the finalized SessionState of another session for the same Graph instance,
+  instead of calling FinalizeSessionState. The kernel lookup, kernel creation, weight pre-packing and planning
+  are not repeated: the kernels and initializers are shared with source, and the execution plans and node info are
+  copied. Subgraph session states are created the same way.
+  source owns the shared kernels and initializers and must outlive this SessionState.
+  */
+  Status InitializeFromFinalizedSessionState(const SessionState& source);
+
   Status FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                               KernelRegistryManager& kernel_registry_manager,
                               const SessionOptions& session_options = {},
@@ -407,6 +429,8 @@ class SessionState {
 
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<OpKernel*> session_kernels_;
+  // false if the kernels are shared from the SessionState this one was initialized from
+  bool owns_kernels_ = true;
   Graph& graph_;
   std::unique_ptr<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -473,12 +497,46 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
-  // lock for the mem_patterns_
-  mutable OrtMutex mem_patterns_lock_;
+  struct MemoryPatternCacheEntry {
+    size_t key;
+    // rank followed by the dims of each input shape. used to resolve key collisions.
+    std::vector<int64_t> input_dims;
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns;
+    std::unordered_map<int, TensorShape> inferred_shapes;
+  };
+
+  // one shard of the mem_patterns cache. the shard is picked based on the key calculated from the input shapes,
+  // so concurrent Run calls with different shapes rarely contend on the same lock.
+  struct MemoryPatternCacheShard {
+    OrtMutex lock;
+    // entries in most recently used order
+    std::list<MemoryPatternCacheEntry> entries;
+    std::unordered_multimap<size_t, std::list<MemoryPatternCacheEntry>::iterator> index;
+  };
+
+  static constexpr size_t kNumMemoryPatternCacheShards = 16;
+
+  // returns the shard for key and its share of the capacity, 0 if unlimited. a capacity below the number of shards
+  // only uses that many shards, and the remainder of the capacity goes to the first shards, so that the shares add up
+  // to the capacity exactly.
+  MemoryPatternCacheShard& GetMemoryPatternCacheShard(size_t key, size_t& shard_capacity) const;
+
+  // returns the entry for input_shapes and marks it as most recently used, or nullptr. shard.lock must be held.
+  static const MemoryPatternCacheEntry* FindMemoryPatternCacheEntry(
+      MemoryPatternCacheShard& shard, size_t key,
+      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes);
+
+  // adds an entry if there isn't one for input_shapes yet, evicting the least recently used entry of the shard if
+  // it holds shard_capacity entries. returns the entry for input_shapes. shard.lock must be held.
+  static const MemoryPatternCacheEntry& InsertMemoryPatternCacheEntry(
+      MemoryPatternCacheShard& shard, size_t shard_capacity, size_t key,
+      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+      std::shared_ptr<const MemoryPatternGroup> mem_patterns,
+      const std::unordered_map<int, TensorShape>& inferred_shapes);
 
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
-  mutable std::map<int64_t, std::unordered_map<int, TensorShape>> shape_patterns_;
+  // cache for the generated mem_patterns and the shapes inferred with them.
+  mutable std::array<MemoryPatternCacheShard, kNumMemoryPatternCacheShards> mem_pattern_cache_;
+  size_t mem_pattern_cache_capacity_ = kDefaultMemoryPatternCacheCapacity;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -127,6 +127,38 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+// Check if the initializer data is in memory that a CPU tensor can use without copying, e.g. a memory mapped ORT format
+// model. data is set to the location of the data if so.
+// The data is part of the model and must not be modified, so only constant initializers qualify. Kernels only read
+// them, whereas an overridable initializer is a graph input and training updates its initializers.
+static bool CanUseInitializerInPlace(const GraphViewer& graph, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                     const OrtMemoryInfo& location, const void*& data) {
+#if defined(ENABLE_TRAINING)
+  ORT_UNUSED_PARAMETER(graph);
+  ORT_UNUSED_PARAMETER(tensor_proto);
+  ORT_UNUSED_PARAMETER(location);
+  ORT_UNUSED_PARAMETER(data);
+  return false;
+#else
+  size_t length = 0;
+  if (!graph.IsConstantInitializer(tensor_proto.name(), /* check_outer_scope */ false) ||
+      strcmp(location.name, CPU) != 0 ||
+      tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+      !utils::GetExternalDataInMemory(tensor_proto, data, length)) {
+    return false;
+  }
+
+  SafeInt<size_t> expected_length = 0;
+  if (!utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &expected_length).IsOK() || expected_length != length) {
+    return false;
+  }
+
+  // data written by older versions may not be aligned
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  return reinterpret_cast<uintptr_t>(data) % type->Size() == 0;
+#endif
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -173,11 +205,16 @@ common::Status SaveInitializedTensors(
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   std::set<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  // ort value ids of the initializers whose data is used in place, and the location of the data
+  std::unordered_map<int, const void*> in_place_initializer_data;
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
+    const void* data = nullptr;
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (CanUseInitializerInPlace(graph, *entry.second, exec_plan.GetLocation(ort_value_index), data)) {
+      in_place_initializer_data[ort_value_index] = data;
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -189,12 +226,16 @@ common::Status SaveInitializedTensors(
     // can not trace string tensor
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end() && entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING);
     ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
+    // the planned buffer is needed to honor the order, so copy the data into it
+    in_place_initializer_data.erase(entry->first);
     initialized_tensors_to_allocate.erase(entry);
   }
 
   for (const auto& entry : initialized_tensors_to_allocate) {
-    // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    // We don't want to trace shared initializers since their memory is provided by the user,
+    // or initializers that are used in place
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        in_place_initializer_data.find(entry.first) != in_place_initializer_data.end()) {
       continue;
     }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -231,6 +272,17 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (in_place_initializer_data.find(entry.first) != in_place_initializer_data.end()) {
+      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
+      TensorShape tensor_shape{utils::GetTensorShapeFromTensorProto(tensor_proto)};
+      const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+      // Tensor has no read-only form. The tensor is saved as a constant initializer, which kernels only read.
+      auto p_tensor = std::make_unique<Tensor>(type, tensor_shape,
+                                               const_cast<void*>(in_place_initializer_data[entry.first]),
+                                               exec_plan.GetLocation(ort_value_index));
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+      VLOGS(logger, 1) << "Using initializer with name (" << name << ") in place.";
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -117,6 +117,20 @@ Status UnpackTensorWithRawData(const void* raw_data, size_t raw_data_len, size_t
                                      reinterpret_cast<unsigned char*>(p_data));
 }
 
+// Copy external data that is in memory instead of in a file.
+static bool ReadExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                     std::vector<uint8_t>& unpacked_tensor) {
+  const void* data = nullptr;
+  size_t length = 0;
+  if (!onnxruntime::utils::GetExternalDataInMemory(tensor_proto, data, length)) {
+    return false;
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  unpacked_tensor.assign(bytes, bytes + length);
+  return true;
+}
+
 static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                   const ORTCHAR_T* tensor_proto_dir,
                                   std::basic_string<ORTCHAR_T>& external_file_path,
@@ -156,6 +170,10 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
 static Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                         const ORTCHAR_T* tensor_proto_dir,
                                         std::vector<uint8_t>& unpacked_tensor) {
+  if (ReadExternalDataInMemory(tensor_proto, unpacked_tensor)) {
+    return Status::OK();
+  }
+
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   SafeInt<size_t> tensor_byte_size;
@@ -411,6 +429,12 @@ Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const Path& model
   }
 #else
   ORT_UNUSED_PARAMETER(model_path);
+  const void* data = nullptr;
+  size_t length = 0;
+  if (GetExternalDataInMemory(tensor, data, length)) {
+    return UnpackTensor(tensor, data, length, p_data, expected_num_elements);
+  }
+
   ORT_RETURN_IF(HasExternalData(tensor), "TensorProto with external data is not supported in ORT minimal build.");
 #endif
 
@@ -614,7 +638,12 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
   SafeInt<size_t> raw_data_len = 0;
   AutoDelete deleter_for_file_data;
 
-  if (utils::HasExternalData(tensor_proto)) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (utils::GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    raw_data = const_cast<void*>(data_in_memory);
+    raw_data_len = data_in_memory_length;
+  } else if (utils::HasExternalData(tensor_proto)) {
     // Get the external data info
     std::basic_string<ORTCHAR_T> external_data_file_path;
     FileOffsetType file_offset;
@@ -1299,10 +1328,70 @@ Status UnpackInitializerData(const onnx::TensorProto& initializer,
 
 Status UnpackInitializerData(const ONNX_NAMESPACE::TensorProto& initializer,
                              std::vector<uint8_t>& unpacked_tensor) {
-  ORT_RETURN_IF(initializer.data_location() == TensorProto_DataLocation_EXTERNAL,
+  const void* data = nullptr;
+  size_t length = 0;
+  ORT_RETURN_IF(initializer.data_location() == TensorProto_DataLocation_EXTERNAL &&
+                    !GetExternalDataInMemory(initializer, data, length),
                 "The given initializer contains external data");
   return UnpackInitializerData(initializer, Path(), unpacked_tensor);
 }
 
+void SetExternalDataInMemory(const void* data, size_t length, TensorProto& tensor_proto) {
+  tensor_proto.clear_raw_data();
+  tensor_proto.clear_external_data();
+  tensor_proto.set_data_location(TensorProto_DataLocation_EXTERNAL);
+
+  auto add_entry = [&tensor_proto](const char* key, const std::string& value) {
+    auto* entry = tensor_proto.add_external_data();
+    entry->set_key(key);
+    entry->set_value(value);
+  };
+
+  add_entry("location", kTensorProtoMemoryAddressTag);
+  add_entry("offset", std::to_string(reinterpret_cast<uintptr_t>(data)));
+  add_entry("length", std::to_string(length));
+}
+
+bool GetExternalDataInMemory(const TensorProto& tensor_proto, const void*& data, size_t& length) {
+  if (!HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  // parsed here rather than by ExternalDataInfo as an address may not fit in a file offset
+  bool in_memory = false;
+  uintptr_t address = 0;
+  size_t num_bytes = 0;
+  for (const auto& entry : tensor_proto.external_data()) {
+    if (entry.key() == "location") {
+      in_memory = entry.value() == kTensorProtoMemoryAddressTag;
+    } else if (entry.key() == "offset") {
+      address = static_cast<uintptr_t>(strtoull(entry.value().c_str(), nullptr, 10));
+    } else if (entry.key() == "length") {
+      num_bytes = static_cast<size_t>(strtoull(entry.value().c_str(), nullptr, 10));
+    }
+  }
+
+  if (!in_memory) {
+    return false;
+  }
+
+  data = reinterpret_cast<const void*>(address);
+  length = num_bytes;
+  return true;
+}
+
+bool ConvertExternalDataInMemoryToRawData(TensorProto& tensor_proto) {
+  const void* data = nullptr;
+  size_t length = 0;
+  if (!GetExternalDataInMemory(tensor_proto, data, length)) {
+    return false;
+  }
+
+  tensor_proto.clear_external_data();
+  tensor_proto.set_data_location(TensorProto_DataLocation_DEFAULT);
+  tensor_proto.set_raw_data(data, length);
+  return true;
+}
+
 }  // namespace utils
 }  // namespace onnxruntime
@@ -57,6 +57,32 @@ common::Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
                                    const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                    Tensor& tensor);
 
+// External data location of a TensorProto whose data is in memory instead of in a file, such as an initializer of
+// a memory mapped ORT format model. The external data offset is the address of the data.
+constexpr const char* kTensorProtoMemoryAddressTag = "*/_ORT_MEM_ADDR_/*";
+
+/**
+ * Set the TensorProto to use the given memory as its external data. The memory must remain valid for as long as the
+ * TensorProto, or any Tensor created from it without copying, is used.
+ */
+void SetExternalDataInMemory(const void* data, size_t length, ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+/**
+ * Check if the TensorProto has external data that is in memory.
+ * @param data    set to the address of the data if it is in memory
+ * @param length  set to the size of the data in bytes if it is in memory
+ * @returns       true if the external data is in memory
+ */
+bool GetExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto, const void*& data, size_t& length);
+
+/**
+ * If the TensorProto has external data that is in memory, copy the data into raw_data and remove the external data
+ * entries. The in memory location is only valid in the current process, so this must be done before the TensorProto
+ * is serialized.
+ * @returns true if the TensorProto was changed
+ */
+bool ConvertExternalDataInMemoryToRawData(ONNX_NAMESPACE::TensorProto& tensor_proto);
+
 /** Creates a TensorProto from a Tensor.
     @param[in] tensor the Tensor whose data and shape will be used to create the TensorProto.
     @param[in] tensor_proto_name the name of the TensorProto.
@@ -654,6 +654,15 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             const logging::Logger& logger, bool only_execute_path_to_fetches) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
+  return ExecuteGraphWithInitializedCopyInfo(session_state, feeds_fetches_manager, feeds, fetches,
+                                             execution_mode, terminate_flag, logger, only_execute_path_to_fetches);
+}
+
+common::Status ExecuteGraphWithInitializedCopyInfo(const SessionState& session_state,
+                                                   FeedsFetchesManager& feeds_fetches_manager,
+                                                   const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                                   ExecutionMode execution_mode, const bool& terminate_flag,
+                                                   const logging::Logger& logger, bool only_execute_path_to_fetches) {
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 
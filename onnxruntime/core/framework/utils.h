@@ -91,6 +91,16 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
                             bool only_execute_path_to_fetches = false);
 
+// Execute the main graph with a feeds_fetches_manager that InitializeFeedFetchCopyInfo was already called for.
+// The feeds_fetches_manager will be finalized based on the provided feeds and fetches. That is a no-op if no device
+// copies are needed, so in that case the same feeds_fetches_manager can be used by concurrent calls.
+common::Status ExecuteGraphWithInitializedCopyInfo(const SessionState& session_state,
+                                                   FeedsFetchesManager& feeds_fetches_manager,
+                                                   const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                                   ExecutionMode execution_mode, const bool& terminate_flag,
+                                                   const logging::Logger& logger,
+                                                   bool only_execute_path_to_fetches = false);
+
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                                    const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
@@ -510,7 +510,10 @@ void AttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int p
           fail_shape_inference("Inputs 4 shall be 5 dimensions");
         }
 
-        if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
+        if (getAttribute(ctx, "past_present_share_buffer", 0) != 0) {
+          // present shares the buffer of past, which has shape (2, batch_size, num_heads, max_sequence_length, head_size)
+          propagateShapeFromInputToOutput(ctx, past_input_index, 1);
+        } else if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
           auto all_sequence_length = past_shape.dim(3).dim_value() + input_shape.dim(1).dim_value();
 
           ONNX_NAMESPACE::TensorShapeProto present_shape;
@@ -536,6 +539,9 @@ where value of each element is the end position, or valid length of actual seque
 left-side padding, mask_index has shape (2 * batch_size), where the values are the exclusive end positions followed by
 the inclusive start positions. When unidirectional is 1, and each token only attend to previous tokens. For GPT-2, both past
 and present state are optional. Present state could appear in output even when past state is not in input.
+When past_present_share_buffer is 1, past and present are expected to be bound to the same buffer with shape
+(2, batch_size, num_heads, max_sequence_length, head_size), and past_sequence_length gives the number of valid entries
+in it. The key and value of the current input are written in place after the valid entries.
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(Attention)
@@ -551,6 +557,11 @@ and present state are optional. Present state could appear in output even when p
             "Hidden layer sizes of Q, K, V paths in Attention",
             AttributeProto::INTS,
             OPTIONAL_VALUE)
+      .Attr("past_present_share_buffer",
+            "Whether past and present share the same buffer with shape (2, batch_size, num_heads, max_sequence_length, head_size). "
+            "Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T")
       .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
@@ -558,8 +569,10 @@ and present state are optional. Present state could appear in output even when p
                 "or (batch_size, sequence_length, past_sequence_length + sequence_length), or index with shape (batch_size) or (2 * batch_size).", "M", OpSchema::Optional)
       .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size).", "T", OpSchema::Optional)
       .Input(5, "extra_add", "additional add to QxK' with shape (batch_size, num_heads, sequence_length, sequence_length).", "T", OpSchema::Optional)
+      .Input(6, "past_sequence_length", "Scalar with the number of valid entries in past. Required when past_present_share_buffer is 1.", "M", OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
-      .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)", "T", OpSchema::Optional)
+      .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size). "
+              "When past_present_share_buffer is 1, it shares the buffer of past.", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
       .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index to integer types")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -2666,6 +2679,45 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a fused expression of elementwise operators in a single pass over the output.
+The expression is a list of steps evaluated in order. Step k applies the operator ops[k] to the
+operands operands[2*k] and operands[2*k+1]. An operand value less than the number of inputs refers
+to that input, a value of (number of inputs + j) refers to the result of step j < k, and -1 marks
+the unused second operand of a unary operator. The result of the last step is the output.
+Supported operators are Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Erf, Exp, Log, Sqrt, Neg, Abs
+and Reciprocal. Inputs are broadcast to the output shape; each input must either have the output
+shape or match its trailing dimensions after dropping leading dimensions of size 1.
+This operator is produced by the elementwise fusion graph transformer.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Attr("ops", "The elementwise operator type of each step.", AttributeProto::STRINGS)
+      .Attr("operands", "The two operand indices of each step.", AttributeProto::INTS)
+      .Input(0, "inputs", "The external inputs of the fused expression.", "T", OpSchema::Variadic)
+      .Output(0, "Y", "The result of the last step.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+        const size_t num_inputs = ctx.getNumInputs();
+        for (size_t i = 0; i < num_inputs; ++i) {
+          if (!hasInputShape(ctx, i)) {
+            return;
+          }
+        }
+
+        TensorShapeProto output_shape = getInputShape(ctx, 0);
+        for (size_t i = 1; i < num_inputs; ++i) {
+          TensorShapeProto result_shape;
+          bidirectionalBroadcastShapeInference(output_shape, getInputShape(ctx, i), result_shape);
+          output_shape = result_shape;
+        }
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
   // Used to be ONNX 1.7 Inverse(12)
   // Comment out docs not to increase the binary size
   //
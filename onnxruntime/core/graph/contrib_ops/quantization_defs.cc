@@ -986,6 +986,68 @@ Wwhere the function `Sigmoid(x) = 1 / (1 + exp(-x))` )DOC";
                second_input_shape.dim(transB ? 0 : 1)});
         }
       });
+
+  static const char* MatMulNBits_ver1_doc = R"DOC(
+MatMulNBits performs a matrix multiplication where the right-hand-side matrix (weights) is quantized to N bits.
+
+It is a fusion of two operations:
+1. Linear dequantization of the quantized weights using scale and (optionally) zero-point.
+2. Matrix multiplication between the input matrix A and the dequantized weight matrix.
+
+The weight matrix B of shape [K, N] is quantized column by column along the K dimension in blocks of
+block_size elements, and each block has its own scale and zero point. The dequantized weight is
+B[k, n] = (quantized_B[k, n] - zero_point[block, n]) * scale[block, n] with block = k / block_size.
+
+Input B is stored as uint8_t with shape [N, n_blocks_per_col, blob_size], where
+n_blocks_per_col = (K + block_size - 1) / block_size and blob_size = block_size * bits / 8.
+For 4 bits, two elements are packed in each byte with the lower indexed element in the low nibble.
+The last block of each column is padded when K is not a multiple of block_size.
+
+Input scales is stored as float with shape [N * n_blocks_per_col].
+
+Input zero_points is optional and stored as uint8_t, packed like B with ceil(n_blocks_per_col * bits / 8)
+bytes per column. If it is not provided, the zero point is 2^(bits - 1).
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulNBits)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(MatMulNBits_ver1_doc)
+      .Attr("K", "size of each input feature", AttributeProto::INT)
+      .Attr("N", "size of each output feature", AttributeProto::INT)
+      .Attr("bits", "number of bits used for weight quantization, 4 or 8", AttributeProto::INT, static_cast<int64_t>(4))
+      .Attr("block_size",
+            "number of elements in each quantization block along the K dimension. "
+            "It must be a power of 2 and not smaller than 16.",
+            AttributeProto::INT)
+      .Input(0, "A", "The input tensor, not quantized", "T1")
+      .Input(1, "B", "1 or 2 dimensional data blob", "T2")
+      .Input(2, "scales", "quantization scale", "T1")
+      .Input(3, "zero_points", "quantization zero points", "T2", OpSchema::Optional)
+      .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight types to uint8.")
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        auto& a_shape = getInputShape(ctx, 0);
+        if (a_shape.dim_size() == 0) {
+          fail_shape_inference("Input A must not be a scalar");
+        }
+
+        const int64_t N = getAttribute(ctx, "N", -1);
+        if (N <= 0) {
+          fail_shape_inference("Attribute N must be positive");
+        }
+
+        auto* y_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        *y_shape = a_shape;
+        y_shape->mutable_dim(a_shape.dim_size() - 1)->set_dim_value(N);
+      });
 }
 
 }  // namespace contrib
@@ -66,6 +66,14 @@ static bool UsingLatestOnnxOpset(const DomainToVersionMap& opset_versions) {
   return is_latest_opset;
 }
 
+// Initializers of a memory mapped ORT format model refer to their data by its address in this process.
+// Copy that data into the initializers of a GraphProto that is going to be serialized.
+static void ConvertInitializersInMemoryToRawData(GraphProto& graph_proto) {
+  for (auto& initializer : *graph_proto.mutable_initializer()) {
+    utils::ConvertExternalDataInMemoryToRawData(initializer);
+  }
+}
+
 static Status MergeShapeInfo(const std::string& output_name,
                              const TypeProto& source, TypeProto& target,
                              bool strict, const logging::Logger& logger) {
@@ -511,6 +519,7 @@ void Node::ToProto(NodeProto& proto, bool update_subgraphs) const {
     if (update_subgraphs && attr->has_g()) {
       attr->clear_g();
       *attr->mutable_g() = attr_to_subgraph_map_.find(attribute.first)->second->ToGraphProto();
+      ConvertInitializersInMemoryToRawData(*attr->mutable_g());
     }
   }
 
@@ -3201,11 +3210,15 @@ const ONNX_NAMESPACE::GraphProto& Graph::ToGraphProto() {
 ONNX_NAMESPACE::GraphProto Graph::ToGraphProto() const {
 #if !defined(DISABLE_SPARSE_TENSORS)
   if (!GraphProtoSyncNeeded() && sparse_tensor_names_.empty()) {
-    return *graph_proto_;
+    GraphProto result = *graph_proto_;
+    ConvertInitializersInMemoryToRawData(result);
+    return result;
   }
 #else
   if (!GraphProtoSyncNeeded()) {
-    return *graph_proto_;
+    GraphProto result = *graph_proto_;
+    ConvertInitializersInMemoryToRawData(result);
+    return result;
   }
 #endif
 
@@ -3238,6 +3251,8 @@ ONNX_NAMESPACE::GraphProto Graph::ToGraphProto() const {
   *result.mutable_initializer() = graph_proto_->initializer();
 #endif
 
+  ConvertInitializersInMemoryToRawData(result);
+
   return result;
 }
 
@@ -3273,6 +3288,7 @@ ONNX_NAMESPACE::GraphProto Graph::ToGraphProtoWithExternalInitializers(const std
       size_t tensor_bytes_size = raw_data.size();
       if (tensor_bytes_size < initializer_size_threshold) {
         *output_proto = initializer;
+        utils::ConvertExternalDataInMemoryToRawData(*output_proto);
         continue;
       }
 
@@ -4024,6 +4040,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
 #if !defined(ORT_MINIMAL_BUILD)
                                 IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+                                bool can_use_flatbuffer_for_initializers,
                                 const logging::Logger& logger, std::unique_ptr<Graph>& graph) {
   // can't use make_unique as we're calling a private ctor
   graph.reset(new Graph(owning_model, domain_to_version,
@@ -4032,6 +4049,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
 #endif
                         nullptr, nullptr, logger));
 
+  graph->can_use_flatbuffer_for_initializers_ = can_use_flatbuffer_for_initializers;
   ORT_RETURN_IF_ERROR(graph->LoadFromOrtFormat(fbs_graph));
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -4058,6 +4076,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
                         &parent_graph, &parent_node,
                         logger));
 
+  graph->can_use_flatbuffer_for_initializers_ = parent_graph.can_use_flatbuffer_for_initializers_;
   return graph->LoadFromOrtFormat(fbs_graph);
 }
 
@@ -4110,7 +4129,8 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Gr
     for (const auto* fbs_tensor : *fbs_initializers) {
       ORT_RETURN_IF(nullptr == fbs_tensor, "Initializer tensor is missing. Invalid ORT format model.");
       TensorProto* initializer = deserialized_proto_data_.add_initializer();
-      ORT_RETURN_IF_ERROR(experimental::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer));
+      ORT_RETURN_IF_ERROR(experimental::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer,
+                                                                        can_use_flatbuffer_for_initializers_));
       auto p = name_to_initial_tensor_.emplace(initializer->name(), initializer);
       if (!p.second) {
         LOGS(logger_, WARNING) << "Duplicate initializer (dense or ConstantNode): '" << initializer->name()
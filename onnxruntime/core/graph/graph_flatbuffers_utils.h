@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace ONNX_NAMESPACE {
 class TensorProto;
 class SparseTensorProto;
@@ -34,6 +36,11 @@ struct Tensor;
 
 namespace utils {
 
+// Raw data of initializers at least this large is written aligned to kInitializerRawDataAlignment bytes, and is
+// used in place rather than copied when the ORT format model is loaded from memory mapped bytes.
+constexpr size_t kMinInitializerSizeForInPlaceUse = 128;
+constexpr size_t kInitializerRawDataAlignment = 64;
+
 // TODO, add ORT_MUST_USE_RESULT when it is moved to a different header
 onnxruntime::common::Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
@@ -54,8 +61,11 @@ onnxruntime::common::Status SaveAttributeOrtFormat(
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
+// If can_use_flatbuffer_for_initializers is true, the raw data of large initializers is referred to as external data
+// in memory instead of being copied into the TensorProto. The flatbuffer bytes must then outlive the TensorProto.
 onnxruntime::common::Status LoadInitializerOrtFormat(
-    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer);
+    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer,
+    bool can_use_flatbuffer_for_initializers = false);
 
 onnxruntime::common::Status LoadSparseInitializerOrtFormat(const fbs::SparseTensor& fbs_sparse_tensor,
                                                            ONNX_NAMESPACE::SparseTensorProto& initializer);
@@ -234,6 +234,10 @@ const std::vector<NodeIndex>& GraphViewer::GetNodesInTopologicalOrder(ExecutionO
     case ExecutionOrder::PRIORITY_BASED:
       return nodes_in_topological_order_with_priority_;
 #endif
+    case ExecutionOrder::MEMORY_EFFICIENT:
+      // the memory efficient order is computed by the allocation planner, which needs the inferred shapes.
+      // other consumers get the default order.
+      return nodes_in_topological_order_;
     default:
       ORT_THROW("Invalid ExecutionOrder");
   }
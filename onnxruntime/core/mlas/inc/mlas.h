@@ -201,6 +201,59 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Data parameters for a batch of SGEMM operations whose matrices are
+ *        located at a fixed distance from each other
+ *
+ * A stride of zero broadcasts the same matrix to every operation of the
+ * batch.
+ */
+struct MLAS_SGEMM_STRIDED_BATCH_PARAMS {
+    const float* A = nullptr; /**< Supplies the address of the first matrix A */
+    size_t lda = 0;           /**< Supplies the first dimension of matrix A. */
+    size_t StrideA = 0;       /**< Supplies the distance in elements between consecutive matrices A. */
+    const float* B = nullptr; /**< Supplies the address of the first matrix B */
+    size_t ldb = 0;           /**< Supplies the first dimension of matrix B. */
+    size_t StrideB = 0;       /**< Supplies the distance in elements between consecutive matrices B. */
+    float* C = nullptr;       /**< Supplies the address of the first matrix C */
+    size_t ldc = 0;           /**< Supplies the first dimension of matrix C. */
+    size_t StrideC = 0;       /**< Supplies the distance in elements between consecutive matrices C. */
+    float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
+    float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation (SGEMM)
+ *         over matrices described by a base address and a batch stride
+ *
+ * Batches of small multiplications are partitioned across the batch
+ * dimension first and a matrix B shared by consecutive multiplications is
+ * only packed once per thread.
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       Supplies the strided matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmStridedBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_STRIDED_BATCH_PARAMS& Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 /**
  * @brief  Single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -452,6 +505,188 @@ MlasGemm(
     MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, ThreadPool);
 }
 
+/**
+ * @brief Supply matrices data information to 16-bit floating point gemm
+ *        functions. The matrices hold either IEEE half precision (fp16) or
+ *        bfloat16 (bf16) values, depending on the routine called. The
+ *        multiplication is accumulated in single precision.
+ */
+struct MLAS_HALF_GEMM_DATA_PARAMS {
+    const uint16_t* A = nullptr; /**< Supplies the address of matrix A */
+    size_t lda = 0;              /**< Supplies the first dimension of matrix A. */
+    const uint16_t* B = nullptr; /**< Supplies the address of matrix B */
+    size_t ldb = 0;              /**< Supplies the first dimension of matrix B. */
+    uint16_t* C = nullptr;       /**< Supplies the address of matrix C */
+    size_t ldc = 0;              /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;          /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
+    float beta = 0.0f;           /**< Supplies the scalar beta multiplier (see SGEMM definition) */
+};
+
+/**
+ * @brief  Batched half precision matrix/matrix multiply operation (HGEMM)
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters, holding fp16 values
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasHalfGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Batched bfloat16 matrix/matrix multiply operation
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters, holding bf16 values
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasBf16GemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Supply matrices data information to the n-bit block quantized gemm
+ *        functions. Matrix B holds the weights in the packed format produced
+ *        by MlasQNBitGemmPackB, matrix A and matrix C hold single precision
+ *        values.
+ */
+struct MLAS_QNBIT_GEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;  /**< Supplies the address of packed matrix B */
+    float* C = nullptr;             /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief Determines whether the n-bit block quantized gemm supports the
+ *        specified quantization parameters.
+ *
+ * @param BlkBitWidth   Supplies the number of bits per quantized element, 4 or 8.
+ * @param BlkLen        Supplies the number of elements per quantization block,
+ *                      a power of two from 16 to 256.
+ */
+bool
+MLASCALL
+MlasIsQNBitGemmAvailable(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    );
+
+/**
+ * @brief Returns the size in bytes of the buffer needed by MlasQNBitGemmPackB,
+ *        or zero if the quantization parameters are not supported.
+ *
+ * @param N             Supplies the number of columns of matrix B.
+ * @param K             Supplies the number of rows of matrix B.
+ * @param BlkBitWidth   Supplies the number of bits per quantized element.
+ * @param BlkLen        Supplies the number of elements per quantization block.
+ */
+size_t
+MLASCALL
+MlasQNBitGemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen
+    );
+
+/**
+ * @brief Packs the block quantized matrix B for MlasQNBitGemmBatch. The
+ *        scale and zero point of each block are stored next to the quantized
+ *        elements of the block so that a column of matrix B is streamed from
+ *        a single contiguous range of memory.
+ *
+ * @param N                 Supplies the number of columns of matrix B.
+ * @param K                 Supplies the number of rows of matrix B.
+ * @param BlkBitWidth       Supplies the number of bits per quantized element.
+ * @param BlkLen            Supplies the number of elements per quantization block.
+ * @param QuantBData        Supplies the quantized elements, stored column by
+ *                          column as [N][ceil(K / BlkLen)][BlkLen * BlkBitWidth / 8]
+ *                          bytes. For 4-bit elements, the lower indexed element of
+ *                          each byte is held in the low nibble.
+ * @param QuantBScale       Supplies the [N][ceil(K / BlkLen)] block scales.
+ * @param QuantBZeroPoint   Supplies the optional block zero points, stored as
+ *                          ceil(ceil(K / BlkLen) * BlkBitWidth / 8) bytes per
+ *                          column and packed like the elements. If nullptr, the
+ *                          zero point is 2^(BlkBitWidth - 1).
+ * @param PackedB           Supplies the buffer of MlasQNBitGemmPackBSize bytes
+ *                          that receives the packed matrix.
+ */
+void
+MLASCALL
+MlasQNBitGemmPackB(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    void* PackedB
+    );
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with
+ *         n-bit block quantized weights: C = A * B. Matrix B is dequantized
+ *         one cache sized tile at a time while the product is accumulated.
+ *
+ * @param M             Supplies the number of rows of matrix A and matrix C.
+ * @param N             Supplies the number of columns of matrix B and matrix C.
+ * @param K             Supplies the number of columns of matrix A and the number
+                        of rows of matrix B.
+ * @param BlkBitWidth   Supplies the number of bits per quantized element.
+ * @param BlkLen        Supplies the number of elements per quantization block.
+ * @param Data          A array of matrices data parameters
+ * @param BatchSize     Supplies number of multiplications in this batch
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if the
+                        base library threading support should be used.
+ */
+void
+MLASCALL
+MlasQNBitGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 enum class MLAS_QUANTIZATION_GRANULARITY {
     PerMatrix,
     PerColumn,
@@ -528,10 +763,16 @@ private:
     MLAS_QUANTIZATION_GRANULARITY QuantGran_;
 };
 
+//
+// N.B. When AIsSigned is true, matrix A and ZeroPointA hold int8_t values
+// reinterpreted as uint8_t.
+//
+
 struct MLAS_GEMM_U8X8_SHAPE_PARAMS {
     size_t M = 0;
     size_t N = 0;
     size_t K = 0;
+    bool AIsSigned = false;
     bool BIsSigned = false;
     bool IsAccumulateMode = false;
 };
@@ -561,8 +802,8 @@ MlasGemm(
 /**
  * @brief Batched GEMM, for multiplying multiple pairs of matrices.
  * Note:  We only support uniform batching, so shapes and types of the
- *        input must be same: M, N, K, BIsSigned must be the
- *        same across all parameter blocks.
+ *        input must be same: M, N, K, AIsSigned, BIsSigned must be
+ *        the same across all parameter blocks.
  *
  * @param [IN]  Shape        A single shape descriptor for all the multiplications
  * @param [IN]  DataParams   Array of data descriptors for the matrices.
@@ -605,6 +846,7 @@ MLASCALL
 MlasGemmPackBSize(
     size_t N,
     size_t K,
+    bool AIsSigned,
     bool BIsSigned
     );
 
@@ -615,10 +857,112 @@ MlasGemmPackB(
     size_t K,
     const uint8_t* B,
     size_t ldb,
+    bool AIsSigned,
     bool BIsSigned,
     void* PackedB
     );
 
+//
+// GEMM tuning routines.
+//
+// The thread partitioning of MlasGemmBatch is normally derived from a fixed
+// complexity heuristic. A tuning table maps a problem shape to a measured
+// partitioning that overrides the heuristic. The table is process wide and is
+// empty unless populated by MlasGemmTune or MlasGemmTuningSetEntry. Lookups
+// from the GEMM routines do not take a lock; each update publishes a new copy
+// of the table, so updates are meant for initialization rather than the
+// inference path.
+//
+
+enum MLAS_GEMM_TUNING_KIND {
+    MlasGemmTuningSgemm,
+    MlasGemmTuningQgemm,
+};
+
+struct MLAS_GEMM_TUNING_ENTRY {
+    MLAS_GEMM_TUNING_KIND Kind;
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t BatchSize;
+    size_t MaximumThreadCount;  /**< Thread pool degree of parallelism the entry was measured with */
+    size_t ThreadCountM;        /**< Number of partitions on the M dimension for each GEMM */
+    size_t ThreadCountN;        /**< Number of partitions on the N dimension for each GEMM */
+};
+
+/**
+ * @brief Adds or replaces an entry in the GEMM tuning table.
+ *
+ * @param Entry  Supplies the entry. ThreadCountM and ThreadCountN must be non-zero.
+ */
+void
+MLASCALL
+MlasGemmTuningSetEntry(
+    const MLAS_GEMM_TUNING_ENTRY& Entry
+    );
+
+/**
+ * @brief Adds or replaces a set of entries in the GEMM tuning table. The
+ *        entries are published together, which is cheaper than adding them
+ *        one at a time.
+ *
+ * @param Entries  Supplies the entries. ThreadCountM and ThreadCountN must be non-zero.
+ * @param Count    Supplies the number of entries.
+ */
+void
+MLASCALL
+MlasGemmTuningSetEntries(
+    const MLAS_GEMM_TUNING_ENTRY* Entries,
+    size_t Count
+    );
+
+/**
+ * @brief Copies the entries of the GEMM tuning table.
+ *
+ * @param Entries  Supplies the buffer to receive the entries, may be nullptr.
+ * @param Count    Supplies the number of entries the buffer can hold.
+ * @return The total number of entries in the table.
+ */
+size_t
+MLASCALL
+MlasGemmTuningGetEntries(
+    MLAS_GEMM_TUNING_ENTRY* Entries,
+    size_t Count
+    );
+
+/**
+ * @brief Removes all entries from the GEMM tuning table.
+ */
+void
+MLASCALL
+MlasGemmTuningClear(
+    void
+    );
+
+/**
+ * @brief Benchmarks candidate thread partitionings of a GEMM shape on the
+ *        supplied thread pool and records the fastest in the tuning table.
+ *        The operands are scratch buffers, so this may be slow for large
+ *        shapes and is intended to run once at initialization or offline.
+ *
+ * @param Kind        Supplies the GEMM flavor to tune.
+ * @param M, N, K     Supplies the shape of each multiplication.
+ * @param BatchSize   Supplies the number of multiplications in the batch.
+ * @param ThreadPool  Supplies the thread pool the GEMM will run on.
+ * @param Entry       Receives the recorded entry, may be nullptr.
+ */
+void
+MLASCALL
+MlasGemmTune(
+    MLAS_GEMM_TUNING_KIND Kind,
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    MLAS_GEMM_TUNING_ENTRY* Entry
+    );
+
 //
 // Convolution routines.
 //
@@ -698,6 +1042,7 @@ MLASCALL
 MlasConvDepthwise(
     const uint8_t* const* Input,
     uint8_t InputZeroPoint,
+    bool InputIsSigned,
     const uint8_t* Filter,
     uint8_t FilterZeroPoint,
     bool FilterIsSigned,
@@ -843,6 +1188,96 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCE_OPERATION {
+    MlasReduceSum,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+};
+
+void
+MLASCALL
+MlasReduceContiguous(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    );
+
+void
+MLASCALL
+MlasReduceStrided(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    );
+
+//
+// Layer normalization routines.
+//
+
+/**
+ * @brief  Normalize a single row: Output = (X - mean) * inv_std_dev * Gamma + Beta,
+ *         where X = Input + Skip + Bias. The mean and variance are gathered in a
+ *         single pass over X.
+ *
+ * @param Input      Supplies the input row of N elements.
+ * @param Skip       Supplies an optional residual row added to the input, or nullptr.
+ * @param Bias       Supplies an optional bias added to the input, or nullptr.
+ * @param Gamma      Supplies the scale of N elements.
+ * @param Beta       Supplies an optional shift of N elements, or nullptr.
+ * @param Output     Supplies the output row of N elements. This may alias Input.
+ * @param N          Supplies the number of elements in the row.
+ * @param Epsilon    Supplies the value added to the variance.
+ * @param Simplified Supplies true to compute RMS normalization, where the mean
+ *                   is not subtracted and Beta is ignored.
+ * @param Mean       Supplies an optional address to store the mean, or nullptr.
+ * @param InvStdDev  Supplies an optional address to store the inverse standard
+ *                   deviation, or nullptr.
+ */
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+/**
+ * @brief  Half precision version of MlasLayerNormalization. The statistics
+ *         and the normalization are computed in single precision.
+ */
+void
+MLASCALL
+MlasHalfLayerNormalization(
+    const uint16_t* Input,
+    const uint16_t* Skip,
+    const uint16_t* Bias,
+    const uint16_t* Gamma,
+    const uint16_t* Beta,
+    uint16_t* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -856,6 +1291,30 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertBf16ToFloat(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBf16(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -1058,6 +1517,23 @@ MlasRequantizeOutput(
     size_t CountN
     );
 
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    int8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    int8_t ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    );
+
 class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
 {
    public:
@@ -1073,7 +1549,25 @@ class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
           Bias_(Bias),
           Scale_(Scale),
           PerColumnScale_(PerColumnScale),
-          ZeroPoint_(ZeroPoint)
+          ZeroPoint_(ZeroPoint),
+          OutputIsSigned_(false)
+    {
+    }
+
+    MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR(
+        int8_t* Output,
+        size_t OutputLeadingDimension,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        int8_t ZeroPoint)
+        : Output_(reinterpret_cast<uint8_t*>(Output)),
+          OutputLeadingDimension_(OutputLeadingDimension),
+          Bias_(Bias),
+          Scale_(Scale),
+          PerColumnScale_(PerColumnScale),
+          ZeroPoint_(static_cast<uint8_t>(ZeroPoint)),
+          OutputIsSigned_(true)
     {
     }
 
@@ -1084,8 +1578,14 @@ class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
                  size_t CountN,
                  size_t ldc) const override
     {
-        MlasRequantizeOutput(C, ldc, Output_, OutputLeadingDimension_, Bias_, Scale_,
-                             PerColumnScale_, ZeroPoint_, StartM, StartN, CountM, CountN);
+        if (OutputIsSigned_) {
+            MlasRequantizeOutput(C, ldc, reinterpret_cast<int8_t*>(Output_), OutputLeadingDimension_,
+                                 Bias_, Scale_, PerColumnScale_, static_cast<int8_t>(ZeroPoint_),
+                                 StartM, StartN, CountM, CountN);
+        } else {
+            MlasRequantizeOutput(C, ldc, Output_, OutputLeadingDimension_, Bias_, Scale_,
+                                 PerColumnScale_, ZeroPoint_, StartM, StartN, CountM, CountN);
+        }
     }
 
 
@@ -1096,6 +1596,7 @@ class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR
     const float* Scale_;
     bool PerColumnScale_;
     uint8_t ZeroPoint_;
+    bool OutputIsSigned_;
 };
 
 
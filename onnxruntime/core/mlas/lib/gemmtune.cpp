@@ -0,0 +1,497 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gemmtune.cpp
+
+Abstract:
+
+    This module implements the GEMM tuning table and the routine that measures
+    candidate thread partitionings to populate it.
+
+    The default thread partitioning of MlasGemmBatch is a 1D split derived
+    from the operation complexity, which is far from optimal for some skinny
+    or irregular shapes. The tuning table overrides the heuristic with a
+    measured 2D partitioning for specific shapes.
+
+--*/
+
+#include "mlasi.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+//
+// Define the key of the tuning table.
+//
+
+struct MLAS_GEMM_TUNING_KEY {
+    MLAS_GEMM_TUNING_KIND Kind;
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t BatchSize;
+    size_t MaximumThreadCount;
+
+    bool operator<(const MLAS_GEMM_TUNING_KEY& Other) const
+    {
+        return std::tie(Kind, M, N, K, BatchSize, MaximumThreadCount) <
+            std::tie(Other.Kind, Other.M, Other.N, Other.K, Other.BatchSize, Other.MaximumThreadCount);
+    }
+};
+
+using MLAS_GEMM_TUNING_ENTRIES = std::map<MLAS_GEMM_TUNING_KEY, std::pair<ptrdiff_t, ptrdiff_t>>;
+
+//
+// The table is published as immutable snapshots so that the lookup on the
+// GEMM path is a single acquire load. An update copies the current snapshot,
+// modifies the copy and publishes it. Readers do not announce themselves, so
+// a replaced snapshot cannot be freed safely and is retained until process
+// exit. Updates only happen while loading or tuning a session, so this is a
+// small and bounded amount of memory.
+//
+
+struct MLAS_GEMM_TUNING_TABLE {
+    std::mutex Lock;
+    std::atomic<const MLAS_GEMM_TUNING_ENTRIES*> Current{nullptr};
+    std::vector<std::unique_ptr<const MLAS_GEMM_TUNING_ENTRIES>> Snapshots;
+
+    //
+    // Publishes a new snapshot. The caller must hold the lock.
+    //
+
+    void
+    Publish(
+        MLAS_GEMM_TUNING_ENTRIES&& Entries
+        )
+    {
+        if (Entries.empty()) {
+            Current.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        Snapshots.emplace_back(new MLAS_GEMM_TUNING_ENTRIES(std::move(Entries)));
+        Current.store(Snapshots.back().get(), std::memory_order_release);
+    }
+};
+
+static
+MLAS_GEMM_TUNING_TABLE&
+MlasGetGemmTuningTable(
+    void
+    )
+{
+    static MLAS_GEMM_TUNING_TABLE Table;
+    return Table;
+}
+
+bool
+MlasGemmTuningLookup(
+    MLAS_GEMM_TUNING_KIND Kind,
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchSize,
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine looks up the tuned thread partitioning of a GEMM shape.
+
+Arguments:
+
+    Kind - Supplies the GEMM flavor.
+
+    M, N, K - Supplies the shape of the multiplication.
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    MaximumThreadCount - Supplies the degree of parallelism of the thread pool.
+
+    ThreadCountM - Receives the total thread partition on the M dimension.
+
+    ThreadCountN - Receives the total thread partition on the N dimension.
+
+Return Value:
+
+    Returns true if the table contains an entry for the shape, else false and
+    the output parameters are unmodified.
+
+--*/
+{
+    const MLAS_GEMM_TUNING_ENTRIES* Entries =
+        MlasGetGemmTuningTable().Current.load(std::memory_order_acquire);
+
+    if (Entries == nullptr) {
+        return false;
+    }
+
+    const MLAS_GEMM_TUNING_KEY Key{Kind, M, N, K, BatchSize, size_t(MaximumThreadCount)};
+
+    auto it = Entries->find(Key);
+
+    if (it == Entries->end()) {
+        return false;
+    }
+
+    *ThreadCountM = it->second.first;
+    *ThreadCountN = it->second.second;
+
+    return true;
+}
+
+void
+MLASCALL
+MlasGemmTuningSetEntries(
+    const MLAS_GEMM_TUNING_ENTRY* Entries,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        if (Entries[i].ThreadCountM == 0 || Entries[i].ThreadCountN == 0) {
+#ifdef MLAS_NO_EXCEPTION
+            abort();
+#else
+            throw std::invalid_argument("GEMM tuning entry has an empty thread partition!");
+#endif
+        }
+    }
+
+    if (Count == 0) {
+        return;
+    }
+
+    MLAS_GEMM_TUNING_TABLE& Table = MlasGetGemmTuningTable();
+
+    std::lock_guard<std::mutex> Guard(Table.Lock);
+
+    const MLAS_GEMM_TUNING_ENTRIES* Current = Table.Current.load(std::memory_order_relaxed);
+    MLAS_GEMM_TUNING_ENTRIES Updated;
+
+    if (Current != nullptr) {
+        Updated = *Current;
+    }
+
+    for (size_t i = 0; i < Count; i++) {
+
+        const MLAS_GEMM_TUNING_ENTRY& Entry = Entries[i];
+        const MLAS_GEMM_TUNING_KEY Key{Entry.Kind, Entry.M, Entry.N, Entry.K, Entry.BatchSize,
+            Entry.MaximumThreadCount};
+
+        Updated[Key] = std::make_pair(ptrdiff_t(Entry.ThreadCountM), ptrdiff_t(Entry.ThreadCountN));
+    }
+
+    Table.Publish(std::move(Updated));
+}
+
+void
+MLASCALL
+MlasGemmTuningSetEntry(
+    const MLAS_GEMM_TUNING_ENTRY& Entry
+    )
+{
+    MlasGemmTuningSetEntries(&Entry, 1);
+}
+
+size_t
+MLASCALL
+MlasGemmTuningGetEntries(
+    MLAS_GEMM_TUNING_ENTRY* Entries,
+    size_t Count
+    )
+{
+    const MLAS_GEMM_TUNING_ENTRIES* Current =
+        MlasGetGemmTuningTable().Current.load(std::memory_order_acquire);
+
+    if (Current == nullptr) {
+        return 0;
+    }
+
+    size_t Index = 0;
+
+    for (const auto& it : *Current) {
+
+        if (Entries == nullptr || Index >= Count) {
+            break;
+        }
+
+        MLAS_GEMM_TUNING_ENTRY& Entry = Entries[Index++];
+
+        Entry.Kind = it.first.Kind;
+        Entry.M = it.first.M;
+        Entry.N = it.first.N;
+        Entry.K = it.first.K;
+        Entry.BatchSize = it.first.BatchSize;
+        Entry.MaximumThreadCount = it.first.MaximumThreadCount;
+        Entry.ThreadCountM = size_t(it.second.first);
+        Entry.ThreadCountN = size_t(it.second.second);
+    }
+
+    return Current->size();
+}
+
+void
+MLASCALL
+MlasGemmTuningClear(
+    void
+    )
+{
+    MLAS_GEMM_TUNING_TABLE& Table = MlasGetGemmTuningTable();
+
+    std::lock_guard<std::mutex> Guard(Table.Lock);
+
+    Table.Publish(MLAS_GEMM_TUNING_ENTRIES());
+}
+
+//
+// Number of timed runs of each candidate partitioning. The fastest run is
+// used to reduce the influence of scheduling noise.
+//
+
+constexpr size_t MLAS_GEMM_TUNING_ITERATIONS = 5;
+
+//
+// Minimum relative improvement over the default partitioning that a
+// candidate must achieve to be selected.
+//
+
+constexpr double MLAS_GEMM_TUNING_MINIMUM_GAIN = 0.03;
+
+template<typename RunFunction>
+double
+MlasGemmTuningMeasure(
+    RunFunction Run
+    )
+{
+    //
+    // Warm up the caches and the thread pool before timing.
+    //
+
+    Run();
+
+    double BestTime = std::numeric_limits<double>::max();
+
+    for (size_t i = 0; i < MLAS_GEMM_TUNING_ITERATIONS; i++) {
+
+        const auto Start = std::chrono::steady_clock::now();
+        Run();
+        const auto Stop = std::chrono::steady_clock::now();
+
+        BestTime = std::min(BestTime, std::chrono::duration<double>(Stop - Start).count());
+    }
+
+    return BestTime;
+}
+
+void
+MLASCALL
+MlasGemmTune(
+    MLAS_GEMM_TUNING_KIND Kind,
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    MLAS_GEMM_TUNING_ENTRY* Entry
+    )
+/*++
+
+Routine Description:
+
+    This routine measures the default thread partitioning and a set of 2D
+    candidate partitionings of a GEMM shape and records the fastest in the
+    tuning table.
+
+    Candidates use a total thread count per GEMM of each power of two up to
+    the degree of parallelism of the thread pool, the degree of parallelism
+    itself, and its share per batch entry, split in every way between the M
+    and N dimensions.
+
+Arguments:
+
+    Kind - Supplies the GEMM flavor to tune.
+
+    M, N, K - Supplies the shape of the multiplication.
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    ThreadPool - Supplies the thread pool the GEMM will run on.
+
+    Entry - Optionally receives the recorded entry.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || K == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    //
+    // Allocate scratch operands. The values do not affect the timing, so the
+    // buffers are only initialized to keep sanitizers quiet.
+    //
+
+    std::function<void(ptrdiff_t, ptrdiff_t)> Run;
+    ptrdiff_t DefaultThreadCountM;
+    ptrdiff_t DefaultThreadCountN;
+    size_t BlockedN;
+
+    std::vector<float> FloatA;
+    std::vector<float> FloatB;
+    std::vector<float> FloatC;
+    std::vector<MLAS_SGEMM_DATA_PARAMS> FloatData;
+
+    std::vector<uint8_t> QuantA;
+    std::vector<uint8_t> QuantB;
+    std::vector<int32_t> QuantC;
+    std::vector<MLAS_GEMM_U8X8_DATA_PARAMS> QuantData;
+    MLAS_GEMM_U8X8_SHAPE_PARAMS QuantShape;
+    const uint8_t QuantZeroPointB = 0;
+
+    if (Kind == MlasGemmTuningSgemm) {
+
+        FloatA.assign(BatchSize * M * K, 1.0f);
+        FloatB.assign(BatchSize * K * N, 1.0f);
+        FloatC.assign(BatchSize * M * N, 0.0f);
+        FloatData.resize(BatchSize);
+
+        for (size_t b = 0; b < BatchSize; b++) {
+            FloatData[b].A = FloatA.data() + b * M * K;
+            FloatData[b].lda = K;
+            FloatData[b].B = FloatB.data() + b * K * N;
+            FloatData[b].ldb = N;
+            FloatData[b].C = FloatC.data() + b * M * N;
+            FloatData[b].ldc = N;
+        }
+
+        Run = [&](ptrdiff_t ThreadCountM, ptrdiff_t ThreadCountN) {
+            MlasSgemmBatchPartitioned(CblasNoTrans, CblasNoTrans, M, N, K, FloatData.data(),
+                BatchSize, ThreadCountM, ThreadCountN, ThreadPool);
+        };
+
+        MlasSgemmThreadPartition(M, N, K, BatchSize, MaximumThreadCount,
+            &DefaultThreadCountM, &DefaultThreadCountN);
+
+        BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) / MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    } else {
+
+        QuantA.assign(BatchSize * M * K, 1);
+        QuantB.assign(BatchSize * K * N, 1);
+        QuantC.assign(BatchSize * M * N, 0);
+        QuantData.resize(BatchSize);
+
+        QuantShape.M = M;
+        QuantShape.N = N;
+        QuantShape.K = K;
+
+        for (size_t b = 0; b < BatchSize; b++) {
+            QuantData[b].A = QuantA.data() + b * M * K;
+            QuantData[b].lda = K;
+            QuantData[b].B = QuantB.data() + b * K * N;
+            QuantData[b].ldb = N;
+            QuantData[b].ZeroPointB = &QuantZeroPointB;
+            QuantData[b].C = QuantC.data() + b * M * N;
+            QuantData[b].ldc = N;
+        }
+
+        Run = [&](ptrdiff_t ThreadCountM, ptrdiff_t ThreadCountN) {
+            MlasGemmU8X8BatchPartitioned(QuantShape, QuantData.data(), BatchSize,
+                ThreadCountM, ThreadCountN, ThreadPool);
+        };
+
+        MlasGemmU8X8ThreadPartition(M, N, K, BatchSize, MaximumThreadCount,
+            &DefaultThreadCountM, &DefaultThreadCountN);
+
+        BlockedN = (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) / MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
+    }
+
+    //
+    // Measure the default partitioning first so that a candidate only wins if
+    // it is measurably faster.
+    //
+
+    ptrdiff_t BestThreadCountM = DefaultThreadCountM;
+    ptrdiff_t BestThreadCountN = DefaultThreadCountN;
+
+    double BestTime = MlasGemmTuningMeasure([&]() {
+        Run(DefaultThreadCountM, DefaultThreadCountN);
+    }) * (1.0 - MLAS_GEMM_TUNING_MINIMUM_GAIN);
+
+    std::vector<ptrdiff_t> ThreadCounts;
+
+    for (ptrdiff_t ThreadCount = 1; ThreadCount < MaximumThreadCount; ThreadCount *= 2) {
+        ThreadCounts.push_back(ThreadCount);
+    }
+
+    ThreadCounts.push_back(MaximumThreadCount);
+    ThreadCounts.push_back((MaximumThreadCount + ptrdiff_t(BatchSize) - 1) / ptrdiff_t(BatchSize));
+
+    std::sort(ThreadCounts.begin(), ThreadCounts.end());
+    ThreadCounts.erase(std::unique(ThreadCounts.begin(), ThreadCounts.end()), ThreadCounts.end());
+
+    for (ptrdiff_t ThreadCount : ThreadCounts) {
+
+        for (ptrdiff_t ThreadCountM = 1; ThreadCountM <= ThreadCount; ThreadCountM++) {
+
+            if (ThreadCount % ThreadCountM != 0) {
+                continue;
+            }
+
+            const ptrdiff_t ThreadCountN = ThreadCount / ThreadCountM;
+
+            if (size_t(ThreadCountM) > M || size_t(ThreadCountN) > BlockedN) {
+                continue;
+            }
+
+            if (ThreadCountM == DefaultThreadCountM && ThreadCountN == DefaultThreadCountN) {
+                continue;
+            }
+
+            const double Time = MlasGemmTuningMeasure([&]() {
+                Run(ThreadCountM, ThreadCountN);
+            });
+
+            if (Time < BestTime) {
+                BestTime = Time;
+                BestThreadCountM = ThreadCountM;
+                BestThreadCountN = ThreadCountN;
+            }
+        }
+    }
+
+    MLAS_GEMM_TUNING_ENTRY TunedEntry;
+
+    TunedEntry.Kind = Kind;
+    TunedEntry.M = M;
+    TunedEntry.N = N;
+    TunedEntry.K = K;
+    TunedEntry.BatchSize = BatchSize;
+    TunedEntry.MaximumThreadCount = size_t(MaximumThreadCount);
+    TunedEntry.ThreadCountM = size_t(BestThreadCountM);
+    TunedEntry.ThreadCountN = size_t(BestThreadCountN);
+
+    MlasGemmTuningSetEntry(TunedEntry);
+
+    if (Entry != nullptr) {
+        *Entry = TunedEntry;
+    }
+}
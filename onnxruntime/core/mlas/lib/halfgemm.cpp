@@ -0,0 +1,627 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision (fp16) and bfloat16 (bf16)
+    matrix/matrix multiply operations.
+
+    The 16-bit matrices are converted to single precision one cache sized tile
+    at a time and multiplied with the single precision kernels, so the full
+    matrices are never expanded in memory. The product is accumulated in
+    single precision and rounded to 16-bit once per output element.
+
+--*/
+
+#include "mlasi.h"
+
+#include <memory>
+
+//
+// Scalar conversion helpers.
+//
+
+MLAS_FORCEINLINE
+float
+MlasHalfToFloat(
+    uint16_t HalfValue
+    )
+{
+    const uint32_t Sign = uint32_t(HalfValue & 0x8000) << 16;
+    const uint32_t Exponent = (HalfValue >> 10) & 0x1F;
+    const uint32_t Mantissa = HalfValue & 0x3FF;
+
+    if (Exponent == 0x1F) {
+        return MlasFp32FromBits(Sign | 0x7F800000 | (Mantissa << 13));
+    }
+
+    if (Exponent == 0) {
+
+        //
+        // Zero or a subnormal value, which is exactly representable as the
+        // mantissa scaled by 2^-24.
+        //
+
+        const float Value = float(Mantissa) * 5.9604644775390625e-8f;
+        return (Sign != 0) ? -Value : Value;
+    }
+
+    return MlasFp32FromBits(Sign | ((Exponent + (127 - 15)) << 23) | (Mantissa << 13));
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToHalf(
+    float FloatValue
+    )
+{
+    uint32_t Bits = MlasBitsOfFp32(FloatValue);
+    const uint32_t Sign = Bits & 0x80000000;
+    Bits ^= Sign;
+
+    uint16_t HalfValue;
+
+    if (Bits >= 0x47800000) {
+
+        //
+        // Overflow to infinity, or a NaN which is kept quiet.
+        //
+
+        HalfValue = (Bits > 0x7F800000) ? 0x7E00 : 0x7C00;
+
+    } else if (Bits < 0x38800000) {
+
+        //
+        // The value is a half precision subnormal or zero. Adding the magic
+        // value lets the floating point unit do the rounding to nearest even.
+        //
+
+        const uint32_t DenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+        const float Rounded = MlasFp32FromBits(Bits) + MlasFp32FromBits(DenormMagic);
+        HalfValue = uint16_t(MlasBitsOfFp32(Rounded) - DenormMagic);
+
+    } else {
+
+        //
+        // Rebias the exponent and round the mantissa to nearest even.
+        //
+
+        const uint32_t MantissaOdd = (Bits >> 13) & 1;
+        Bits += (uint32_t(15 - 127) << 23) + 0xFFF + MantissaOdd;
+        HalfValue = uint16_t(Bits >> 13);
+    }
+
+    return HalfValue | uint16_t(Sign >> 16);
+}
+
+MLAS_FORCEINLINE
+float
+MlasBf16ToFloat(
+    uint16_t Bf16Value
+    )
+{
+    return MlasFp32FromBits(uint32_t(Bf16Value) << 16);
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBf16(
+    float FloatValue
+    )
+{
+    uint32_t Bits = MlasBitsOfFp32(FloatValue);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t((Bits >> 16) | 0x40);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+    return uint16_t(Bits >> 16);
+}
+
+//
+// Buffer conversion routines.
+//
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision values to
+    single precision values.
+
+Arguments:
+
+    Source - Supplies the source buffer of half precision values.
+
+    Destination - Supplies the destination buffer of single precision values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasHalfToFloat(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision values to
+    half precision values. Values are rounded to the nearest even value.
+
+Arguments:
+
+    Source - Supplies the source buffer of single precision values.
+
+    Destination - Supplies the destination buffer of half precision values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFloatToHalf(Source[n]);
+    }
+}
+
+extern "C"
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertHalfToFloatKernel(
+#else
+    MlasConvertHalfToFloatKernel(
+#endif
+        Source, Destination, Count);
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertFloatToHalfKernel(
+#else
+    MlasConvertFloatToHalfKernel(
+#endif
+        Source, Destination, Count);
+}
+
+void
+MLASCALL
+MlasConvertBf16ToFloat(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasBf16ToFloat(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBf16(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFloatToBf16(Source[n]);
+    }
+}
+
+//
+// Define the conversions used by the GEMM for each 16-bit format.
+//
+
+struct MLAS_HALF_GEMM_FP16_FORMAT
+{
+    static void ToFloat(const uint16_t* Source, float* Destination, size_t Count)
+    {
+        MlasConvertHalfToFloatBuffer(Source, Destination, Count);
+    }
+
+    static void FromFloat(const float* Source, uint16_t* Destination, size_t Count)
+    {
+        MlasConvertFloatToHalf(Source, Destination, Count);
+    }
+};
+
+struct MLAS_HALF_GEMM_BF16_FORMAT
+{
+    static void ToFloat(const uint16_t* Source, float* Destination, size_t Count)
+    {
+        MlasConvertBf16ToFloat(Source, Destination, Count);
+    }
+
+    static void FromFloat(const float* Source, uint16_t* Destination, size_t Count)
+    {
+        MlasConvertFloatToBf16(Source, Destination, Count);
+    }
+};
+
+static
+void*
+MlasHalfGemmGetThreadBuffer(
+    size_t BufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a per thread buffer used to hold a converted and
+    packed panel of matrix B. The buffer is kept for the lifetime of the thread
+    and only grows, so repeated multiplies do not allocate.
+
+Arguments:
+
+    BufferSize - Supplies the number of bytes required.
+
+Return Value:
+
+    Returns the address of the buffer, aligned to the preferred buffer
+    alignment of the packed single precision kernels.
+
+--*/
+{
+    thread_local std::unique_ptr<uint8_t[]> Buffer;
+    thread_local size_t BufferCapacity = 0;
+
+    const size_t Alignment = MlasGetPreferredBufferAlignment();
+
+    if (BufferSize > BufferCapacity) {
+        Buffer.reset(new uint8_t[BufferSize + Alignment]);
+        BufferCapacity = BufferSize;
+    }
+
+    const uintptr_t Address = reinterpret_cast<uintptr_t>(Buffer.get());
+
+    return reinterpret_cast<void*>((Address + Alignment - 1) & ~uintptr_t(Alignment - 1));
+}
+
+template<typename FormatType>
+void
+MlasHalfGemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a segment of the 16-bit floating point
+    matrix/matrix multiply operation.
+
+    Each panel of matrix B is converted to single precision and packed once,
+    then reused for every row tile of matrix A.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    RangeStartM - Supplies the first row of matrix C to compute.
+
+    RangeCountM - Supplies the number of rows of matrix C to compute.
+
+    RangeStartN - Supplies the first column of matrix C to compute.
+
+    RangeCountN - Supplies the number of columns of matrix C to compute.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies the matrices data parameters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelA[MLAS_HGEMM_STRIDEM * MLAS_HGEMM_STRIDEK], 16 * sizeof(float));
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_HGEMM_STRIDEK * MLAS_HGEMM_STRIDEN], 16 * sizeof(float));
+    MLAS_DECLSPEC_ALIGN(float PanelC[MLAS_HGEMM_STRIDEM * MLAS_HGEMM_STRIDEN], 16 * sizeof(float));
+
+    static_assert(MLAS_HGEMM_STRIDEM * MLAS_HGEMM_STRIDEK >= MLAS_HGEMM_STRIDEN,
+        "PanelA must be able to hold a row of matrix C");
+    static_assert(MLAS_HGEMM_STRIDEK <= MLAS_SGEMM_PACKED_STRIDEK,
+        "A slice of matrix B must pack into a single packed block");
+
+    const uint16_t* A = Data->A;
+    const uint16_t* B = Data->B;
+    uint16_t* C = Data->C;
+    const size_t lda = Data->lda;
+    const size_t ldb = Data->ldb;
+    const size_t ldc = Data->ldc;
+    const float alpha = Data->alpha;
+    const float beta = Data->beta;
+
+    //
+    // The packed panel of matrix B holds every slice along the K dimension
+    // for up to MLAS_HGEMM_STRIDEN columns.
+    //
+
+    float* PackedB = static_cast<float*>(
+        MlasHalfGemmGetThreadBuffer(MlasGemmPackBSize(std::min(RangeCountN, size_t(MLAS_HGEMM_STRIDEN)), K)));
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_HGEMM_STRIDEN));
+        const size_t StartN = RangeStartN + n;
+        const size_t AlignedN = (CountN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+            ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        //
+        // Convert and pack each slice of matrix B along the K dimension.
+        //
+
+        size_t CountK;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_HGEMM_STRIDEK));
+
+            if (TransB == CblasNoTrans) {
+                for (size_t kk = 0; kk < CountK; kk++) {
+                    FormatType::ToFloat(B + (k + kk) * ldb + StartN, PanelB + kk * CountN, CountN);
+                }
+                MlasGemmPackB(CblasNoTrans, CountN, CountK, PanelB, CountN, PackedB + AlignedN * k);
+            } else {
+                for (size_t nn = 0; nn < CountN; nn++) {
+                    FormatType::ToFloat(B + (StartN + nn) * ldb + k, PanelB + nn * CountK, CountK);
+                }
+                MlasGemmPackB(CblasTrans, CountN, CountK, PanelB, CountK, PackedB + AlignedN * k);
+            }
+        }
+
+        size_t CountM;
+
+        for (size_t m = 0; m < RangeCountM; m += CountM) {
+
+            CountM = std::min(RangeCountM - m, size_t(MLAS_HGEMM_STRIDEM));
+            const size_t StartM = RangeStartM + m;
+
+            if (K == 0) {
+                std::fill_n(PanelC, CountM * CountN, 0.0f);
+            }
+
+            //
+            // Accumulate the product of the converted slices of matrix A and
+            // the packed slices of matrix B in the single precision panel of
+            // matrix C.
+            //
+
+            for (size_t k = 0; k < K; k += CountK) {
+
+                CountK = std::min(K - k, size_t(MLAS_HGEMM_STRIDEK));
+
+                size_t PanelStrideA;
+
+                if (TransA == CblasNoTrans) {
+                    for (size_t mm = 0; mm < CountM; mm++) {
+                        FormatType::ToFloat(A + (StartM + mm) * lda + k, PanelA + mm * CountK, CountK);
+                    }
+                    PanelStrideA = CountK;
+                } else {
+                    for (size_t kk = 0; kk < CountK; kk++) {
+                        FormatType::ToFloat(A + (k + kk) * lda + StartM, PanelA + kk * CountM, CountM);
+                    }
+                    PanelStrideA = CountM;
+                }
+
+                MlasSgemmPackedOperation(TransA, CountM, 0, CountN, CountK, 1.0f,
+                    PanelA, PanelStrideA, PackedB + AlignedN * k, AlignedN, (k == 0) ? 0.0f : 1.0f,
+                    PanelC, CountN);
+            }
+
+            //
+            // Apply the alpha and beta multipliers and round the panel to
+            // the 16-bit output matrix.
+            //
+
+            for (size_t mm = 0; mm < CountM; mm++) {
+
+                float* c = PanelC + mm * CountN;
+                uint16_t* Output = C + (StartM + mm) * ldc + StartN;
+
+                if (beta != 0.0f) {
+                    FormatType::ToFloat(Output, PanelA, CountN);
+                    for (size_t nn = 0; nn < CountN; nn++) {
+                        c[nn] = alpha * c[nn] + beta * PanelA[nn];
+                    }
+                } else if (alpha != 1.0f) {
+                    for (size_t nn = 0; nn < CountN; nn++) {
+                        c[nn] *= alpha;
+                    }
+                }
+
+                FormatType::FromFloat(c, Output, CountN);
+            }
+        }
+    }
+}
+
+template<typename FormatType>
+void
+MlasHalfGemmBatchImpl(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_HGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_HGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads using the same 1D
+    // partition as the single precision GEMM.
+    //
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (N > M) {
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        const ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        const ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        const ptrdiff_t ThreadIdM = ThreadIdx / ThreadCountN;
+        const ptrdiff_t ThreadIdN = ThreadIdx % ThreadCountN;
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+
+        MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+        size_t RangeStartN;
+        size_t RangeCountN;
+
+        MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN, &RangeCountN);
+
+        RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+        RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+        MlasHalfGemmOperation<FormatType>(TransA, TransB, RangeStartM, RangeCountM,
+            RangeStartN, RangeCountN, K, &Data[GemmIdx]);
+    });
+}
+
+void
+MLASCALL
+MlasHalfGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasHalfGemmBatchImpl<MLAS_HALF_GEMM_FP16_FORMAT>(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool);
+}
+
+void
+MLASCALL
+MlasBf16GemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasHalfGemmBatchImpl<MLAS_HALF_GEMM_BF16_FORMAT>(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool);
+}
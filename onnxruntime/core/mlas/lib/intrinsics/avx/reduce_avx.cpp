@@ -0,0 +1,261 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_avx.cpp
+
+Abstract:
+
+    This module implements the kernels to reduce a buffer of single precision
+    floating point values with AVX instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<MLAS_REDUCE_OPERATION Operation>
+struct MLAS_REDUCE_F32_AVX;
+
+template<>
+struct MLAS_REDUCE_F32_AVX<MlasReduceSum>
+{
+    static constexpr float InitialValue() { return 0.0f; }
+
+    static MLAS_FORCEINLINE __m256 Reduce(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m128 Reduce(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m128 ReduceScalar(__m128 a, __m128 b) { return _mm_add_ss(a, b); }
+};
+
+template<>
+struct MLAS_REDUCE_F32_AVX<MlasReduceMaximum>
+{
+    static constexpr float InitialValue() { return -std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FORCEINLINE __m256 Reduce(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m128 Reduce(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m128 ReduceScalar(__m128 a, __m128 b) { return _mm_max_ss(a, b); }
+};
+
+template<>
+struct MLAS_REDUCE_F32_AVX<MlasReduceMinimum>
+{
+    static constexpr float InitialValue() { return std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FORCEINLINE __m256 Reduce(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m128 Reduce(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m128 ReduceScalar(__m128 a, __m128 b) { return _mm_min_ss(a, b); }
+};
+
+template<MLAS_REDUCE_OPERATION Operation>
+float
+MlasReduceContiguousF32KernelAvxImpl(
+    const float* Input,
+    size_t N
+    )
+{
+    using Reducer = MLAS_REDUCE_F32_AVX<Operation>;
+
+    __m128 Accumulator = _mm_set_ss(Reducer::InitialValue());
+
+    if (N >= 8) {
+
+        __m256 AccumulatorVector0 = _mm256_set1_ps(Reducer::InitialValue());
+
+        if (N >= 32) {
+
+            __m256 AccumulatorVector1 = AccumulatorVector0;
+            __m256 AccumulatorVector2 = AccumulatorVector0;
+            __m256 AccumulatorVector3 = AccumulatorVector0;
+
+            while (N >= 32) {
+
+                AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, _mm256_loadu_ps(Input));
+                AccumulatorVector1 = Reducer::Reduce(AccumulatorVector1, _mm256_loadu_ps(Input + 8));
+                AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, _mm256_loadu_ps(Input + 16));
+                AccumulatorVector3 = Reducer::Reduce(AccumulatorVector3, _mm256_loadu_ps(Input + 24));
+
+                Input += 32;
+                N -= 32;
+            }
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, AccumulatorVector1);
+            AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, AccumulatorVector3);
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, AccumulatorVector2);
+        }
+
+        while (N >= 8) {
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, _mm256_loadu_ps(Input));
+
+            Input += 8;
+            N -= 8;
+        }
+
+        __m128 Reduced = Reducer::Reduce(_mm256_castps256_ps128(AccumulatorVector0),
+                                         _mm256_extractf128_ps(AccumulatorVector0, 1));
+        Reduced = Reducer::Reduce(Reduced, _mm_movehl_ps(Reduced, Reduced));
+        Reduced = Reducer::ReduceScalar(Reduced, _mm_shuffle_ps(Reduced, Reduced, 1));
+
+        Accumulator = Reduced;
+    }
+
+    while (N > 0) {
+
+        Accumulator = Reducer::ReduceScalar(Accumulator, _mm_load_ss(Input));
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return _mm_cvtss_f32(Accumulator);
+}
+
+template<MLAS_REDUCE_OPERATION Operation>
+void
+MlasReduceContiguousF32KernelAvxRows(
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+{
+    for (size_t r = 0; r < Rows; r++) {
+        Output[r] = MlasReduceContiguousF32KernelAvxImpl<Operation>(Input, ReduceCount);
+        Input += ReduceCount;
+    }
+}
+
+void
+MLASCALL
+MlasReduceContiguousF32KernelAvx(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+{
+    switch (Operation) {
+        case MlasReduceSum:
+            MlasReduceContiguousF32KernelAvxRows<MlasReduceSum>(Input, Output, Rows, ReduceCount);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceContiguousF32KernelAvxRows<MlasReduceMaximum>(Input, Output, Rows, ReduceCount);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceContiguousF32KernelAvxRows<MlasReduceMinimum>(Input, Output, Rows, ReduceCount);
+            break;
+    }
+}
+
+template<MLAS_REDUCE_OPERATION Operation>
+void
+MlasReduceStridedF32KernelAvxImpl(
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    )
+{
+    using Reducer = MLAS_REDUCE_F32_AVX<Operation>;
+
+    while (Columns >= 32) {
+
+        const float* input = Input;
+
+        __m256 AccumulatorVector0 = _mm256_loadu_ps(input);
+        __m256 AccumulatorVector1 = _mm256_loadu_ps(input + 8);
+        __m256 AccumulatorVector2 = _mm256_loadu_ps(input + 16);
+        __m256 AccumulatorVector3 = _mm256_loadu_ps(input + 24);
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+
+            input += InputStride;
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, _mm256_loadu_ps(input));
+            AccumulatorVector1 = Reducer::Reduce(AccumulatorVector1, _mm256_loadu_ps(input + 8));
+            AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, _mm256_loadu_ps(input + 16));
+            AccumulatorVector3 = Reducer::Reduce(AccumulatorVector3, _mm256_loadu_ps(input + 24));
+        }
+
+        _mm256_storeu_ps(Output, AccumulatorVector0);
+        _mm256_storeu_ps(Output + 8, AccumulatorVector1);
+        _mm256_storeu_ps(Output + 16, AccumulatorVector2);
+        _mm256_storeu_ps(Output + 24, AccumulatorVector3);
+
+        Input += 32;
+        Output += 32;
+        Columns -= 32;
+    }
+
+    while (Columns >= 8) {
+
+        const float* input = Input;
+
+        __m256 AccumulatorVector = _mm256_loadu_ps(input);
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+            input += InputStride;
+            AccumulatorVector = Reducer::Reduce(AccumulatorVector, _mm256_loadu_ps(input));
+        }
+
+        _mm256_storeu_ps(Output, AccumulatorVector);
+
+        Input += 8;
+        Output += 8;
+        Columns -= 8;
+    }
+
+    while (Columns > 0) {
+
+        const float* input = Input;
+
+        __m128 Accumulator = _mm_load_ss(input);
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+            input += InputStride;
+            Accumulator = Reducer::ReduceScalar(Accumulator, _mm_load_ss(input));
+        }
+
+        _mm_store_ss(Output, Accumulator);
+
+        Input += 1;
+        Output += 1;
+        Columns -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasReduceStridedF32KernelAvx(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    )
+{
+    switch (Operation) {
+        case MlasReduceSum:
+            MlasReduceStridedF32KernelAvxImpl<MlasReduceSum>(Input, Output, ReduceCount, Columns, InputStride);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceStridedF32KernelAvxImpl<MlasReduceMaximum>(Input, Output, ReduceCount, Columns, InputStride);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceStridedF32KernelAvxImpl<MlasReduceMinimum>(Input, Output, ReduceCount, Columns, InputStride);
+            break;
+    }
+}
@@ -0,0 +1,121 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_packa_avx2.cpp
+
+Abstract:
+
+    This module implements the routine to copy and pack a signed matrix A for
+    the U8S8 quantized integer matrix/matrix multiply kernels using avx2
+    intrinsics.
+
+    The sign bit of each element is flipped so that the packed panel holds
+    unsigned data biased by 128. The caller adjusts the zero point offset of
+    matrix A by the same bias.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasGemmS8X8CopyPackAAvx2(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer. The layout matches MlasGemmU8S8CopyPackAAvx2: each row is
+    stored contiguously with the number of columns padded with zeroes to a
+    multiple of four.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    RowSumBuffer - Supplies the address of the buffer to receive the sums of
+        the biased elements along each of the rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + 3) & ~size_t(3);
+
+    const __m256i BitFlipVector = _mm256_set1_epi8(char(0x80));
+    const __m256i OnesByteVector = _mm256_set1_epi8(1);
+    const __m256i OnesWordVector = _mm256_set1_epi16(1);
+
+    while (CountM-- > 0) {
+
+        __m256i RowSums = _mm256_setzero_si256();
+        size_t k = 0;
+
+        for (; k + 32 <= CountK; k += 32) {
+
+            __m256i Bytes = _mm256_loadu_si256((const __m256i*)&A[k]);
+            Bytes = _mm256_xor_si256(Bytes, BitFlipVector);
+            _mm256_storeu_si256((__m256i*)&D[k], Bytes);
+
+            __m256i Words = _mm256_maddubs_epi16(Bytes, OnesByteVector);
+            RowSums = _mm256_add_epi32(RowSums, _mm256_madd_epi16(Words, OnesWordVector));
+        }
+
+        __m128i RowSums128 = _mm_add_epi32(_mm256_castsi256_si128(RowSums),
+            _mm256_extracti128_si256(RowSums, 1));
+
+        if (k + 16 <= CountK) {
+
+            __m128i Bytes = _mm_loadu_si128((const __m128i*)&A[k]);
+            Bytes = _mm_xor_si128(Bytes, _mm256_castsi256_si128(BitFlipVector));
+            _mm_storeu_si128((__m128i*)&D[k], Bytes);
+
+            __m128i Words = _mm_maddubs_epi16(Bytes, _mm256_castsi256_si128(OnesByteVector));
+            RowSums128 = _mm_add_epi32(RowSums128, _mm_madd_epi16(Words, _mm256_castsi256_si128(OnesWordVector)));
+
+            k += 16;
+        }
+
+        RowSums128 = _mm_add_epi32(RowSums128, _mm_shuffle_epi32(RowSums128, _MM_SHUFFLE(1, 0, 3, 2)));
+        RowSums128 = _mm_add_epi32(RowSums128, _mm_shuffle_epi32(RowSums128, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int32_t RowSum = _mm_cvtsi128_si32(RowSums128);
+
+        for (; k < CountK; k++) {
+            const uint8_t Value = uint8_t(A[k] ^ 0x80);
+            D[k] = Value;
+            RowSum += Value;
+        }
+
+        for (; k < AlignedCountK; k++) {
+            D[k] = 0;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
@@ -0,0 +1,412 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_s8s8_avx2.cpp
+
+Abstract:
+
+    This module implements the packing routines and the kernel for the S8S8
+    quantized integer matrix/matrix multiply operation using avx2 intrinsics.
+
+    Both matrices are sign extended to 16-bit values and multiplied with
+    vpmaddwd, so the full int8 range is supported without the intermediate
+    saturation of the vpmaddubsw based U8S8 kernel.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasGemmS8S8CopyPackAAvx2(
+    int16_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer. Each row is stored contiguously as 16-bit values with the
+    number of columns padded with zeroes to a multiple of two.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    RowSumBuffer - Supplies the address of the buffer to receive the sums of
+        the elements along each of the rows.
+
+    AIsSigned - Supplies true if the source matrix is signed data, else false
+        if the source matrix is unsigned data.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + 1) & ~size_t(1);
+
+    const __m256i OnesWordVector = _mm256_set1_epi16(1);
+
+    while (CountM-- > 0) {
+
+        __m256i RowSums = _mm256_setzero_si256();
+        size_t k = 0;
+
+        for (; k + 16 <= CountK; k += 16) {
+
+            const __m128i Bytes = _mm_loadu_si128((const __m128i*)&A[k]);
+            const __m256i Words = AIsSigned ? _mm256_cvtepi8_epi16(Bytes) : _mm256_cvtepu8_epi16(Bytes);
+            _mm256_storeu_si256((__m256i*)&D[k], Words);
+
+            RowSums = _mm256_add_epi32(RowSums, _mm256_madd_epi16(Words, OnesWordVector));
+        }
+
+        __m128i RowSums128 = _mm_add_epi32(_mm256_castsi256_si128(RowSums),
+            _mm256_extracti128_si256(RowSums, 1));
+        RowSums128 = _mm_add_epi32(RowSums128, _mm_shuffle_epi32(RowSums128, _MM_SHUFFLE(1, 0, 3, 2)));
+        RowSums128 = _mm_add_epi32(RowSums128, _mm_shuffle_epi32(RowSums128, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int32_t RowSum = _mm_cvtsi128_si32(RowSums128);
+
+        for (; k < CountK; k++) {
+            const int16_t Value = AIsSigned ? int16_t(int8_t(A[k])) : int16_t(A[k]);
+            D[k] = Value;
+            RowSum += Value;
+        }
+
+        for (; k < AlignedCountK; k++) {
+            D[k] = 0;
+        }
+
+        *RowSumBuffer++ = RowSum;
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+void
+MLASCALL
+MlasGemmS8S8CopyPackBAvx2(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+    The columns are packed in blocks of sixteen. For each pair of rows of the
+    source matrix, a block stores the two bytes of each column next to each
+    other, so that a sign extended 256-bit load lines up with the pairs of
+    16-bit values of a packed row of matrix A. A partial block and an odd row
+    count are padded with zeroes.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    ColumnSumBuffer - Supplies the address of the buffer to receive the sums
+        of the elements along each of the columns.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m256i OnesWordVector = _mm256_set1_epi16(1);
+
+    while (CountN > 0) {
+
+        const size_t CountNThisBlock = std::min(CountN, size_t(16));
+
+        MLAS_DECLSPEC_ALIGN(uint8_t PaddedRows[2][16], 16) = {};
+        __m256i ColumnSums[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+
+        const uint8_t* b = B;
+        size_t k = CountK;
+
+        while (k > 0) {
+
+            __m128i Rows[2];
+
+            if (CountNThisBlock == 16) {
+                Rows[0] = _mm_loadu_si128((const __m128i*)&b[0]);
+                Rows[1] = (k >= 2) ? _mm_loadu_si128((const __m128i*)&b[ldb]) : _mm_setzero_si128();
+            } else {
+                std::copy_n(&b[0], CountNThisBlock, PaddedRows[0]);
+                if (k >= 2) {
+                    std::copy_n(&b[ldb], CountNThisBlock, PaddedRows[1]);
+                } else {
+                    std::fill_n(PaddedRows[1], CountNThisBlock, uint8_t(0));
+                }
+                Rows[0] = _mm_load_si128((const __m128i*)PaddedRows[0]);
+                Rows[1] = _mm_load_si128((const __m128i*)PaddedRows[1]);
+            }
+
+            const __m128i Interleaved0 = _mm_unpacklo_epi8(Rows[0], Rows[1]);
+            const __m128i Interleaved1 = _mm_unpackhi_epi8(Rows[0], Rows[1]);
+
+            _mm_storeu_si128((__m128i*)&D[0], Interleaved0);
+            _mm_storeu_si128((__m128i*)&D[16], Interleaved1);
+
+            ColumnSums[0] = _mm256_add_epi32(ColumnSums[0],
+                _mm256_madd_epi16(_mm256_cvtepi8_epi16(Interleaved0), OnesWordVector));
+            ColumnSums[1] = _mm256_add_epi32(ColumnSums[1],
+                _mm256_madd_epi16(_mm256_cvtepi8_epi16(Interleaved1), OnesWordVector));
+
+            D += 32;
+            b += ldb * 2;
+            k -= std::min(k, size_t(2));
+        }
+
+        if (CountNThisBlock == 16) {
+            _mm256_storeu_si256((__m256i*)&ColumnSumBuffer[0], ColumnSums[0]);
+            _mm256_storeu_si256((__m256i*)&ColumnSumBuffer[8], ColumnSums[1]);
+        } else {
+            MLAS_DECLSPEC_ALIGN(int32_t ColumnSumsOutput[16], 32);
+            _mm256_store_si256((__m256i*)&ColumnSumsOutput[0], ColumnSums[0]);
+            _mm256_store_si256((__m256i*)&ColumnSumsOutput[8], ColumnSums[1]);
+            std::copy_n(ColumnSumsOutput, CountNThisBlock, ColumnSumBuffer);
+        }
+
+        B += CountNThisBlock;
+        ColumnSumBuffer += CountNThisBlock;
+        CountN -= CountNThisBlock;
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasGemmS8S8KernelAvx2Rows(
+    const int16_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    const size_t StrideA = PackedCountK * 2;
+
+    while (CountN > 0) {
+
+        //
+        // Initialize the accumulators with the row and column sums. The sum
+        // buffers and the zero point buffer are sized for a full block.
+        //
+
+        __m256i Accumulators[RowCount][2];
+
+        const __m256i ColumnSums0 = _mm256_loadu_si256((const __m256i*)&ColumnSumBuffer[0]);
+        const __m256i ColumnSums1 = _mm256_loadu_si256((const __m256i*)&ColumnSumBuffer[8]);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const __m256i RowSums = _mm256_set1_epi32(RowSumBuffer[r]);
+
+            if (ZeroPointB != nullptr) {
+                Accumulators[r][0] = _mm256_mullo_epi32(RowSums,
+                    _mm256_loadu_si256((const __m256i*)&ZeroPointB[0]));
+                Accumulators[r][1] = _mm256_mullo_epi32(RowSums,
+                    _mm256_loadu_si256((const __m256i*)&ZeroPointB[8]));
+            } else {
+                Accumulators[r][0] = RowSums;
+                Accumulators[r][1] = RowSums;
+            }
+
+            Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0], ColumnSums0);
+            Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1], ColumnSums1);
+        }
+
+        //
+        // Multiply the pairs of 16-bit values along the K dimension.
+        //
+
+        const int16_t* a = A;
+
+        for (size_t k = 0; k < PackedCountK; k++) {
+
+            const __m256i BBytes = _mm256_loadu_si256((const __m256i*)B);
+            const __m256i BWords0 = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(BBytes));
+            const __m256i BWords1 = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(BBytes, 1));
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                const __m256i ABroadcast = _mm256_set1_epi32(*(const int32_t*)&a[r * StrideA]);
+
+                Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0],
+                    _mm256_madd_epi16(ABroadcast, BWords0));
+                Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1],
+                    _mm256_madd_epi16(ABroadcast, BWords1));
+            }
+
+            a += 2;
+            B += 32;
+        }
+
+        //
+        // Store the block to the output matrix.
+        //
+
+        const size_t CountNThisBlock = std::min(CountN, size_t(16));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t* c = C + r * ldc;
+
+            if (CountNThisBlock == 16) {
+
+                if (!ZeroMode) {
+                    Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0],
+                        _mm256_loadu_si256((const __m256i*)&c[0]));
+                    Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1],
+                        _mm256_loadu_si256((const __m256i*)&c[8]));
+                }
+
+                _mm256_storeu_si256((__m256i*)&c[0], Accumulators[r][0]);
+                _mm256_storeu_si256((__m256i*)&c[8], Accumulators[r][1]);
+
+            } else {
+
+                MLAS_DECLSPEC_ALIGN(int32_t Output[16], 32);
+                _mm256_store_si256((__m256i*)&Output[0], Accumulators[r][0]);
+                _mm256_store_si256((__m256i*)&Output[8], Accumulators[r][1]);
+
+                for (size_t n = 0; n < CountNThisBlock; n++) {
+                    c[n] = ZeroMode ? Output[n] : c[n] + Output[n];
+                }
+            }
+        }
+
+        C += CountNThisBlock;
+        ColumnSumBuffer += CountNThisBlock;
+        if (ZeroPointB != nullptr) {
+            ZeroPointB += CountNThisBlock;
+        }
+        CountN -= CountNThisBlock;
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmS8S8KernelAvx2(
+    const int16_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasGemmS8S8CopyPackAAvx2.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasGemmS8S8CopyPackBAvx2.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed pairs of columns from matrix
+        A and the number of packed pairs of rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    RowSumBuffer - Supplies the sum of each row from matrix A. These values
+        have been pre-scaled by the zero point offset of matrix B if the offset
+        is per-tensor (ZeroPointB is nullptr). Otherwise, these values must be
+        scaled by the per-column zero point offsets of matrix B.
+
+    ColumnSumBuffer - Supplies the sum of each column from matrix B multiplied
+        by the zero point offset of matrix A.
+
+    ZeroPointB - Optionally supplies the per-column zero point offsets of
+        matrix B, else nullptr if the matrix B is using per-tensor
+        quantization.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasGemmS8S8KernelAvx2Rows<4>(A, B, C, PackedCountK, CountN, ldc,
+            RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasGemmS8S8KernelAvx2Rows<2>(A, B, C, PackedCountK, CountN, ldc,
+            RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+        return 2;
+    }
+
+    MlasGemmS8S8KernelAvx2Rows<1>(A, B, C, PackedCountK, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+    return 1;
+}
@@ -0,0 +1,89 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qnbitgemm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel to dequantize packed 4-bit blocks of the
+    n-bit block quantized matrix/matrix multiply operation using AVX2
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasQ4DequantizeBlocksKernelAvx2(
+    const uint8_t* PackedB,
+    float* Destination,
+    size_t BlockCount,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a run of packed 4-bit blocks from one column of
+    matrix B.
+
+Arguments:
+
+    PackedB - Supplies the address of the first packed block.
+
+    Destination - Supplies the buffer that receives BlockCount * BlkLen
+        single precision values.
+
+    BlockCount - Supplies the number of blocks to dequantize.
+
+    BlkLen - Supplies the number of elements per quantization block, which
+        is a multiple of 16.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m128i LowNibbleMask = _mm_set1_epi8(0x0F);
+    const size_t BlkDataSize = BlkLen / 2;
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const float* Header = reinterpret_cast<const float*>(PackedB);
+        const __m256 ScaleVector = _mm256_broadcast_ss(&Header[0]);
+        const __m256 ZeroPointVector = _mm256_broadcast_ss(&Header[1]);
+        const uint8_t* Data = PackedB + MLAS_QNBIT_BLK_HEADER_SIZE;
+
+        for (size_t i = 0; i < BlkDataSize; i += 8) {
+
+            //
+            // Split 8 bytes into 16 nibbles, interleaving the low and high
+            // nibbles to restore the element order.
+            //
+
+            __m128i Bytes = _mm_loadl_epi64((const __m128i*)(Data + i));
+            __m128i LowNibbles = _mm_and_si128(Bytes, LowNibbleMask);
+            __m128i HighNibbles = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowNibbleMask);
+            __m128i Values = _mm_unpacklo_epi8(LowNibbles, HighNibbles);
+
+            __m256 FloatVector0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Values));
+            __m256 FloatVector1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(Values, 8)));
+
+            FloatVector0 = _mm256_mul_ps(_mm256_sub_ps(FloatVector0, ZeroPointVector), ScaleVector);
+            FloatVector1 = _mm256_mul_ps(_mm256_sub_ps(FloatVector1, ZeroPointVector), ScaleVector);
+
+            _mm256_storeu_ps(Destination + i * 2, FloatVector0);
+            _mm256_storeu_ps(Destination + i * 2 + 8, FloatVector1);
+        }
+
+        PackedB += MLAS_QNBIT_BLK_HEADER_SIZE + BlkDataSize;
+        Destination += BlkLen;
+    }
+}
@@ -0,0 +1,151 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernels to reduce a buffer of single precision
+    floating point values with AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<MLAS_REDUCE_OPERATION Operation>
+struct MLAS_REDUCE_F32_AVX512F;
+
+template<>
+struct MLAS_REDUCE_F32_AVX512F<MlasReduceSum>
+{
+    static constexpr float InitialValue() { return 0.0f; }
+
+    static MLAS_FORCEINLINE __m512 Reduce(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m512 Reduce(__m512 a, __mmask16 mask, __m512 b) { return _mm512_mask_add_ps(a, mask, a, b); }
+
+    static MLAS_FORCEINLINE float ReduceVector(__m512 a) { return _mm512_reduce_add_ps(a); }
+};
+
+template<>
+struct MLAS_REDUCE_F32_AVX512F<MlasReduceMaximum>
+{
+    static constexpr float InitialValue() { return -std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FORCEINLINE __m512 Reduce(__m512 a, __m512 b) { return _mm512_max_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m512 Reduce(__m512 a, __mmask16 mask, __m512 b) { return _mm512_mask_max_ps(a, mask, a, b); }
+
+    static MLAS_FORCEINLINE float ReduceVector(__m512 a) { return _mm512_reduce_max_ps(a); }
+};
+
+template<>
+struct MLAS_REDUCE_F32_AVX512F<MlasReduceMinimum>
+{
+    static constexpr float InitialValue() { return std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FORCEINLINE __m512 Reduce(__m512 a, __m512 b) { return _mm512_min_ps(a, b); }
+
+    static MLAS_FORCEINLINE __m512 Reduce(__m512 a, __mmask16 mask, __m512 b) { return _mm512_mask_min_ps(a, mask, a, b); }
+
+    static MLAS_FORCEINLINE float ReduceVector(__m512 a) { return _mm512_reduce_min_ps(a); }
+};
+
+template<MLAS_REDUCE_OPERATION Operation>
+float
+MlasReduceContiguousF32KernelAvx512FImpl(
+    const float* Input,
+    size_t N
+    )
+{
+    using Reducer = MLAS_REDUCE_F32_AVX512F<Operation>;
+
+    __m512 AccumulatorVector0 = _mm512_set1_ps(Reducer::InitialValue());
+
+    if (N >= 64) {
+
+        __m512 AccumulatorVector1 = AccumulatorVector0;
+        __m512 AccumulatorVector2 = AccumulatorVector0;
+        __m512 AccumulatorVector3 = AccumulatorVector0;
+
+        while (N >= 64) {
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, _mm512_loadu_ps(Input));
+            AccumulatorVector1 = Reducer::Reduce(AccumulatorVector1, _mm512_loadu_ps(Input + 16));
+            AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, _mm512_loadu_ps(Input + 32));
+            AccumulatorVector3 = Reducer::Reduce(AccumulatorVector3, _mm512_loadu_ps(Input + 48));
+
+            Input += 64;
+            N -= 64;
+        }
+
+        AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, AccumulatorVector1);
+        AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, AccumulatorVector3);
+        AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, AccumulatorVector2);
+    }
+
+    while (N >= 16) {
+
+        AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, _mm512_loadu_ps(Input));
+
+        Input += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        //
+        // Handle the remaining elements with a masked load. Masked out lanes
+        // keep the accumulator value.
+        //
+
+        __mmask16 mask = __mmask16((1u << N) - 1);
+
+        AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, mask, _mm512_maskz_loadu_ps(mask, Input));
+    }
+
+    return Reducer::ReduceVector(AccumulatorVector0);
+}
+
+template<MLAS_REDUCE_OPERATION Operation>
+void
+MlasReduceContiguousF32KernelAvx512FRows(
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+{
+    for (size_t r = 0; r < Rows; r++) {
+        Output[r] = MlasReduceContiguousF32KernelAvx512FImpl<Operation>(Input, ReduceCount);
+        Input += ReduceCount;
+    }
+}
+
+void
+MLASCALL
+MlasReduceContiguousF32KernelAvx512F(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+{
+    switch (Operation) {
+        case MlasReduceSum:
+            MlasReduceContiguousF32KernelAvx512FRows<MlasReduceSum>(Input, Output, Rows, ReduceCount);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceContiguousF32KernelAvx512FRows<MlasReduceMaximum>(Input, Output, Rows, ReduceCount);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceContiguousF32KernelAvx512FRows<MlasReduceMinimum>(Input, Output, Rows, ReduceCount);
+            break;
+    }
+}
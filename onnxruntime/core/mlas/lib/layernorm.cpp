@@ -0,0 +1,503 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization, with an
+    optional fused residual add, and RMS normalization.
+
+    The mean and the mean of the squares are accumulated in a single pass over
+    the row, then the row is normalized in a second pass.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements converted at a time by the half precision routine.
+//
+
+constexpr size_t MLAS_LAYER_NORM_HALF_BLOCK_SIZE = 256;
+
+template<bool HasSkip, bool HasBias>
+void
+MlasLayerNormAccumulateKernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float& Sum,
+    float& SumSquare
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the sum and the sum of the squares of the
+    supplied row. If a residual is supplied, the sum of the input and the
+    residual is stored to the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Supplies the optional residual buffer.
+
+    Bias - Supplies the optional bias buffer.
+
+    Output - Supplies the output buffer, written only if a residual is
+        supplied.
+
+    N - Supplies the number of elements to process.
+
+    Sum - Supplies the running sum, updated on return.
+
+    SumSquare - Supplies the running sum of the squares, updated on return.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr bool StoreOutput = HasSkip || HasBias;
+
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector1 = MlasZeroFloat32x4();
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+
+        if (HasSkip) {
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Skip));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Skip + 4));
+            Skip += 8;
+        }
+
+        if (HasBias) {
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Bias));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Bias + 4));
+            Bias += 8;
+        }
+
+        if (StoreOutput) {
+            MlasStoreFloat32x4(Output, Vector0);
+            MlasStoreFloat32x4(Output + 4, Vector1);
+            Output += 8;
+        }
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Vector1);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquareVector1);
+
+        Input += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+
+        if (HasSkip) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip));
+            Skip += 4;
+        }
+
+        if (HasBias) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias));
+            Bias += 4;
+        }
+
+        if (StoreOutput) {
+            MlasStoreFloat32x4(Output, Vector);
+            Output += 4;
+        }
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquareVector0);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float SumValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquareValue = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquareVector0, SumSquareVector1));
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        if (HasSkip) {
+            Value += *Skip++;
+        }
+
+        if (HasBias) {
+            Value += *Bias++;
+        }
+
+        if (StoreOutput) {
+            *Output++ = Value;
+        }
+
+        SumValue += Value;
+        SumSquareValue += Value * Value;
+
+        N -= 1;
+    }
+
+    Sum += SumValue;
+    SumSquare += SumSquareValue;
+}
+
+void
+MlasLayerNormAccumulate(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float& Sum,
+    float& SumSquare
+    )
+{
+    if (Skip != nullptr) {
+        if (Bias != nullptr) {
+            MlasLayerNormAccumulateKernel<true, true>(Input, Skip, Bias, Output, N, Sum, SumSquare);
+        } else {
+            MlasLayerNormAccumulateKernel<true, false>(Input, Skip, Bias, Output, N, Sum, SumSquare);
+        }
+    } else {
+        if (Bias != nullptr) {
+            MlasLayerNormAccumulateKernel<false, true>(Input, Skip, Bias, Output, N, Sum, SumSquare);
+        } else {
+            MlasLayerNormAccumulateKernel<false, false>(Input, Skip, Bias, Output, N, Sum, SumSquare);
+        }
+    }
+}
+
+template<bool HasBeta>
+void
+MlasLayerNormNormalizeKernel(
+    const float* Input,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = (Input - Mean) * InvStdDev * Gamma + Beta.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Gamma - Supplies the scale buffer.
+
+    Beta - Supplies the optional shift buffer.
+
+    Output - Supplies the output buffer. This may alias the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Supplies the mean of the row.
+
+    InvStdDev - Supplies the inverse standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+
+        Vector0 = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector0, MeanVector), InvStdDevVector);
+        Vector1 = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector1, MeanVector), InvStdDevVector);
+
+        if (HasBeta) {
+            Vector0 = MlasMultiplyAddFloat32x4(Vector0, MlasLoadFloat32x4(Gamma), MlasLoadFloat32x4(Beta));
+            Vector1 = MlasMultiplyAddFloat32x4(Vector1, MlasLoadFloat32x4(Gamma + 4), MlasLoadFloat32x4(Beta + 4));
+            Beta += 8;
+        } else {
+            Vector0 = MlasMultiplyFloat32x4(Vector0, MlasLoadFloat32x4(Gamma));
+            Vector1 = MlasMultiplyFloat32x4(Vector1, MlasLoadFloat32x4(Gamma + 4));
+        }
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+
+        Input += 8;
+        Gamma += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+
+        Vector = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector, MeanVector), InvStdDevVector);
+
+        if (HasBeta) {
+            Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Gamma), MlasLoadFloat32x4(Beta));
+            Beta += 4;
+        } else {
+            Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Gamma));
+        }
+
+        MlasStoreFloat32x4(Output, Vector);
+
+        Input += 4;
+        Gamma += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = (*Input++ - Mean) * InvStdDev * *Gamma++;
+
+        if (HasBeta) {
+            Value += *Beta++;
+        }
+
+        *Output++ = Value;
+
+        N -= 1;
+    }
+}
+
+void
+MlasLayerNormNormalize(
+    const float* Input,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+    )
+{
+    if (Beta != nullptr) {
+        MlasLayerNormNormalizeKernel<true>(Input, Gamma, Beta, Output, N, Mean, InvStdDev);
+    } else {
+        MlasLayerNormNormalizeKernel<false>(Input, Gamma, Beta, Output, N, Mean, InvStdDev);
+    }
+}
+
+void
+MlasLayerNormComputeStatistics(
+    float Sum,
+    float SumSquare,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float& MeanValue,
+    float& InvStdDevValue
+    )
+{
+    float MeanSquare = SumSquare / float(N);
+
+    if (Simplified) {
+        MeanValue = 0.0f;
+        InvStdDevValue = 1.0f / std::sqrt(MeanSquare + Epsilon);
+    } else {
+        MeanValue = Sum / float(N);
+
+        //
+        // Rounding can produce a tiny negative variance for constant rows.
+        //
+
+        float Variance = std::max(MeanSquare - MeanValue * MeanValue, 0.0f);
+        InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+    }
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a single row of single precision values.
+
+Arguments:
+
+    See the description in mlas.h.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+
+    MlasLayerNormAccumulate(Input, Skip, Bias, Output, N, Sum, SumSquare);
+
+    //
+    // The residual sum was stored to the output buffer by the first pass.
+    //
+
+    const float* Normalized = (Skip != nullptr || Bias != nullptr) ? Output : Input;
+
+    float MeanValue;
+    float InvStdDevValue;
+
+    MlasLayerNormComputeStatistics(Sum, SumSquare, N, Epsilon, Simplified, MeanValue, InvStdDevValue);
+
+    MlasLayerNormNormalize(Normalized, Gamma, Simplified ? nullptr : Beta, Output, N, MeanValue, InvStdDevValue);
+
+    if (Mean != nullptr) {
+        *Mean = MeanValue;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = InvStdDevValue;
+    }
+}
+
+void
+MLASCALL
+MlasHalfLayerNormalization(
+    const uint16_t* Input,
+    const uint16_t* Skip,
+    const uint16_t* Bias,
+    const uint16_t* Gamma,
+    const uint16_t* Beta,
+    uint16_t* Output,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a single row of half precision values.
+
+    The row is converted to single precision in blocks. The residual sum is
+    recomputed by the second pass instead of being stored in half precision
+    between the passes.
+
+Arguments:
+
+    See the description in mlas.h.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float InputBuffer[MLAS_LAYER_NORM_HALF_BLOCK_SIZE], 64);
+    MLAS_DECLSPEC_ALIGN(float SkipBuffer[MLAS_LAYER_NORM_HALF_BLOCK_SIZE], 64);
+    MLAS_DECLSPEC_ALIGN(float BiasBuffer[MLAS_LAYER_NORM_HALF_BLOCK_SIZE], 64);
+
+    const float* SkipData = (Skip != nullptr) ? SkipBuffer : nullptr;
+    const float* BiasData = (Bias != nullptr) ? BiasBuffer : nullptr;
+
+    auto ConvertResidual = [&](size_t Offset, size_t Count) {
+        MlasConvertHalfToFloatBuffer(Input + Offset, InputBuffer, Count);
+        if (Skip != nullptr) {
+            MlasConvertHalfToFloatBuffer(Skip + Offset, SkipBuffer, Count);
+        }
+        if (Bias != nullptr) {
+            MlasConvertHalfToFloatBuffer(Bias + Offset, BiasBuffer, Count);
+        }
+    };
+
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+
+    for (size_t Offset = 0; Offset < N; Offset += MLAS_LAYER_NORM_HALF_BLOCK_SIZE) {
+
+        const size_t Count = std::min(N - Offset, MLAS_LAYER_NORM_HALF_BLOCK_SIZE);
+
+        ConvertResidual(Offset, Count);
+        MlasLayerNormAccumulate(InputBuffer, SkipData, BiasData, InputBuffer, Count, Sum, SumSquare);
+    }
+
+    float MeanValue;
+    float InvStdDevValue;
+
+    MlasLayerNormComputeStatistics(Sum, SumSquare, N, Epsilon, Simplified, MeanValue, InvStdDevValue);
+
+    //
+    // The skip and bias buffers are reused for the scale and the shift once
+    // the residual sum has been formed.
+    //
+
+    const uint16_t* Shift = Simplified ? nullptr : Beta;
+
+    for (size_t Offset = 0; Offset < N; Offset += MLAS_LAYER_NORM_HALF_BLOCK_SIZE) {
+
+        const size_t Count = std::min(N - Offset, MLAS_LAYER_NORM_HALF_BLOCK_SIZE);
+
+        if (Skip != nullptr || Bias != nullptr) {
+            float Unused = 0.0f;
+            ConvertResidual(Offset, Count);
+            MlasLayerNormAccumulate(InputBuffer, SkipData, BiasData, InputBuffer, Count, Unused, Unused);
+        } else {
+            MlasConvertHalfToFloatBuffer(Input + Offset, InputBuffer, Count);
+        }
+
+        MlasConvertHalfToFloatBuffer(Gamma + Offset, SkipBuffer, Count);
+        if (Shift != nullptr) {
+            MlasConvertHalfToFloatBuffer(Shift + Offset, BiasBuffer, Count);
+        }
+
+        MlasLayerNormNormalize(InputBuffer, SkipBuffer, (Shift != nullptr) ? BiasBuffer : nullptr, InputBuffer,
+                               Count, MeanValue, InvStdDevValue);
+
+        MlasConvertFloatToHalf(InputBuffer, Output + Offset, Count);
+    }
+
+    if (Mean != nullptr) {
+        *Mean = MeanValue;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = InvStdDevValue;
+    }
+}
@@ -125,6 +125,18 @@ Abstract:
 #define MLAS_SGEMM_PACKED_STRIDEK                   256
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
+#define MLAS_HGEMM_STRIDEM                          32
+#define MLAS_HGEMM_STRIDEN                          64
+#define MLAS_HGEMM_STRIDEK                          128
+#define MLAS_QNBIT_GEMM_STRIDEN                     32
+#define MLAS_QNBIT_GEMM_STRIDEK                     256
+
+//
+// Define the size of the scale and zero point header that precedes the
+// elements of each block of a packed n-bit quantized matrix.
+//
+
+#define MLAS_QNBIT_BLK_HEADER_SIZE                  (2 * sizeof(float))
 
 //
 // Define the alignment for segmenting a GEMM operation across multiple
@@ -413,6 +425,27 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_REDUCE_CONTIGUOUS_FLOAT_KERNEL)(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    );
+
+typedef
+void
+(MLASCALL MLAS_REDUCE_STRIDED_FLOAT_KERNEL)(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -465,14 +498,39 @@ void
     int8_t ZeroPoint
     );
 
-template<typename FilterType>
-struct MLAS_U8X8_KERNEL
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_KERNEL)(
+    const uint16_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FLOAT_TO_HALF_KERNEL)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_QNBIT_DEQUANTIZE_BLOCKS_KERNEL)(
+    const uint8_t* PackedB,
+    float* Destination,
+    size_t BlockCount,
+    size_t BlkLen
+    );
+
+template<typename InputType, typename FilterType>
+struct MLAS_CONV_DEPTHWISE_KERNEL
 {
     typedef
     void
     (MLASCALL DepthwiseKernel)(
-        const uint8_t* const* Input,
-        uint8_t InputZeroPoint,
+        const InputType* const* Input,
+        InputType InputZeroPoint,
         const FilterType* Filter,
         FilterType FilterZeroPoint,
         int32_t* Output,
@@ -577,6 +635,10 @@ extern "C" {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL MlasQLinearAddU8Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8Kernel;
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernel;
+    MLAS_QNBIT_DEQUANTIZE_BLOCKS_KERNEL MlasQ4DequantizeBlocksKernel;
+    MLAS_QNBIT_DEQUANTIZE_BLOCKS_KERNEL MlasQ8DequantizeBlocksKernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasErfKernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelFma3;
@@ -591,13 +653,21 @@ extern "C" {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL MlasQLinearAddU8KernelAvx2;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8KernelAvx512F;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8KernelAvx512F;
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernelF16C;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernelF16C;
+    MLAS_QNBIT_DEQUANTIZE_BLOCKS_KERNEL MlasQ4DequantizeBlocksKernelAvx2;
 #endif
 
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32Kernel;
+    MLAS_REDUCE_CONTIGUOUS_FLOAT_KERNEL MlasReduceContiguousF32Kernel;
+    MLAS_REDUCE_STRIDED_FLOAT_KERNEL MlasReduceStridedF32Kernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32KernelAvx;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
+    MLAS_REDUCE_CONTIGUOUS_FLOAT_KERNEL MlasReduceContiguousF32KernelAvx;
+    MLAS_REDUCE_STRIDED_FLOAT_KERNEL MlasReduceStridedF32KernelAvx;
+    MLAS_REDUCE_CONTIGUOUS_FLOAT_KERNEL MlasReduceContiguousF32KernelAvx512F;
 #endif
 
 }
@@ -627,9 +697,11 @@ extern "C" {
 #define MLAS_SGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_QGEMM_THREAD_COMPLEXITY                (64 * 1024)
+#define MLAS_HGEMM_THREAD_COMPLEXITY                (64 * 1024)
+#define MLAS_QNBIT_GEMM_THREAD_COMPLEXITY           (64 * 1024)
 
 //
-// Single-threaded single precision matrix/matrix multiply operation.
+// Single-threaded single precision matrix/matrix multiply operations.
 //
 
 void
@@ -649,6 +721,23 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
 //
 // Quantized integer matrix/matrix dispatch structure.
 //
@@ -659,6 +748,7 @@ extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchSse;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8S8DispatchSse41;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8S8DispatchAvx2;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8U8DispatchAvx2;
+extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchAvx2;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchNeon;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchNeon;
 extern const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8X8DispatchUdot;
@@ -680,12 +770,12 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni;
 // Quantized depthwise convolution kernels.
 //
 
-template<typename FilterType>
+template<typename InputType, typename FilterType>
 void
 MLASCALL
 MlasConvDepthwiseKernel(
-    const uint8_t* const* Input,
-    uint8_t InputZeroPoint,
+    const InputType* const* Input,
+    InputType InputZeroPoint,
     const FilterType* Filter,
     FilterType FilterZeroPoint,
     int32_t* Output,
@@ -694,12 +784,12 @@ MlasConvDepthwiseKernel(
     size_t KernelSize
     );
 
-template<typename FilterType>
+template<typename InputType, typename FilterType>
 void
 MLASCALL
 MlasConvDepthwiseKernelAvx2(
-    const uint8_t* const* Input,
-    uint8_t InputZeroPoint,
+    const InputType* const* Input,
+    InputType InputZeroPoint,
     const FilterType* Filter,
     FilterType FilterZeroPoint,
     int32_t* Output,
@@ -708,6 +798,60 @@ MlasConvDepthwiseKernelAvx2(
     size_t KernelSize
     );
 
+//
+// Quantized integer matrix/matrix multiply helper routines.
+//
+
+void
+MLASCALL
+MlasGemmS8X8CopyPackAAvx2(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    );
+
+void
+MLASCALL
+MlasGemmS8S8CopyPackAAvx2(
+    int16_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer,
+    bool AIsSigned
+    );
+
+void
+MLASCALL
+MlasGemmS8S8CopyPackBAvx2(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer
+    );
+
+size_t
+MLASCALL
+MlasGemmS8S8KernelAvx2(
+    const int16_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    );
+
 //
 // Environment information class.
 //
@@ -723,6 +867,7 @@ struct MLAS_PLATFORM {
 #if defined(MLAS_TARGET_AMD64_IX86)
     const MLAS_GEMM_U8X8_DISPATCH* GemmU8S8Dispatch;
     const MLAS_GEMM_U8X8_DISPATCH* GemmU8U8Dispatch;
+    const MLAS_GEMM_U8X8_DISPATCH* GemmS8S8Dispatch;
 #elif defined(MLAS_TARGET_ARM64)
     const MLAS_GEMM_U8X8_DISPATCH* GemmU8X8Dispatch;
 #endif
@@ -745,8 +890,10 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* ErfKernelRoutine;
     MLAS_QLINEAR_BINARY_OP_S8_KERNEL* QLinearAddS8Kernel;
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL* QLinearAddU8Kernel;
-    MLAS_U8X8_KERNEL<int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
-    MLAS_U8X8_KERNEL<uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
+    MLAS_CONV_DEPTHWISE_KERNEL<uint8_t, int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
+    MLAS_CONV_DEPTHWISE_KERNEL<uint8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
+    MLAS_CONV_DEPTHWISE_KERNEL<int8_t, int8_t>::DepthwiseKernel* ConvDepthwiseS8S8Kernel;
+    MLAS_CONV_DEPTHWISE_KERNEL<int8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseS8U8Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* ComputeExpF32Kernel;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
@@ -755,8 +902,13 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_REDUCE_CONTIGUOUS_FLOAT_KERNEL* ReduceContiguousF32Kernel;
+    MLAS_REDUCE_STRIDED_FLOAT_KERNEL* ReduceStridedF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL* ConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL* ConvertFloatToHalfKernel;
+    MLAS_QNBIT_DEQUANTIZE_BLOCKS_KERNEL* Q4DequantizeBlocksKernel;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
@@ -842,6 +994,68 @@ MlasPartitionWork(
     }
 }
 
+//
+// GEMM tuning support.
+//
+
+bool
+MlasGemmTuningLookup(
+    MLAS_GEMM_TUNING_KIND Kind,
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchSize,
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    );
+
+void
+MlasSgemmThreadPartition(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchSize,
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    );
+
+void
+MlasSgemmBatchPartitioned(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    ptrdiff_t ThreadCountM,
+    ptrdiff_t ThreadCountN,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasGemmU8X8ThreadPartition(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    );
+
+void
+MlasGemmU8X8BatchPartitioned(
+    const MLAS_GEMM_U8X8_SHAPE_PARAMS& Shape,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* DataParams,
+    size_t BatchN,
+    ptrdiff_t ThreadCountM,
+    ptrdiff_t ThreadCountN,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Define the minimum floating point value (and its bit value equivalent) that
 // has no fractional bits. This number can be used for fast rounding of floating
@@ -132,6 +132,7 @@ Return Value:
     this->GemmFloatKernel = MlasGemmFloatKernelSse;
     this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchSse;
     this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchSse;
+    this->GemmS8S8Dispatch = &MlasGemmU8X8DispatchSse;
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -153,12 +154,19 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->ReduceContiguousF32Kernel = MlasReduceContiguousF32Kernel;
+    this->ReduceStridedF32Kernel = MlasReduceStridedF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
-    this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<int8_t>;
-    this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t>;
+    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernel;
+    this->Q4DequantizeBlocksKernel = MlasQ4DequantizeBlocksKernel;
+    this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<uint8_t, int8_t>;
+    this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t, uint8_t>;
+    this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernel<int8_t, int8_t>;
+    this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernel<int8_t, uint8_t>;
 
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
@@ -219,6 +227,8 @@ Return Value:
             this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32KernelAvx;
             this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelAvx;
             this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32KernelAvx;
+            this->ReduceContiguousF32Kernel = MlasReduceContiguousF32KernelAvx;
+            this->ReduceStridedF32Kernel = MlasReduceStridedF32KernelAvx;
 
             //
             // Check if the processor supports AVX2/FMA3 features.
@@ -238,6 +248,7 @@ Return Value:
                 this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx2;
                 this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAvx2;
                 this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx2;
+                this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchAvx2;
                 this->ConvSymDispatch = &MlasConvSymDispatchAvx2;
 
                 this->GemmFloatKernel = MlasGemmFloatKernelFma3;
@@ -252,9 +263,22 @@ Return Value:
                 this->ErfKernelRoutine = MlasErfKernelFma3;
                 this->QLinearAddS8Kernel = MlasQLinearAddS8KernelAvx2;
                 this->QLinearAddU8Kernel = MlasQLinearAddU8KernelAvx2;
-                this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t>;
-                this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t>;
+                this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t, int8_t>;
+                this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t, uint8_t>;
+                this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
+                this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->Q4DequantizeBlocksKernel = MlasQ4DequantizeBlocksKernelAvx2;
+
+                //
+                // Check if the processor supports the F16C half precision
+                // conversion instructions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernelF16C;
+                    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernelF16C;
+                }
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -278,6 +302,7 @@ Return Value:
                 if ((Cpuid7_1[0] & 0x10) != 0) {
 
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                    this->GemmS8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
                     this->ConvSymDispatch = &MlasConvSymDispatchAvxVnni;
@@ -305,6 +330,7 @@ Return Value:
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->ReduceContiguousF32Kernel = MlasReduceContiguousF32KernelAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -315,10 +341,18 @@ Return Value:
 
                     if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
 
-                        this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
-                        this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
-                        this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
-                        this->ConvSymDispatch = &MlasConvSymDispatchAvx512Core;
+                        //
+                        // The AVX512 core kernels use vpmaddubsw. Keep the AVX-VNNI
+                        // kernels if they were selected, as signed activations are
+                        // then routed through the U8S8 kernel and rely on vpdpbusd.
+                        //
+
+                        if (this->GemmS8S8Dispatch != &MlasGemmU8S8DispatchAvx2) {
+                            this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
+                            this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
+                            this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
+                            this->ConvSymDispatch = &MlasConvSymDispatchAvx512Core;
+                        }
 
                         //
                         // Check if the processor supports AVX512VNNI.
@@ -327,6 +361,7 @@ Return Value:
                         if ((Cpuid7[2] & 0x800) != 0) {
 
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
+                            this->GemmS8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymDispatch = &MlasConvSymDispatchAvx512Vnni;
@@ -16,12 +16,12 @@ Abstract:
 
 #include "mlasi.h"
 
-template<typename FilterType>
+template<typename InputType, typename FilterType>
 void
 MLASCALL
 MlasConvDepthwiseKernel(
-    const uint8_t* const* Input,
-    uint8_t InputZeroPoint,
+    const InputType* const* Input,
+    InputType InputZeroPoint,
     const FilterType* Filter,
     FilterType FilterZeroPoint,
     int32_t* Output,
@@ -35,7 +35,7 @@ MlasConvDepthwiseKernel(
     const __m128i InputZeroPointVector = _mm_set1_epi16(InputZeroPoint);
     const __m128i FilterZeroPointVector = _mm_set1_epi16(FilterZeroPoint);
 #elif defined(MLAS_NEON_INTRINSICS)
-    const uint8x8_t InputZeroPointVector = vdup_n_u8(InputZeroPoint);
+    const uint8x8_t InputZeroPointVector = vdup_n_u8(uint8_t(InputZeroPoint));
     const uint8x8_t FilterZeroPointVector = vdup_n_u8(uint8_t(FilterZeroPoint));
 #endif
 
@@ -57,7 +57,11 @@ MlasConvDepthwiseKernel(
                 __m128i InputVector = _mm_loadl_epi64((const __m128i*)&Input[k][ChannelOffset]);
                 __m128i FilterVector = _mm_loadl_epi64((const __m128i*)&Filter[ChannelKernelOffset]);
 
-                InputVector = _mm_unpacklo_epi8(InputVector, ZeroVector);
+                if (std::is_signed<InputType>::value) {
+                    InputVector = _mm_srai_epi16(_mm_unpacklo_epi8(ZeroVector, InputVector), 8);
+                } else {
+                    InputVector = _mm_unpacklo_epi8(InputVector, ZeroVector);
+                }
 
                 if (std::is_signed<FilterType>::value) {
                     FilterVector = _mm_srai_epi16(_mm_unpacklo_epi8(ZeroVector, FilterVector), 8);
@@ -98,12 +102,18 @@ MlasConvDepthwiseKernel(
 
             for (size_t k = 0; k < KernelSize; k++) {
 
-                uint8x8_t InputVector = vld1_u8(&Input[k][ChannelOffset]);
+                uint8x8_t InputVector = vld1_u8(reinterpret_cast<const uint8_t*>(&Input[k][ChannelOffset]));
                 uint8x8_t FilterVector = vld1_u8(reinterpret_cast<const uint8_t*>(&Filter[ChannelKernelOffset]));
 
-                int16x8_t InputVector16 = vreinterpretq_s16_u16(vsubl_u8(InputVector, InputZeroPointVector));
+                int16x8_t InputVector16;
                 int16x8_t FilterVector16;
 
+                if (std::is_signed<InputType>::value) {
+                    InputVector16 = vsubl_s8(vreinterpret_s8_u8(InputVector), vreinterpret_s8_u8(InputZeroPointVector));
+                } else {
+                    InputVector16 = vreinterpretq_s16_u16(vsubl_u8(InputVector, InputZeroPointVector));
+                }
+
                 if (std::is_signed<FilterType>::value) {
                     FilterVector16 = vsubl_s8(vreinterpret_s8_u8(FilterVector), vreinterpret_s8_u8(FilterZeroPointVector));
                 } else {
@@ -183,11 +193,40 @@ MlasConvDepthwiseKernel(
     size_t KernelSize
     );
 
+template
+void
+MLASCALL
+MlasConvDepthwiseKernel(
+    const int8_t* const* Input,
+    int8_t InputZeroPoint,
+    const int8_t* Filter,
+    int8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwiseKernel(
+    const int8_t* const* Input,
+    int8_t InputZeroPoint,
+    const uint8_t* Filter,
+    uint8_t FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
     const uint8_t* const* Input,
     uint8_t InputZeroPoint,
+    bool InputIsSigned,
     const uint8_t* Filter,
     uint8_t FilterZeroPoint,
     bool FilterIsSigned,
@@ -219,6 +258,9 @@ Arguments:
 
     InputZeroPoint - Supplies the zero point offset of the input tensor.
 
+    InputIsSigned - Supplies true if the input tensor is signed data, else
+        false if the input tensor is unsigned data.
+
     Filter - Supplies the filter tensor.
 
     FilterZeroPoint - Supplies the zero point offset of the filter tensor.
@@ -242,12 +284,49 @@ Return Value:
 
 --*/
 {
-    if (FilterIsSigned) {
+    if (InputIsSigned) {
+
+        const int8_t* const* SignedInput = reinterpret_cast<const int8_t* const*>(Input);
+
+        if (FilterIsSigned) {
+
+#if defined(MLAS_TARGET_AMD64)
+            MlasPlatform.ConvDepthwiseS8S8Kernel(
+#else
+            MlasConvDepthwiseKernel<int8_t, int8_t>(
+#endif
+                SignedInput,
+                static_cast<int8_t>(InputZeroPoint),
+                reinterpret_cast<const int8_t*>(Filter),
+                static_cast<int8_t>(FilterZeroPoint),
+                Output,
+                Channels,
+                OutputCount,
+                KernelSize);
+
+        } else {
+
+#if defined(MLAS_TARGET_AMD64)
+            MlasPlatform.ConvDepthwiseS8U8Kernel(
+#else
+            MlasConvDepthwiseKernel<int8_t, uint8_t>(
+#endif
+                SignedInput,
+                static_cast<int8_t>(InputZeroPoint),
+                Filter,
+                FilterZeroPoint,
+                Output,
+                Channels,
+                OutputCount,
+                KernelSize);
+        }
+
+    } else if (FilterIsSigned) {
 
 #if defined(MLAS_TARGET_AMD64)
         MlasPlatform.ConvDepthwiseU8S8Kernel(
 #else
-        MlasConvDepthwiseKernel<int8_t>(
+        MlasConvDepthwiseKernel<uint8_t, int8_t>(
 #endif
             Input,
             InputZeroPoint,
@@ -263,7 +342,7 @@ Return Value:
 #if defined(MLAS_TARGET_AMD64)
         MlasPlatform.ConvDepthwiseU8U8Kernel(
 #else
-        MlasConvDepthwiseKernel<uint8_t>(
+        MlasConvDepthwiseKernel<uint8_t, uint8_t>(
 #endif
             Input,
             InputZeroPoint,
@@ -96,7 +96,7 @@ Return Value:
     // Dispatch the partitioned operation.
     //
 
-    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(Shape->BIsSigned);
+    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(Shape->AIsSigned, Shape->BIsSigned);
     MLAS_GEMM_U8X8_OPERATION* GemmU8X8Operation;
 
     if (Data->BIsPacked) {
@@ -141,17 +141,40 @@ Return Value:
 }
 
 void
-MLASCALL
-MlasGemmBatch(
-    const MLAS_GEMM_U8X8_SHAPE_PARAMS& Shape,
-    const MLAS_GEMM_U8X8_DATA_PARAMS* DataParams,
-    const size_t BatchN,
-    MLAS_THREADPOOL* ThreadPool)
-{
-    const size_t M = Shape.M;
-    const size_t N = Shape.N;
-    const size_t K = Shape.K;
+MlasGemmU8X8ThreadPartition(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the default thread partitioning of each operation in
+    a batch of QGEMM operations.
+
+Arguments:
+
+    M, N, K - Supplies the shape of the multiplication
+
+    BatchN - Supplies the number of multiplications in the batch.
+
+    MaximumThreadCount - Supplies the degree of parallelism of the thread pool.
+
+    ThreadCountM - Receives the total thread partition on the M dimension.
 
+    ThreadCountN - Receives the total thread partition on the N dimension.
+
+Return Value:
+
+    None.
+
+--*/
+{
     //
     // Compute the number of target threads given the complexity of the SGEMM
     // operation. Small requests should run using the single threaded path.
@@ -167,8 +190,6 @@ MlasGemmBatch(
         TargetThreadCount = MlasPlatform.MaximumThreadCount;
     }
 
-    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
-
     if (TargetThreadCount >= MaximumThreadCount) {
         TargetThreadCount = MaximumThreadCount;
     }
@@ -185,8 +206,6 @@ MlasGemmBatch(
     // works okay for operations involving skinny matrices.
     //
 
-    MLAS_GEMM_U8X8_WORK_BLOCK WorkBlock;
-
     if (N > M) {
 
         const size_t BlockedN = (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) /
@@ -196,8 +215,8 @@ MlasGemmBatch(
             ThreadsPerGemm = ptrdiff_t(BlockedN);
         }
 
-        WorkBlock.ThreadCountM = 1;
-        WorkBlock.ThreadCountN = ThreadsPerGemm;
+        *ThreadCountM = 1;
+        *ThreadCountN = ThreadsPerGemm;
 
     } else {
 
@@ -205,10 +224,87 @@ MlasGemmBatch(
             ThreadsPerGemm = ptrdiff_t(M);
         }
 
-        WorkBlock.ThreadCountM = ThreadsPerGemm;
-        WorkBlock.ThreadCountN = 1;
+        *ThreadCountM = ThreadsPerGemm;
+        *ThreadCountN = 1;
     }
-    TargetThreadCount = ThreadsPerGemm * BatchN;
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    const MLAS_GEMM_U8X8_SHAPE_PARAMS& Shape,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* DataParams,
+    const size_t BatchN,
+    MLAS_THREADPOOL* ThreadPool)
+{
+    const size_t M = Shape.M;
+    const size_t N = Shape.N;
+    const size_t K = Shape.K;
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    //
+    // Prefer a measured partitioning for this shape if one has been recorded,
+    // else fall back to the complexity heuristic.
+    //
+
+    if (!MlasGemmTuningLookup(MlasGemmTuningQgemm, M, N, K, BatchN,
+            MaximumThreadCount, &ThreadCountM, &ThreadCountN)) {
+        MlasGemmU8X8ThreadPartition(M, N, K, BatchN, MaximumThreadCount,
+            &ThreadCountM, &ThreadCountN);
+    }
+
+    MlasGemmU8X8BatchPartitioned(Shape, DataParams, BatchN, ThreadCountM,
+        ThreadCountN, ThreadPool);
+}
+
+void
+MlasGemmU8X8BatchPartitioned(
+    const MLAS_GEMM_U8X8_SHAPE_PARAMS& Shape,
+    const MLAS_GEMM_U8X8_DATA_PARAMS* DataParams,
+    size_t BatchN,
+    ptrdiff_t ThreadCountM,
+    ptrdiff_t ThreadCountN,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a batch of QGEMM operations using the supplied
+    thread partitioning of each operation.
+
+Arguments:
+
+    Shape - Supplies the structure containing the GEMM input and output shapes.
+
+    DataParams - Supplies the array of GEMM input and output data layouts.
+
+    BatchN - Supplies the number of multiplications in the batch.
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_GEMM_U8X8_WORK_BLOCK WorkBlock;
+
+    WorkBlock.ThreadCountM = ThreadCountM;
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    const ptrdiff_t ThreadsPerGemm = ThreadCountM * ThreadCountN;
+    const ptrdiff_t TargetThreadCount = ThreadsPerGemm * ptrdiff_t(BatchN);
 
     MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
         const auto gemm_i = tid / ThreadsPerGemm;
@@ -223,6 +319,7 @@ MLASCALL
 MlasGemmPackBSize(
     size_t N,
     size_t K,
+    bool AIsSigned,
     bool BIsSigned
     )
 /*++
@@ -238,6 +335,10 @@ Arguments:
 
     K - Supplies the the number of rows of matrix B.
 
+    AIsSigned - Supplies true if the matrix A that is multiplied with the packed
+        matrix is signed data, else false if matrix A is unsigned data. The
+        packed format depends on the kernel selected for the pair of types.
+
     BIsSigned - Supplies true if matrix B is signed data, else false if matrix
         B is unsigned data.
 
@@ -252,7 +353,7 @@ Return Value:
     // Retrieve the packing parameters.
     //
 
-    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(BIsSigned);
+    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(AIsSigned, BIsSigned);
 
     size_t PackedK = GemmU8X8Dispatch->PackedK;
     size_t PackedStrideK = GemmU8X8Dispatch->PackedStrideK;
@@ -285,6 +386,7 @@ MlasGemmPackB(
     size_t K,
     const uint8_t* B,
     size_t ldb,
+    bool AIsSigned,
     bool BIsSigned,
     void* PackedB
     )
@@ -305,6 +407,10 @@ Arguments:
 
     ldb - Supplies the first dimension of matrix B.
 
+    AIsSigned - Supplies true if the matrix A that is multiplied with the packed
+        matrix is signed data, else false if matrix A is unsigned data. The
+        packed format depends on the kernel selected for the pair of types.
+
     BIsSigned - Supplies true if matrix B is signed data, else false if matrix
         B is unsigned data.
 
@@ -320,7 +426,7 @@ Return Value:
     // Retrieve the packing parameters.
     //
 
-    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(BIsSigned);
+    const auto* GemmU8X8Dispatch = MlasGemmU8X8GetDispatch(AIsSigned, BIsSigned);
 
     size_t PackedK = GemmU8X8Dispatch->PackedK;
     size_t PackedStrideK = GemmU8X8Dispatch->PackedStrideK;
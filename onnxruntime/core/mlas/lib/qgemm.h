@@ -19,7 +19,8 @@ Abstract:
         MlasGemmU8X8CopyPackA
         MlasGemmU8X8CopyPackB
         MlasGemmU8X8Kernel
-    Specialization of MlasGemmU8X8TryGemvKernel is optional.
+    Specialization of MlasGemmU8X8TryGemvKernel, MlasGemmS8X8FixupZeroPointA
+    and MlasGemmS8X8CopyPackA is optional.
 
     MlasGemmU8X8Operation and MlasGemmU8X8PackedOperation are shared kernel drivers.
     MlasGemmU8X8ScaleSumBuffer is a helper function.
@@ -74,6 +75,18 @@ MlasGemmU8X8FixupZeroPointA(int32_t ZeroPointA)
     return ZeroPointA;
 }
 
+template <typename KernelType>
+MLAS_FORCEINLINE int32_t
+MlasGemmS8X8FixupZeroPointA(int32_t ZeroPointA)
+{
+    //
+    // Bias the zero point offset of a signed matrix A to match the unsigned
+    // data produced by the default MlasGemmS8X8CopyPackA.
+    //
+
+    return int32_t(int8_t(ZeroPointA)) + 0x80;
+}
+
 template<typename KernelType>
 int32_t
 MlasGemmU8X8FixupZeroPointB(
@@ -129,6 +142,85 @@ MlasGemmU8X8CopyPackA(
     int32_t* RowSumBuffer
 );
 
+template<typename KernelType>
+void
+MlasGemmS8X8CopyPackA(
+    typename KernelType::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer for a signed matrix A.
+
+    The sign bit of each element is flipped to bias the signed values to
+    unsigned values, so that the panel is consumed by the unsigned matrix A
+    path of the kernel. The caller biases the zero point offset of matrix A by
+    the same amount, so the result is unchanged.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    RowSumBuffer - Supplies the address of the buffer to receive the sums of
+        the elements along each of the rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(uint8_t BiasedA[4096], 64);
+
+    const size_t PackedCountK = (CountK + KernelType::PackedK - 1) / KernelType::PackedK;
+
+    //
+    // Some kernels interleave groups of rows in the packed buffer, so each pass
+    // must start on a multiple of eight rows. The stride K of every kernel is
+    // small enough that the staging buffer always holds eight rows.
+    //
+
+    const size_t RowsPerPass = (sizeof(BiasedA) / CountK) & ~size_t(7);
+
+    while (CountM > 0) {
+
+        const size_t RowsThisPass = std::min(CountM, RowsPerPass);
+
+        for (size_t m = 0; m < RowsThisPass; m++) {
+
+            const uint8_t* a = A + m * lda;
+            uint8_t* b = BiasedA + m * CountK;
+
+            for (size_t k = 0; k < CountK; k++) {
+                b[k] = uint8_t(a[k] ^ 0x80);
+            }
+        }
+
+        MlasGemmU8X8CopyPackA<KernelType>(D, BiasedA, CountK, RowsThisPass,
+            CountK, RowSumBuffer);
+
+        A += lda * RowsThisPass;
+        D += KernelType::PackedK * PackedCountK * RowsThisPass;
+        RowSumBuffer += RowsThisPass;
+        CountM -= RowsThisPass;
+    }
+}
+
 template<typename KernelType>
 void
 MlasGemmU8X8CopyPackB(
@@ -251,7 +343,7 @@ Return Value:
     // Try to use a GEMV kernel if supported by this kernel type.
     //
 
-    if ((RangeCountM == 1) &&
+    if ((RangeCountM == 1) && !Shape->AIsSigned &&
         (ZeroPointA == 0) && (PackedZeroPointB == nullptr) && (ZeroPointB == 0) &&
         (Data->OutputProcessor == nullptr)) {
         if (MlasGemmU8X8TryGemvKernel<KernelType>(A, B, ldb, C, K, RangeCountN, Shape->BIsSigned)) {
@@ -259,6 +351,15 @@ Return Value:
         }
     }
 
+    //
+    // Adjust the zero point offset of a signed matrix A to match the data
+    // produced by MlasGemmS8X8CopyPackA.
+    //
+
+    if (Shape->AIsSigned) {
+        ZeroPointA = MlasGemmS8X8FixupZeroPointA<KernelType>(ZeroPointA);
+    }
+
     //
     // Fixup the sign bit of the per-matrix zero point offset of matrix A if the
     // kernel requires signed data.
@@ -339,13 +440,23 @@ Return Value:
                 // Copy a panel of matrix A to a local packed buffer.
                 //
 
-                MlasGemmU8X8CopyPackA<KernelType>(
-                    PanelA,
-                    A + m * lda,
-                    lda,
-                    CountM,
-                    CountK,
-                    RowSumBuffer);
+                if (Shape->AIsSigned) {
+                    MlasGemmS8X8CopyPackA<KernelType>(
+                        PanelA,
+                        A + m * lda,
+                        lda,
+                        CountM,
+                        CountK,
+                        RowSumBuffer);
+                } else {
+                    MlasGemmU8X8CopyPackA<KernelType>(
+                        PanelA,
+                        A + m * lda,
+                        lda,
+                        CountM,
+                        CountK,
+                        RowSumBuffer);
+                }
 
                 //
                 // Apply the global depth value constant without the ZeroPointB scaling from:
@@ -480,6 +591,15 @@ Return Value:
     int32_t ZeroPointA = Data->ZeroPointA;
     int32_t ZeroPointB = typename KernelType::OffsetBType(*Data->ZeroPointB);
 
+    //
+    // Adjust the zero point offset of a signed matrix A to match the data
+    // produced by MlasGemmS8X8CopyPackA.
+    //
+
+    if (Shape->AIsSigned) {
+        ZeroPointA = MlasGemmS8X8FixupZeroPointA<KernelType>(ZeroPointA);
+    }
+
     //
     // Fixup the sign bit of the per-matrix zero point offset of matrix A if the
     // kernel requires signed data.
@@ -566,13 +686,23 @@ Return Value:
                 // Copy a panel of matrix A to a local packed buffer.
                 //
 
-                MlasGemmU8X8CopyPackA<KernelType>(
-                    PanelA,
-                    A + m * lda,
-                    lda,
-                    CountM,
-                    CountK,
-                    RowSumBuffer);
+                if (Shape->AIsSigned) {
+                    MlasGemmS8X8CopyPackA<KernelType>(
+                        PanelA,
+                        A + m * lda,
+                        lda,
+                        CountM,
+                        CountK,
+                        RowSumBuffer);
+                } else {
+                    MlasGemmU8X8CopyPackA<KernelType>(
+                        PanelA,
+                        A + m * lda,
+                        lda,
+                        CountM,
+                        CountK,
+                        RowSumBuffer);
+                }
 
                 //
                 // Apply the global depth value constant without the ZeroPointB scaling from:
@@ -686,15 +816,20 @@ struct MLAS_GEMM_U8X8_DISPATCH {
 MLAS_FORCEINLINE
 const MLAS_GEMM_U8X8_DISPATCH*
 MlasGemmU8X8GetDispatch(
+    bool AIsSigned,
     bool BIsSigned
 )
 {
     const MLAS_GEMM_U8X8_DISPATCH* GemmU8X8Dispatch;
 
+    MLAS_UNREFERENCED_PARAMETER(AIsSigned);
     MLAS_UNREFERENCED_PARAMETER(BIsSigned);
 
 #if defined(MLAS_TARGET_AMD64_IX86)
-    if (BIsSigned) {
+    if (AIsSigned && BIsSigned) {
+        GemmU8X8Dispatch = MlasPlatform.GemmS8S8Dispatch;
+    }
+    else if (BIsSigned) {
         GemmU8X8Dispatch = MlasPlatform.GemmU8S8Dispatch;
     }
     else {
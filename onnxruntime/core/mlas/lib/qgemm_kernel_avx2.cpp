@@ -142,6 +142,21 @@ MlasGemmU8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_AVX2>(
     MlasGemmU8S8CopyPackAAvx2(D, A, lda, CountM, CountK, RowSumBuffer);
 }
 
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmS8X8CopyPackA<MLAS_GEMM_U8S8_KERNEL_AVX2>(
+    MLAS_GEMM_U8S8_KERNEL_AVX2::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    MlasGemmS8X8CopyPackAAvx2(D, A, lda, CountM, CountK, RowSumBuffer);
+}
+
 template<>
 MLAS_FORCEINLINE
 void
@@ -264,3 +279,112 @@ const MLAS_GEMM_U8X8_DISPATCH MlasGemmU8U8DispatchAvx2 = {
     MLAS_GEMM_U8U8_KERNEL_AVX2::PackedK,
     MLAS_GEMM_U8U8_KERNEL_AVX2::PackedStrides.K,
 };
+
+//
+// The S8S8 kernel sign extends both matrices to 16-bit values, so that the
+// products do not saturate as with the vpmaddubsw based U8S8 kernel when the
+// biased matrix A is multiplied with the full range of matrix B. The kernel is
+// only selected when matrix B is signed.
+//
+
+struct MLAS_GEMM_S8S8_KERNEL_AVX2
+{
+    typedef int16_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef int8_t OffsetBType;
+
+    static constexpr size_t PackedK = 2;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{ 24, 256, 128 };
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{ 48, 256, 384 };
+};
+
+constexpr size_t MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_AVX2::Strides;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_S8S8_KERNEL_AVX2::PackedStrides;
+
+template<>
+MLAS_FORCEINLINE
+int32_t
+MlasGemmS8X8FixupZeroPointA<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    int32_t ZeroPointA
+    )
+{
+    return int32_t(int8_t(ZeroPointA));
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8CopyPackA<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    MlasGemmS8S8CopyPackAAvx2(D, A, lda, CountM, CountK, RowSumBuffer, false);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmS8X8CopyPackA<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedAType* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    MlasGemmS8S8CopyPackAAvx2(D, A, lda, CountM, CountK, RowSumBuffer, true);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedBType* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+
+    MlasGemmS8S8CopyPackBAvx2(D, B, ldb, CountN, CountK, ColumnSumBuffer);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasGemmU8X8Kernel<MLAS_GEMM_S8S8_KERNEL_AVX2>(
+    const MLAS_GEMM_S8S8_KERNEL_AVX2::PackedAType* A,
+    const MLAS_GEMM_S8S8_KERNEL_AVX2::PackedBType* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+{
+    return MlasGemmS8S8KernelAvx2(A, B, C, PackedCountK, CountM, CountN, ldc,
+                                  RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode);
+}
+
+const MLAS_GEMM_U8X8_DISPATCH MlasGemmS8S8DispatchAvx2 = {
+    MlasGemmU8X8Operation<MLAS_GEMM_S8S8_KERNEL_AVX2>,
+    MlasGemmU8X8PackedOperation<MLAS_GEMM_S8S8_KERNEL_AVX2>,
+    MlasGemmU8X8CopyPackB<MLAS_GEMM_S8S8_KERNEL_AVX2>,
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_AVX2::PackedStrides.K,
+};
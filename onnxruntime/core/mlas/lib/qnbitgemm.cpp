@@ -0,0 +1,473 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qnbitgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with n-bit block quantized weights (QNBitGemm).
+
+    Matrix B is quantized along the K dimension in blocks of BlkLen elements,
+    each with its own scale and zero point. The packed format stores every
+    column of matrix B as a contiguous run of blocks, where each block holds
+    its scale and zero point followed by the quantized elements:
+
+        [float Scale][float ZeroPoint][BlkLen * BlkBitWidth / 8 bytes]
+
+    The operation dequantizes a cache sized tile of matrix B at a time and
+    multiplies it with the single precision kernels, so the weights are never
+    expanded in memory.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+size_t
+MlasQNBitBlkDataSize(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+{
+    return BlkLen * BlkBitWidth / 8;
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasQNBitPackedBlkSize(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+{
+    return MLAS_QNBIT_BLK_HEADER_SIZE + MlasQNBitBlkDataSize(BlkBitWidth, BlkLen);
+}
+
+bool
+MLASCALL
+MlasIsQNBitGemmAvailable(
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+{
+    if (BlkBitWidth != 4 && BlkBitWidth != 8) {
+        return false;
+    }
+
+    //
+    // The block length must evenly divide the K stride of the dequantized
+    // tile so that a tile never starts in the middle of a block.
+    //
+
+    return BlkLen >= 16 && BlkLen <= MLAS_QNBIT_GEMM_STRIDEK && (BlkLen & (BlkLen - 1)) == 0;
+}
+
+size_t
+MLASCALL
+MlasQNBitGemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen
+    )
+{
+    if (!MlasIsQNBitGemmAvailable(BlkBitWidth, BlkLen)) {
+        return 0;
+    }
+
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+
+    return N * BlockCountK * MlasQNBitPackedBlkSize(BlkBitWidth, BlkLen);
+}
+
+void
+MLASCALL
+MlasQNBitGemmPackB(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the block quantized matrix B, interleaving the block
+    scales and zero points with the quantized elements.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BlkBitWidth - Supplies the number of bits per quantized element.
+
+    BlkLen - Supplies the number of elements per quantization block.
+
+    QuantBData - Supplies the quantized elements of matrix B.
+
+    QuantBScale - Supplies the block scales.
+
+    QuantBZeroPoint - Optionally supplies the block zero points.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = MlasQNBitBlkDataSize(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = (BlockCountK * BlkBitWidth + 7) / 8;
+    const float DefaultZeroPoint = float(1 << (BlkBitWidth - 1));
+
+    uint8_t* Packed = reinterpret_cast<uint8_t*>(PackedB);
+
+    for (size_t n = 0; n < N; n++) {
+
+        for (size_t b = 0; b < BlockCountK; b++) {
+
+            float ZeroPoint = DefaultZeroPoint;
+
+            if (QuantBZeroPoint != nullptr) {
+
+                const uint8_t* ZeroPointRow = QuantBZeroPoint + n * ZeroPointStride;
+
+                if (BlkBitWidth == 4) {
+                    const uint8_t PackedZeroPoints = ZeroPointRow[b / 2];
+                    ZeroPoint = float((b & 1) ? (PackedZeroPoints >> 4) : (PackedZeroPoints & 0x0F));
+                } else {
+                    ZeroPoint = float(ZeroPointRow[b]);
+                }
+            }
+
+            float* Header = reinterpret_cast<float*>(Packed);
+            Header[0] = QuantBScale[n * BlockCountK + b];
+            Header[1] = ZeroPoint;
+
+            std::copy_n(QuantBData + (n * BlockCountK + b) * BlkDataSize, BlkDataSize,
+                Packed + MLAS_QNBIT_BLK_HEADER_SIZE);
+
+            Packed += MLAS_QNBIT_BLK_HEADER_SIZE + BlkDataSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4DequantizeBlocksKernel(
+    const uint8_t* PackedB,
+    float* Destination,
+    size_t BlockCount,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a run of packed 4-bit blocks from one column of
+    matrix B.
+
+Arguments:
+
+    PackedB - Supplies the address of the first packed block.
+
+    Destination - Supplies the buffer that receives BlockCount * BlkLen
+        single precision values.
+
+    BlockCount - Supplies the number of blocks to dequantize.
+
+    BlkLen - Supplies the number of elements per quantization block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSize(4, BlkLen);
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const float* Header = reinterpret_cast<const float*>(PackedB);
+        const float Scale = Header[0];
+        const float ZeroPoint = Header[1];
+        const uint8_t* Data = PackedB + MLAS_QNBIT_BLK_HEADER_SIZE;
+
+        for (size_t i = 0; i < BlkDataSize; i++) {
+            const uint8_t Value = Data[i];
+            Destination[i * 2] = (float(Value & 0x0F) - ZeroPoint) * Scale;
+            Destination[i * 2 + 1] = (float(Value >> 4) - ZeroPoint) * Scale;
+        }
+
+        PackedB += MLAS_QNBIT_BLK_HEADER_SIZE + BlkDataSize;
+        Destination += BlkLen;
+    }
+}
+
+void
+MLASCALL
+MlasQ8DequantizeBlocksKernel(
+    const uint8_t* PackedB,
+    float* Destination,
+    size_t BlockCount,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a run of packed 8-bit blocks from one column of
+    matrix B.
+
+Arguments:
+
+    PackedB - Supplies the address of the first packed block.
+
+    Destination - Supplies the buffer that receives BlockCount * BlkLen
+        single precision values.
+
+    BlockCount - Supplies the number of blocks to dequantize.
+
+    BlkLen - Supplies the number of elements per quantization block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const float* Header = reinterpret_cast<const float*>(PackedB);
+        const float Scale = Header[0];
+        const float ZeroPoint = Header[1];
+        const uint8_t* Data = PackedB + MLAS_QNBIT_BLK_HEADER_SIZE;
+
+        for (size_t i = 0; i < BlkLen; i++) {
+            Destination[i] = (float(Data[i]) - ZeroPoint) * Scale;
+        }
+
+        PackedB += MLAS_QNBIT_BLK_HEADER_SIZE + BlkLen;
+        Destination += BlkLen;
+    }
+}
+
+void
+MlasQNBitGemmOperation(
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS* Data
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a segment of the n-bit block quantized
+    matrix/matrix multiply operation.
+
+Arguments:
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    BlkBitWidth - Supplies the number of bits per quantized element.
+
+    BlkLen - Supplies the number of elements per quantization block.
+
+    RangeStartM - Supplies the first row of matrix C to compute.
+
+    RangeCountM - Supplies the number of rows of matrix C to compute.
+
+    RangeStartN - Supplies the first column of matrix C to compute.
+
+    RangeCountN - Supplies the number of columns of matrix C to compute.
+
+    Data - Supplies the matrices data parameters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_QNBIT_GEMM_STRIDEN * MLAS_QNBIT_GEMM_STRIDEK], 16 * sizeof(float));
+
+    MLAS_QNBIT_DEQUANTIZE_BLOCKS_KERNEL* DequantizeBlocks;
+
+    if (BlkBitWidth == 4) {
+#if defined(MLAS_TARGET_AMD64)
+        DequantizeBlocks = MlasPlatform.Q4DequantizeBlocksKernel;
+#else
+        DequantizeBlocks = MlasQ4DequantizeBlocksKernel;
+#endif
+    } else {
+        DequantizeBlocks = MlasQ8DequantizeBlocksKernel;
+    }
+
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t PackedBlkSize = MlasQNBitPackedBlkSize(BlkBitWidth, BlkLen);
+    const size_t PackedColumnSize = BlockCountK * PackedBlkSize;
+
+    const float* A = Data->A + RangeStartM * Data->lda;
+    const uint8_t* PackedB = reinterpret_cast<const uint8_t*>(Data->PackedB);
+    float* C = Data->C + RangeStartM * Data->ldc;
+    const size_t lda = Data->lda;
+    const size_t ldc = Data->ldc;
+
+    if (K == 0) {
+        for (size_t m = 0; m < RangeCountM; m++) {
+            std::fill_n(C + m * ldc + RangeStartN, RangeCountN, 0.0f);
+        }
+        return;
+    }
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_QNBIT_GEMM_STRIDEN));
+        const size_t StartN = RangeStartN + n;
+
+        size_t CountK;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_QNBIT_GEMM_STRIDEK));
+
+            //
+            // Dequantize whole blocks of each column into the panel. The last
+            // block of a column may extend past K, so the panel rows are
+            // padded to a multiple of the block length.
+            //
+
+            const size_t BlockCount = (CountK + BlkLen - 1) / BlkLen;
+            const size_t PanelStrideB = BlockCount * BlkLen;
+            const uint8_t* b = PackedB + StartN * PackedColumnSize + (k / BlkLen) * PackedBlkSize;
+
+            for (size_t nn = 0; nn < CountN; nn++) {
+                DequantizeBlocks(b, PanelB + nn * PanelStrideB, BlockCount, BlkLen);
+                b += PackedColumnSize;
+            }
+
+            MlasSgemmOperation(CblasNoTrans, CblasTrans, RangeCountM, CountN, CountK, 1.0f,
+                A + k, lda, PanelB, PanelStrideB, (k == 0) ? 0.0f : 1.0f, C + StartN, ldc);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQNBitGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_QNBIT_GEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QNBIT_GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Each thread dequantizes the columns of matrix B that it owns, so prefer
+    // to partition along N. Only partition along M when there are too few
+    // columns to keep the threads busy, which repeats the dequantization.
+    //
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (size_t(ThreadsPerGemm) <= BlockedN || BlockedN >= M) {
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        const ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        const ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        const ptrdiff_t ThreadIdM = ThreadIdx / ThreadCountN;
+        const ptrdiff_t ThreadIdN = ThreadIdx % ThreadCountN;
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+
+        MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+        size_t RangeStartN;
+        size_t RangeCountN;
+
+        MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN, &RangeCountN);
+
+        RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+        RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+        MlasQNBitGemmOperation(K, BlkBitWidth, BlkLen, RangeStartM, RangeCountM,
+            RangeStartN, RangeCountN, &Data[GemmIdx]);
+    });
+}
@@ -885,6 +885,60 @@ MlasRequantizeOutput(
 
 #endif
 
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    int8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerColumnScale,
+    int8_t ZeroPoint,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes the intermediate buffer to a signed output buffer.
+
+    The output is produced by the unsigned implementation with the zero point
+    biased by 128, which yields the same values as the signed result with the
+    sign bit flipped. The sign bit of the output block is then flipped back.
+
+Arguments:
+
+    See the unsigned variant of this routine.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    uint8_t* UnsignedOutput = reinterpret_cast<uint8_t*>(Output);
+
+    MlasRequantizeOutput(Input, InputLeadingDimension, UnsignedOutput, OutputLeadingDimension,
+                         Bias, Scale, PerColumnScale, uint8_t(ZeroPoint ^ 0x80),
+                         StartM, StartN, CountM, CountN);
+
+    UnsignedOutput += StartM * OutputLeadingDimension + StartN;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        for (size_t n = 0; n < CountN; n++) {
+            UnsignedOutput[n] ^= 0x80;
+        }
+
+        UnsignedOutput += OutputLeadingDimension;
+    }
+}
+
 void
 MLASCALL
 MlasFindMinMaxElement(
@@ -0,0 +1,410 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce a buffer of single precision
+    floating point values along a contiguous or a strided axis.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the vector and scalar operations used by the generic kernels.
+//
+
+template<MLAS_REDUCE_OPERATION Operation>
+struct MLAS_REDUCE_F32;
+
+template<>
+struct MLAS_REDUCE_F32<MlasReduceSum>
+{
+    static constexpr float InitialValue() { return 0.0f; }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasAddFloat32x4(a, b); }
+
+    static MLAS_FORCEINLINE float Reduce(float a, float b) { return a + b; }
+
+    static MLAS_FORCEINLINE float ReduceVector(MLAS_FLOAT32X4 a) { return MlasReduceAddFloat32x4(a); }
+};
+
+template<>
+struct MLAS_REDUCE_F32<MlasReduceMaximum>
+{
+    static constexpr float InitialValue() { return -std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMaximumFloat32x4(a, b); }
+
+    static MLAS_FORCEINLINE float Reduce(float a, float b) { return std::max(a, b); }
+
+    static MLAS_FORCEINLINE float ReduceVector(MLAS_FLOAT32X4 a) { return MlasReduceMaximumFloat32x4(a); }
+};
+
+template<>
+struct MLAS_REDUCE_F32<MlasReduceMinimum>
+{
+    static constexpr float InitialValue() { return std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FORCEINLINE MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 a, MLAS_FLOAT32X4 b) { return MlasMinimumFloat32x4(a, b); }
+
+    static MLAS_FORCEINLINE float Reduce(float a, float b) { return std::min(a, b); }
+
+    static MLAS_FORCEINLINE float ReduceVector(MLAS_FLOAT32X4 a) { return MlasReduceMinimumFloat32x4(a); }
+};
+
+template<MLAS_REDUCE_OPERATION Operation>
+float
+MlasReduceContiguousF32KernelImpl(
+    const float* Input,
+    size_t N
+    )
+{
+    using Reducer = MLAS_REDUCE_F32<Operation>;
+
+    float Accumulator = Reducer::InitialValue();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 AccumulatorVector0 = MlasBroadcastFloat32x4(Accumulator);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 AccumulatorVector1 = AccumulatorVector0;
+            MLAS_FLOAT32X4 AccumulatorVector2 = AccumulatorVector0;
+            MLAS_FLOAT32X4 AccumulatorVector3 = AccumulatorVector0;
+
+            while (N >= 16) {
+
+                AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, MlasLoadFloat32x4(Input));
+                AccumulatorVector1 = Reducer::Reduce(AccumulatorVector1, MlasLoadFloat32x4(Input + 4));
+                AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, MlasLoadFloat32x4(Input + 8));
+                AccumulatorVector3 = Reducer::Reduce(AccumulatorVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, AccumulatorVector1);
+            AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, AccumulatorVector3);
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, AccumulatorVector2);
+        }
+
+        while (N >= 4) {
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Accumulator = Reducer::ReduceVector(AccumulatorVector0);
+    }
+
+    while (N > 0) {
+
+        Accumulator = Reducer::Reduce(Accumulator, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+template<MLAS_REDUCE_OPERATION Operation>
+void
+MlasReduceContiguousF32KernelRows(
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+{
+    for (size_t r = 0; r < Rows; r++) {
+        Output[r] = MlasReduceContiguousF32KernelImpl<Operation>(Input, ReduceCount);
+        Input += ReduceCount;
+    }
+}
+
+void
+MLASCALL
+MlasReduceContiguousF32Kernel(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to reduce each row of a matrix
+    to a single value.
+
+Arguments:
+
+    Operation - Supplies the reduction operation.
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output buffer with Rows elements.
+
+    Rows - Supplies the number of rows to process.
+
+    ReduceCount - Supplies the number of elements to reduce in each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Operation) {
+        case MlasReduceSum:
+            MlasReduceContiguousF32KernelRows<MlasReduceSum>(Input, Output, Rows, ReduceCount);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceContiguousF32KernelRows<MlasReduceMaximum>(Input, Output, Rows, ReduceCount);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceContiguousF32KernelRows<MlasReduceMinimum>(Input, Output, Rows, ReduceCount);
+            break;
+    }
+}
+
+template<MLAS_REDUCE_OPERATION Operation>
+void
+MlasReduceStridedF32KernelImpl(
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    )
+{
+    using Reducer = MLAS_REDUCE_F32<Operation>;
+
+    //
+    // Keep a block of output columns in registers while walking down the
+    // reduced rows, so that each output element is stored once.
+    //
+
+    while (Columns >= 16) {
+
+        const float* input = Input;
+
+        MLAS_FLOAT32X4 AccumulatorVector0 = MlasLoadFloat32x4(input);
+        MLAS_FLOAT32X4 AccumulatorVector1 = MlasLoadFloat32x4(input + 4);
+        MLAS_FLOAT32X4 AccumulatorVector2 = MlasLoadFloat32x4(input + 8);
+        MLAS_FLOAT32X4 AccumulatorVector3 = MlasLoadFloat32x4(input + 12);
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+
+            input += InputStride;
+
+            AccumulatorVector0 = Reducer::Reduce(AccumulatorVector0, MlasLoadFloat32x4(input));
+            AccumulatorVector1 = Reducer::Reduce(AccumulatorVector1, MlasLoadFloat32x4(input + 4));
+            AccumulatorVector2 = Reducer::Reduce(AccumulatorVector2, MlasLoadFloat32x4(input + 8));
+            AccumulatorVector3 = Reducer::Reduce(AccumulatorVector3, MlasLoadFloat32x4(input + 12));
+        }
+
+        MlasStoreFloat32x4(Output, AccumulatorVector0);
+        MlasStoreFloat32x4(Output + 4, AccumulatorVector1);
+        MlasStoreFloat32x4(Output + 8, AccumulatorVector2);
+        MlasStoreFloat32x4(Output + 12, AccumulatorVector3);
+
+        Input += 16;
+        Output += 16;
+        Columns -= 16;
+    }
+
+    while (Columns >= 4) {
+
+        const float* input = Input;
+
+        MLAS_FLOAT32X4 AccumulatorVector = MlasLoadFloat32x4(input);
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+            input += InputStride;
+            AccumulatorVector = Reducer::Reduce(AccumulatorVector, MlasLoadFloat32x4(input));
+        }
+
+        MlasStoreFloat32x4(Output, AccumulatorVector);
+
+        Input += 4;
+        Output += 4;
+        Columns -= 4;
+    }
+
+    while (Columns > 0) {
+
+        const float* input = Input;
+
+        float Accumulator = *input;
+
+        for (size_t r = 1; r < ReduceCount; r++) {
+            input += InputStride;
+            Accumulator = Reducer::Reduce(Accumulator, *input);
+        }
+
+        *Output = Accumulator;
+
+        Input += 1;
+        Output += 1;
+        Columns -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasReduceStridedF32Kernel(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to reduce the rows of a matrix
+    to a single row.
+
+Arguments:
+
+    Operation - Supplies the reduction operation.
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output row.
+
+    ReduceCount - Supplies the number of rows to reduce. This must be at
+        least one.
+
+    Columns - Supplies the number of columns to process.
+
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Operation) {
+        case MlasReduceSum:
+            MlasReduceStridedF32KernelImpl<MlasReduceSum>(Input, Output, ReduceCount, Columns, InputStride);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceStridedF32KernelImpl<MlasReduceMaximum>(Input, Output, ReduceCount, Columns, InputStride);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceStridedF32KernelImpl<MlasReduceMinimum>(Input, Output, ReduceCount, Columns, InputStride);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasReduceContiguous(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t Rows,
+    size_t ReduceCount
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each row of the input matrix to a single value, that
+    is the reduced axis is the innermost contiguous axis.
+
+Arguments:
+
+    Operation - Supplies the reduction operation.
+
+    Input - Supplies the input matrix with Rows x ReduceCount elements.
+
+    Output - Supplies the output buffer with Rows elements.
+
+    Rows - Supplies the number of rows to process.
+
+    ReduceCount - Supplies the number of elements to reduce in each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ReduceContiguousF32Kernel(Operation, Input, Output, Rows, ReduceCount);
+#else
+    MlasReduceContiguousF32Kernel(Operation, Input, Output, Rows, ReduceCount);
+#endif
+}
+
+void
+MLASCALL
+MlasReduceStrided(
+    MLAS_REDUCE_OPERATION Operation,
+    const float* Input,
+    float* Output,
+    size_t ReduceCount,
+    size_t Columns,
+    size_t InputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the rows of the input matrix to a single row, that is
+    the reduced axis is strided and the kept axis is contiguous.
+
+Arguments:
+
+    Operation - Supplies the reduction operation.
+
+    Input - Supplies the input matrix with ReduceCount rows.
+
+    Output - Supplies the output buffer with Columns elements.
+
+    ReduceCount - Supplies the number of rows to reduce.
+
+    Columns - Supplies the number of columns to process.
+
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (ReduceCount == 0) {
+        float InitialValue = (Operation == MlasReduceSum) ? 0.0f :
+            (Operation == MlasReduceMaximum) ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity();
+        std::fill_n(Output, Columns, InitialValue);
+        return;
+    }
+
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ReduceStridedF32Kernel(Operation, Input, Output, ReduceCount, Columns, InputStride);
+#else
+    MlasReduceStridedF32Kernel(Operation, Input, Output, ReduceCount, Columns, InputStride);
+#endif
+}
@@ -1554,17 +1554,39 @@ Return Value:
 }
 
 void
-MLASCALL
-MlasGemmBatch(
-    CBLAS_TRANSPOSE TransA,
-    CBLAS_TRANSPOSE TransB,
+MlasSgemmThreadPartition(
     size_t M,
     size_t N,
     size_t K,
-    const MLAS_SGEMM_DATA_PARAMS* Data,
     size_t BatchSize,
-    MLAS_THREADPOOL* ThreadPool
+    ptrdiff_t MaximumThreadCount,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
     )
+/*++
+
+Routine Description:
+
+    This routine computes the default thread partitioning of each operation in
+    a batch of SGEMM operations.
+
+Arguments:
+
+    M, N, K - Supplies the shape of the multiplication
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    MaximumThreadCount - Supplies the degree of parallelism of the thread pool.
+
+    ThreadCountM - Receives the total thread partition on the M dimension.
+
+    ThreadCountN - Receives the total thread partition on the N dimension.
+
+Return Value:
+
+    None.
+
+--*/
 {
 
     //
@@ -1582,8 +1604,6 @@ MlasGemmBatch(
         TargetThreadCount = MlasPlatform.MaximumThreadCount;
     }
 
-    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
-
     if (TargetThreadCount >= MaximumThreadCount) {
         TargetThreadCount = MaximumThreadCount;
     }
@@ -1596,8 +1616,6 @@ MlasGemmBatch(
     //
 
     ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
 
     if (N > M) {
 
@@ -1608,8 +1626,8 @@ MlasGemmBatch(
             ThreadsPerGemm = ptrdiff_t(BlockedN);
         }
 
-        ThreadCountM = 1;
-        ThreadCountN = ThreadsPerGemm;
+        *ThreadCountM = 1;
+        *ThreadCountN = ThreadsPerGemm;
 
     } else {
 
@@ -1617,21 +1635,481 @@ MlasGemmBatch(
             ThreadsPerGemm = ptrdiff_t(M);
         }
 
-        ThreadCountM = ThreadsPerGemm;
-        ThreadCountN = 1;
+        *ThreadCountM = ThreadsPerGemm;
+        *ThreadCountN = 1;
+    }
+}
+
+void
+MlasSgemmBatchRangeOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS& DataParams,
+    float* PanelB,
+    const float** PanelSourceB,
+    size_t* PanelSourceLdb
+    )
+/*++
+
+Routine Description:
+
+    This routine executes one small SGEMM operation from a contiguous range of
+    a batch that is assigned to a single thread.
+
+    Matrix B is packed once in its entirety to the supplied panel buffer and
+    the packed copy is reused by subsequent operations of the range that
+    reference the same matrix B, such as a right operand that is broadcast
+    across the batch.
+
+Arguments:
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication. The packed matrix B
+        must fit in MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK elements.
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    PanelB - Supplies the panel buffer used to hold the packed matrix B.
+
+    PanelSourceB - Supplies the address of the matrix B currently held in the
+        panel buffer, else nullptr. Updated if the panel buffer is repacked.
+
+    PanelSourceLdb - Supplies the first dimension of the matrix B currently
+        held in the panel buffer. Updated if the panel buffer is repacked.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* A = DataParams.A;
+    const size_t lda = DataParams.lda;
+    float* C = DataParams.C;
+    const size_t ldc = DataParams.ldc;
+    const float alpha = DataParams.alpha;
+    const float beta = DataParams.beta;
+
+    //
+    // Use the generic routines for the cases that have a dedicated path that
+    // does not reference a local packed buffer.
+    //
+
+    if (DataParams.BIsPacked) {
+
+        const size_t AlignedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+            ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        MlasSgemmPackedOperation(TransA, M, 0, N, K, alpha, A, lda,
+            DataParams.B, AlignedN, beta, C, ldc);
+        return;
+    }
+
+    if (K == 0 || M == 1 || N == 1) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda,
+            DataParams.B, DataParams.ldb, beta, C, ldc);
+        return;
+    }
+
+    //
+    // Pack matrix B unless the panel already holds the same matrix.
+    //
+
+    const float* B = DataParams.B;
+    const size_t ldb = DataParams.ldb;
+
+    if (B != *PanelSourceB || ldb != *PanelSourceLdb) {
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemmCopyPackB(PanelB, B, ldb, N, K);
+        } else {
+            MlasSgemmTransposePackB(PanelB, B, ldb, N, K);
+        }
+
+        *PanelSourceB = B;
+        *PanelSourceLdb = ldb;
+    }
+
+    //
+    // Multiply the output matrix by beta as needed.
+    //
+
+    if (beta != 0.0f && beta != 1.0f) {
+        MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+    }
+
+    const bool ZeroMode = (beta == 0.0f);
+
+    if (TransA == CblasNoTrans) {
+
+        MlasSgemmKernelLoop(A, PanelB, C, K, M, N, lda, ldc, alpha, ZeroMode);
+
+    } else {
+
+        float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
+
+        const float* a = A;
+        float* c = C;
+        size_t RowsRemaining = M;
+
+        while (RowsRemaining > 0) {
+
+            //
+            // Transpose elements from matrix A into a local buffer.
+            //
+
+            size_t RowsTransposed = std::min(RowsRemaining, size_t(MLAS_SGEMM_TRANSA_ROWS));
+
+            MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, K);
+
+            RowsRemaining -= RowsTransposed;
+            a += RowsTransposed;
+
+            //
+            // Step through the rows of the local buffer.
+            //
+
+            c = MlasSgemmKernelLoop(PanelA, PanelB, c, K, RowsTransposed, N, K, ldc, alpha, ZeroMode);
+        }
+    }
+}
+
+template<typename DataAccessor>
+void
+MlasSgemmBatchRangeThreaded(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const DataAccessor& GetData,
+    size_t RangeStart,
+    size_t RangeCount
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a contiguous range
+    of a batch of SGEMM operations that are not partitioned any further.
+
+Arguments:
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    GetData - Supplies the accessor returning the data position and layout of
+        the matrices of an operation in the batch.
+
+    RangeStart - Supplies the index of the first operation of the range.
+
+    RangeCount - Supplies the number of operations in the range.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Operations whose packed matrix B fits in a single panel are executed
+    // from a local panel that is reused across the range. Larger operations
+    // are executed as unpartitioned operations.
+    //
+
+    const size_t AlignedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const bool UsePanel = (AlignedN * K <= MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK) &&
+        (TransA == CblasNoTrans || K <= MLAS_SGEMM_STRIDEK);
+
+    if (!UsePanel) {
+
+        for (size_t i = RangeStart; i < RangeStart + RangeCount; i++) {
+            const MLAS_SGEMM_DATA_PARAMS DataParams = GetData(i);
+            MlasSgemmThreaded(1, 1, TransA, TransB, M, N, K, &DataParams, 0);
+        }
+
+        return;
+    }
+
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
+
+    const float* PanelSourceB = nullptr;
+    size_t PanelSourceLdb = 0;
+
+    for (size_t i = RangeStart; i < RangeStart + RangeCount; i++) {
+        MlasSgemmBatchRangeOperation(TransA, TransB, M, N, K, GetData(i),
+            PanelB, &PanelSourceB, &PanelSourceLdb);
+    }
+}
+
+template<typename DataAccessor>
+void
+MlasSgemmBatchPartitionedImpl(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const DataAccessor& GetData,
+    size_t BatchSize,
+    ptrdiff_t ThreadCountM,
+    ptrdiff_t ThreadCountN,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a batch of SGEMM operations using the supplied
+    thread partitioning of each operation.
+
+    If each operation is executed by a single thread, the batch is instead
+    partitioned into contiguous ranges, one per thread, so that many small
+    operations do not each pay the thread dispatch cost and so that a shared
+    matrix B is packed once per range.
+
+Arguments:
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    GetData - Supplies the accessor returning the data position and layout of
+        the matrices of an operation in the batch.
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    if (ThreadsPerGemm == 1 && BatchSize > 1) {
+
+        //
+        // Compute the number of target threads given the complexity of the
+        // whole batch.
+        //
+
+        const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
+
+        ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY) * double(TargetThreadCount)) {
+            TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        }
+
+        if (size_t(TargetThreadCount) > BatchSize) {
+            TargetThreadCount = ptrdiff_t(BatchSize);
+        }
+
+        MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid)
+        {
+            size_t RangeStart;
+            size_t RangeCount;
+
+            MlasPartitionWork(tid, TargetThreadCount, BatchSize, &RangeStart, &RangeCount);
+
+            MlasSgemmBatchRangeThreaded(TransA, TransB, M, N, K, GetData,
+                RangeStart, RangeCount);
+        });
+
+        return;
     }
 
     MlasTrySimpleParallel(ThreadPool,
         ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
-        [=](ptrdiff_t tid)
+        [&](ptrdiff_t tid)
     {
         ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
         ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        const MLAS_SGEMM_DATA_PARAMS DataParams = GetData(size_t(GemmIdx));
         MlasSgemmThreaded(ThreadCountM, ThreadCountN,
-            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+            TransA, TransB, M, N, K, &DataParams, ThreadIdx);
     });
 }
 
+void
+MlasSgemmBatchThreadPartition(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    ptrdiff_t* ThreadCountM,
+    ptrdiff_t* ThreadCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the thread partitioning of each operation in a batch
+    of SGEMM operations.
+
+Arguments:
+
+    M, N, K - Supplies the shape of the multiplication
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+    ThreadCountM - Receives the total thread partition on the M dimension.
+
+    ThreadCountN - Receives the total thread partition on the N dimension.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    //
+    // Prefer a measured partitioning for this shape if one has been recorded,
+    // else fall back to the complexity heuristic.
+    //
+
+    if (!MlasGemmTuningLookup(MlasGemmTuningSgemm, M, N, K, BatchSize,
+            MaximumThreadCount, ThreadCountM, ThreadCountN)) {
+        MlasSgemmThreadPartition(M, N, K, BatchSize, MaximumThreadCount,
+            ThreadCountM, ThreadCountN);
+    }
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    MlasSgemmBatchThreadPartition(M, N, K, BatchSize, ThreadPool,
+        &ThreadCountM, &ThreadCountN);
+
+    MlasSgemmBatchPartitioned(TransA, TransB, M, N, K, Data, BatchSize,
+        ThreadCountM, ThreadCountN, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmStridedBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_STRIDED_BATCH_PARAMS& Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    MlasSgemmBatchThreadPartition(M, N, K, BatchSize, ThreadPool,
+        &ThreadCountM, &ThreadCountN);
+
+    MlasSgemmBatchPartitionedImpl(TransA, TransB, M, N, K,
+        [&Data](size_t BatchIdx) {
+            MLAS_SGEMM_DATA_PARAMS DataParams;
+            DataParams.A = Data.A + BatchIdx * Data.StrideA;
+            DataParams.lda = Data.lda;
+            DataParams.B = Data.B + BatchIdx * Data.StrideB;
+            DataParams.ldb = Data.ldb;
+            DataParams.C = Data.C + BatchIdx * Data.StrideC;
+            DataParams.ldc = Data.ldc;
+            DataParams.alpha = Data.alpha;
+            DataParams.beta = Data.beta;
+            return DataParams;
+        },
+        BatchSize, ThreadCountM, ThreadCountN, ThreadPool);
+}
+
+void
+MlasSgemmBatchPartitioned(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    ptrdiff_t ThreadCountM,
+    ptrdiff_t ThreadCountN,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a batch of SGEMM operations using the supplied
+    thread partitioning of each operation.
+
+Arguments:
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    Data - Supplies the data position and layout of the matrices
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasSgemmBatchPartitionedImpl(TransA, TransB, M, N, K,
+        [Data](size_t BatchIdx) -> const MLAS_SGEMM_DATA_PARAMS& { return Data[BatchIdx]; },
+        BatchSize, ThreadCountM, ThreadCountN, ThreadPool);
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
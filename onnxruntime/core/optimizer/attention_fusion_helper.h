@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #include "onnx/defs/shape_inference.h"
 #include "onnx/defs/tensor_proto_util.h"
+#include "core/framework/tensorprotoutils.h"
 
 #pragma once
 
@@ -316,6 +317,16 @@ bool ValidateUnidirMask(const Graph& graph, const NodeArg& mask, bool& is_unidir
     return false;
   }
 
+  // The data of an initializer of a memory mapped ORT format model is in memory, so parse a copy that holds it.
+  ONNX_NAMESPACE::TensorProto tensor_proto_in_memory;
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (utils::GetExternalDataInMemory(*tensor_proto, data_in_memory, data_in_memory_length)) {
+    tensor_proto_in_memory = *tensor_proto;
+    utils::ConvertExternalDataInMemoryToRawData(tensor_proto_in_memory);
+    tensor_proto = &tensor_proto_in_memory;
+  }
+
   if (tensor_proto->data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL) {
     DEBUG_LOG("This optimizer does not support external data for unidirectional mask right now");
     return false;
@@ -0,0 +1,218 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+#include <tuple>
+#include <unordered_map>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the number of operands of a fusible elementwise node, or 0 if the node can not be fused.
+size_t FusibleOperandCount(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14})) {
+    return 2;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13})) {
+    return 1;
+  }
+
+  return 0;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+bool IsSameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  return (utils::HasDimValue(a) && utils::HasDimValue(b) && a.dim_value() == b.dim_value()) ||
+         (utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param());
+}
+
+// The fused kernel reads an input at output index i from input[i % input_size], so the input shape with
+// its leading ones dropped must be equal to the trailing dimensions of the output shape.
+bool IsSuffixOfShape(const NodeArg& arg, const TensorShapeProto& output_shape) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  int first = 0;
+  while (first < shape->dim_size() && utils::HasDimValue(shape->dim(first)) && shape->dim(first).dim_value() == 1) {
+    ++first;
+  }
+
+  const int trailing = shape->dim_size() - first;
+  if (trailing > output_shape.dim_size()) {
+    return false;
+  }
+
+  const int offset = output_shape.dim_size() - trailing;
+  for (int i = 0; i < trailing; ++i) {
+    if (!IsSameDim(shape->dim(first + i), output_shape.dim(offset + i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CanFuseNode(const Node& node, const TensorShapeProto& output_shape) {
+  const size_t operand_count = FusibleOperandCount(node);
+  if (operand_count == 0 || node.InputDefs().size() != operand_count || !IsFloatTensor(*node.OutputDefs()[0])) {
+    return false;
+  }
+
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!IsFloatTensor(*input) || !IsSuffixOfShape(*input, output_shape)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Collect the producers of 'node' that can be evaluated in the same pass, then 'node' itself, so that
+// 'group' ends up in topological order with the root last.
+void CollectGroup(const Graph& graph, const Node& node, const TensorShapeProto& output_shape,
+                  std::vector<Node*>& group) {
+  for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+    const Node& producer = it->GetNode();
+    if (producer.GetExecutionProviderType() == node.GetExecutionProviderType() &&
+        optimizer_utils::CheckOutputEdges(graph, producer, 1) &&
+        CanFuseNode(producer, output_shape)) {
+      CollectGroup(graph, producer, output_shape, group);
+    }
+  }
+
+  group.push_back(const_cast<Node*>(&node));
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    ORT_RETURN_IF_ERROR(Recurse(*node_ptr, modified, graph_level, logger));
+  }
+
+  // Walk the graph from its outputs so that each group is rooted at the last node of its tree and
+  // absorbs as many producers as possible.
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    auto* node_ptr = graph.GetNode(*it);
+    if (nullptr == node_ptr)
+      continue;  // node was fused into a group
+
+    Node& root = *node_ptr;
+    const TensorShapeProto* output_shape = root.OutputDefs()[0]->Shape();
+    if (output_shape == nullptr ||
+        !graph_utils::IsSupportedProvider(root, GetCompatibleExecutionProviders()) ||
+        !CanFuseNode(root, *output_shape)) {
+      continue;
+    }
+
+    std::vector<Node*> group;
+    CollectGroup(graph, root, *output_shape, group);
+    if (group.size() < 2) {
+      continue;
+    }
+
+    // Assign operand indices: the external inputs first, then the result of each step.
+    std::vector<NodeArg*> fused_inputs;
+    std::unordered_map<const NodeArg*, int64_t> operand_index;
+    std::unordered_map<const NodeArg*, const Node*> group_outputs;
+    for (Node* node : group) {
+      group_outputs[node->OutputDefs()[0]] = node;
+    }
+    for (Node* node : group) {
+      for (NodeArg* input : node->MutableInputDefs()) {
+        if (group_outputs.count(input) == 0 && operand_index.count(input) == 0) {
+          operand_index[input] = static_cast<int64_t>(fused_inputs.size());
+          fused_inputs.push_back(input);
+        }
+      }
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    for (size_t k = 0; k < group.size(); ++k) {
+      const Node& node = *group[k];
+      ops.push_back(node.OpType());
+      operands.push_back(operand_index[node.InputDefs()[0]]);
+      operands.push_back(node.InputDefs().size() > 1 ? operand_index[node.InputDefs()[1]] : -1);
+      operand_index[node.OutputDefs()[0]] = static_cast<int64_t>(fused_inputs.size() + k);
+    }
+
+    // Remember the producers of the external inputs before the group is removed.
+    std::vector<std::tuple<NodeIndex, int, int>> input_edges;
+    for (Node* node : group) {
+      for (auto edge = node->InputEdgesBegin(), end = node->InputEdgesEnd(); edge != end; ++edge) {
+        const NodeArg* input = node->InputDefs()[edge->GetDstArgIndex()];
+        if (group_outputs.count(input) == 0) {
+          input_edges.emplace_back(edge->GetNode().Index(), edge->GetSrcArgIndex(),
+                                   static_cast<int>(operand_index[input]));
+        }
+      }
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused elementwise operators",
+                                     fused_inputs,
+                                     {},
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+
+    // Assign provider to this new node. Provider should be same as the provider for old nodes.
+    fused_node.SetExecutionProviderType(root.GetExecutionProviderType());
+
+    std::vector<std::reference_wrapper<Node>> nodes_to_fuse;
+    for (Node* node : group) {
+      nodes_to_fuse.push_back(*node);
+    }
+
+    // move the output definitions and edges from the root to the fused node and delete the group.
+    // FinalizeNodeFusion only moves the input edges of the first node, so connect the others here.
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+    for (const auto& edge : input_edges) {
+      if (graph_utils::GetInputEdge(fused_node, std::get<2>(edge)) == nullptr) {
+        graph.AddEdge(std::get<0>(edge), fused_node.Index(), std::get<1>(edge), std::get<2>(edge));
+      }
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+Fuse maximal trees of float elementwise nodes (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Erf, Exp, Log,
+Sqrt, Neg, Abs, Reciprocal) into a single FusedElementwise node. A producer is absorbed when its only
+consumer is in the group and every input of the group broadcasts to the output as a trailing suffix,
+so the fused kernel can evaluate the whole expression in one pass over the output.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -18,6 +18,21 @@ Status Initializer::ReadExternalRawData(
           tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING,
       "External data type must not be UNDEFINED or STRING.");
 
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (utils::GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    size_t actual_tensor_data_length;
+    ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &actual_tensor_data_length));
+    ORT_RETURN_IF_NOT(data_in_memory_length == actual_tensor_data_length,
+                      "TensorProto in memory data size mismatch. ",
+                      "Computed size: ", actual_tensor_data_length,
+                      ", external_data.length: ", data_in_memory_length);
+
+    const char* data = static_cast<const char*>(data_in_memory);
+    raw_data.assign(data, data + data_in_memory_length);
+    return Status::OK();
+  }
+
   ORT_RETURN_IF(
       model_path.IsEmpty(),
       "model_path must not be empty. Ensure that a path is provided when the model is created or loaded.");
@@ -0,0 +1,805 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/transpose_optimizer.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+using Perm = std::vector<int64_t>;
+using graph_utils::GraphEdge;
+
+// Maximum number of operators a Transpose is pushed through.
+constexpr int kMaxPushDepth = 64;
+
+bool IsTranspose(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13});
+}
+
+// Returns the permutation of a Transpose node, or an empty vector if it is unknown or invalid.
+Perm GetPerm(const Node& node) {
+  Perm perm;
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, "perm", perm)) {
+    // the default permutation reverses the dimensions of the input
+    const auto* shape = node.InputDefs()[0]->Shape();
+    if (shape == nullptr) {
+      return {};
+    }
+    perm.resize(shape->dim_size());
+    std::iota(perm.rbegin(), perm.rend(), int64_t{0});
+  }
+
+  std::vector<bool> seen(perm.size(), false);
+  for (int64_t axis : perm) {
+    if (axis < 0 || axis >= static_cast<int64_t>(perm.size()) || seen[axis]) {
+      return {};
+    }
+    seen[axis] = true;
+  }
+
+  return perm;
+}
+
+Perm InvertPerm(const Perm& perm) {
+  Perm inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    inverse[perm[i]] = static_cast<int64_t>(i);
+  }
+  return inverse;
+}
+
+// Returns the permutation equivalent to Transpose(Transpose(x, first), second).
+Perm ComposePerm(const Perm& first, const Perm& second) {
+  Perm composed(second.size());
+  for (size_t i = 0; i < second.size(); ++i) {
+    composed[i] = first[second[i]];
+  }
+  return composed;
+}
+
+// An empty permutation is used for outputs that do not need to be transposed.
+bool IsIdentity(const Perm& perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NormalizeAxis(int64_t axis, int64_t rank, int64_t& normalized) {
+  normalized = axis < 0 ? axis + rank : axis;
+  return normalized >= 0 && normalized < rank;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr && attr->has_i() ? attr->i() : default_value;
+}
+
+// Reads the values of a constant int32 or int64 input.
+bool GetConstantInts(const Graph& graph, const NodeArg& arg, std::vector<int64_t>& values, int32_t& data_type) {
+  const auto* tensor = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor == nullptr) {
+    return false;
+  }
+
+  Initializer initializer(*tensor, graph.ModelPath());
+  data_type = tensor->data_type();
+  if (data_type == TensorProto_DataType_INT64) {
+    const int64_t* data = initializer.data<int64_t>();
+    values.assign(data, data + initializer.size());
+  } else if (data_type == TensorProto_DataType_INT32) {
+    const int32_t* data = initializer.data<int32_t>();
+    values.assign(data, data + initializer.size());
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+bool IsUnaryOp(const Node& node) {
+  static const std::unordered_set<std::string> ops{
+      "Abs", "Acos", "Acosh", "Asin", "Asinh", "Atan", "Atanh", "Cast", "Ceil", "Clip", "Cos", "Cosh", "Elu",
+      "Erf", "Exp", "Floor", "HardSigmoid", "HardSwish", "Identity", "IsInf", "IsNaN", "LeakyRelu", "Log", "Neg",
+      "Not", "Reciprocal", "Relu", "Round", "Selu", "Sigmoid", "Sign", "Sin", "Sinh", "Softplus", "Softsign",
+      "Sqrt", "Tan", "Tanh", "ThresholdedRelu"};
+  return graph_utils::MatchesOpSetDomain(node, kOnnxDomain) && ops.count(node.OpType()) != 0;
+}
+
+bool IsBroadcastOp(const Node& node) {
+  static const std::unordered_set<std::string> ops{
+      "Add", "And", "BitShift", "Div", "Equal", "Greater", "GreaterOrEqual", "Less", "LessOrEqual", "Max", "Mean",
+      "Min", "Mod", "Mul", "Or", "Pow", "PRelu", "Sub", "Sum", "Where", "Xor"};
+  // opset 6 and earlier used the 'broadcast' and 'axis' attributes instead of multidirectional broadcasting
+  return graph_utils::MatchesOpSetDomain(node, kOnnxDomain) && ops.count(node.OpType()) != 0 &&
+         node.SinceVersion() >= 7;
+}
+
+bool IsReduceOp(const Node& node) {
+  for (const char* op : {"ReduceL1", "ReduceL2", "ReduceLogSum", "ReduceLogSumExp", "ReduceMax", "ReduceMean",
+                         "ReduceMin", "ReduceProd", "ReduceSumSquare"}) {
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, op, {1, 11, 12, 13})) {
+      return true;
+    }
+  }
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSum", {1, 11, 13});
+}
+
+// Returns the permutation of the output of a reduction of Transpose(x, perm), where 'reduced' marks the
+// reduced dimensions of x.
+Perm ReducedOutputPerm(const Perm& perm, const std::vector<bool>& reduced, bool keepdims) {
+  if (std::all_of(reduced.begin(), reduced.end(), [](bool r) { return r; })) {
+    return {};
+  }
+
+  if (keepdims) {
+    return perm;
+  }
+
+  // position of each remaining dimension of x in the output
+  std::vector<int64_t> position(perm.size(), -1);
+  int64_t next = 0;
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (!reduced[i]) {
+      position[i] = next++;
+    }
+  }
+
+  Perm output_perm;
+  for (int64_t axis : perm) {
+    if (!reduced[axis]) {
+      output_perm.push_back(position[axis]);
+    }
+  }
+
+  return output_perm;
+}
+
+// Describes how a node is rewritten when a Transpose is pushed from its inputs to its outputs.
+struct PushInfo {
+  // inputs that are in the layout of the output of the Transpose
+  std::vector<size_t> data_inputs;
+  // permutation of each output after the push
+  std::vector<Perm> output_perms;
+  // attributes and the constant input that hold axes in the new layout
+  std::vector<std::pair<std::string, int64_t>> int_attributes;
+  std::vector<std::pair<std::string, std::vector<int64_t>>> ints_attributes;
+  int ints_input_index = -1;
+  std::vector<int64_t> ints_input_values;
+  int32_t ints_input_type = TensorProto_DataType_INT64;
+};
+
+// Checks if a Transpose with permutation 'perm' feeding input 'input_index' of 'node' can be moved to the
+// outputs of 'node', and computes the rewrite of the node for it.
+bool GetPushInfo(const Graph& graph, const Node& node, size_t input_index, const Perm& perm, PushInfo& info) {
+  const auto rank = static_cast<int64_t>(perm.size());
+  const size_t output_count = node.OutputDefs().size();
+
+  // maps axes of the transposed input to axes of the original input
+  auto transpose_axes = [&perm, rank](const std::vector<int64_t>& axes, std::vector<int64_t>& new_axes) {
+    new_axes.clear();
+    for (int64_t axis : axes) {
+      int64_t normalized;
+      if (!NormalizeAxis(axis, rank, normalized)) {
+        return false;
+      }
+      new_axes.push_back(perm[normalized]);
+    }
+    return true;
+  };
+
+  if (IsUnaryOp(node)) {
+    info.data_inputs = {0};
+    info.output_perms = {perm};
+  } else if (IsBroadcastOp(node)) {
+    info.data_inputs.resize(node.InputDefs().size());
+    std::iota(info.data_inputs.begin(), info.data_inputs.end(), size_t{0});
+    info.output_perms = {perm};
+  } else if (IsReduceOp(node) || graph_utils::IsSupportedOptypeVersionAndDomain(node, "ArgMax", {1, 11, 12, 13}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "ArgMin", {1, 11, 12, 13})) {
+    std::vector<int64_t> axes;
+    const bool is_arg_op = node.OpType() == "ArgMax" || node.OpType() == "ArgMin";
+    const bool axes_input = node.OpType() == "ReduceSum" && node.SinceVersion() >= 13;
+    bool has_axes = true;
+    if (is_arg_op) {
+      axes = {GetIntAttribute(node, "axis", 0)};
+    } else if (axes_input) {
+      // an empty axes input reduces all dimensions or none depending on noop_with_empty_axes
+      const auto& inputs = node.InputDefs();
+      if (inputs.size() < 2 || !inputs[1]->Exists() ||
+          !GetConstantInts(graph, *inputs[1], axes, info.ints_input_type) || axes.empty()) {
+        return false;
+      }
+    } else if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+      has_axes = false;
+      axes.resize(perm.size());
+      std::iota(axes.begin(), axes.end(), int64_t{0});
+    }
+
+    std::vector<int64_t> new_axes;
+    if (!transpose_axes(axes, new_axes)) {
+      return false;
+    }
+
+    std::vector<bool> reduced(perm.size(), false);
+    for (int64_t axis : new_axes) {
+      reduced[axis] = true;
+    }
+
+    info.data_inputs = {0};
+    info.output_perms = {ReducedOutputPerm(perm, reduced, GetIntAttribute(node, "keepdims", 1) != 0)};
+    if (is_arg_op) {
+      info.int_attributes.emplace_back("axis", new_axes[0]);
+    } else if (axes_input) {
+      info.ints_input_index = 1;
+      info.ints_input_values = new_axes;
+    } else if (has_axes) {
+      info.ints_attributes.emplace_back("axes", new_axes);
+    }
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Split", {2, 11, 13}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softmax", {13}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "LogSoftmax", {13})) {
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    int64_t axis = node.OpType() == "Split" ? 0 : -1;
+    if (axis_attr != nullptr && axis_attr->has_i()) {
+      axis = axis_attr->i();
+    } else if (node.OpType() == "Concat") {
+      return false;
+    }
+
+    int64_t normalized;
+    if (!NormalizeAxis(axis, rank, normalized)) {
+      return false;
+    }
+
+    if (node.OpType() == "Concat") {
+      info.data_inputs.resize(node.InputDefs().size());
+      std::iota(info.data_inputs.begin(), info.data_inputs.end(), size_t{0});
+    } else {
+      info.data_inputs = {0};
+    }
+    info.output_perms.assign(output_count, perm);
+    info.int_attributes.emplace_back("axis", perm[normalized]);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Pad", {2, 11, 13})) {
+    std::vector<int64_t> pads;
+    if (node.SinceVersion() < 11) {
+      if (!graph_utils::GetRepeatedNodeAttributeValues(node, "pads", pads)) {
+        return false;
+      }
+    } else if (node.InputDefs().size() < 2 ||
+               !GetConstantInts(graph, *node.InputDefs()[1], pads, info.ints_input_type)) {
+      return false;
+    }
+
+    if (pads.size() != 2 * perm.size()) {
+      return false;
+    }
+
+    std::vector<int64_t> new_pads(pads.size());
+    for (size_t i = 0; i < perm.size(); ++i) {
+      new_pads[perm[i]] = pads[i];
+      new_pads[perm.size() + perm[i]] = pads[perm.size() + i];
+    }
+
+    info.data_inputs = {0};
+    info.output_perms = {perm};
+    if (node.SinceVersion() < 11) {
+      info.ints_attributes.emplace_back("pads", new_pads);
+    } else {
+      info.ints_input_index = 1;
+      info.ints_input_values = new_pads;
+    }
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Slice", {1, 10, 11, 13})) {
+    // the default axes are [0, len(starts))
+    std::vector<int64_t> axes;
+    std::vector<int64_t> starts;
+    const auto& inputs = node.InputDefs();
+    if (node.SinceVersion() < 10) {
+      if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes)) {
+        if (!graph_utils::GetRepeatedNodeAttributeValues(node, "starts", starts)) {
+          return false;
+        }
+        axes.resize(starts.size());
+        std::iota(axes.begin(), axes.end(), int64_t{0});
+      }
+    } else if (inputs.size() > 3 && inputs[3]->Exists()) {
+      if (!GetConstantInts(graph, *inputs[3], axes, info.ints_input_type)) {
+        return false;
+      }
+    } else {
+      // the new axes input must have the same type as starts
+      if (!GetConstantInts(graph, *inputs[1], starts, info.ints_input_type)) {
+        return false;
+      }
+      axes.resize(starts.size());
+      std::iota(axes.begin(), axes.end(), int64_t{0});
+    }
+
+    std::vector<int64_t> new_axes;
+    if (!transpose_axes(axes, new_axes)) {
+      return false;
+    }
+
+    info.data_inputs = {0};
+    info.output_perms = {perm};
+    if (node.SinceVersion() < 10) {
+      info.ints_attributes.emplace_back("axes", new_axes);
+    } else {
+      info.ints_input_index = 3;
+      info.ints_input_values = new_axes;
+    }
+  } else {
+    return false;
+  }
+
+  return std::find(info.data_inputs.begin(), info.data_inputs.end(), input_index) != info.data_inputs.end();
+}
+
+// Creates a NodeArg for Transpose(base, perm).
+NodeArg& CreateTransposedArg(Graph& graph, const NodeArg& base, const Perm& perm) {
+  const std::string name = graph.GenerateNodeArgName(base.Name());
+  if (base.TypeAsProto() == nullptr) {
+    return graph.GetOrCreateNodeArg(name, nullptr);
+  }
+
+  TypeProto type(*base.TypeAsProto());
+  if (type.has_tensor_type() && type.tensor_type().has_shape() &&
+      type.tensor_type().shape().dim_size() == static_cast<int>(perm.size())) {
+    const TensorShapeProto shape = type.tensor_type().shape();
+    auto* new_shape = type.mutable_tensor_type()->mutable_shape();
+    for (size_t i = 0; i < perm.size(); ++i) {
+      *new_shape->mutable_dim(static_cast<int>(i)) = shape.dim(static_cast<int>(perm[i]));
+    }
+  }
+
+  return graph.GetOrCreateNodeArg(name, &type);
+}
+
+Node& AddTranspose(Graph& graph, NodeArg& input, NodeArg& output, const Perm& perm, const std::string& provider) {
+  Node& transpose = graph.AddNode(graph.GenerateNodeName("Transpose"),
+                                  "Transpose",
+                                  "Transpose inserted by the transpose optimizer",
+                                  {&input},
+                                  {&output});
+  transpose.AddAttribute("perm", perm);
+  transpose.SetExecutionProviderType(provider);
+  return transpose;
+}
+
+// How an input other than the one the Transpose is pushed from is brought into the new layout.
+enum class InputAction {
+  kKeep,              // the input is not affected by the permutation
+  kConstant,          // insert a Transpose of a constant, which is removed by constant folding
+  kBypassTranspose,   // the input is produced by a Transpose with the same permutation, so remove it
+  kUpdateTranspose,   // the input is produced by another Transpose, so compose the permutations
+  kInsertTranspose,   // insert a Transpose with the inverse permutation
+};
+
+// Returns false if input 'index' of 'node' can not be brought into the new layout. 'cost' is the change in
+// the number of Transpose nodes.
+bool PlanInput(const Graph& graph, const Node& node, size_t index, const Perm& perm,
+               InputAction& action, int64_t& cost) {
+  const NodeArg& arg = *node.InputDefs()[index];
+  action = InputAction::kKeep;
+  cost = 0;
+  if (!arg.Exists()) {
+    return true;
+  }
+
+  const auto* shape = arg.Shape();
+  if (shape == nullptr || shape->dim_size() > static_cast<int>(perm.size())) {
+    return false;
+  }
+
+  if (std::all_of(shape->dim().begin(), shape->dim().end(), [](const TensorShapeProto_Dimension& dim) {
+        return utils::HasDimValue(dim) && dim.dim_value() == 1;
+      })) {
+    return true;
+  }
+
+  if (graph_utils::GetConstantInitializer(graph, arg.Name()) != nullptr) {
+    action = InputAction::kConstant;
+    return true;
+  }
+
+  // a non-constant input with a smaller rank would need an Unsqueeze
+  if (shape->dim_size() != static_cast<int>(perm.size())) {
+    return false;
+  }
+
+  const Node* producer = graph_utils::GetInputNode(node, static_cast<int>(index));
+  if (producer != nullptr && IsTranspose(*producer) &&
+      producer->GetExecutionProviderType() == node.GetExecutionProviderType() &&
+      optimizer_utils::CheckOutputEdges(graph, *producer, 1)) {
+    const Perm producer_perm = GetPerm(*producer);
+    if (producer_perm == perm) {
+      action = InputAction::kBypassTranspose;
+      cost = -1;
+      return true;
+    }
+
+    if (producer_perm.size() == perm.size()) {
+      action = InputAction::kUpdateTranspose;
+      return true;
+    }
+  }
+
+  action = InputAction::kInsertTranspose;
+  cost = 1;
+  return true;
+}
+
+void ApplyInput(Graph& graph, Node& node, size_t index, const Perm& perm, InputAction action) {
+  const int input_index = static_cast<int>(index);
+  const Perm inverse = InvertPerm(perm);
+  NodeArg& arg = *node.MutableInputDefs()[index];
+
+  switch (action) {
+    case InputAction::kKeep:
+      break;
+
+    case InputAction::kConstant:
+    case InputAction::kInsertTranspose: {
+      NodeArg* input = &arg;
+      const auto rank = static_cast<size_t>(arg.Shape()->dim_size());
+      if (rank < perm.size()) {
+        // add leading dimensions of 1 so that the constant broadcasts the same way after the Transpose
+        const TensorProto& initializer = *graph_utils::GetConstantInitializer(graph, arg.Name());
+        TensorProto expanded(initializer);
+        expanded.set_name(graph.GenerateNodeArgName(arg.Name()));
+        expanded.clear_dims();
+        for (size_t i = rank; i < perm.size(); ++i) {
+          expanded.add_dims(1);
+        }
+        for (int64_t dim : initializer.dims()) {
+          expanded.add_dims(dim);
+        }
+        input = &graph_utils::AddInitializer(graph, expanded);
+      }
+
+      NodeArg& output = CreateTransposedArg(graph, *input, inverse);
+      Node& transpose = AddTranspose(graph, *input, output, inverse, node.GetExecutionProviderType());
+      if (const auto* input_edge = graph_utils::GetInputEdge(node, input_index)) {
+        const NodeIndex src = input_edge->GetNode().Index();
+        const int src_index = input_edge->GetSrcArgIndex();
+        graph.RemoveEdge(src, node.Index(), src_index, input_index);
+        graph.AddEdge(src, transpose.Index(), src_index, 0);
+      }
+      graph_utils::ReplaceNodeInput(node, input_index, output);
+      graph.AddEdge(transpose.Index(), node.Index(), 0, input_index);
+      break;
+    }
+
+    case InputAction::kBypassTranspose: {
+      Node& producer = *graph.GetNode(graph_utils::GetInputNode(node, input_index)->Index());
+      graph_utils::RemoveNodeOutputEdges(graph, producer);
+      graph_utils::ReplaceNodeInput(node, input_index, *producer.MutableInputDefs()[0]);
+      if (const auto* input_edge = graph_utils::GetInputEdge(producer, 0)) {
+        graph.AddEdge(input_edge->GetNode().Index(), node.Index(), input_edge->GetSrcArgIndex(), input_index);
+      }
+      graph.RemoveNode(producer.Index());
+      break;
+    }
+
+    case InputAction::kUpdateTranspose: {
+      Node& producer = *graph.GetNode(graph_utils::GetInputNode(node, input_index)->Index());
+      NodeArg& output = CreateTransposedArg(graph, arg, inverse);
+      producer.AddAttribute("perm", ComposePerm(GetPerm(producer), inverse));
+      producer.MutableOutputDefs()[0] = &output;
+      graph_utils::ReplaceNodeInput(node, input_index, output);
+      break;
+    }
+  }
+}
+
+// Writes the axes of the new layout to the attributes and inputs of a node the Transpose is pushed through.
+void UpdateNode(Graph& graph, Node& node, const PushInfo& info) {
+  for (const auto& attr : info.int_attributes) {
+    node.AddAttribute(attr.first, attr.second);
+  }
+
+  for (const auto& attr : info.ints_attributes) {
+    node.AddAttribute(attr.first, attr.second);
+  }
+
+  if (info.ints_input_index >= 0) {
+    const auto& inputs = node.InputDefs();
+    const auto index = static_cast<size_t>(info.ints_input_index);
+    const bool has_input = index < inputs.size();
+    const std::string base_name = has_input && inputs[index]->Exists() ? inputs[index]->Name() : node.Name() + "_axes";
+
+    TensorProto proto;
+    proto.set_name(graph.GenerateNodeArgName(base_name));
+    proto.set_data_type(info.ints_input_type);
+    proto.add_dims(static_cast<int64_t>(info.ints_input_values.size()));
+    for (int64_t value : info.ints_input_values) {
+      if (info.ints_input_type == TensorProto_DataType_INT32) {
+        proto.add_int32_data(static_cast<int32_t>(value));
+      } else {
+        proto.add_int64_data(value);
+      }
+    }
+
+    NodeArg& arg = graph_utils::AddInitializer(graph, proto);
+    if (has_input) {
+      graph_utils::ReplaceNodeInput(node, info.ints_input_index, arg);
+    } else {
+      graph_utils::AddNodeInput(node, info.ints_input_index, arg);
+    }
+  }
+}
+
+// The consumers of a value that is waiting for the Transpose to be pushed past them.
+struct Pending {
+  std::vector<GraphEdge> edges;
+  bool is_graph_output;
+};
+
+Pending GetPending(const Graph& graph, const Node& node, size_t output_index) {
+  return {GraphEdge::GetNodeOutputEdges(node, output_index), graph.IsOutput(node.OutputDefs()[output_index])};
+}
+
+// Values consumed by a subgraph are referenced by name, so they can not be replaced.
+bool AllExplicitInputs(const Graph& graph, const std::vector<GraphEdge>& edges) {
+  return std::all_of(edges.begin(), edges.end(), [&graph](const GraphEdge& edge) {
+    return static_cast<size_t>(edge.dst_arg_index) < graph.GetNode(edge.dst_node)->InputDefs().size();
+  });
+}
+
+bool CanBypass(const Graph& graph, const Node& node) {
+  return !graph.NodeProducesGraphOutput(node) && AllExplicitInputs(graph, GraphEdge::GetNodeOutputEdges(node));
+}
+
+enum class Action {
+  kForward,      // the permutation is the identity, so the consumers read the data directly
+  kMaterialize,  // insert a Transpose for the consumers
+  kMerge,        // the only consumer is a Transpose, so merge the permutations or cancel both
+  kPush,         // push the Transpose through the only consumer to its outputs
+};
+
+struct Decision {
+  Action action;
+  // change in the number of Transpose nodes compared to materializing the pending Transpose
+  int64_t cost;
+};
+
+// Decides how the consumers in 'pending', which expect Transpose(data, perm), are resolved. The cost of a push
+// includes the Transposes needed by the other inputs of the consumer and the cost of resolving its outputs,
+// so a push is only chosen when it ends with fewer Transposes than it started with. 'owns_data' is set when
+// data has no other consumers, so its producer can write the output of a cancelled Transpose directly.
+Decision Decide(const Graph& graph, const Pending& pending, const Perm& perm, const std::string& provider,
+                int depth, bool allow_push, bool owns_data) {
+  const Decision materialize{Action::kMaterialize, 1};
+  if (!AllExplicitInputs(graph, pending.edges)) {
+    return materialize;
+  }
+
+  if (!pending.is_graph_output && (pending.edges.empty() || IsIdentity(perm))) {
+    return {Action::kForward, 0};
+  }
+
+  if (pending.is_graph_output || pending.edges.size() != 1) {
+    return materialize;
+  }
+
+  const GraphEdge& edge = pending.edges[0];
+  const Node& consumer = *graph.GetNode(edge.dst_node);
+  if (consumer.GetExecutionProviderType() != provider) {
+    return materialize;
+  }
+
+  if (IsTranspose(consumer)) {
+    const Perm consumer_perm = GetPerm(consumer);
+    if (consumer_perm.size() != perm.size()) {
+      return materialize;
+    }
+
+    if (IsIdentity(ComposePerm(perm, consumer_perm)) && (owns_data || CanBypass(graph, consumer))) {
+      return {Action::kMerge, -1};
+    }
+
+    return {Action::kMerge, 0};
+  }
+
+  PushInfo info;
+  if (!allow_push || depth >= kMaxPushDepth ||
+      !GetPushInfo(graph, consumer, static_cast<size_t>(edge.dst_arg_index), perm, info)) {
+    return materialize;
+  }
+
+  int64_t cost = 0;
+  for (size_t index : info.data_inputs) {
+    InputAction action;
+    int64_t input_cost;
+    if (index == static_cast<size_t>(edge.dst_arg_index)) {
+      continue;
+    }
+    if (!PlanInput(graph, consumer, index, perm, action, input_cost)) {
+      return materialize;
+    }
+    cost += input_cost;
+  }
+
+  // the outputs of a node with several outputs are only merged with Transposes, so that pushes along the
+  // outputs never meet again at a node with several inputs
+  const bool single_output = consumer.OutputDefs().size() == 1;
+  for (size_t i = 0; i < info.output_perms.size(); ++i) {
+    if (!IsIdentity(info.output_perms[i]) && consumer.OutputDefs()[i]->Exists()) {
+      cost += Decide(graph, GetPending(graph, consumer, i), info.output_perms[i], provider, depth + 1,
+                     single_output, true)
+                  .cost;
+    }
+  }
+
+  return cost < 1 ? Decision{Action::kPush, cost} : materialize;
+}
+
+// Connects the consumers in 'pending', which expect Transpose(data, perm) in 'expected', to 'data' produced by
+// output 'src_index' of 'src' (nullptr for graph inputs and initializers). The edges in 'pending' must already
+// be removed from the graph, and 'expected' must not have a producer.
+Status Resolve(Graph& graph, const Pending& pending, NodeArg& data, Node* src, int src_index, NodeArg& expected,
+               const Perm& perm, const std::string& provider, int depth, bool allow_push, bool owns_data) {
+  auto connect = [&](Node& dst, int dst_index) {
+    graph_utils::ReplaceNodeInput(dst, dst_index, data);
+    if (src != nullptr) {
+      graph.AddEdge(src->Index(), dst.Index(), src_index, dst_index);
+    }
+  };
+
+  const Decision decision = Decide(graph, pending, perm, provider, depth, allow_push, owns_data);
+  switch (decision.action) {
+    case Action::kForward: {
+      for (const auto& edge : pending.edges) {
+        connect(*graph.GetNode(edge.dst_node), edge.dst_arg_index);
+      }
+      break;
+    }
+
+    case Action::kMaterialize: {
+      Node& transpose = AddTranspose(graph, data, expected, perm, provider);
+      if (src != nullptr) {
+        graph.AddEdge(src->Index(), transpose.Index(), src_index, 0);
+      }
+      for (const auto& edge : pending.edges) {
+        graph.AddEdge(transpose.Index(), edge.dst_node, 0, edge.dst_arg_index);
+      }
+      break;
+    }
+
+    case Action::kMerge: {
+      Node& consumer = *graph.GetNode(pending.edges[0].dst_node);
+      const Perm composed = ComposePerm(perm, GetPerm(consumer));
+      if (decision.cost < 0) {
+        // the Transposes cancel, so the consumers of the second one read the data directly
+        const auto edges = GraphEdge::GetNodeOutputEdges(consumer);
+        GraphEdge::RemoveGraphEdges(graph, edges);
+        if (owns_data) {
+          // keep the name of the output, which may be a graph output or be used by a subgraph
+          src->MutableOutputDefs()[src_index] = consumer.MutableOutputDefs()[0];
+          for (const auto& edge : edges) {
+            graph.AddEdge(src->Index(), edge.dst_node, src_index, edge.dst_arg_index);
+          }
+        } else {
+          for (const auto& edge : edges) {
+            connect(*graph.GetNode(edge.dst_node), edge.dst_arg_index);
+          }
+        }
+        graph.RemoveNode(consumer.Index());
+      } else {
+        connect(consumer, 0);
+        consumer.AddAttribute("perm", composed);
+      }
+      break;
+    }
+
+    case Action::kPush: {
+      const GraphEdge& edge = pending.edges[0];
+      Node& node = *graph.GetNode(edge.dst_node);
+      PushInfo info;
+      ORT_RETURN_IF_NOT(GetPushInfo(graph, node, static_cast<size_t>(edge.dst_arg_index), perm, info),
+                        "Transpose can not be pushed through ", node.Name());
+
+      std::vector<std::pair<size_t, InputAction>> input_actions;
+      for (size_t index : info.data_inputs) {
+        InputAction action;
+        int64_t input_cost;
+        if (index != static_cast<size_t>(edge.dst_arg_index)) {
+          ORT_RETURN_IF_NOT(PlanInput(graph, node, index, perm, action, input_cost),
+                            "Input ", index, " of ", node.Name(), " can not be transposed");
+          input_actions.emplace_back(index, action);
+        }
+      }
+
+      connect(node, edge.dst_arg_index);
+      for (const auto& input_action : input_actions) {
+        ApplyInput(graph, node, input_action.first, perm, input_action.second);
+      }
+      UpdateNode(graph, node, info);
+
+      const bool single_output = node.OutputDefs().size() == 1;
+      for (size_t i = 0; i < info.output_perms.size(); ++i) {
+        const Perm& output_perm = info.output_perms[i];
+        if (IsIdentity(output_perm) || !node.OutputDefs()[i]->Exists()) {
+          continue;
+        }
+
+        const Pending output_pending = GetPending(graph, node, i);
+        NodeArg& old_output = *node.MutableOutputDefs()[i];
+        NodeArg& new_output = CreateTransposedArg(graph, old_output, InvertPerm(output_perm));
+        GraphEdge::RemoveGraphEdges(graph, output_pending.edges);
+        node.MutableOutputDefs()[i] = &new_output;
+        ORT_RETURN_IF_ERROR(Resolve(graph, output_pending, new_output, &node, static_cast<int>(i), old_output,
+                                    output_perm, provider, depth + 1, single_output, true));
+      }
+      break;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+Status TransposeOptimizer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // Transposes of constants are left to constant folding
+    if (!IsTranspose(node) || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        graph_utils::GetConstantInitializer(graph, node.InputDefs()[0]->Name()) != nullptr) {
+      continue;
+    }
+
+    const Perm perm = GetPerm(node);
+    if (perm.empty()) {
+      continue;
+    }
+
+    // removing the Transpose saves one node, so any resolution of its consumers that costs less than one
+    // Transpose is an improvement
+    const std::string provider = node.GetExecutionProviderType();
+    const Pending pending = GetPending(graph, node, 0);
+    if (Decide(graph, pending, perm, provider, 0, true, false).cost >= 1) {
+      continue;
+    }
+
+    NodeArg& data = *node.MutableInputDefs()[0];
+    NodeArg& expected = *node.MutableOutputDefs()[0];
+    Node* src = nullptr;
+    int src_index = 0;
+    if (const auto* input_edge = graph_utils::GetInputEdge(node, 0)) {
+      src = graph.GetNode(input_edge->GetNode().Index());
+      src_index = input_edge->GetSrcArgIndex();
+    }
+
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+    ORT_RETURN_IF_ERROR(Resolve(graph, pending, data, src, src_index, expected, perm, provider, 0, true, false));
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TransposeOptimizer
+Push Transpose nodes downstream through layout agnostic operators (elementwise, reductions, Concat, Split,
+Softmax, Pad and Slice) so that they merge with or cancel against other Transpose nodes. The axis related
+attributes and inputs of each operator are rewritten for the new layout, and the other inputs of a
+multi-input operator are transposed with the inverse permutation. A push is only applied when it reduces
+the number of Transpose nodes left in the graph; Transposes of constant inputs are not counted as they are
+removed by constant folding.
+*/
+class TransposeOptimizer : public GraphTransformer {
+ public:
+  TransposeOptimizer(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TransposeOptimizer", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
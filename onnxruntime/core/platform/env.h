@@ -51,6 +51,25 @@ class EnvThread {
   virtual ~EnvThread() = default;
 };
 
+// How the idle threads of a thread pool that allows spinning wait for new work.
+enum class ThreadPoolSpinPolicy : uint8_t {
+  // Spin for a fixed number of iterations, then block.
+  Fixed,
+  // Spin for a duration tuned to the recent inter-arrival times of parallel work, then block.  Threads spin
+  // while work arrives frequently, and block almost immediately when it is sparse.
+  Adaptive,
+  // As Adaptive, but only spin while a Run is active on the thread pool (see ThreadPool::StartRun).  Between
+  // Runs, idle threads block immediately.
+  DuringRun,
+};
+
+// Priority of the work submitted to a thread pool (see ThreadPool::PriorityScope).
+enum class ThreadPoolPriority : uint8_t {
+  Normal,
+  // Served ahead of normal-priority work, which yields to it at the chunk boundaries of parallel loops.
+  High,
+};
+
 // Parameters that are required to create a set of threads for a thread pool
 struct ThreadOptions {
   // Stack size for a new thread. If it is 0, the operating system uses the same value as the stack that's specified for
@@ -65,6 +84,14 @@ struct ThreadOptions {
   // processor group [0,1,2,3] may only contain half of the physical cores.
   std::vector<size_t> affinity;
 
+  // NUMA node or cache domain of each thread. Index is thread index, value is a domain ID. Threads steal work from
+  // threads of their own domain first, and parallel loops hand contiguous ranges of iterations to the threads of
+  // a domain. If the vector is empty, all of the threads form a single domain.
+  std::vector<int> domains;
+
+  // How idle threads wait for work when the thread pool allows spinning.
+  ThreadPoolSpinPolicy spin_policy = ThreadPoolSpinPolicy::Fixed;
+
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
 };
@@ -110,6 +137,12 @@ class Env {
   // This function doesn't support systems with more than 64 logical processors
   virtual std::vector<size_t> GetThreadAffinityMasks() const = 0;
 
+  // Returns the NUMA node of each logical processor, indexed by processor ID. Returns an empty vector if the
+  // topology is not known, in which case all processors are treated as belonging to one node.
+  virtual std::vector<int> GetProcessorNumaNodes() const {
+    return {};
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
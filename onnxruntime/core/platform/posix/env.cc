@@ -25,8 +25,10 @@ limitations under the License.
 #include <sys/mman.h>
 #include <fcntl.h>
 #include <dlfcn.h>
+#include <dirent.h>
 #include <ftw.h>
 #include <string.h>
+#include <fstream>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -227,6 +229,44 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<int> GetProcessorNumaNodes() const override {
+    std::vector<int> ret;
+#if defined(__linux__) && !defined(__ANDROID__)
+    // Each node directory lists its processors as ranges, e.g. "0-15,32-47".
+    const std::string node_path = "/sys/devices/system/node/";
+    DIR* dir = opendir(node_path.c_str());
+    if (dir == nullptr) {
+      return ret;
+    }
+    while (const dirent* entry = readdir(dir)) {
+      int node;
+      if (sscanf(entry->d_name, "node%d", &node) != 1) {
+        continue;
+      }
+      std::ifstream cpulist(node_path + entry->d_name + "/cpulist");
+      std::string range;
+      while (std::getline(cpulist, range, ',')) {
+        unsigned first, last;
+        const int fields = sscanf(range.c_str(), "%u-%u", &first, &last);
+        if (fields < 1) {
+          continue;
+        }
+        if (fields == 1) {
+          last = first;
+        }
+        if (ret.size() <= last) {
+          ret.resize(last + 1, 0);
+        }
+        for (unsigned cpu = first; cpu <= last; cpu++) {
+          ret[cpu] = node;
+        }
+      }
+    }
+    closedir(dir);
+#endif
+    return ret;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -113,11 +113,16 @@ template <typename EnabledOutputTypeList>
 void ConstantOfShapeBase<EnabledOutputTypeList>::SetValueFromTensorProto(const ONNX_NAMESPACE::TensorProto& t_proto) {
   ORT_ENFORCE(utils::HasDataType(t_proto));
   ORT_ENFORCE(ONNX_NAMESPACE::TensorProto::DataType_IsValid(t_proto.data_type()));
-  ORT_ENFORCE(!utils::HasExternalData(t_proto),
-              "Tensor proto with external data for value attribute is not supported.");
+  // data in memory is from a memory mapped ORT format model and is read like raw data
+  const void* raw_data = nullptr;
+  size_t raw_data_len = 0;
+  if (!utils::GetExternalDataInMemory(t_proto, raw_data, raw_data_len)) {
+    ORT_ENFORCE(!utils::HasExternalData(t_proto),
+                "Tensor proto with external data for value attribute is not supported.");
+    raw_data = utils::HasRawData(t_proto) ? t_proto.raw_data().data() : nullptr;
+    raw_data_len = utils::HasRawData(t_proto) ? t_proto.raw_data().size() : 0;
+  }
   const auto tensor_type = static_cast<ONNX_NAMESPACE::TensorProto_DataType>(t_proto.data_type());
-  const void* const raw_data = utils::HasRawData(t_proto) ? t_proto.raw_data().data() : nullptr;
-  const size_t raw_data_len = utils::HasRawData(t_proto) ? t_proto.raw_data().size() : 0;
   bool handled = false;
   switch (tensor_type) {
     CASE_FETCH_VALUE_DATA(bool)
@@ -3,6 +3,8 @@
 
 #include "einsum_auxiliary_ops.h"
 
+#include "core/mlas/inc/mlas.h"
+
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
@@ -47,6 +49,29 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
   return Status::OK();
 }
 
+// Issue all the batches as a single strided batch so that many small contractions are partitioned
+// across the batch dimension instead of each being dispatched to the thread pool on its own
+template <>
+Status MatMul<float>(const float* input_1_data, const float* input_2_data, float* output_data,
+                     size_t left_stride, size_t right_stride, size_t output_stride,
+                     size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                     void* /*einsum_cuda_assets*/) {
+  MLAS_SGEMM_STRIDED_BATCH_PARAMS data;
+  data.A = input_1_data;
+  data.lda = K;
+  data.StrideA = left_stride;
+  data.B = input_2_data;
+  data.ldb = N;
+  data.StrideB = right_stride;
+  data.C = output_data;
+  data.ldc = N;
+  data.StrideC = output_stride;
+
+  MlasGemmStridedBatch(CblasNoTrans, CblasNoTrans, M, N, K, data, num_batches, tp);
+
+  return Status::OK();
+}
+
 // CPU specific ReduceSum helper
 template <typename T>
 std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const std::vector<int64_t>& reduce_axes,
@@ -357,12 +382,6 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const std::vector<int64_t
 // Explicit template instantiations of functions
 
 // float
-template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
-    const float* input_1_data, const float* input_2_data, float* output_data,
-    size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-    void* einsum_cuda_assets);
-
 template std::unique_ptr<Tensor> MatMul<float>(
     const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
     const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
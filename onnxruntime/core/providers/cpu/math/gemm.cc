@@ -56,7 +56,7 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
 
-// opset 13 Adds BFloat16 support but we are not supporting it yet
+// opset 13 Adds BFloat16 support
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Gemm,
     13,
@@ -69,6 +69,18 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    Gemm<BFloat16>);
 
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
@@ -136,6 +148,92 @@ void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                 thread_pool);
 }
 
+// The 16-bit float types have no Eigen support, so broadcast the bias with plain copies.
+template <typename T>
+static void GemmBroadcastBias16(int64_t M, int64_t N, float beta,
+                                const T* c_data, const TensorShape* c_shape,
+                                T* y_data) {
+  if (beta == 0 || c_data == nullptr) {
+    return;
+  }
+
+  ORT_ENFORCE(c_shape != nullptr, "c_shape is required if c_data is provided");
+  if (c_shape->Size() == 1) {
+    // C is (), (1,) or (1, 1), set the scalar
+    std::fill_n(y_data, M * N, *c_data);
+  } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+    // C is (N,) or (1, N)
+    for (int64_t m = 0; m < M; ++m) {
+      std::copy_n(c_data, N, y_data + m * N);
+    }
+  } else if ((*c_shape)[1] == 1) {
+    // C is (M, 1)
+    for (int64_t m = 0; m < M; ++m) {
+      std::fill_n(y_data + m * N, N, c_data[m]);
+    }
+  } else {
+    // C is (M, N), no broadcast needed.
+    std::copy_n(c_data, M * N, y_data);
+  }
+}
+
+// MLFloat16 and BFloat16 are multiplied by MLAS directly from the 16-bit inputs, accumulating in float.
+template <typename T, typename GemmBatchFn>
+static void ComputeGemm16(GemmBatchFn gemm_batch,
+                          CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                          int64_t M, int64_t N, int64_t K,
+                          float alpha,
+                          const T* a_data, const T* b_data,
+                          float beta,
+                          const T* c_data, const TensorShape* c_shape,
+                          T* y_data,
+                          concurrency::ThreadPool* thread_pool) {
+  // if input is empty tensor, return directly as nothing need to be calculated.
+  if (M == 0 || N == 0)
+    return;
+
+  GemmBroadcastBias16(M, N, beta, c_data, c_shape, y_data);
+
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = reinterpret_cast<const uint16_t*>(a_data);
+  data.lda = static_cast<size_t>(trans_a == CblasNoTrans ? K : M);
+  data.B = reinterpret_cast<const uint16_t*>(b_data);
+  data.ldb = static_cast<size_t>(trans_b == CblasNoTrans ? N : K);
+  data.C = reinterpret_cast<uint16_t*>(y_data);
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha;
+  data.beta = c_data != nullptr ? beta : 0.0f;
+
+  gemm_batch(trans_a, trans_b, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+             &data, 1, thread_pool);
+}
+
+template <>
+void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                                  int64_t M, int64_t N, int64_t K,
+                                  float alpha,
+                                  const MLFloat16* a_data, const MLFloat16* b_data,
+                                  float beta,
+                                  const MLFloat16* c_data, const TensorShape* c_shape,
+                                  MLFloat16* y_data,
+                                  concurrency::ThreadPool* thread_pool) {
+  ComputeGemm16(MlasHalfGemmBatch, trans_a, trans_b, M, N, K, alpha, a_data, b_data, beta, c_data, c_shape, y_data,
+                thread_pool);
+}
+
+template <>
+void Gemm<BFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                                 int64_t M, int64_t N, int64_t K,
+                                 float alpha,
+                                 const BFloat16* a_data, const BFloat16* b_data,
+                                 float beta,
+                                 const BFloat16* c_data, const TensorShape* c_shape,
+                                 BFloat16* y_data,
+                                 concurrency::ThreadPool* thread_pool) {
+  ComputeGemm16(MlasBf16GemmBatch, trans_a, trans_b, M, N, K, alpha, a_data, b_data, beta, c_data, c_shape, y_data,
+                thread_pool);
+}
+
 template void Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                                        int64_t M, int64_t N, int64_t K,
                                        float alpha,
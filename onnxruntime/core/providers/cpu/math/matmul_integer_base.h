@@ -10,7 +10,12 @@ namespace onnxruntime {
 
 class MatMulIntegerBase : public OpKernel {
  public:
-  MatMulIntegerBase(const OpKernelInfo& info) : OpKernel(info) {}
+  MatMulIntegerBase(const OpKernelInfo& info) : OpKernel(info) {
+    // The packed layout of matrix B depends on the type of matrix A, which is the first input of all derived kernels.
+    const auto* a_type = info.node().InputDefs()[0]->TypeAsProto();
+    a_is_signed_ = a_type != nullptr &&
+                   a_type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_INT8;
+  }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                  /*out*/ bool& is_packed,
@@ -38,7 +43,7 @@ class MatMulIntegerBase : public OpKernel {
         std::swap(K, N);
         b_data = quantization::TransPoseInputData(b_data, b_trans_buffer, alloc, N, K);
       }
-      const size_t packed_b_size = MlasGemmPackBSize(N, K, b_is_signed_);
+      const size_t packed_b_size = MlasGemmPackBSize(N, K, a_is_signed_, b_is_signed_);
       if (packed_b_size == 0) {
         return Status::OK();
       }
@@ -51,7 +56,7 @@ class MatMulIntegerBase : public OpKernel {
       memset(packed_b_data, 0, packed_b_size);
 
       packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
-      MlasGemmPackB(N, K, b_data, N, b_is_signed_, packed_b_data);
+      MlasGemmPackB(N, K, b_data, N, a_is_signed_, b_is_signed_, packed_b_data);
 
       bool share_prepacked_weights = (prepacked_weights != nullptr);
       if (share_prepacked_weights) {
@@ -122,6 +127,7 @@ class MatMulIntegerBase : public OpKernel {
     return true;
   }
 
+  bool a_is_signed_{false};
   bool b_is_signed_{true};
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
@@ -13,20 +13,26 @@
 
 namespace onnxruntime {
 
-ONNX_OPERATOR_KERNEL_EX(
-    QLinearMatMul,
-    kOnnxDomain,
-    10,
-    kCpuExecutionProvider,
-    KernelDefBuilder()
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
-        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
-    QLinearMatMul);
+#define REGISTER_QLINEARMATMUL_TYPED_KERNEL(ACT_TYPE)                                                      \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                           \
+      QLinearMatMul,                                                                                       \
+      kOnnxDomain,                                                                                         \
+      10,                                                                                                  \
+      ACT_TYPE,                                                                                            \
+      kCpuExecutionProvider,                                                                               \
+      KernelDefBuilder()                                                                                   \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<ACT_TYPE>())                                   \
+          .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}) \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<ACT_TYPE>()),                                  \
+      QLinearMatMul);
+
+REGISTER_QLINEARMATMUL_TYPED_KERNEL(uint8_t)
+REGISTER_QLINEARMATMUL_TYPED_KERNEL(int8_t)
 
 Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
   const auto* a = ctx->Input<Tensor>(IN_A);
   const auto* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
+  const bool a_is_signed = a->IsDataType<int8_t>();
 
   // validate offsets
   const auto* a_offset = ctx->Input<Tensor>(IN_A_ZERO_POINT);
@@ -83,6 +89,7 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
   gemm_shape.M = static_cast<size_t>(helper.M());
   gemm_shape.N = static_cast<size_t>(helper.N());
   gemm_shape.K = static_cast<size_t>(helper.K());
+  gemm_shape.AIsSigned = a_is_signed;
   gemm_shape.BIsSigned = b_is_signed;
 
   AllocatorPtr alloc;
@@ -97,11 +104,13 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
   std::vector<MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR> requant_procs;
   requant_procs.reserve(num_gemms);
 
+  auto a_data = static_cast<const uint8_t*>(a->DataRaw());
   auto b_zp_data = static_cast<const uint8_t*>(b_offset->DataRaw());
+  auto* y_data = static_cast<uint8_t*>(y->MutableDataRaw());
   for (size_t i = 0; i < num_gemms; i++) {
-    gemm_params[i].A = a->template Data<uint8_t>() + helper.LeftOffsets()[i];
+    gemm_params[i].A = a_data + helper.LeftOffsets()[i];
     gemm_params[i].lda = gemm_shape.K;
-    gemm_params[i].ZeroPointA = *a_offset->template Data<uint8_t>();
+    gemm_params[i].ZeroPointA = *static_cast<const uint8_t*>(a_offset->DataRaw());
 
     gemm_params[i].B = b_data + helper.RightOffsets()[i];
     gemm_params[i].ldb = gemm_shape.N;
@@ -113,12 +122,21 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
 
     gemm_params[i].PerColumnZeroPoints = !IsScalarOr1ElementVector(b_offset);
 
-    requant_procs.emplace_back(y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                               static_cast<size_t>(helper.N()),
-                               nullptr,
-                               output_scales.data() + helper.RightScaleOffsets()[i],
-                               output_scales.size() > 1,
-                               *y_offset->template Data<uint8_t>());
+    if (a_is_signed) {
+      requant_procs.emplace_back(reinterpret_cast<int8_t*>(y_data) + helper.OutputOffsets()[i],
+                                 static_cast<size_t>(helper.N()),
+                                 nullptr,
+                                 output_scales.data() + helper.RightScaleOffsets()[i],
+                                 output_scales.size() > 1,
+                                 *y_offset->template Data<int8_t>());
+    } else {
+      requant_procs.emplace_back(y_data + helper.OutputOffsets()[i],
+                                 static_cast<size_t>(helper.N()),
+                                 nullptr,
+                                 output_scales.data() + helper.RightScaleOffsets()[i],
+                                 output_scales.size() > 1,
+                                 *y_offset->template Data<uint8_t>());
+    }
     gemm_params[i].OutputProcessor = &(requant_procs[i]);
   }
 
@@ -13,6 +13,7 @@
 
 namespace onnxruntime {
 
+template <typename ActType>
 class QLinearConv : public OpKernel {
  public:
   explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
@@ -66,8 +67,10 @@ class QLinearConv : public OpKernel {
     ORT_ENFORCE(IsValidQuantParam(W_zero_point, M),
                 "QLinearConv : filter zero point shape invalid");
 
-    X_zero_point_value = *(X_zero_point->template Data<uint8_t>());
-    Y_zero_point_value = *(Y_zero_point->template Data<uint8_t>());
+    // The zero points of a signed activation type are carried as their bit
+    // pattern and reinterpreted by the MLAS routines.
+    X_zero_point_value = *static_cast<const uint8_t*>(X_zero_point->DataRaw());
+    Y_zero_point_value = *static_cast<const uint8_t*>(Y_zero_point->DataRaw());
 
     const int64_t W_zero_point_size = W_zero_point->Shape().Size();
     const auto* W_zero_point_data = static_cast<const uint8_t*>(W_zero_point->DataRaw());
@@ -211,17 +214,24 @@ class QLinearConv : public OpKernel {
   bool is_symmetric_conv_{false};
   bool channels_last_{false};
   std::vector<int32_t> column_sums_;
+
+  static constexpr bool is_X_signed_ = std::is_same<ActType, int8_t>::value;
 };
 
-ONNX_CPU_OPERATOR_KERNEL(
-    QLinearConv,
-    10,
-    KernelDefBuilder()
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
-        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),
-    QLinearConv);
+#define REGISTER_QLINEARCONV_TYPED_KERNEL(ACT_TYPE)                                                              \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                                                  \
+      QLinearConv,                                                                                                 \
+      10,                                                                                                          \
+      ACT_TYPE,                                                                                                    \
+      KernelDefBuilder()                                                                                           \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<ACT_TYPE>())                                           \
+          .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}) \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<ACT_TYPE>())                                           \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),                                           \
+      QLinearConv<ACT_TYPE>);
+
+REGISTER_QLINEARCONV_TYPED_KERNEL(uint8_t)
+REGISTER_QLINEARCONV_TYPED_KERNEL(int8_t)
 
 #ifndef DISABLE_CONTRIB_OPS
 
@@ -229,23 +239,29 @@ namespace contrib {
 
 // Register an alternate version of this kernel that supports the channels_last
 // attribute in order to consume and produce NHWC tensors.
-ONNX_OPERATOR_KERNEL_EX(
-    QLinearConv,
-    kMSDomain,
-    1,
-    kCpuExecutionProvider,
-    KernelDefBuilder()
-        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
-        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),
-    QLinearConv);
+#define REGISTER_QLINEARCONV_NHWC_TYPED_KERNEL(ACT_TYPE)                                                         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                                   \
+      QLinearConv,                                                                                                 \
+      kMSDomain,                                                                                                   \
+      1,                                                                                                           \
+      ACT_TYPE,                                                                                                    \
+      kCpuExecutionProvider,                                                                                       \
+      KernelDefBuilder()                                                                                           \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<ACT_TYPE>())                                           \
+          .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}) \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<ACT_TYPE>())                                           \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),                                           \
+      QLinearConv<ACT_TYPE>);
+
+REGISTER_QLINEARCONV_NHWC_TYPED_KERNEL(uint8_t)
+REGISTER_QLINEARCONV_NHWC_TYPED_KERNEL(int8_t)
 
 }  // namespace contrib
 
 #endif
 
-Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+template <typename ActType>
+Status QLinearConv<ActType>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                             /*out*/ bool& is_packed,
                             /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
@@ -287,9 +303,9 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr al
 
   bool share_prepacked_weights = (prepacked_weights != nullptr);
 
-  // Determine if the symmetric weight convolution path can be used. The weights must be
-  // signed and all weight zero points must be zero.
-  if (is_W_signed_ && TryConvSymPrepack(Wdata,
+  // Determine if the symmetric weight convolution path can be used. The input must be
+  // unsigned, the weights must be signed and all weight zero points must be zero.
+  if (!is_X_signed_ && is_W_signed_ && TryConvSymPrepack(Wdata,
                                         alloc,
                                         output_channels,
                                         group_count,
@@ -302,7 +318,7 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr al
 
   // Don't pack the filter buffer if the MlasConvDepthwise path is used.
   if (group_input_channels != 1 && group_output_channels != 1) {
-    packed_W_size_ = MlasGemmPackBSize(group_output_channels, kernel_dim, is_W_signed_);
+    packed_W_size_ = MlasGemmPackBSize(group_output_channels, kernel_dim, is_X_signed_, is_W_signed_);
     if (packed_W_size_ != 0) {
       size_t packed_W_data_size = SafeInt<size_t>(group_count) * packed_W_size_;
       auto* packed_W = static_cast<uint8_t*>(alloc->Alloc(packed_W_data_size));
@@ -326,7 +342,7 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr al
 
       for (int64_t group_id = 0; group_id < conv_attrs_.group; ++group_id) {
         ReorderFilter(Wdata, group_reordered_W, group_output_channels, group_input_channels, kernel_size);
-        MlasGemmPackB(group_output_channels, kernel_dim, group_reordered_W, group_output_channels, is_W_signed_, packed_W);
+        MlasGemmPackB(group_output_channels, kernel_dim, group_reordered_W, group_output_channels, is_X_signed_, is_W_signed_, packed_W);
         packed_W += packed_W_size_;
         Wdata += W_offset;
       }
@@ -369,9 +385,10 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr al
   return Status::OK();
 }
 
-Status QLinearConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
-                                              int input_idx,
-                                              /*out*/ bool& used_shared_buffers) {
+template <typename ActType>
+Status QLinearConv<ActType>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                       int input_idx,
+                                                       /*out*/ bool& used_shared_buffers) {
   if (input_idx != 3) {
     return Status::OK();
   }
@@ -389,7 +406,8 @@ Status QLinearConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
-Status QLinearConv::Compute(OpKernelContext* context) const {
+template <typename ActType>
+Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
   const Tensor* X = context->Input<Tensor>(InputTensors::IN_X);
   const Tensor* W = is_W_packed_ ? nullptr : context->Input<Tensor>(InputTensors::IN_W);
   const auto& W_shape = W ? W->Shape() : W_shape_;
@@ -504,9 +522,9 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
     gemm_output_buffer = BufferUniquePtr(gemm_output_data, BufferDeleter(alloc));
   }
 
-  const auto* Xdata = X->template Data<uint8_t>();
+  const auto* Xdata = static_cast<const uint8_t*>(X->DataRaw());
   const auto* Bdata = B != nullptr ? B->template Data<int32_t>() : nullptr;
-  auto* Ydata = Y->template MutableData<uint8_t>();
+  auto* Ydata = static_cast<uint8_t*>(Y->MutableDataRaw());
 
   BufferUniquePtr transpose_input_buffer;
   BufferUniquePtr transpose_output_buffer;
@@ -642,6 +660,7 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
         MlasConvDepthwise(
             worker_indirection_buffer,
             X_zero_point_value,
+            is_X_signed_,
             reordered_W,
             W_zero_point_value,
             is_W_signed,
@@ -724,6 +743,7 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
           gemm_shape.M = static_cast<size_t>(output_count);
           gemm_shape.N = static_cast<size_t>(group_output_channels);
           gemm_shape.K = static_cast<size_t>(kernel_dim);
+          gemm_shape.AIsSigned = is_X_signed_;
           gemm_shape.BIsSigned = is_W_signed;
 
           MlasGemm(gemm_shape, gemm_params, nullptr);
@@ -733,12 +753,12 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
       MlasRequantizeOutput(
           worker_gemm_output,
           static_cast<size_t>(M),
-          worker_output,
+          reinterpret_cast<ActType*>(worker_output),
           static_cast<size_t>(M),
           Bdata,
           output_scales.data(),
           output_scales.size() > 1,
-          Y_zero_point_value,
+          static_cast<ActType>(Y_zero_point_value),
           0,
           0,
           static_cast<size_t>(output_count),
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
 #include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -283,6 +284,70 @@ TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t elemen
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+static void MlasFastReduceKR(MLAS_REDUCE_OPERATION operation, const Tensor& input, const std::vector<int64_t>& fast_shape,
+                             Tensor& output, concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  int64_t stridei = fast_shape[1];
+  concurrency::ThreadPool::TryParallelFor(
+      tp, fast_shape[0], ParallelReduceFastCost(1, stridei, sizeof(float), 6),
+      [operation, data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
+        MlasReduceContiguous(operation, data + first * stridei, out + first,
+                             static_cast<size_t>(last - first), static_cast<size_t>(stridei));
+      });
+}
+
+static void MlasFastReduceRK(MLAS_REDUCE_OPERATION operation, const Tensor& input, const std::vector<int64_t>& fast_shape,
+                             Tensor& output, concurrency::ThreadPool* tp) {
+  int64_t n_rows = fast_shape[0];
+  int64_t N = fast_shape[1];
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, N, ParallelReduceFastCost(1, n_rows, sizeof(float), 6),
+      [operation, data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+        MlasReduceStrided(operation, data + begin, out + begin, static_cast<size_t>(n_rows),
+                          static_cast<size_t>(end - begin), static_cast<size_t>(N));
+      });
+}
+
+static void MlasFastReduceKRK(MLAS_REDUCE_OPERATION operation, const Tensor& input, const std::vector<int64_t>& fast_shape,
+                              Tensor& output, concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  int64_t stridei = fast_shape[1] * fast_shape[2];
+  int64_t strideo = fast_shape[2];
+  concurrency::ThreadPool::TryParallelFor(
+      tp, fast_shape[0], ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(float), 6),
+      [operation, data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
+        for (ptrdiff_t j = begin; j < end; ++j) {
+          MlasReduceStrided(operation, data + j * stridei, out + j * strideo, static_cast<size_t>(fast_shape[1]),
+                            static_cast<size_t>(fast_shape[2]), static_cast<size_t>(fast_shape[2]));
+        }
+      });
+}
+
+#define REGISTER_MLAS_FAST_REDUCE(AGG, operation)                                                    \
+  template <>                                                                                        \
+  void AGG<float, float>::FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,  \
+                                       Tensor& output, concurrency::ThreadPool* tp) {                \
+    MlasFastReduceKR(operation, input, fast_shape, output, tp);                                      \
+  }                                                                                                  \
+  template <>                                                                                        \
+  void AGG<float, float>::FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,  \
+                                       Tensor& output, concurrency::ThreadPool* tp) {                \
+    MlasFastReduceRK(operation, input, fast_shape, output, tp);                                      \
+  }                                                                                                  \
+  template <>                                                                                        \
+  void AGG<float, float>::FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape, \
+                                        Tensor& output, concurrency::ThreadPool* tp) {               \
+    MlasFastReduceKRK(operation, input, fast_shape, output, tp);                                     \
+  }
+
+REGISTER_MLAS_FAST_REDUCE(ReduceAggregatorSum, MlasReduceSum)
+REGISTER_MLAS_FAST_REDUCE(ReduceAggregatorMax, MlasReduceMaximum)
+REGISTER_MLAS_FAST_REDUCE(ReduceAggregatorMin, MlasReduceMinimum)
+
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  const std::vector<int64_t>& reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
@@ -236,6 +236,17 @@ class ReduceAggregatorSum : public ReduceAggregator<T, TVAL> {
   }
 };
 
+// float reductions are implemented with MLAS in reduction_ops.cc.
+template <>
+void ReduceAggregatorSum<float, float>::FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                     Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorSum<float, float>::FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                     Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorSum<float, float>::FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                      Tensor& output, concurrency::ThreadPool* tp);
+
 template <typename T, typename TVAL = T>
 class ReduceAggregatorSumSquare : public ReduceAggregator<T, TVAL> {
  public:
@@ -368,6 +379,17 @@ class ReduceAggregatorMax : public ReduceAggregator<T, TVAL> {
   }
 };
 
+// float reductions are implemented with MLAS in reduction_ops.cc.
+template <>
+void ReduceAggregatorMax<float, float>::FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                     Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float, float>::FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                     Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float, float>::FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                      Tensor& output, concurrency::ThreadPool* tp);
+
 template <typename T, typename TVAL = int64_t>
 class ReduceAggregatorArgMinMax : public ReduceAggregator<T, TVAL> {
  protected:
@@ -527,6 +549,17 @@ class ReduceAggregatorMin : public ReduceAggregator<T, TVAL> {
   }
 };
 
+// float reductions are implemented with MLAS in reduction_ops.cc.
+template <>
+void ReduceAggregatorMin<float, float>::FastReduceKR(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                     Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMin<float, float>::FastReduceRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                     Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMin<float, float>::FastReduceKRK(const Tensor& input, const std::vector<int64_t>& fast_shape,
+                                                      Tensor& output, concurrency::ThreadPool* tp);
+
 template <typename T, typename TVAL = T>
 class ReduceAggregatorProd : public ReduceAggregator<T, TVAL> {
  public:
@@ -214,8 +214,8 @@ struct TensorCaster<std::string, DstType> {
 };
 
 #if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
+// specializations to use the optimized MlasConvertHalfToFloatBuffer() routine
+// for MLFloat16 -> float conversion
 
 // tensor MLFloat16 -> float
 template <>
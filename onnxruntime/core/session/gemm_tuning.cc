@@ -0,0 +1,312 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/gemm_tuning.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace gemm_tuning {
+
+namespace {
+
+constexpr const char* kTuningTableHeader = "# onnxruntime gemm tuning table v1";
+
+// M, N, K, batch size
+using GemmShape = std::tuple<size_t, size_t, size_t, size_t>;
+
+const char* KindToString(MLAS_GEMM_TUNING_KIND kind) {
+  return kind == MlasGemmTuningSgemm ? "sgemm" : "qgemm";
+}
+
+bool KindFromString(const std::string& str, MLAS_GEMM_TUNING_KIND& kind) {
+  if (str == "sgemm") {
+    kind = MlasGemmTuningSgemm;
+  } else if (str == "qgemm") {
+    kind = MlasGemmTuningQgemm;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool TryGetStaticShape(const NodeArg* node_arg, TensorShape& shape) {
+  if (node_arg == nullptr || !node_arg->Exists() || node_arg->Shape() == nullptr) {
+    return false;
+  }
+
+  for (const auto& dim : node_arg->Shape()->dim()) {
+    if (!dim.has_dim_value()) {
+      return false;
+    }
+  }
+
+  shape = utils::GetTensorShapeFromTensorShapeProto(*node_arg->Shape());
+  return true;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() ? it->second.i() : 0;
+}
+
+bool IsFloatTensor(const NodeArg* node_arg) {
+  const auto* type = node_arg->TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+// Computes M, N, K and the batch size of a MatMul of the given input shapes. This mirrors the shape inference of
+// MatMulComputeHelper in the CPU provider, which folds the batch dimensions of A into M when B is a matrix.
+bool ComputeMatMulGemmShape(const TensorShape& a_shape, const TensorShape& b_shape, bool trans_a, bool trans_b,
+                            GemmShape& gemm_shape) {
+  const size_t a_dims = a_shape.NumDimensions();
+  const size_t b_dims = b_shape.NumDimensions();
+  if (a_dims == 0 || b_dims == 0) {
+    return false;
+  }
+
+  if (!trans_a && a_dims >= 2 && b_dims >= 2 && a_dims >= b_dims &&
+      b_shape.SizeToDimension(b_dims - 1) == b_shape[b_dims - 2]) {
+    const int64_t k = a_shape[a_dims - 1];
+    if (k != b_shape[trans_b ? b_dims - 1 : b_dims - 2]) {
+      return false;
+    }
+    gemm_shape = GemmShape{static_cast<size_t>(a_shape.SizeToDimension(a_dims - 1)),
+                           static_cast<size_t>(trans_b ? b_shape[b_dims - 2] : b_shape[b_dims - 1]),
+                           static_cast<size_t>(k), 1};
+    return true;
+  }
+
+  // pad both shapes to the same rank, a vector B becomes (..., K, 1) and moves the rows of A into the batch
+  const size_t num_dims = std::max(a_dims, b_dims) + (b_dims == 1 ? 1 : 0);
+  std::vector<int64_t> a_padded(num_dims, 1);
+  std::vector<int64_t> b_padded(num_dims, 1);
+  if (b_dims == 1) {
+    b_padded[num_dims - 2] = b_shape[0];
+    if (a_dims >= 2) {
+      for (size_t i = 0; i < a_dims - 2; ++i) {
+        a_padded[i] = a_shape[i];
+      }
+      a_padded[num_dims - 3] = a_shape[trans_a ? a_dims - 1 : a_dims - 2];
+      a_padded[num_dims - 1] = a_shape[trans_a ? a_dims - 2 : a_dims - 1];
+    } else {
+      a_padded[num_dims - 1] = a_shape[0];
+    }
+  } else {
+    for (size_t i = 0; i < a_dims; ++i) {
+      a_padded[num_dims - a_dims + i] = a_shape[i];
+    }
+    for (size_t i = 0; i < b_dims; ++i) {
+      b_padded[num_dims - b_dims + i] = b_shape[i];
+    }
+  }
+
+  size_t batch_size = 1;
+  for (size_t i = 0; i + 2 < num_dims; ++i) {
+    if (a_padded[i] != b_padded[i] && a_padded[i] != 1 && b_padded[i] != 1) {
+      return false;
+    }
+    batch_size *= static_cast<size_t>(std::max(a_padded[i], b_padded[i]));
+  }
+
+  const bool has_vector = a_dims == 1 || b_dims == 1;
+  const int64_t m = has_vector ? 1 : a_shape[trans_a ? a_dims - 1 : a_dims - 2];
+  const int64_t k = a_dims == 1 ? a_shape[0] : a_shape[trans_a ? a_dims - 2 : a_dims - 1];
+  const int64_t n = b_dims == 1 ? 1 : b_shape[trans_b ? b_dims - 2 : b_dims - 1];
+  if (k != (b_dims == 1 ? b_shape[0] : b_shape[trans_b ? b_dims - 1 : b_dims - 2]) || batch_size == 0) {
+    return false;
+  }
+
+  gemm_shape = GemmShape{static_cast<size_t>(m), static_cast<size_t>(n), static_cast<size_t>(k), batch_size};
+  return true;
+}
+
+// Computes the shape of the MlasGemmBatch call made by the CPU kernel of the node.
+bool GetGemmShape(const Node& node, MLAS_GEMM_TUNING_KIND& kind, GemmShape& gemm_shape) {
+  const auto& op_type = node.OpType();
+  const auto& domain = node.Domain();
+  const auto& inputs = node.InputDefs();
+
+  const bool is_onnx_domain = domain == kOnnxDomain || domain == kOnnxDomainAlias;
+  const bool is_ms_domain = domain == kMSDomain;
+
+  size_t right_index = 1;
+  bool trans_a = false;
+  bool trans_b = false;
+
+  if (is_onnx_domain && op_type == "Gemm") {
+    TensorShape a_shape;
+    TensorShape b_shape;
+    if (!IsFloatTensor(inputs[0]) || !TryGetStaticShape(inputs[0], a_shape) ||
+        !TryGetStaticShape(inputs[1], b_shape) || a_shape.NumDimensions() != 2 || b_shape.NumDimensions() != 2) {
+      return false;
+    }
+
+    trans_a = GetIntAttribute(node, "transA") != 0;
+    trans_b = GetIntAttribute(node, "transB") != 0;
+
+    kind = MlasGemmTuningSgemm;
+    gemm_shape = GemmShape{static_cast<size_t>(trans_a ? a_shape[1] : a_shape[0]),
+                           static_cast<size_t>(trans_b ? b_shape[0] : b_shape[1]),
+                           static_cast<size_t>(trans_a ? a_shape[0] : a_shape[1]),
+                           1};
+    return true;
+  }
+
+  if (is_onnx_domain && op_type == "MatMul") {
+    if (!IsFloatTensor(inputs[0])) {
+      return false;
+    }
+    kind = MlasGemmTuningSgemm;
+  } else if (is_ms_domain && op_type == "FusedMatMul") {
+    if (!IsFloatTensor(inputs[0]) || GetIntAttribute(node, "transBatchA") != 0 ||
+        GetIntAttribute(node, "transBatchB") != 0) {
+      return false;
+    }
+    trans_a = GetIntAttribute(node, "transA") != 0;
+    trans_b = GetIntAttribute(node, "transB") != 0;
+    kind = MlasGemmTuningSgemm;
+  } else if (is_onnx_domain && op_type == "MatMulInteger") {
+    kind = MlasGemmTuningQgemm;
+  } else if (is_onnx_domain && op_type == "QLinearMatMul") {
+    right_index = 3;
+    kind = MlasGemmTuningQgemm;
+  } else if (is_ms_domain && (op_type == "MatMulIntegerToFloat" || op_type == "DynamicQuantizeMatMul")) {
+    kind = MlasGemmTuningQgemm;
+  } else {
+    return false;
+  }
+
+  TensorShape a_shape;
+  TensorShape b_shape;
+  if (inputs.size() <= right_index || !TryGetStaticShape(inputs[0], a_shape) ||
+      !TryGetStaticShape(inputs[right_index], b_shape)) {
+    return false;
+  }
+
+  // match the kernels, which ignore transpose for vectors
+  trans_a = trans_a && a_shape.NumDimensions() != 1;
+  trans_b = trans_b && b_shape.NumDimensions() != 1;
+
+  return ComputeMatMulGemmShape(a_shape, b_shape, trans_a, trans_b, gemm_shape);
+}
+
+}  // namespace
+
+Status LoadTuningTable(const std::string& path, const logging::Logger& logger) {
+  std::ifstream stream(path);
+  if (!stream.is_open()) {
+    LOGS(logger, INFO) << "GEMM tuning table " << path << " does not exist yet.";
+    return Status::OK();
+  }
+
+  std::string line;
+  size_t line_number = 0;
+  std::vector<MLAS_GEMM_TUNING_ENTRY> entries;
+
+  while (std::getline(stream, line)) {
+    ++line_number;
+
+    if (line_number == 1) {
+      ORT_RETURN_IF_NOT(line == kTuningTableHeader, "GEMM tuning table ", path, " has an unsupported header: ", line);
+      continue;
+    }
+
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream line_stream(line);
+    std::string kind;
+    MLAS_GEMM_TUNING_ENTRY entry;
+
+    line_stream >> kind >> entry.M >> entry.N >> entry.K >> entry.BatchSize >> entry.MaximumThreadCount >>
+        entry.ThreadCountM >> entry.ThreadCountN;
+
+    ORT_RETURN_IF(line_stream.fail() || !KindFromString(kind, entry.Kind) || entry.ThreadCountM == 0 ||
+                      entry.ThreadCountN == 0,
+                  "GEMM tuning table ", path, " has an invalid entry on line ", line_number, ": ", line);
+
+    entries.push_back(entry);
+  }
+
+  // only publish the entries once the whole file has been validated
+  MlasGemmTuningSetEntries(entries.data(), entries.size());
+
+  LOGS(logger, INFO) << "Loaded " << entries.size() << " entries from GEMM tuning table " << path;
+  return Status::OK();
+}
+
+Status SaveTuningTable(const std::string& path) {
+  std::vector<MLAS_GEMM_TUNING_ENTRY> entries(MlasGemmTuningGetEntries(nullptr, 0));
+  entries.resize(MlasGemmTuningGetEntries(entries.data(), entries.size()));
+
+  std::ofstream stream(path, std::ios::out | std::ios::trunc);
+  ORT_RETURN_IF_NOT(stream.is_open(), "Failed to open GEMM tuning table ", path, " for writing.");
+
+  stream << kTuningTableHeader << "\n"
+         << "# kind M N K batch_size max_threads thread_count_m thread_count_n\n";
+
+  for (const auto& entry : entries) {
+    stream << KindToString(entry.Kind) << " " << entry.M << " " << entry.N << " " << entry.K << " "
+           << entry.BatchSize << " " << entry.MaximumThreadCount << " " << entry.ThreadCountM << " "
+           << entry.ThreadCountN << "\n";
+  }
+
+  ORT_RETURN_IF_NOT(stream.good(), "Failed to write GEMM tuning table ", path);
+  return Status::OK();
+}
+
+Status TuneGraph(const GraphViewer& graph_viewer, concurrency::ThreadPool* thread_pool,
+                 const logging::Logger& logger) {
+  const size_t max_threads = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+
+  // shapes that are already tuned for this degree of parallelism, including ones loaded from a file
+  std::set<std::pair<MLAS_GEMM_TUNING_KIND, GemmShape>> tuned;
+  {
+    std::vector<MLAS_GEMM_TUNING_ENTRY> entries(MlasGemmTuningGetEntries(nullptr, 0));
+    entries.resize(MlasGemmTuningGetEntries(entries.data(), entries.size()));
+    for (const auto& entry : entries) {
+      if (entry.MaximumThreadCount == max_threads) {
+        tuned.emplace(entry.Kind, GemmShape{entry.M, entry.N, entry.K, entry.BatchSize});
+      }
+    }
+  }
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+
+    MLAS_GEMM_TUNING_KIND kind;
+    GemmShape shape;
+    if (!GetGemmShape(node, kind, shape) || std::get<0>(shape) * std::get<1>(shape) * std::get<2>(shape) == 0 ||
+        !tuned.emplace(kind, shape).second) {
+      continue;
+    }
+
+    MLAS_GEMM_TUNING_ENTRY entry;
+    MlasGemmTune(kind, std::get<0>(shape), std::get<1>(shape), std::get<2>(shape), std::get<3>(shape),
+                 thread_pool, &entry);
+
+    LOGS(logger, INFO) << "Tuned " << KindToString(kind) << " for node " << node.Name() << " with shape M="
+                       << entry.M << " N=" << entry.N << " K=" << entry.K << " batch=" << entry.BatchSize
+                       << ": " << entry.ThreadCountM << "x" << entry.ThreadCountN << " threads of " << max_threads;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace gemm_tuning
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+namespace gemm_tuning {
+
+// Loads the entries of a tuning table file into the process wide MLAS GEMM tuning table.
+// A file that does not exist is not an error, so the same path can be used to create the table.
+Status LoadTuningTable(const std::string& path, const logging::Logger& logger);
+
+// Writes the entries of the process wide MLAS GEMM tuning table to a file.
+Status SaveTuningTable(const std::string& path);
+
+// Measures the thread partitioning of every CPU GEMM in the graph with a static shape that does not have
+// an entry in the tuning table yet, using the thread pool the kernels will run on.
+Status TuneGraph(const GraphViewer& graph_viewer, concurrency::ThreadPool* thread_pool,
+                 const logging::Logger& logger);
+
+}  // namespace gemm_tuning
+}  // namespace onnxruntime
@@ -4,7 +4,9 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <unordered_set>
 #include <list>
@@ -47,7 +49,9 @@
 #include "core/providers/dml/DmlExecutionProvider/src/GraphTransformer.h"
 #endif
 #include "core/session/environment.h"
+#include "core/session/gemm_tuning.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_run.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
@@ -320,6 +324,16 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                              session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                              to.affinity_vec_len == 0;
       to.allow_spinning = allow_intra_op_spinning;
+      const std::string spin_policy =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpSpinPolicy, "fixed");
+      if (spin_policy == "adaptive") {
+        to.spin_policy = ThreadPoolSpinPolicy::Adaptive;
+      } else if (spin_policy == "run") {
+        to.spin_policy = ThreadPoolSpinPolicy::DuringRun;
+      } else {
+        ORT_ENFORCE(spin_policy == "fixed", "Invalid value for ", kOrtSessionOptionsConfigIntraOpSpinPolicy, ": ",
+                    spin_policy);
+      }
       thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
     }
@@ -440,6 +454,11 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  {
+    std::unique_lock<onnxruntime::OrtMutex> lock(async_runs_mutex_);
+    async_runs_done_.wait(lock, [this]() { return num_pending_async_runs_ == 0; });
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -965,15 +984,25 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
+// If map_file is true and the file can be memory mapped, mapped_bytes holds the mapping and bytes refers to it.
+// Otherwise the file is read into bytes_data_holder.
 template <typename T>
 static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                                 std::basic_string<ORTCHAR_T>& model_location,
                                 gsl::span<const uint8_t>& bytes,
-                                std::vector<uint8_t>& bytes_data_holder) {
+                                std::vector<uint8_t>& bytes_data_holder,
+                                bool map_file,
+                                Env::MappedMemoryPtr& mapped_bytes) {
   size_t num_bytes = 0;
   model_location = ToWideString(model_uri);
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location.c_str(), num_bytes));
 
+  if (map_file && num_bytes > 0 &&
+      Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, mapped_bytes).IsOK()) {
+    bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes.get()), num_bytes);
+    return Status::OK();
+  }
+
   bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
@@ -993,9 +1022,12 @@ static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
 Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
   return LoadOrtModel(
       [&]() {
+        const bool map_file =
+            GetSessionOptions().config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapOrtModelFile, "0") == "1";
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              map_file, ort_format_model_mapped_bytes_));
         return Status::OK();
       });
 }
@@ -1004,9 +1036,12 @@ Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
 Status InferenceSession::LoadOrtModel(const std::wstring& model_uri) {
   return LoadOrtModel(
       [&]() {
+        const bool map_file =
+            GetSessionOptions().config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapOrtModelFile, "0") == "1";
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              map_file, ort_format_model_mapped_bytes_));
         return Status::OK();
       });
 }
@@ -1067,15 +1102,23 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   const auto* fbs_model = fbs_session->model();
   ORT_RETURN_IF(nullptr == fbs_model, "Missing Model. Invalid ORT format model.");
 
+  // the mapped bytes are kept for the lifetime of the session so the initializers can refer to them
+  const bool can_use_flatbuffer_for_initializers = ort_format_model_mapped_bytes_ != nullptr;
+  if (can_use_flatbuffer_for_initializers) {
+    LOGS(*session_logger_, INFO) << "Using initializers from the memory mapped ORT format model.";
+  }
+
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
 #if !defined(ORT_MINIMAL_BUILD)
   ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model,
                                                HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                               can_use_flatbuffer_for_initializers,
                                                *session_logger_, tmp_model));
 
 #else
-  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, *session_logger_, tmp_model));
+  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, can_use_flatbuffer_for_initializers,
+                                               *session_logger_, tmp_model));
 #endif
 
   ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
@@ -1311,18 +1354,7 @@ common::Status InferenceSession::Initialize() {
 #endif
 
     // now that we have all the execution providers, create the session state
-    session_state_ = std::make_unique<SessionState>(
-        model_->MainGraph(),
-        execution_providers_,
-        session_options_.enable_mem_pattern && session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL,
-        GetIntraOpThreadPoolToUse(),
-        GetInterOpThreadPoolToUse(),
-        data_transfer_mgr_,
-        *session_logger_,
-        session_profiler_,
-        session_options_.use_deterministic_compute,
-        session_options_.enable_mem_reuse,
-        prepacked_weights_container_);
+    ORT_RETURN_IF_ERROR(CreateSessionState());
 
     // Collect the kernel registries from execution provider instances;
     // There are 2 kinds of kernel registries with priority from high to low as below,
@@ -1432,11 +1464,26 @@ common::Status InferenceSession::Initialize() {
     }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+    // load and optionally extend the per-machine GEMM tuning table now that the kernels are assigned
+    const std::string gemm_tuning_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGemmTuningFile, "");
+    if (!gemm_tuning_file.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(gemm_tuning::LoadTuningTable(gemm_tuning_file, *session_logger_));
+    }
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGemmAutotune, "0") == "1") {
+      ORT_RETURN_IF_ERROR_SESSIONID_(gemm_tuning::TuneGraph(session_state_->GetGraphViewer(),
+                                                            session_state_->GetThreadPool(), *session_logger_));
+      if (!gemm_tuning_file.empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(gemm_tuning::SaveTuningTable(gemm_tuning_file));
+      }
+    }
+
     session_state_->ResolveMemoryPatternFlag();
     is_inited_ = true;
 
-    // we don't directly use the ORT format bytes currently, so free those now
-    // TODO, we may need to keep the bytes if we are using the offset directly in the initializers
+    // free the ORT format bytes now unless they are memory mapped, in which case the initializers may refer to them
+    // and ort_format_model_mapped_bytes_ keeps them until the session is destroyed
     ort_format_model_bytes_ = gsl::span<const uint8_t>();
     std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
 
@@ -1738,10 +1785,210 @@ Status InferenceSession::PartialRun(onnxruntime::RunOptions& run_options,
 }
 #endif
 
+common::Status InferenceSession::ValidatePreparedRun(const PreparedRun& prepared_run,
+                                                     const std::vector<OrtValue>& feeds,
+                                                     const std::vector<OrtValue>* p_fetches) const {
+  if (&prepared_run.session_ != this) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "PreparedRun was created by a different InferenceSession.");
+  }
+
+  const auto& feed_names = prepared_run.GetFeedNames();
+  if (feed_names.size() != feeds.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: feed_names has ", feed_names.size(),
+                           "elements, but feeds has ", feeds.size(), " elements.");
+  }
+
+  if (p_fetches == nullptr) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL");
+  }
+
+  const auto num_outputs = prepared_run.GetOutputNames().size();
+  if (!p_fetches->empty() && (num_outputs != p_fetches->size())) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output vector incorrectly sized: output_names.size(): ",
+                           num_outputs, "p_fetches->size(): ", p_fetches->size());
+  }
+
+  // the names were validated in PrepareRun. check the feeds are tensors of the expected types with shapes the model
+  // accepts. anything else goes through the full validation to produce the right error.
+  bool valid = true;
+  for (size_t i = 0, end = feeds.size(); i < end && valid; ++i) {
+    const auto* expected_type = prepared_run.feed_element_types_[i];
+    valid = expected_type != nullptr && feeds[i].IsTensor() && feeds[i].Get<Tensor>().DataType() == expected_type;
+
+    if (valid) {
+      const auto& expected_shape = prepared_run.feed_shapes_[i];
+      valid = expected_shape.NumDimensions() == 0 ||
+              CheckShapes(feed_names[i], feeds[i].Get<Tensor>().Shape(), expected_shape).IsOK();
+    }
+  }
+
+  return valid ? Status::OK() : ValidateInputs(feed_names, feeds);
+}
+
+common::Status InferenceSession::PrepareRun(const std::vector<std::string>& feed_names,
+                                            const std::vector<std::string>& output_names,
+                                            const std::vector<OrtDevice>* p_fetches_device_info,
+                                            std::unique_ptr<PreparedRun>* prepared_run) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  std::vector<MLDataType> feed_element_types;
+  std::vector<TensorShape> feed_shapes;
+  feed_element_types.reserve(feed_names.size());
+  feed_shapes.reserve(feed_names.size());
+
+  for (const auto& feed_name : feed_names) {
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
+    }
+
+    auto expected_type = iter->second.ml_data_type;
+    if (expected_type->IsTensorType()) {
+      feed_element_types.push_back(expected_type->AsTensorType()->GetElementType());
+      feed_shapes.push_back(iter->second.tensor_shape);
+    } else {
+      feed_element_types.push_back(nullptr);
+      feed_shapes.emplace_back();
+    }
+  }
+
+  std::vector<OrtValue> no_fetches;
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, &no_fetches));
+
+  if (p_fetches_device_info && p_fetches_device_info->size() != output_names.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: output_names has ", output_names.size(),
+                           " elements, but fetches device info has ", p_fetches_device_info->size(), " elements.");
+  }
+
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager;
+  ORT_RETURN_IF_ERROR_SESSIONID_(FeedsFetchesManager::Create(feed_names, output_names,
+                                                             session_state_->GetOrtValueNameIdxMap(),
+                                                             feeds_fetches_manager));
+
+  if (p_fetches_device_info) {
+    // populate the target device info. ignored if pre-allocated fetches are provided
+    const auto& fetch_device_info = *p_fetches_device_info;
+    auto& fetch_info = feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
+
+    for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+      fetch_info[i].target_device = fetch_device_info[i];
+    }
+  }
+
+  ORT_RETURN_IF_ERROR_SESSIONID_(utils::InitializeFeedFetchCopyInfo(*session_state_, *feeds_fetches_manager));
+
+  // private constructor, can't use make_unique
+  prepared_run->reset(new PreparedRun(*this, std::move(feeds_fetches_manager), std::move(feed_element_types),
+                                      std::move(feed_shapes)));
+  return Status::OK();
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches) {
+  return RunImpl(run_options, &prepared_run, prepared_run.GetFeedNames(), feeds, prepared_run.GetOutputNames(),
+                 p_fetches, nullptr);
+}
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
                              const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  return RunImpl(run_options, nullptr, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+}
+
+Status InferenceSession::RunAsync(const RunOptions* run_options, const std::vector<std::string>& feed_names,
+                                  const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                                  std::vector<OrtValue> fetches, RunAsyncCallback callback) {
+  if (!callback) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "RunAsync requires a callback.");
+  }
+
+  concurrency::ThreadPool* tp = GetInterOpThreadPoolToUse();
+  if (tp == nullptr) {
+    tp = GetIntraOpThreadPoolToUse();
+  }
+
+  // Schedule runs the function on the calling thread if there are no worker threads, which would make
+  // the call blocking and invoke the callback before RunAsync returns.
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "RunAsync requires the session to have a thread pool with at least one worker thread.");
+  }
+
+  {
+    std::lock_guard<onnxruntime::OrtMutex> lock(async_runs_mutex_);
+    ++num_pending_async_runs_;
+  }
+
+  concurrency::ThreadPool::Schedule(
+      tp, [this, run_options, feed_names, feeds, output_names,
+           fetches = std::move(fetches), callback = std::move(callback)]() mutable {
+        // Run converts any exception to a failed status
+        Status status = run_options != nullptr
+                            ? Run(*run_options, feed_names, feeds, output_names, &fetches)
+                            : Run(RunOptions(), feed_names, feeds, output_names, &fetches);
+
+        callback(status, fetches);
+
+        // notify under the lock as the session may be destroyed as soon as the destructor sees no pending runs
+        std::lock_guard<onnxruntime::OrtMutex> lock(async_runs_mutex_);
+        if (--num_pending_async_runs_ == 0) {
+          async_runs_done_.notify_all();
+        }
+      });
+
+  return Status::OK();
+}
+
+// Set the thread pool priority and deadline of a Run from the run options, if given
+static Status SetRunPriority(const RunOptions& run_options,
+                             std::optional<concurrency::ThreadPool::PriorityScope>& priority_scope) {
+  const std::string priority_str = run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigPriority, "");
+  const std::string deadline_str = run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigDeadlineUs, "");
+  if (priority_str.empty() && deadline_str.empty()) {
+    return Status::OK();
+  }
+
+  ThreadPoolPriority priority = ThreadPoolPriority::Normal;
+  if (priority_str == "high") {
+    priority = ThreadPoolPriority::High;
+  } else if (!priority_str.empty() && priority_str != "normal") {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtRunOptionsConfigPriority, ": ",
+                           priority_str);
+  }
+
+  std::chrono::steady_clock::time_point deadline;
+  if (!deadline_str.empty()) {
+    int64_t deadline_us = 0;
+    if (!TryParseStringWithClassicLocale<int64_t>(deadline_str, deadline_us) || deadline_us < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtRunOptionsConfigDeadlineUs, ": ",
+                             deadline_str);
+    }
+
+    // a deadline past the range of steady_clock can never be reached, so it is the same as not having one.
+    // compare in microseconds as converting large values to the clock's duration would overflow.
+    const auto now = std::chrono::steady_clock::now();
+    const auto max_deadline_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::time_point::max() - now);
+    if (deadline_us < max_deadline_us.count()) {
+      deadline = now + std::chrono::microseconds(deadline_us);
+    }
+  }
+
+  priority_scope.emplace(priority, deadline);
+  return Status::OK();
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options, const PreparedRun* prepared_run,
+                                 const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                 const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -1759,6 +2006,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
   exec_providers_to_stop.reserve(execution_providers_.NumProviders());
 
   std::vector<AllocatorPtr> arenas_to_shrink;
+  bool run_started = false;
 
   ORT_TRY {
     if (!is_inited_) {
@@ -1769,8 +2017,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
     // log evaluation start to trace logging provider
     env.GetTelemetryProvider().LogEvaluationStart();
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    if (prepared_run) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidatePreparedRun(*prepared_run, feeds, p_fetches));
+    } else {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    }
 
     // shrink certain default memory arenas if the user has requested for it
     const std::string& shrink_memory_arenas =
@@ -1780,24 +2032,53 @@ Status InferenceSession::Run(const RunOptions& run_options,
       ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
     }
 
-    FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-    FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+    // priority and deadline of the thread pool work for this Run
+    std::optional<concurrency::ThreadPool::PriorityScope> priority_scope;
+    ORT_RETURN_IF_ERROR_SESSIONID_(SetRunPriority(run_options, priority_scope));
+
+    std::unique_ptr<FeedsFetchesManager> owned_feeds_fetches_manager;
+    FeedsFetchesManager* p_feeds_fetches_manager = nullptr;
+
+    if (prepared_run) {
+      const auto& prepared_manager = *prepared_run->feeds_fetches_manager_;
+      if (prepared_manager.GetDeviceCopyChecks().status == DeviceCopyCheck::NoCopy) {
+        // nothing will be modified during execution so the prepared instance can be shared
+        p_feeds_fetches_manager = prepared_run->feeds_fetches_manager_.get();
+      } else {
+        // the copy info gets finalized based on the feeds and fetches of this call, so start from a copy of the
+        // prepared state. this is still cheaper than mapping the names and calculating the static copy info.
+        FeedsFetchesInfo info = prepared_manager.GetFeedsFetchesInfo();
+        owned_feeds_fetches_manager = std::make_unique<FeedsFetchesManager>(std::move(info));
+        owned_feeds_fetches_manager->GetMutableFeedsDeviceCopyInfo() = prepared_manager.GetFeedsDeviceCopyInfo();
+        owned_feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo() = prepared_manager.GetFetchesDeviceCopyInfo();
+        p_feeds_fetches_manager = owned_feeds_fetches_manager.get();
+      }
+    } else {
+      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
+      owned_feeds_fetches_manager = std::make_unique<FeedsFetchesManager>(std::move(info));
+      p_feeds_fetches_manager = owned_feeds_fetches_manager.get();
 
-    if (p_fetches_device_info) {
-      // populate the target device info. ignored if pre-allocated fetches are provided
-      const auto& fetch_device_info = *p_fetches_device_info;
-      auto& fetch_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
+      if (p_fetches_device_info) {
+        // populate the target device info. ignored if pre-allocated fetches are provided
+        const auto& fetch_device_info = *p_fetches_device_info;
+        auto& fetch_info = p_feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
 
-      for (size_t i = 0, end = output_names.size(); i < end; ++i) {
-        fetch_info[i].target_device = fetch_device_info[i];
+        for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+          fetch_info[i].target_device = fetch_device_info[i];
+        }
       }
     }
 
+    FeedsFetchesManager& feeds_fetches_manager = *p_feeds_fetches_manager;
+
     if (!run_options.run_tag.empty()) {
       LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
     }
 
     ++current_num_runs_;
+    concurrency::ThreadPool::StartRun(GetIntraOpThreadPoolToUse());
+    concurrency::ThreadPool::StartRun(GetInterOpThreadPoolToUse());
+    run_started = true;
 
     // scope of owned_run_logger is just the call to Execute.
     // If Execute ever becomes async we need a different approach
@@ -1829,9 +2110,17 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
     session_state_->IncrementGraphExecutionCounter();
 #endif
-    ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
-                                                 session_options_.execution_mode, run_options.terminate, run_logger,
-                                                 run_options.only_execute_path_to_fetches));
+    if (prepared_run) {
+      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraphWithInitializedCopyInfo(*session_state_, feeds_fetches_manager,
+                                                                          feeds, *p_fetches,
+                                                                          session_options_.execution_mode,
+                                                                          run_options.terminate, run_logger,
+                                                                          run_options.only_execute_path_to_fetches));
+    } else {
+      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
+                                                   session_options_.execution_mode, run_options.terminate, run_logger,
+                                                   run_options.only_execute_path_to_fetches));
+    }
   }
   ORT_CATCH(const std::exception& e) {
     ORT_HANDLE_EXCEPTION([&]() {
@@ -1852,6 +2141,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
     ShrinkMemoryArenas(arenas_to_shrink);
   }
 
+  if (run_started) {
+    concurrency::ThreadPool::EndRun(GetInterOpThreadPoolToUse());
+    concurrency::ThreadPool::EndRun(GetIntraOpThreadPoolToUse());
+  }
   --current_num_runs_;
 
   // keep track of telemetry
@@ -2100,6 +2393,88 @@ common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model)
 }
 #endif
 
+common::Status InferenceSession::CreateSessionState() {
+  session_state_ = std::make_unique<SessionState>(
+      model_->MainGraph(),
+      execution_providers_,
+      session_options_.enable_mem_pattern && session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL,
+      GetIntraOpThreadPoolToUse(),
+      GetInterOpThreadPoolToUse(),
+      data_transfer_mgr_,
+      *session_logger_,
+      session_profiler_,
+      session_options_.use_deterministic_compute,
+      session_options_.enable_mem_reuse,
+      prepacked_weights_container_);
+
+  const std::string mem_pattern_cache_size =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheSize, "");
+  if (!mem_pattern_cache_size.empty()) {
+    size_t capacity = 0;
+    if (!TryParseStringWithClassicLocale<size_t>(mem_pattern_cache_size, capacity)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                             kOrtSessionOptionsConfigMemoryPatternCacheSize, ": ", mem_pattern_cache_size);
+    }
+    session_state_->SetMemoryPatternCacheCapacity(capacity);
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::Clone(const SessionOptions& session_options, const Environment& session_env,
+                                       std::unique_ptr<InferenceSession>& clone) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  // the execution plans are shared, so keep the settings they were created with
+  SessionOptions clone_options = session_options;
+  clone_options.execution_mode = session_options_.execution_mode;
+  clone_options.execution_order = session_options_.execution_order;
+  clone_options.enable_mem_reuse = session_options_.enable_mem_reuse;
+
+  auto new_session = std::make_unique<InferenceSession>(clone_options, session_env);
+  ORT_RETURN_IF_ERROR(new_session->InitializeFromSession(*this));
+
+  clone = std::move(new_session);
+  return Status::OK();
+}
+
+common::Status InferenceSession::InitializeFromSession(const InferenceSession& source) {
+  std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+
+  model_ = source.model_;
+  model_location_ = source.model_location_;
+  model_metadata_ = source.model_metadata_;
+  required_inputs_ = source.required_inputs_;
+  input_def_map_ = source.input_def_map_;
+  output_def_list_ = source.output_def_list_;
+  model_output_names_ = source.model_output_names_;
+  is_model_loaded_ = true;
+
+  // the kernels were created for these provider instances so they have to be shared
+  for (const auto& provider : source.execution_providers_) {
+    auto p_data_xfr = provider->GetDataTransfer();
+    if (p_data_xfr) {
+      ORT_RETURN_IF_ERROR(data_transfer_mgr_.RegisterDataTransfer(std::move(p_data_xfr)));
+    }
+
+    ORT_RETURN_IF_ERROR(execution_providers_.Add(provider->Type(), provider));
+  }
+
+  ORT_RETURN_IF_ERROR(CreateSessionState());
+  ORT_RETURN_IF_ERROR(session_state_->InitializeFromFinalizedSessionState(*source.session_state_));
+  session_state_->ResolveMemoryPatternFlag();
+  is_inited_ = true;
+
+  LOGS(*session_logger_, INFO) << "Session successfully initialized from session " << source.session_id_ << ".";
+  return Status::OK();
+}
+
 common::Status InferenceSession::SaveModelMetadata(const onnxruntime::Model& model) {
   VLOGS(*session_logger_, 1) << "Saving model metadata";
   const onnxruntime::Graph& graph = model.MainGraph();
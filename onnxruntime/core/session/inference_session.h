@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -22,6 +23,7 @@
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
+#include "core/platform/env.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -50,6 +52,7 @@ struct OrtCustomOpDomain {
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class PreparedRun;
 class CustomRegistry;
 struct Notification;
 
@@ -269,11 +272,44 @@ class InferenceSession {
     */
   common::Status Initialize() ORT_MUST_USE_RESULT;
 
+  /**
+    * Create a new InferenceSession for the model of this initialized session without repeating the graph
+    * transformations, partitioning, kernel creation and weight pre-packing.
+    * The clone shares the model, execution providers (and therefore their allocators), initializers and kernels with
+    * this session, and copies its execution plans. It creates its own thread pools, logger and profiler from
+    * session_options and uses its memory pattern and run-time settings. The execution mode, execution order and
+    * memory reuse settings the plans were created with are kept. Execution providers and graph optimization
+    * settings from session_options do not apply.
+    * This session must outlive the clone.
+    * This API is thread-safe.
+    * @return OK if success
+    */
+  common::Status Clone(const SessionOptions& session_options, const Environment& session_env,
+                       std::unique_ptr<InferenceSession>& clone) const ORT_MUST_USE_RESULT;
+
   common::Status Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
                      const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches,
                      const std::vector<OrtDevice>* p_fetches_device_info = nullptr) ORT_MUST_USE_RESULT;
 
+  using RunAsyncCallback = std::function<void(const common::Status& status, std::vector<OrtValue>& fetches)>;
+
+  /**
+    * Schedule a run of a pre-loaded and pre-intialized model and return without waiting for it.
+    * The run executes on the inter-op thread pool, or on the intra-op thread pool if the session has no
+    * inter-op thread pool (ExecutionMode::ORT_SEQUENTIAL).
+    * Multiple threads are allowed to run this function; hence its thread-safe.
+    * @param run_options optional. Must remain valid until the callback has been invoked.
+    * @param feed_names, feeds, output_names copied by the scheduled run. The client may release them on return.
+    * @param fetches output values in the order specified by output_names. Entries may be pre-allocated or empty.
+    * @param callback invoked on a thread pool thread with the status of the run and the fetches. Must not throw,
+    *        and must not destroy the session as the destructor waits for pending runs.
+    * @return OK if the run was scheduled. The callback will not be invoked otherwise.
+    */
+  common::Status RunAsync(const RunOptions* run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                          std::vector<OrtValue> fetches, RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
   /**
     * Run a pre-loaded and pre-intialized model.
     * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -306,6 +342,29 @@ class InferenceSession {
   virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding) ORT_MUST_USE_RESULT;
   common::Status Run(IOBinding& io_binding) ORT_MUST_USE_RESULT;
 
+  /**
+  * Resolves and validates the feed and output names, and calculates the device copy information, once for
+  * repeated Run calls with the same names. See PreparedRun class for more info.
+  * @param feed_names names of the inputs that will be fed.
+  * @param output_names names of the outputs that will be fetched.
+  * @param p_fetches_device_info optional. Device each output should be returned on if not pre-allocated.
+  * @param prepared_run the new PreparedRun. Only valid for use with this InferenceSession.
+  * @return OK if success.
+  */
+  common::Status PrepareRun(const std::vector<std::string>& feed_names, const std::vector<std::string>& output_names,
+                            const std::vector<OrtDevice>* p_fetches_device_info,
+                            std::unique_ptr<PreparedRun>* prepared_run) ORT_MUST_USE_RESULT;
+
+  /**
+  * Run the model with the feed/fetch setup from PrepareRun.
+  * Multiple threads are allowed to run this function with the same PreparedRun; hence its thread-safe.
+  * @param feeds inputs in the order of the names the PreparedRun was created with.
+  * @param p_fetches output values in the order of the output names the PreparedRun was created with.
+  * @return OK if success.
+  */
+  common::Status Run(const RunOptions& run_options, const PreparedRun& prepared_run,
+                     const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
+
 #ifdef ENABLE_TRAINING
   /**
   * Partially run a pre-loaded and pre-intialized model.
@@ -478,6 +537,10 @@ class InferenceSession {
   /// convenience pointer to logger. should always be the same as session_state_.Logger();
   const logging::Logger* session_logger_;
 
+  // The ORT format model file if it was memory mapped (see kOrtSessionOptionsConfigMapOrtModelFile).
+  // Initializers in model_ and session_state_ may refer to it, so it must be declared before them.
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
   // The model served by this inference session instance.
   // Currently this has to be a shared ptr because the Model::Load method
   // returns a shared_ptr only. Ideally factory functions should always return
@@ -502,6 +565,12 @@ class InferenceSession {
 
   common::Status SaveModelMetadata(const onnxruntime::Model& model) ORT_MUST_USE_RESULT;
 
+  // Create session_state_ using the execution providers and session options.
+  common::Status CreateSessionState() ORT_MUST_USE_RESULT;
+
+  // Initialize this session from an initialized session for the same model. See Clone.
+  common::Status InitializeFromSession(const InferenceSession& source) ORT_MUST_USE_RESULT;
+
 #if !defined(ORT_MINIMAL_BUILD)
 
   template <typename T>
@@ -558,6 +627,15 @@ class InferenceSession {
   common::Status ValidateOutputs(const std::vector<std::string>& output_names,
                                  const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
 
+  common::Status ValidatePreparedRun(const PreparedRun& prepared_run, const std::vector<OrtValue>& feeds,
+                                     const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
+
+  // Run with either the given names, or the setup from prepared_run if it is not nullptr.
+  common::Status RunImpl(const RunOptions& run_options, const PreparedRun* prepared_run,
+                         const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                         const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                         const std::vector<OrtDevice>* p_fetches_device_info) ORT_MUST_USE_RESULT;
+
   common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms) ORT_MUST_USE_RESULT;
 
   template <typename T>
@@ -668,6 +746,12 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Number of runs scheduled by RunAsync that have not invoked their callback yet.
+  // The destructor waits for them to finish.
+  int num_pending_async_runs_ = 0;  // GUARDED_BY(async_runs_mutex_)
+  onnxruntime::OrtMutex async_runs_mutex_;
+  onnxruntime::OrtCondVar async_runs_done_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -720,6 +804,7 @@ class InferenceSession {
   // Short term we free them after Initialize.
   // Longer term we may want to directly refer to offsets in this buffer for initializers so we don't need to copy
   // those into new OrtValue instances, at which point we won't free them until the InferenceSession goes away.
+  // This is done if the model file is memory mapped, in which case ort_format_model_mapped_bytes_ holds the bytes.
   gsl::span<const uint8_t> ort_format_model_bytes_;
 
   // This holds the actual model data
@@ -671,17 +671,18 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   API_IMPL_END
 }
 
-ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
-                    _In_reads_(input_len) const char* const* input_names,
-                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
-                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
-                    _Inout_updates_all_(output_names_len) OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+namespace {
+// Collect the names and values passed to Run or RunAsync.
+OrtStatus* GetRunFeedsAndFetches(_In_reads_(input_len) const char* const* input_names,
+                                 _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                                 _In_reads_(output_names_len) const char* const* output_names1,
+                                 size_t output_names_len, _In_reads_(output_names_len) OrtValue* const* output,
+                                 std::vector<std::string>& feed_names, std::vector<OrtValue>& feeds,
+                                 std::vector<std::string>& output_names, std::vector<OrtValue>& fetches) {
   const int queue_id = 0;
 
-  std::vector<std::string> feed_names(input_len);
-  std::vector<OrtValue> feeds(input_len);
+  feed_names.resize(input_len);
+  feeds.resize(input_len);
 
   for (size_t i = 0; i != input_len; ++i) {
     if (input_names[i] == nullptr || input_names[i][0] == '\0') {
@@ -695,7 +696,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   }
 
   // Create output feed
-  std::vector<std::string> output_names(output_names_len);
+  output_names.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
       return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
@@ -703,7 +704,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
     output_names[i] = output_names1[i];
   }
 
-  std::vector<OrtValue> fetches(output_names_len);
+  fetches.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output[i] != nullptr) {
       ::OrtValue& value = *(output[i]);
@@ -712,6 +713,42 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
       fetches[i] = value;
     }
   }
+
+  return nullptr;
+}
+
+// Return the values produced by Run or RunAsync, creating an OrtValue for the outputs that were not pre-allocated.
+void SetRunOutputs(std::vector<OrtValue>& fetches, _Inout_updates_all_(fetches.size()) OrtValue** output) {
+  const int queue_id = 0;
+  for (size_t i = 0, end = fetches.size(); i != end; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  auto* error = GetRunFeedsAndFetches(input_names, input, input_len, output_names1, output_names_len, output,
+                                      feed_names, feeds, output_names, fetches);
+  if (error != nullptr) {
+    return error;
+  }
+
   Status status;
   if (run_options == nullptr) {
     OrtRunOptions op;
@@ -722,14 +759,63 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
 
   if (!status.IsOK())
     return ToOrtStatus(status);
-  for (size_t i = 0; i != output_names_len; ++i) {
-    ::OrtValue& value = fetches[i];
-    if (value.Fence())
-      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
-    if (output[i] == nullptr) {
-      output[i] = new OrtValue(value);
-    }
+
+  SetRunOutputs(fetches, output);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
   }
+
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  auto* error = GetRunFeedsAndFetches(input_names, input, input_len, output_names1, output_names_len, output,
+                                      feed_names, feeds, output_names, fetches);
+  if (error != nullptr) {
+    return error;
+  }
+
+  auto callback = [output, run_async_callback, user_data](const Status& status, std::vector<OrtValue>& fetches) {
+    if (!status.IsOK()) {
+      OrtStatus* ort_status = ToOrtStatus(status);
+      run_async_callback(user_data, output, fetches.size(), ort_status);
+      OrtApis::ReleaseStatus(ort_status);
+      return;
+    }
+
+    SetRunOutputs(fetches, output);
+    run_async_callback(user_data, output, fetches.size(), nullptr);
+  };
+
+  return ToOrtStatus(session->RunAsync(run_options, feed_names, feeds, output_names, std::move(fetches),
+                                       std::move(callback)));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CloneSession, _In_ const OrtEnv* env, _In_ const OrtSession* session,
+                    _In_opt_ const OrtSessionOptions* options, _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+  *out = nullptr;
+
+  const auto* source = reinterpret_cast<const ::onnxruntime::InferenceSession*>(session);
+  std::unique_ptr<onnxruntime::InferenceSession> sess;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(source->Clone(options == nullptr ? onnxruntime::SessionOptions() : options->value,
+                                                env->GetEnvironment(), sess));
+
+  *out = reinterpret_cast<OrtSession*>(sess.release());
   return nullptr;
   API_IMPL_END
 }
@@ -1997,6 +2083,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->max_dead_bytes_per_chunk = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "initial_growth_chunk_size_bytes") == 0) {
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "max_thread_cache_bytes") == 0) {
+      cfg->max_thread_cache_bytes = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2350,6 +2438,8 @@ static constexpr OrtApi ort_api_1_to_10 = {
     // End of Version 9 - DO NOT MODIFY ABOVE (see above text for more information)
 
     // Version 10 - In development, feel free to add/remove/rearrange here
+    &OrtApis::RunAsync,
+    &OrtApis::CloneSession,
 };
 
 // Asserts to do a some checks to ensure older Versions of the OrtApi never change (will detect an addition or deletion but not if they cancel out each other)
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/data_types.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+class InferenceSession;
+
+/**
+ * The feed/fetch setup for repeated Run calls with a fixed set of feed and output names.
+ * Usage is as follows:
+ *
+ * InferenceSession session;
+ * session.Load();
+ * session.Initialize();
+ * ...
+ * std::unique_ptr<PreparedRun> prepared_run;
+ * session.PrepareRun(feed_names, output_names, nullptr, &prepared_run);
+ *
+ * while (...) {
+ *   session.Run(run_options, *prepared_run, feeds, &fetches);
+ * }
+ *
+ * The names are mapped to OrtValue indices, validated against the model and the static device copy information is
+ * calculated once in PrepareRun. Each call to Run only checks that the feeds match the element types and shapes the
+ * model expects, without any name lookups. Feeds that fail the check go through the full input validation.
+ *
+ * A PreparedRun is immutable once created and may be used by concurrent Run calls on the session that created it.
+ */
+class PreparedRun {
+ public:
+  const std::vector<std::string>& GetFeedNames() const {
+    return feeds_fetches_manager_->GetFeedsFetchesInfo().feed_names;
+  }
+
+  const std::vector<std::string>& GetOutputNames() const {
+    return feeds_fetches_manager_->GetFeedsFetchesInfo().output_names;
+  }
+
+ private:
+  friend class InferenceSession;
+
+  // private constructor, created by InferenceSession::PrepareRun
+  PreparedRun(const InferenceSession& session, std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager,
+              std::vector<MLDataType>&& feed_element_types, std::vector<TensorShape>&& feed_shapes)
+      : session_{session},
+        feeds_fetches_manager_{std::move(feeds_fetches_manager)},
+        feed_element_types_{std::move(feed_element_types)},
+        feed_shapes_{std::move(feed_shapes)} {
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedRun);
+
+  const InferenceSession& session_;
+
+  // feeds/fetches mapping with the static device copy info filled in.
+  // if no device copies can be needed it is fully finalized and used as-is by every Run.
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+
+  // expected tensor element type for each feed. nullptr if the feed is not a tensor.
+  std::vector<MLDataType> feed_element_types_;
+
+  // shape of each feed as declared by the model. may contain symbolic dimensions (-1), or be empty if unknown.
+  std::vector<TensorShape> feed_shapes_;
+};
+}  // namespace onnxruntime
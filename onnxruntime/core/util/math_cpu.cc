@@ -146,6 +146,30 @@ void MatMul<double>(ptrdiff_t M, ptrdiff_t N, ptrdiff_t K, const double* A, cons
 EIGEN_MATMUL_FUNCTION(double)
 #endif
 
+template <>
+void MatMul<MLFloat16>(ptrdiff_t M, ptrdiff_t N, ptrdiff_t K, const MLFloat16* A, const MLFloat16* B, MLFloat16* C, ThreadPool* threadpool) {
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = reinterpret_cast<const uint16_t*>(A);
+  data.lda = K;
+  data.B = reinterpret_cast<const uint16_t*>(B);
+  data.ldb = N;
+  data.C = reinterpret_cast<uint16_t*>(C);
+  data.ldc = N;
+  MlasHalfGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, &data, 1, threadpool);
+}
+
+template <>
+void MatMul<BFloat16>(ptrdiff_t M, ptrdiff_t N, ptrdiff_t K, const BFloat16* A, const BFloat16* B, BFloat16* C, ThreadPool* threadpool) {
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = reinterpret_cast<const uint16_t*>(A);
+  data.lda = K;
+  data.B = reinterpret_cast<const uint16_t*>(B);
+  data.ldb = N;
+  data.C = reinterpret_cast<uint16_t*>(C);
+  data.ldc = N;
+  MlasBf16GemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, &data, 1, threadpool);
+}
+
 template <>
 void GemmEx<float, ThreadPool>(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                                float alpha, const float* A, int lda, const float* B, int ldb, float beta, float* C,
@@ -9,6 +9,23 @@
 
 namespace onnxruntime {
 namespace concurrency {
+// Map the processor each thread is bound to onto its NUMA node.  Returns an empty vector (a single domain) if the
+// topology is unknown or all of the processors are on the same node.
+static std::vector<int> GetThreadDomains(const Env& env, const std::vector<size_t>& affinity) {
+  std::vector<int> domains;
+  const std::vector<int> processor_nodes = env.GetProcessorNumaNodes();
+  if (processor_nodes.empty()) {
+    return domains;
+  }
+  for (size_t processor : affinity) {
+    domains.push_back(processor < processor_nodes.size() ? processor_nodes[processor] : 0);
+  }
+  if (std::all_of(domains.begin(), domains.end(), [&](int domain) { return domain == domains.front(); })) {
+    domains.clear();
+  }
+  return domains;
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   if (options.thread_pool_size == 1)
@@ -26,6 +43,12 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
     if (options.auto_set_affinity)
       to.affinity = cpu_list;
   }
+  if (options.domain_vec_len != 0) {
+    to.domains.assign(options.domain_vec, options.domain_vec + options.domain_vec_len);
+  } else if (!to.affinity.empty()) {
+    to.domains = GetThreadDomains(Env::Default(), to.affinity);
+  }
+  to.spin_policy = options.spin_policy;
   to.set_denormal_as_zero = options.set_denormal_as_zero;
 
   return std::make_unique<ThreadPool>(env, to, options.name, options.thread_pool_size,
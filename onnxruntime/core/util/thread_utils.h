@@ -18,12 +18,19 @@ struct OrtThreadPoolParams {
   bool auto_set_affinity = false;
   //If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
+  //How long the thread pool spins when spinning is allowed. See onnxruntime::ThreadPoolSpinPolicy.
+  onnxruntime::ThreadPoolSpinPolicy spin_policy = onnxruntime::ThreadPoolSpinPolicy::Fixed;
 
   unsigned int stack_size = 0;
   //Index is thread id, value is processor ID
   //If the vector is empty, no explict affinity binding
   size_t* affinity_vec = nullptr;
   size_t affinity_vec_len = 0;
+  //Index is thread id, value is the NUMA node or cache domain of the thread
+  //If the vector is empty and the threads are bound to processors, the domains are detected from the
+  //NUMA nodes of those processors. Otherwise all threads are in one domain.
+  int* domain_vec = nullptr;
+  size_t domain_vec_len = 0;
   const ORTCHAR_T* name = nullptr;
 
   // Set or unset denormal as zero
@@ -3,9 +3,15 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "test/framework/test_utils.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -41,11 +47,13 @@ static void RunAttentionTest(
     bool only_enable_cuda = false,
     bool only_enable_cpu = false,
     std::vector<int32_t> qkv_sizes = {},
-    const std::vector<float>& extra_add_data = {}) {
+    const std::vector<float>& extra_add_data = {},
+    bool past_present_share_buffer = false) {
   input_hidden_size = (input_hidden_size == 0 ? hidden_size : input_hidden_size);  // By default, no pruning.
 
   int min_cuda_architecture = use_float16 ? 530 : 0;
-  bool enable_cuda = HasCudaEnvironment(min_cuda_architecture) && !is_weights_constant && !only_enable_cpu;
+  bool enable_cuda = HasCudaEnvironment(min_cuda_architecture) && !is_weights_constant && !only_enable_cpu &&
+                     !past_present_share_buffer;
   bool enable_cpu = (nullptr != DefaultCpuExecutionProvider().get()) && !use_float16 && !only_enable_cuda;
 
   int head_size = hidden_size / number_of_heads;
@@ -53,6 +61,9 @@ static void RunAttentionTest(
     OpTester tester("Attention", 1, onnxruntime::kMSDomain);
     tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
     tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+    if (past_present_share_buffer) {
+      tester.AddAttribute<int64_t>("past_present_share_buffer", 1);
+    }
 
     int32_t matrix_size;
     int32_t output_hidden_size;
@@ -123,7 +134,43 @@ static void RunAttentionTest(
       tester.AddOptionalInputEdge<int32_t>();
     }
 
-    if (use_past_state) {
+    if (use_past_state && past_present_share_buffer) {
+      // past and present have capacity max_sequence_length per head. Entries after the valid ones are zero in past
+      // and unspecified in present.
+      auto pad_state = [&](const std::vector<float>& state, int state_sequence_length) {
+        std::vector<float> padded(2 * batch_size * number_of_heads * max_sequence_length * head_size, 0.0f);
+        for (int i = 0; i < 2 * batch_size * number_of_heads; i++) {
+          std::copy_n(state.begin() + i * state_sequence_length * head_size, state_sequence_length * head_size,
+                      padded.begin() + i * max_sequence_length * head_size);
+        }
+        return padded;
+      };
+
+      std::vector<int64_t> shared_dims = {2, batch_size, number_of_heads, max_sequence_length, head_size};
+      tester.AddInput<float>("past", shared_dims, pad_state(*past_data, past_sequence_length));
+      tester.AddOutput<float>("present", shared_dims, pad_state(*present_data, past_sequence_length + sequence_length));
+      tester.AddOptionalInputEdge<float>();
+      tester.AddInput<int32_t>("past_sequence_length", {1}, {past_sequence_length});
+
+      const int all_sequence_length = past_sequence_length + sequence_length;
+      tester.SetCustomOutputVerifier([&, all_sequence_length](const std::vector<OrtValue>& fetches,
+                                                              const std::string& provider_type) {
+        ASSERT_EQ(fetches.size(), 2u);
+        auto output = FetchTensor(fetches[0]).DataAsSpan<float>();
+        ASSERT_EQ(static_cast<size_t>(output.size()), output_data.size());
+        for (size_t i = 0; i < output_data.size(); i++) {
+          ASSERT_NEAR(output[i], output_data[i], 0.001f) << "i:" << i << ", provider_type: " << provider_type;
+        }
+
+        auto present = FetchTensor(fetches[1]).DataAsSpan<float>();
+        for (int i = 0; i < 2 * batch_size * number_of_heads; i++) {
+          for (int j = 0; j < all_sequence_length * head_size; j++) {
+            ASSERT_EQ(present[i * max_sequence_length * head_size + j], (*present_data)[i * all_sequence_length * head_size + j])
+                << "head:" << i << ", j:" << j << ", provider_type: " << provider_type;
+          }
+        }
+      });
+    } else if (use_past_state) {
       if (use_float16) {
         if (past_sequence_length > 0) {
           tester.AddInput<MLFloat16>("past", past_dims, ToFloat16(*past_data));
@@ -181,17 +228,18 @@ static void RunAttentionTest(
     bool only_enable_cuda = false,
     bool only_enable_cpu = false,
     const std::vector<int32_t> qkv_sizes = {},
-    const std::vector<float>& extra_add_data = {}) {
+    const std::vector<float>& extra_add_data = {},
+    bool past_present_share_buffer = false) {
     RunAttentionTest(input_data, weights_data, false, bias_data, mask_index_data, output_data,
                      batch_size, sequence_length, hidden_size, number_of_heads,
                      use_float16, is_unidirectional, use_past_state, past_sequence_length,
                      past_data, present_data, mask_index_type, input_hidden_size, max_sequence_length,
-                     only_enable_cuda, only_enable_cpu, qkv_sizes, extra_add_data);
+                     only_enable_cuda, only_enable_cpu, qkv_sizes, extra_add_data, past_present_share_buffer);
     RunAttentionTest(input_data, weights_data, true, bias_data, mask_index_data, output_data,
                      batch_size, sequence_length, hidden_size, number_of_heads,
                      use_float16, is_unidirectional, use_past_state, past_sequence_length,
                      past_data, present_data, mask_index_type, input_hidden_size, max_sequence_length,
-                     only_enable_cuda, only_enable_cpu, qkv_sizes, extra_add_data);
+                     only_enable_cuda, only_enable_cpu, qkv_sizes, extra_add_data, past_present_share_buffer);
 }
 
 TEST(AttentionTest, AttentionBatch1) {
@@ -814,6 +862,13 @@ TEST(AttentionTest, AttentionPastStateBatch1) {
   RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
                    batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
                    use_past_state, past_sequence_length, &past_data, &present_data);
+
+  // Same state in a buffer with capacity of 6 that is shared by past and present.
+  int max_sequence_length = 6;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
+                   use_past_state, past_sequence_length, &past_data, &present_data, kMaskIndexEnd, 0,
+                   max_sequence_length, false, true, {}, {}, true);
 }
 
 TEST(AttentionTest, AttentionPastStateBatch2) {
@@ -1787,6 +1842,300 @@ TEST(AttentionTest, AttentionPrunedModel) {
                    use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data, kMaskRaw, input_hidden_size);
 }
 
+// Reference attention that materializes the full attention probs, to check the blocked online softmax of the CPU
+// kernel. mask is a raw 2D mask of shape [batch_size, past_sequence_length + sequence_length]. Returns the output
+// and fills present with the concatenation of past and the new K and V.
+static std::vector<float> ComputeReferenceAttention(const std::vector<float>& input_data,
+                                                    const std::vector<float>& weight_data,
+                                                    const std::vector<float>& bias_data,
+                                                    const std::vector<int32_t>& mask_data,
+                                                    const std::vector<float>& past_data,
+                                                    std::vector<float>& present_data,
+                                                    int batch_size, int sequence_length, int hidden_size,
+                                                    int number_of_heads, int past_sequence_length,
+                                                    bool is_unidirectional) {
+  const int head_size = hidden_size / number_of_heads;
+  const int all_sequence_length = past_sequence_length + sequence_length;
+
+  // qkv(B, S, 3 x hidden) = input x weight + bias
+  std::vector<float> qkv(static_cast<size_t>(batch_size) * sequence_length * 3 * hidden_size);
+  for (int t = 0; t < batch_size * sequence_length; t++) {
+    for (int c = 0; c < 3 * hidden_size; c++) {
+      float sum = bias_data[c];
+      for (int h = 0; h < hidden_size; h++) {
+        sum += input_data[t * hidden_size + h] * weight_data[h * 3 * hidden_size + c];
+      }
+      qkv[t * 3 * hidden_size + c] = sum;
+    }
+  }
+
+  // present(2, B, N, S*, H)
+  const size_t state_size = static_cast<size_t>(batch_size) * number_of_heads * all_sequence_length * head_size;
+  present_data.assign(2 * state_size, 0.0f);
+  for (int kv = 0; kv < 2; kv++) {
+    for (int b = 0; b < batch_size; b++) {
+      for (int n = 0; n < number_of_heads; n++) {
+        for (int m = 0; m < all_sequence_length; m++) {
+          for (int h = 0; h < head_size; h++) {
+            float value;
+            if (m < past_sequence_length) {
+              value = past_data[(((kv * batch_size + b) * number_of_heads + n) * past_sequence_length + m) * head_size + h];
+            } else {
+              const int t = b * sequence_length + m - past_sequence_length;
+              value = qkv[t * 3 * hidden_size + (kv + 1) * hidden_size + n * head_size + h];
+            }
+            present_data[kv * state_size + ((b * number_of_heads + n) * all_sequence_length + m) * head_size + h] = value;
+          }
+        }
+      }
+    }
+  }
+
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(head_size));
+  std::vector<float> output(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<double> probs(all_sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      const float* k = present_data.data() + (b * number_of_heads + n) * all_sequence_length * head_size;
+      const float* v = k + state_size;
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = qkv.data() + (b * sequence_length + s) * 3 * hidden_size + n * head_size;
+        double max_score = std::numeric_limits<double>::lowest();
+        for (int m = 0; m < all_sequence_length; m++) {
+          double score = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            score += static_cast<double>(q[h]) * k[m * head_size + h];
+          }
+          score *= alpha;
+          if (mask_data[b * all_sequence_length + m] == 0) {
+            score -= 10000.0;
+          }
+          if (is_unidirectional && m > past_sequence_length + s) {
+            score -= 10000.0;
+          }
+          probs[m] = score;
+          max_score = std::max(max_score, score);
+        }
+
+        double sum = 0.0;
+        for (int m = 0; m < all_sequence_length; m++) {
+          probs[m] = std::exp(probs[m] - max_score);
+          sum += probs[m];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          double value = 0.0;
+          for (int m = 0; m < all_sequence_length; m++) {
+            value += probs[m] * v[m * head_size + h];
+          }
+          output[(b * sequence_length + s) * hidden_size + n * head_size + h] = static_cast<float>(value / sum);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// S = 300 with a past of 20 spans 5 query blocks and 2 key blocks in the CPU kernel, so the partial output of
+// most rows is rescaled when the second key block has a larger logit. With a unidirectional mask, the query
+// blocks that end before the second key block stop before it.
+static void RunBlockedAttentionTest(bool is_unidirectional) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 300;
+  constexpr int past_sequence_length = 20;
+  constexpr int all_sequence_length = past_sequence_length + sequence_length;
+  constexpr int hidden_size = 8;
+  constexpr int number_of_heads = 2;
+  constexpr int head_size = hidden_size / number_of_heads;
+
+  RandomValueGenerator random{};
+  std::vector<float> input_data = random.Gaussian<float>({batch_size, sequence_length, hidden_size}, 0.0f, 1.0f);
+  std::vector<float> weight_data = random.Gaussian<float>({hidden_size, 3 * hidden_size}, 0.0f, 0.5f);
+  std::vector<float> bias_data = random.Gaussian<float>({3 * hidden_size}, 0.0f, 0.1f);
+  std::vector<float> past_data =
+      random.Gaussian<float>({2, batch_size, number_of_heads, past_sequence_length, head_size}, 0.0f, 1.0f);
+
+  // Mask some keys in the past and in both key blocks of the first batch, and the padding at the end of the second.
+  std::vector<int32_t> mask_data(batch_size * all_sequence_length, 1);
+  for (int m = 0; m < all_sequence_length; m++) {
+    if (m % 7 == 3) {
+      mask_data[m] = 0;
+    }
+  }
+  for (int m = all_sequence_length - 40; m < all_sequence_length; m++) {
+    mask_data[all_sequence_length + m] = 0;
+  }
+
+  std::vector<float> present_data;
+  std::vector<float> output_data = ComputeReferenceAttention(input_data, weight_data, bias_data, mask_data, past_data,
+                                                             present_data, batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, past_sequence_length, is_unidirectional);
+
+  bool use_float16 = false;
+  bool use_past_state = true;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads, use_float16, is_unidirectional,
+                   use_past_state, past_sequence_length, &past_data, &present_data, kMaskRaw);
+}
+
+TEST(AttentionTest, AttentionBlockedPastStateWithMask) {
+  RunBlockedAttentionTest(false);
+}
+
+TEST(AttentionTest, AttentionBlockedUnidirectionalPastStateWithMask) {
+  RunBlockedAttentionTest(true);
+}
+
+// Bind past and present to the same buffer as done for GPT-2 decoding, so that the kernel appends the new K and V
+// in place instead of copying the past state.
+TEST(AttentionTest, AttentionPastPresentShareBufferInPlace) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 3;
+  constexpr int past_sequence_length = 5;
+  constexpr int all_sequence_length = past_sequence_length + sequence_length;
+  constexpr int max_sequence_length = 12;
+  constexpr int hidden_size = 8;
+  constexpr int number_of_heads = 2;
+  constexpr int head_size = hidden_size / number_of_heads;
+
+  RandomValueGenerator random{};
+  std::vector<float> input_data = random.Gaussian<float>({batch_size, sequence_length, hidden_size}, 0.0f, 1.0f);
+  std::vector<float> weight_data = random.Gaussian<float>({hidden_size, 3 * hidden_size}, 0.0f, 0.5f);
+  std::vector<float> bias_data = random.Gaussian<float>({3 * hidden_size}, 0.0f, 0.1f);
+  std::vector<float> past_data =
+      random.Gaussian<float>({2, batch_size, number_of_heads, past_sequence_length, head_size}, 0.0f, 1.0f);
+  std::vector<int32_t> mask_data(batch_size * all_sequence_length, 1);
+
+  std::vector<float> present_data;
+  std::vector<float> output_data = ComputeReferenceAttention(input_data, weight_data, bias_data, mask_data, past_data,
+                                                             present_data, batch_size, sequence_length, hidden_size,
+                                                             number_of_heads, past_sequence_length, true);
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 12}, {kMSDomain, 1}};
+  Model model("AttentionPastPresentShareBuffer", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto int32_tensor;
+  int32_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT32);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &float_tensor);
+  auto& weight_arg = graph.GetOrCreateNodeArg("weight", &float_tensor);
+  auto& bias_arg = graph.GetOrCreateNodeArg("bias", &float_tensor);
+  auto& past_arg = graph.GetOrCreateNodeArg("past", &float_tensor);
+  auto& past_sequence_length_arg = graph.GetOrCreateNodeArg("past_sequence_length", &int32_tensor);
+  auto& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+  auto& output_arg = graph.GetOrCreateNodeArg("output", &float_tensor);
+  auto& present_arg = graph.GetOrCreateNodeArg("present", &float_tensor);
+
+  Node& node = graph.AddNode("attention", "Attention", "Attention with past and present in one buffer",
+                             {&input_arg, &weight_arg, &bias_arg, &empty_arg, &past_arg, &empty_arg,
+                              &past_sequence_length_arg},
+                             {&output_arg, &present_arg}, nullptr, kMSDomain);
+  node.AddAttribute("num_heads", static_cast<int64_t>(number_of_heads));
+  node.AddAttribute("unidirectional", static_cast<int64_t>(1));
+  node.AddAttribute("past_present_share_buffer", static_cast<int64_t>(1));
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  std::stringstream model_stream(model_data);
+
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  // the state buffer has capacity max_sequence_length per head
+  std::vector<float> state_data(2 * batch_size * number_of_heads * max_sequence_length * head_size, 0.0f);
+  for (int i = 0; i < 2 * batch_size * number_of_heads; i++) {
+    std::copy_n(past_data.begin() + i * past_sequence_length * head_size, past_sequence_length * head_size,
+                state_data.begin() + i * max_sequence_length * head_size);
+  }
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue input_value;
+  OrtValue weight_value;
+  OrtValue bias_value;
+  OrtValue state_value;
+  OrtValue past_sequence_length_value;
+  OrtValue output_value;
+  CreateMLValue<float>(allocator, {batch_size, sequence_length, hidden_size}, input_data, &input_value);
+  CreateMLValue<float>(allocator, {hidden_size, 3 * hidden_size}, weight_data, &weight_value);
+  CreateMLValue<float>(allocator, {3 * hidden_size}, bias_data, &bias_value);
+  CreateMLValue<float>(allocator, {2, batch_size, number_of_heads, max_sequence_length, head_size}, state_data,
+                       &state_value);
+  CreateMLValue<int32_t>(allocator, {1}, {past_sequence_length}, &past_sequence_length_value);
+
+  std::unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session.NewIOBinding(&io_binding));
+  ASSERT_STATUS_OK(io_binding->BindInput("input", input_value));
+  ASSERT_STATUS_OK(io_binding->BindInput("weight", weight_value));
+  ASSERT_STATUS_OK(io_binding->BindInput("bias", bias_value));
+  ASSERT_STATUS_OK(io_binding->BindInput("past", state_value));
+  ASSERT_STATUS_OK(io_binding->BindInput("past_sequence_length", past_sequence_length_value));
+  ASSERT_STATUS_OK(io_binding->BindOutput("output", output_value));
+  ASSERT_STATUS_OK(io_binding->BindOutput("present", state_value));
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(session.Run(run_options, *io_binding));
+
+  const auto& outputs = io_binding->GetOutputs();
+  ASSERT_EQ(outputs.size(), 2u);
+
+  auto output = outputs[0].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(static_cast<size_t>(output.size()), output_data.size());
+  for (size_t i = 0; i < output_data.size(); i++) {
+    EXPECT_NEAR(output[i], output_data[i], 0.001f) << "i:" << i;
+  }
+
+  // present is the bound buffer, which now holds past followed by the new K and V of each head
+  const Tensor& state = state_value.Get<Tensor>();
+  ASSERT_EQ(outputs[1].Get<Tensor>().DataRaw(), state.DataRaw());
+  auto present = state.DataAsSpan<float>();
+  for (int i = 0; i < 2 * batch_size * number_of_heads; i++) {
+    for (int j = 0; j < all_sequence_length * head_size; j++) {
+      ASSERT_EQ(present[i * max_sequence_length * head_size + j], present_data[i * all_sequence_length * head_size + j])
+          << "head:" << i << ", j:" << j;
+    }
+  }
+}
+
+// The past state of a shared buffer has capacity max_sequence_length per head, so it cannot be attended to
+// without the present output that holds the appended state.
+TEST(AttentionTest, AttentionPastPresentShareBufferWithoutPresent) {
+  constexpr int batch_size = 1;
+  constexpr int sequence_length = 1;
+  constexpr int past_sequence_length = 2;
+  constexpr int max_sequence_length = 4;
+  constexpr int hidden_size = 4;
+  constexpr int number_of_heads = 2;
+  constexpr int head_size = hidden_size / number_of_heads;
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(1));
+  tester.AddAttribute<int64_t>("past_present_share_buffer", static_cast<int64_t>(1));
+
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, {0.5f, 0.2f, 0.3f, -0.6f});
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, std::vector<float>(hidden_size * 3 * hidden_size, 0.1f));
+  tester.AddInput<float>("bias", {3 * hidden_size}, std::vector<float>(3 * hidden_size, 0.0f));
+  tester.AddOptionalInputEdge<int32_t>();
+  tester.AddInput<float>("past", {2, batch_size, number_of_heads, max_sequence_length, head_size},
+                         std::vector<float>(2 * batch_size * number_of_heads * max_sequence_length * head_size, 1.0f));
+  tester.AddOptionalInputEdge<float>();
+  tester.AddInput<int32_t>("past_sequence_length", {1}, {past_sequence_length});
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, std::vector<float>(hidden_size, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "Expect to have present state output when past state input is given",
+             {}, nullptr, &execution_providers);
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(AttentionTest, SharedPrepackedWeights) {
   int batch_size = 2;
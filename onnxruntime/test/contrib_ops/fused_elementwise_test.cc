@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static int64_t ShapeSize(const std::vector<int64_t>& dims) {
+  return std::accumulate(dims.begin(), dims.end(), int64_t{1}, std::multiplies<int64_t>());
+}
+
+// Evaluates a single step of a unary or binary operator as separate ONNX operators would.
+static float ReferenceOp(const std::string& op, float a, float b) {
+  if (op == "Add") return a + b;
+  if (op == "Sub") return a - b;
+  if (op == "Mul") return a * b;
+  if (op == "Div") return a / b;
+  if (op == "Relu") return std::max(a, 0.0f);
+  if (op == "Sigmoid") return 1.0f / (1.0f + std::exp(-a));
+  if (op == "Tanh") return std::tanh(a);
+  if (op == "Erf") return std::erf(a);
+  if (op == "Exp") return std::exp(a);
+  if (op == "Log") return std::log(a);
+  if (op == "Sqrt") return std::sqrt(a);
+  if (op == "Neg") return -a;
+  if (op == "Abs") return std::abs(a);
+  if (op == "Reciprocal") return 1.0f / a;
+  ORT_THROW("Unexpected operator ", op);
+}
+
+// Computes the expected output of a fused expression where every input is indexed as input[i % size].
+static std::vector<float> ReferenceFusedElementwise(const std::vector<std::vector<float>>& inputs,
+                                                    const std::vector<std::string>& ops,
+                                                    const std::vector<int64_t>& operands,
+                                                    int64_t output_size) {
+  std::vector<float> output(static_cast<size_t>(output_size));
+  std::vector<float> values(inputs.size() + ops.size());
+  for (int64_t i = 0; i < output_size; ++i) {
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      values[j] = inputs[j][static_cast<size_t>(i) % inputs[j].size()];
+    }
+    for (size_t k = 0; k < ops.size(); ++k) {
+      const float a = values[static_cast<size_t>(operands[2 * k])];
+      const float b = operands[2 * k + 1] >= 0 ? values[static_cast<size_t>(operands[2 * k + 1])] : 0.0f;
+      values[inputs.size() + k] = ReferenceOp(ops[k], a, b);
+    }
+    output[static_cast<size_t>(i)] = values.back();
+  }
+  return output;
+}
+
+static void RunFusedElementwiseTest(const std::vector<std::vector<int64_t>>& input_dims,
+                                    const std::vector<std::string>& ops,
+                                    const std::vector<int64_t>& operands,
+                                    const std::vector<int64_t>& output_dims,
+                                    float min_value = -2.0f,
+                                    float max_value = 2.0f) {
+  RandomValueGenerator random{};
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", ops);
+  test.AddAttribute<std::vector<int64_t>>("operands", operands);
+
+  std::vector<std::vector<float>> inputs;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    inputs.push_back(random.Uniform<float>(input_dims[i], min_value, max_value));
+    test.AddInput<float>(("X" + std::to_string(i)).c_str(), input_dims[i], inputs.back());
+  }
+
+  test.AddOutput<float>("Y", output_dims, ReferenceFusedElementwise(inputs, ops, operands, ShapeSize(output_dims)));
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, UnaryOps) {
+  for (const char* op : {"Relu", "Sigmoid", "Tanh", "Erf", "Exp", "Neg", "Abs"}) {
+    RunFusedElementwiseTest({{3, 17}}, {op}, {0, -1}, {3, 17});
+  }
+
+  // Keep the inputs positive for the operators that are not defined for negative values.
+  for (const char* op : {"Log", "Sqrt", "Reciprocal"}) {
+    RunFusedElementwiseTest({{3, 17}}, {op}, {0, -1}, {3, 17}, 0.5f, 4.0f);
+  }
+}
+
+TEST(FusedElementwiseTest, BinaryOps) {
+  for (const char* op : {"Add", "Sub", "Mul"}) {
+    RunFusedElementwiseTest({{3, 17}, {3, 17}}, {op}, {0, 1}, {3, 17});
+  }
+  RunFusedElementwiseTest({{3, 17}, {3, 17}}, {"Div"}, {0, 1}, {3, 17}, 0.5f, 4.0f);
+}
+
+TEST(FusedElementwiseTest, Chain) {
+  // Y = Sigmoid((X0 + X1) * X2) * X0
+  RunFusedElementwiseTest({{2, 3, 1000}, {1000}, {}},
+                          {"Add", "Mul", "Sigmoid", "Mul"},
+                          {0, 1, 3, 2, 4, -1, 5, 0},
+                          {2, 3, 1000});
+}
+
+TEST(FusedElementwiseTest, Tree) {
+  // Y = Tanh(X0 - X1) + Relu(X2) * X1, spanning many blocks so the work is split across threads.
+  RunFusedElementwiseTest({{4, 64, 384}, {1, 384}, {4, 64, 384}},
+                          {"Sub", "Tanh", "Relu", "Mul", "Add"},
+                          {0, 1, 3, -1, 2, -1, 5, 1, 4, 6},
+                          {4, 64, 384});
+}
+
+TEST(FusedElementwiseTest, BroadcastSuffix) {
+  // The smaller inputs repeat with a period that does not divide the block size.
+  RunFusedElementwiseTest({{7}, {5, 7}, {30, 5, 7}},
+                          {"Mul", "Add"},
+                          {0, 1, 3, 2},
+                          {30, 5, 7});
+}
+
+TEST(FusedElementwiseTest, InvalidBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1});
+  test.AddInput<float>("X0", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("X1", {2, 1}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2, 3}, {2.0f, 3.0f, 4.0f, 6.0f, 7.0f, 8.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "must match the trailing dimensions of the output shape");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -66,5 +66,42 @@ TEST(LayerNormTest, BERTLayerNorm_NoBias) {
   tester.Run();
 }
 
+TEST(LayerNormTest, LayerNorm_Float16Input) {
+  OpTester tester("LayerNormalization", 1 /*opset_version*/);
+  tester.AddAttribute<int64_t>("axis", -1);
+  tester.AddAttribute<float>("epsilon", 1e-05f);
+
+  std::vector<int64_t> dims{2, 4};
+  tester.AddInput<MLFloat16>("X", dims, ToFloat16({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, 0.5f, 2.0f, -3.0f}));
+  tester.AddInput<MLFloat16>("Scale", {4}, ToFloat16({0.5f, 1.0f, 1.5f, 2.0f}));
+  tester.AddInput<MLFloat16>("B", {4}, ToFloat16({0.1f, -0.2f, 0.3f, 0.0f}));
+  tester.AddOutput<MLFloat16>("Y", dims, ToFloat16({-0.5708177f, -0.6472118f, 0.9708177f, 2.6832708f,
+                                                    -0.0689341f, 0.2730155f, 2.2258487f, -2.8380928f}));
+  tester.AddOutput<float>("Mean", {2, 1}, {2.5f, -0.375f});
+  tester.AddOutput<float>("InvStdDev", {2, 1}, {0.8944236f, 0.5405891f});
+  tester.SetOutputAbsErr("Y", 0.01f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(LayerNormTest, SimplifiedLayerNorm) {
+  OpTester tester("SimplifiedLayerNormalization", 1 /*opset_version*/);
+  tester.AddAttribute<int64_t>("axis", -1);
+  tester.AddAttribute<float>("epsilon", 1e-05f);
+
+  std::vector<int64_t> dims{2, 4};
+  tester.AddInput<float>("X", dims, {1.0f, 2.0f, 3.0f, 4.0f, -1.0f, 0.5f, 2.0f, -3.0f});
+  tester.AddInput<float>("scale", {4}, {0.5f, 1.0f, 1.5f, 2.0f});
+  tester.AddOutput<float>("Y", dims, {0.1825741f, 0.7302963f, 1.6431666f, 2.9211850f,
+                                      -0.2649061f, 0.2649061f, 1.5894366f, -3.1788732f});
+  tester.AddOutput<float>("inv_std_var", {2, 1}, {0.3651481f, 0.5298122f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
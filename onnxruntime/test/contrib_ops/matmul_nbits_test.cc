@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+void TestMatMulNBits(int64_t M, int64_t N, int64_t K, int64_t bits, int64_t block_size,
+                     bool has_zero_point, bool is_weight_constant, const std::vector<int64_t>& batch_dims = {}) {
+  RandomValueGenerator random{};
+
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+  const int64_t zero_point_stride = (block_count_k * bits + 7) / 8;
+
+  std::vector<int64_t> A_dims(batch_dims);
+  A_dims.push_back(M);
+  A_dims.push_back(K);
+  std::vector<int64_t> Y_dims(batch_dims);
+  Y_dims.push_back(M);
+  Y_dims.push_back(N);
+
+  const int64_t rows = M * std::accumulate(batch_dims.begin(), batch_dims.end(), int64_t{1}, std::multiplies<int64_t>());
+
+  std::vector<float> A_data = random.Uniform<float>({rows, K}, -1.0f, 1.0f);
+
+  std::vector<uint8_t> B_data;
+  std::vector<int32_t> tmp_B_data = random.Uniform<int32_t>({N, block_count_k, blob_size}, 0, 255);
+  std::transform(tmp_B_data.begin(), tmp_B_data.end(), std::back_inserter(B_data), [](int32_t v) -> uint8_t {
+    return static_cast<uint8_t>(v);
+  });
+
+  std::vector<float> scales = random.Uniform<float>({N * block_count_k}, 0.01f, 0.1f);
+
+  std::vector<uint8_t> zero_points;
+  std::vector<int32_t> tmp_zero_points = random.Uniform<int32_t>({N, zero_point_stride}, 0, 255);
+  std::transform(tmp_zero_points.begin(), tmp_zero_points.end(), std::back_inserter(zero_points), [](int32_t v) -> uint8_t {
+    return static_cast<uint8_t>(v);
+  });
+
+  // Dequantize B and compute the expected output.
+  std::vector<float> B_dequantized(K * N);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t block = k / block_size;
+      const uint8_t* blob = B_data.data() + (n * block_count_k + block) * blob_size;
+      const int64_t index = k % block_size;
+
+      int32_t value;
+      int32_t zero_point = 1 << (bits - 1);
+      if (bits == 4) {
+        value = (index & 1) ? (blob[index / 2] >> 4) : (blob[index / 2] & 0x0F);
+        if (has_zero_point) {
+          const uint8_t zp = zero_points[n * zero_point_stride + block / 2];
+          zero_point = (block & 1) ? (zp >> 4) : (zp & 0x0F);
+        }
+      } else {
+        value = blob[index];
+        if (has_zero_point) {
+          zero_point = zero_points[n * zero_point_stride + block];
+        }
+      }
+
+      B_dequantized[k * N + n] = static_cast<float>(value - zero_point) * scales[n * block_count_k + block];
+    }
+  }
+
+  std::vector<float> Y_data(rows * N);
+  for (int64_t m = 0; m < rows; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += A_data[m * K + k] * B_dequantized[k * N + n];
+      }
+      Y_data[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("block_size", block_size);
+
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<uint8_t>("B", {N, block_count_k, blob_size}, B_data, is_weight_constant);
+  test.AddInput<float>("scales", {N * block_count_k}, scales, is_weight_constant);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * zero_point_stride}, zero_points, is_weight_constant);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+  test.SetOutputAbsErr("Y", 5e-3f);
+  test.Run();
+}
+
+TEST(MatMulNBits, Float4Bits) {
+  for (bool has_zero_point : {false, true}) {
+    for (bool is_weight_constant : {false, true}) {
+      TestMatMulNBits(1, 1, 16, 4, 16, has_zero_point, is_weight_constant);
+      TestMatMulNBits(1, 2, 32, 4, 16, has_zero_point, is_weight_constant);
+      TestMatMulNBits(2, 67, 300, 4, 32, has_zero_point, is_weight_constant);
+      TestMatMulNBits(5, 288, 1024, 4, 128, has_zero_point, is_weight_constant);
+      TestMatMulNBits(3, 40, 517, 4, 256, has_zero_point, is_weight_constant);
+    }
+  }
+}
+
+TEST(MatMulNBits, Float8Bits) {
+  for (bool has_zero_point : {false, true}) {
+    for (bool is_weight_constant : {false, true}) {
+      TestMatMulNBits(1, 1, 16, 8, 16, has_zero_point, is_weight_constant);
+      TestMatMulNBits(2, 67, 300, 8, 32, has_zero_point, is_weight_constant);
+      TestMatMulNBits(5, 96, 512, 8, 64, has_zero_point, is_weight_constant);
+    }
+  }
+}
+
+TEST(MatMulNBits, BatchedInput) {
+  TestMatMulNBits(3, 33, 130, 4, 32, true, true, {2, 2});
+  TestMatMulNBits(1, 33, 130, 8, 32, false, false, {3});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
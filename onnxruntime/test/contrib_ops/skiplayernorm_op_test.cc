@@ -54,32 +54,41 @@ static void RunTest(
 
     test.AddOutput<float>("output", output_dims, output_data);
     test.Run();
-  } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/) ||
-             rocm_ep != nullptr) {
-    OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
-    test.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
-    test.AddInput<MLFloat16>("skip", skip_dims, ToFloat16(skip_data));
-    test.AddInput<MLFloat16>("gamma", gamma_dims, ToFloat16(gamma_data));
-    if (!no_beta) {
-      test.AddInput<MLFloat16>("beta", beta_dims, ToFloat16(beta_data));
-    } else {
-      test.AddOptionalInputEdge<float>();
-    }
-    test.AddAttribute("epsilon", epsilon);
-    if (!bias_data.empty()) {
-      test.AddInput<MLFloat16>("bias", bias_dims, ToFloat16(bias_data));
-    }
+  } else {
+    auto run_float16 = [&](std::unique_ptr<IExecutionProvider> execution_provider, optional<float> absolute_error) {
+      OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
+      test.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
+      test.AddInput<MLFloat16>("skip", skip_dims, ToFloat16(skip_data));
+      test.AddInput<MLFloat16>("gamma", gamma_dims, ToFloat16(gamma_data));
+      if (!no_beta) {
+        test.AddInput<MLFloat16>("beta", beta_dims, ToFloat16(beta_data));
+      } else {
+        test.AddOptionalInputEdge<float>();
+      }
+      test.AddAttribute("epsilon", epsilon);
+      if (!bias_data.empty()) {
+        test.AddInput<MLFloat16>("bias", bias_dims, ToFloat16(bias_data));
+      }
+
+      test.AddOutput<MLFloat16>("output", output_dims, ToFloat16(output_data));
+      if (absolute_error.has_value()) {
+        test.SetOutputAbsErr("output", *absolute_error);
+      }
+
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(std::move(execution_provider));
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    };
 
-    test.AddOutput<MLFloat16>("output", output_dims, ToFloat16(output_data));
-
-    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
     if (rocm_ep != nullptr) {
-      execution_providers.push_back(DefaultRocmExecutionProvider());
-    } else {
-      execution_providers.push_back(DefaultCudaExecutionProvider());
+      run_float16(std::move(rocm_ep), {});
+    } else if (HasCudaEnvironment(530 /*min_cuda_architecture*/)) {
+      run_float16(DefaultCudaExecutionProvider(), {});
     }
 
-    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    // The expected outputs are computed from the single precision inputs, so
+    // allow for the rounding of the inputs to half precision.
+    run_float16(DefaultCpuExecutionProvider(), 0.01f);
   }
 }
 
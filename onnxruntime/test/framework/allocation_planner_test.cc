@@ -139,15 +139,19 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, ExecutionOrder execution_order = ExecutionOrder::DEFAULT)
+      : shape_map_(shape_map), execution_order_(execution_order) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  ExecutionOrder GetExecutionOrder() const override { return execution_order_; }
+
  private:
   ShapeMap* shape_map_;
+  ExecutionOrder execution_order_;
 };
 
 class PlannerTest : public ::testing::Test {
@@ -176,6 +180,7 @@ class PlannerTest : public ::testing::Test {
   profiling::Profiler profiler_;
   std::unique_ptr<SessionState> state_;
   ShapeMap shape_map_;
+  ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
   std::unique_ptr<SequentialExecutionPlan> plan_;
 
  public:
@@ -253,6 +258,8 @@ class PlannerTest : public ::testing::Test {
     }
   }
 
+  void SetExecutionOrder(ExecutionOrder execution_order) { execution_order_ = execution_order; }
+
   void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {}) {
     EXPECT_EQ(graph_.Resolve(), Status::OK());
 
@@ -275,7 +282,7 @@ class PlannerTest : public ::testing::Test {
     status = state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, {}, nullptr, remove_initializers);
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, execution_order_);
 
     status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph_), outer_scope_node_args, execution_providers_,
                                            kernel_create_info_map, {}, {}, state_->GetOrtValueNameIdxMap(), test_context,
@@ -291,6 +298,16 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckExecutionOrder(std::initializer_list<std::string> outputs) {
+    // nodes are identified by the name of their (single) output
+    std::vector<std::string> expected{outputs};
+    std::vector<std::string> plan_result;
+    for (const auto& step : plan_->execution_plan) {
+      plan_result.push_back(graph_.GetNode(step.node_index)->OutputDefs()[0]->Name());
+    }
+    EXPECT_EQ(plan_result, expected) << "Execution order incorrect";
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -513,6 +530,36 @@ TEST_F(PlannerTest, PlanOutputTest) {
   }
 }
 
+/* MemoryEfficientOrderTest: Test that the memory efficient order finishes a branch as soon as
+it can free a large tensor, instead of keeping the large tensors of both branches alive.
+*/
+TEST_F(PlannerTest, MemoryEfficientOrderTest) {
+  // tensor variables:
+  std::string X("X"), A1("A1"), A2("A2"), B1("B1"), B2("B2");
+
+  // graph structure: two branches, each producing a large temporary followed by a small output
+  AddNormalNode(X, A1);
+  AddNormalNode(X, B1);
+  AddNormalNode(A1, A2);
+  AddNormalNode(B1, B2);
+
+  // simulate shape-inference results:
+  Shape input_shape{1000};
+  Shape large_shape{1000};
+  Shape larger_shape{2000};
+  Shape small_shape{1};
+  SetShape({{X, &input_shape.value}, {A1, &large_shape.value}, {B1, &larger_shape.value},
+            {A2, &small_shape.value}, {B2, &small_shape.value}});
+
+  SetExecutionOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  CreatePlan();
+
+  CheckExecutionOrder({A1, A2, B1, B2});
+
+  // only the larger temporary and the two outputs are alive at the peak
+  EXPECT_EQ(GetPlan().estimated_peak_activation_bytes, (2000 + 1 + 1) * sizeof(float));
+}
+
 #ifdef USE_CUDA
 TEST_F(PlannerTest, LocationPlanningForPassThroughExplicitAndImplicitSubgraphInputs) {
   // Types
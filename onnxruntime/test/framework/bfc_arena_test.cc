@@ -2,9 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/framework/bfc_arena.h"
+#include "test/util/include/asserts.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <algorithm>
 #include <cstdlib>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -285,6 +288,165 @@ TEST(BFCArenaTest, TestReserve) {
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
 
+TEST(BFCArenaTest, ThreadCacheReusesFreedChunks) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 1 << 20);
+
+  // 1000 bytes round up to 1024
+  void* first_ptr = a.Alloc(1000);
+  a.Free(first_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  // same rounded size from the same thread is served from the cache
+  void* second_ptr = a.Alloc(1010);
+  EXPECT_EQ(first_ptr, second_ptr);
+  EXPECT_EQ(a.RequestedSize(second_ptr), 1010u);
+  EXPECT_EQ(a.AllocatedSize(second_ptr), 1024u);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  // large allocations bypass the cache and are not made any bigger by it
+  void* large_ptr = a.Alloc(1 << 20);
+  EXPECT_EQ(a.AllocatedSize(large_ptr), size_t{1} << 20);
+  a.Free(large_ptr);
+  a.Free(second_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheFlushesToArena) {
+  constexpr int max_thread_cache_bytes = 16 * 1024;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, max_thread_cache_bytes);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; ++i) {
+    ptrs.push_back(a.Alloc(1024));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_GT(stats.num_thread_cache_flushes, 0);
+  EXPECT_LE(stats.bytes_in_thread_caches, max_thread_cache_bytes);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 64 * 1024);
+
+  constexpr int num_threads = 8;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<std::pair<unsigned char*, size_t>> live;
+      for (int i = 0; i < 2000; ++i) {
+        size_t size = static_cast<size_t>(64 + (i * 37 + t * 101) % 8000);
+        auto* p = static_cast<unsigned char*>(a.Alloc(size));
+        memset(p, t, size);
+        live.emplace_back(p, size);
+        if (live.size() > 16) {
+          // free a buffer allocated by this thread after checking nobody else wrote to it
+          auto victim = live[static_cast<size_t>(i) % live.size()];
+          for (size_t j = 0; j < victim.second; ++j) {
+            ASSERT_EQ(victim.first[j], static_cast<unsigned char>(t));
+          }
+          a.Free(victim.first);
+          live.erase(live.begin() + static_cast<size_t>(i) % live.size());
+        }
+      }
+      for (auto& p : live) {
+        a.Free(p.first);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheReturnsRemoteFreesToOwner) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 1 << 20);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 4; ++i) {
+    ptrs.push_back(a.Alloc(4000));
+  }
+
+  // a consumer thread frees the buffers, which go back to the cache of the allocating thread
+  std::thread consumer([&a, &ptrs]() {
+    for (void* p : ptrs) {
+      a.Free(p);
+    }
+  });
+  consumer.join();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 4 * 4096);
+
+  for (int i = 0; i < 4; ++i) {
+    void* p = a.Alloc(4000);
+    EXPECT_NE(std::find(ptrs.begin(), ptrs.end(), p), ptrs.end());
+    a.Free(p);
+  }
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 4);
+  EXPECT_EQ(stats.num_thread_cache_flushes, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 4 * 4096);
+}
+
+TEST(BFCArenaTest, ThreadCacheShrinkDrainsOtherThreads) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 1 << 20);
+
+  // the worker's cache is released when it exits but keeps its chunks
+  std::thread worker([&a]() {
+    for (int i = 0; i < 8; ++i) {
+      a.Free(a.Alloc(static_cast<size_t>(512 * (i + 1))));
+    }
+  });
+  worker.join();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_GT(stats.bytes_in_thread_caches, 0);
+
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_GT(stats.num_thread_cache_flushes, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
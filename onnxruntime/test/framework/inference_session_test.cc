@@ -27,6 +27,7 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/platform/env.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
@@ -41,6 +42,7 @@
 #endif
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_run.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
@@ -611,6 +613,63 @@ TEST(InferenceSessionTests, CheckRunLogger) {
 #endif
 }
 
+TEST(InferenceSessionTests, RunPriorityConfig) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunPriorityConfig";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto make_run_options = [](const char* priority, const char* deadline_us) {
+    RunOptions run_options;
+    if (priority != nullptr) {
+      ORT_THROW_IF_ERROR(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigPriority, priority));
+    }
+    if (deadline_us != nullptr) {
+      ORT_THROW_IF_ERROR(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigDeadlineUs, deadline_us));
+    }
+    return run_options;
+  };
+
+  // valid values
+  RunModel(session_object, make_run_options("normal", nullptr));
+  RunModel(session_object, make_run_options("high", nullptr));
+  RunModel(session_object, make_run_options(nullptr, "0"));
+  RunModel(session_object, make_run_options(nullptr, "1000000"));
+  RunModel(session_object, make_run_options("high", "500"));
+  RunModel(session_object, make_run_options("", ""));
+  // too far in the future to be represented by steady_clock, so there is effectively no deadline
+  RunModel(session_object, make_run_options(nullptr, "9223372036854775807"));
+  RunModel(session_object, make_run_options("high", "9223372036854775000"));
+
+  // invalid values are rejected before the Run starts
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+
+  auto check_rejected = [&](const char* priority, const char* deadline_us, const char* key) {
+    std::vector<OrtValue> fetches;
+    auto status = session_object.Run(make_run_options(priority, deadline_us), feeds, output_names, &fetches);
+    ASSERT_FALSE(status.IsOK()) << "priority:" << (priority ? priority : "-")
+                                << " deadline_us:" << (deadline_us ? deadline_us : "-");
+    EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
+    EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr(key));
+  };
+
+  check_rejected("urgent", nullptr, kOrtRunOptionsConfigPriority);
+  check_rejected("High", nullptr, kOrtRunOptionsConfigPriority);
+  check_rejected("1", "100", kOrtRunOptionsConfigPriority);
+  check_rejected(nullptr, "-1", kOrtRunOptionsConfigDeadlineUs);
+  check_rejected(nullptr, "abc", kOrtRunOptionsConfigDeadlineUs);
+  check_rejected(nullptr, "10us", kOrtRunOptionsConfigDeadlineUs);
+  check_rejected(nullptr, " 10", kOrtRunOptionsConfigDeadlineUs);
+  check_rejected("high", "99999999999999999999", kOrtRunOptionsConfigDeadlineUs);
+}
+
 // WebAssembly will emit profiling data into console
 #if !defined(__wasm__)
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
@@ -988,6 +1047,61 @@ TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   ASSERT_TRUE(!st.IsOK());
 }
 
+TEST(InferenceSessionTests, TestPreparedRun) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestPreparedRun";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<std::string> feed_names{"X"};
+  std::vector<std::string> output_names{"Y"};
+
+  std::unique_ptr<PreparedRun> prepared_run;
+  ASSERT_STATUS_OK(session_object.PrepareRun(feed_names, output_names, nullptr, &prepared_run));
+
+  RunOptions run_options;
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &ml_value);
+  std::vector<OrtValue> feeds{ml_value};
+
+  // the same prepared run can be used repeatedly
+  for (int i = 0; i < 3; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, *prepared_run, feeds, &fetches));
+    VerifyOutputs(fetches, dims_mul_x, expected_values_mul_y);
+  }
+
+  // wrong element type has to be caught
+  OrtValue int_value;
+  CreateMLValue<int64_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x,
+                         {1, 2, 3, 4, 5, 6}, &int_value);
+  std::vector<OrtValue> bad_feeds{int_value};
+  std::vector<OrtValue> fetches;
+  ASSERT_FALSE(session_object.Run(run_options, *prepared_run, bad_feeds, &fetches).IsOK());
+
+  // wrong number of feeds has to be caught
+  bad_feeds.push_back(ml_value);
+  ASSERT_FALSE(session_object.Run(run_options, *prepared_run, bad_feeds, &fetches).IsOK());
+
+  // wrong shape has to be caught
+  OrtValue bad_shape_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {3, 2, 1}, values_mul_x,
+                       &bad_shape_value);
+  bad_feeds = {bad_shape_value};
+  ASSERT_FALSE(session_object.Run(run_options, *prepared_run, bad_feeds, &fetches).IsOK());
+
+  // invalid names are rejected when preparing
+  std::unique_ptr<PreparedRun> invalid_prepared_run;
+  ASSERT_FALSE(session_object.PrepareRun({"bad_name"}, output_names, nullptr, &invalid_prepared_run).IsOK());
+  ASSERT_FALSE(session_object.PrepareRun(feed_names, {"bad_name"}, nullptr, &invalid_prepared_run).IsOK());
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
@@ -2887,5 +3001,56 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
   VerifyThreadPoolWithDenormalAsZero(session2.GetInterOpThreadPoolToUse(), false);
 }
 
+
+TEST(InferenceSessionTests, GemmAutotuneTuningTable) {
+  const std::string tuning_file = "gemm_autotune_tuning_table.txt";
+  std::remove(tuning_file.c_str());
+  MlasGemmTuningClear();
+
+  // tune the MatMul of the model, a 3x2 by 2x1 multiplication, and save the table
+  {
+    SessionOptions so;
+    so.session_logid = "GemmAutotuneTuningTable";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGemmTuningFile, tuning_file.c_str()));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGemmAutotune, "1"));
+
+    InferenceSession session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load("testdata/matmul_1.onnx"));
+    ASSERT_STATUS_OK(session.Initialize());
+  }
+
+  MLAS_GEMM_TUNING_ENTRY tuned;
+  ASSERT_EQ(MlasGemmTuningGetEntries(&tuned, 1), size_t(1));
+  EXPECT_EQ(tuned.Kind, MlasGemmTuningSgemm);
+  EXPECT_EQ(tuned.M, size_t(3));
+  EXPECT_EQ(tuned.N, size_t(1));
+  EXPECT_EQ(tuned.K, size_t(2));
+  EXPECT_EQ(tuned.BatchSize, size_t(1));
+
+  // a session without autotuning only loads the saved table
+  MlasGemmTuningClear();
+  {
+    SessionOptions so;
+    so.session_logid = "GemmAutotuneTuningTable";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGemmTuningFile, tuning_file.c_str()));
+
+    InferenceSession session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load("testdata/matmul_1.onnx"));
+    ASSERT_STATUS_OK(session.Initialize());
+  }
+
+  MLAS_GEMM_TUNING_ENTRY loaded;
+  ASSERT_EQ(MlasGemmTuningGetEntries(&loaded, 1), size_t(1));
+  EXPECT_EQ(loaded.M, tuned.M);
+  EXPECT_EQ(loaded.N, tuned.N);
+  EXPECT_EQ(loaded.K, tuned.K);
+  EXPECT_EQ(loaded.MaximumThreadCount, tuned.MaximumThreadCount);
+  EXPECT_EQ(loaded.ThreadCountM, tuned.ThreadCountM);
+  EXPECT_EQ(loaded.ThreadCountN, tuned.ThreadCountN);
+
+  MlasGemmTuningClear();
+  std::remove(tuning_file.c_str());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
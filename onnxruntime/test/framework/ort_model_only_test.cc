@@ -305,6 +305,95 @@ TEST(OrtModelOnlyTests, ValidateOrtFormatModelDoesNotRunOptimizersInFullBuild) {
   RunOrtModel(test_info);
 }
 
+// Load the ORT format model with and without memory mapping it, and check how the initializers of the mapped model
+// are used. Returns the number of initializers that refer to the mapped file and the number used in place.
+static void LoadMappedOrtFormatModel(const std::string& onnx_file, const std::basic_string<ORTCHAR_T>& ort_file,
+                                     size_t& num_in_memory, size_t& num_in_place) {
+  SaveAndCompareModels(onnx_file, ort_file);
+
+  SessionOptions so;
+  so.session_logid = "LoadOrtFormat";
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ort_file));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  SessionOptions so2;
+  so2.session_logid = "LoadMappedOrtFormat";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigMapOrtModelFile, "1"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+
+  CompareGraphAndSessionState(session_object, session_object2);
+
+  // the large initializers refer to the mapped file. the tensors created for the constant ones use that memory
+  // directly, and the others are copied as they can be overridden.
+  const auto& graph = session_object2.GetGraph();
+  const auto& session_state = session_object2.GetSessionState();
+  const auto& initialized_tensors = session_state.GetInitializedTensors();
+  num_in_memory = 0;
+  num_in_place = 0;
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    const void* data = nullptr;
+    size_t length = 0;
+    if (!utils::GetExternalDataInMemory(*entry.second, data, length)) {
+      continue;
+    }
+
+    ++num_in_memory;
+    int idx;
+    ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx(entry.first, idx));
+    auto iter = initialized_tensors.find(idx);
+    // initializers that were pre-packed may have been released
+    if (iter == initialized_tensors.cend()) {
+      continue;
+    }
+
+    if (graph.IsConstantInitializer(entry.first, false)) {
+      EXPECT_EQ(iter->second.Get<Tensor>().DataRaw(), data) << entry.first;
+      ++num_in_place;
+    } else {
+      EXPECT_NE(iter->second.Get<Tensor>().DataRaw(), data) << entry.first;
+    }
+  }
+
+  // serializing the graph must copy the mapped data rather than write out its address
+  const auto graph_proto = graph.ToGraphProto();
+  for (const auto& initializer : graph_proto.initializer()) {
+    const void* data = nullptr;
+    size_t length = 0;
+    EXPECT_FALSE(utils::GetExternalDataInMemory(initializer, data, length)) << initializer.name();
+    for (const auto& entry : initializer.external_data()) {
+      EXPECT_NE(entry.value(), utils::kTensorProtoMemoryAddressTag) << initializer.name();
+    }
+
+    const ONNX_NAMESPACE::TensorProto* original = nullptr;
+    ASSERT_TRUE(session_object.GetGraph().GetInitializedTensor(initializer.name(), original));
+    EXPECT_EQ(initializer.raw_data(), original->raw_data()) << initializer.name();
+  }
+}
+
+// test that the constant initializers of a memory mapped ORT format model are used in place
+TEST(OrtModelOnlyTests, LoadMappedOrtFormatModel) {
+  size_t num_in_memory = 0;
+  size_t num_in_place = 0;
+  LoadMappedOrtFormatModel("testdata/transform/fusion/fast_gelu_with_bias.onnx",
+                           ORT_TSTR("testdata/fast_gelu_with_bias.onnx.test_output.ort"),
+                           num_in_memory, num_in_place);
+  ASSERT_GT(num_in_place, 0u);
+}
+
+// test that the initializers of a memory mapped ORT format model are copied if they are also graph inputs
+TEST(OrtModelOnlyTests, LoadMappedOrtFormatModelWithOverridableInitializers) {
+  // IR version 3 model, so all the initializers are graph inputs
+  size_t num_in_memory = 0;
+  size_t num_in_place = 0;
+  LoadMappedOrtFormatModel("testdata/mnist.onnx", ORT_TSTR("testdata/mnist.onnx.test_output.ort"),
+                           num_in_memory, num_in_place);
+  ASSERT_GT(num_in_memory, 0u);
+  ASSERT_EQ(num_in_place, 0u);
+}
+
 TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/ort_github_issue_4031.onnx.test_output.ort");
   SaveAndCompareModels("testdata/ort_github_issue_4031.onnx", ort_file);
@@ -462,6 +551,13 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopy) {
   RunOrtModel(test_info);
 }
 
+// Memory map the model file instead of reading it
+TEST(OrtModelOnlyTests, LoadOrtFormatModelMapped) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigMapOrtModelFile, "1"));
+  RunOrtModel(test_info);
+}
+
 #if !defined(DISABLE_ML_OPS)
 // test that we can deserialize and run a previously saved ORT format model
 // for a model with sequence and map outputs
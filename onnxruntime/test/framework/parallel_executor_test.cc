@@ -3,7 +3,10 @@
 
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
 #include "test_utils.h"
 #include "core/session/inference_session.h"
 
@@ -145,5 +148,77 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
 
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                         testing::Values(1, 0));
+
+// many independent branches joined at the end, so ready nodes are spread across the inter-op threads.
+// with a single root, all the branches become ready on one worker and the others have to steal them.
+static void RunWideGraphTest(bool single_root) {
+  constexpr int num_branches = 32;
+
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  Model model("wide_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* x = &graph.GetOrCreateNodeArg("X", &tensor_float);
+  if (single_root) {
+    auto& root_out = graph.GetOrCreateNodeArg("root", &tensor_float);
+    graph.AddNode("root_node", "Identity", "", {x}, {&root_out});
+    x = &root_out;
+  }
+
+  std::vector<NodeArg*> branch_outputs;
+  for (int i = 0; i < num_branches; ++i) {
+    // each branch is a short chain so the executor also continues nodes inline
+    auto& add_out = graph.GetOrCreateNodeArg("add_" + std::to_string(i), &tensor_float);
+    graph.AddNode("add_node_" + std::to_string(i), "Add", "", {x, x}, {&add_out});
+    auto& relu_out = graph.GetOrCreateNodeArg("relu_" + std::to_string(i), &tensor_float);
+    graph.AddNode("relu_node_" + std::to_string(i), "Relu", "", {&add_out}, {&relu_out});
+    branch_outputs.push_back(&relu_out);
+  }
+
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("sum_node", "Sum", "", branch_outputs, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+
+  SessionOptions so;
+  so.session_logid = "ParallelExecutor.TestWideGraph";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 4;
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {4},
+                       {1.f, -1.f, 2.f, 0.5f}, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+
+  for (int run = 0; run < 10; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto result = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    const std::vector<float> expected{2.f * num_branches, 0.f, 4.f * num_branches, 1.f * num_branches};
+    ASSERT_EQ(static_cast<size_t>(result.size()), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(result[i], expected[i]);
+    }
+  }
+}
+
+TEST(ParallelExecutor, TestWideGraph) {
+  RunWideGraphTest(false);
+}
+
+TEST(ParallelExecutor, TestWideGraphSingleRoot) {
+  RunWideGraphTest(true);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -99,6 +99,60 @@ TEST_P(SessionStateAddGetKernelTest, AddGetKernelTest) {
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateAddGetKernelTest, testing::Values(0, 1));
 
+// training builds generate patterns on a cache miss, which requires a finalized session state
+#if !defined(ENABLE_TRAINING)
+TEST(SessionStateTest, MemoryPatternCache) {
+  // one entry per shard, a capacity that does not divide evenly between the shards, and fewer entries than shards
+  for (size_t capacity : std::vector<size_t>{16, 21, 5}) {
+    SCOPED_TRACE(capacity);
+    onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+    ExecutionProviders execution_providers;
+    ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                             std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false))));
+    DataTransferManager dtm;
+    profiling::Profiler profiler;
+    SessionState s(model.MainGraph(), execution_providers, true, nullptr, nullptr, dtm,
+                   DefaultLoggingManager().DefaultLogger(), profiler);
+    s.SetMemoryPatternCacheCapacity(capacity);
+
+    std::vector<int> feed_mlvalue_idxs{0};
+    std::unordered_map<int, TensorShape> inferred_shapes;
+    auto get = [&](const TensorShape& shape) {
+      std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+      return s.GetMemoryPatternGroup(input_shapes, feed_mlvalue_idxs, inferred_shapes);
+    };
+    auto update = [&](const TensorShape& shape) {
+      std::vector<std::reference_wrapper<const TensorShape>> input_shapes{std::cref(shape)};
+      ASSERT_STATUS_OK(s.UpdateMemoryPatternGroupCache(input_shapes, std::make_unique<MemoryPatternGroup>()));
+    };
+
+    // shapes with the same dims in a different order or rank must not share a pattern
+    update(TensorShape({2, 3}));
+    EXPECT_NE(get(TensorShape({2, 3})), nullptr);
+    EXPECT_EQ(get(TensorShape({3, 2})), nullptr);
+    EXPECT_EQ(get(TensorShape({2, 3, 1})), nullptr);
+
+    // a pattern in use stays valid after it is evicted
+    auto in_use = get(TensorShape({2, 3}));
+
+    constexpr int64_t num_shapes = 1000;
+    for (int64_t i = 1; i <= num_shapes; ++i) {
+      update(TensorShape({1, i}));
+    }
+
+    EXPECT_NE(get(TensorShape({1, num_shapes})), nullptr);
+    EXPECT_EQ(in_use.use_count(), 1);
+
+    // every shard in use is full, and the shards hold exactly the capacity between them
+    size_t num_cached = 0;
+    for (int64_t i = 1; i <= num_shapes; ++i) {
+      num_cached += get(TensorShape({1, i})) != nullptr;
+    }
+    EXPECT_EQ(num_cached, capacity);
+  }
+}
+#endif
+
 namespace {
 class TestParam {
  public:
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> activation_arg_names = {"M", "N"};
+
+void ACTIVATION(benchmark::State& state, MLAS_ACTIVATION_KIND kind, bool with_bias) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = kind;
+  switch (kind) {
+    case MlasLeakyReluActivation:
+      activation.Parameters.LeakyRelu.alpha = 0.01f;
+      break;
+    case MlasClipActivation:
+      activation.Parameters.Clip.minimum = 0.0f;
+      activation.Parameters.Clip.maximum = 6.0f;
+      break;
+    case MlasHardSigmoidActivation:
+      activation.Parameters.HardSigmoid.alpha = 0.2f;
+      activation.Parameters.HardSigmoid.beta = 0.5f;
+      break;
+    default:
+      break;
+  }
+
+  const auto input = RandomVectorUniform(M * N, -8.0f, 8.0f);
+  const auto bias = RandomVectorUniform(M, -1.0f, 1.0f);
+  std::vector<float> buffer(input);
+
+  for (auto _ : state) {
+    // The activation is applied in place, so restore the input to keep the values in range.
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), buffer.begin());
+    state.ResumeTiming();
+
+    MlasActivation(&activation, buffer.data(), with_bias ? bias.data() : nullptr, M, N, N);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N));
+}
+
+static void ActivationSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(activation_arg_names);
+  // Conv outputs of ResNet-50 and MobileNetV2 (channels x image size) and a BERT-base hidden state
+  b->Args({64, 112 * 112});
+  b->Args({256, 56 * 56});
+  b->Args({2048, 7 * 7});
+  b->Args({32, 112 * 112});
+  b->Args({128, 768});
+  b->Args({1, 1000});
+}
+
+BENCHMARK_CAPTURE(ACTIVATION, Relu, MlasReluActivation, false)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Relu_Bias, MlasReluActivation, true)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, LeakyRelu, MlasLeakyReluActivation, false)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Tanh, MlasTanhActivation, false)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Logistic, MlasLogisticActivation, false)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, Clip, MlasClipActivation, false)->Apply(ActivationSize)->UseRealTime();
+BENCHMARK_CAPTURE(ACTIVATION, HardSigmoid, MlasHardSigmoidActivation, false)->Apply(ActivationSize)->UseRealTime();
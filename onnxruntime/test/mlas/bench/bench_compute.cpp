@@ -0,0 +1,233 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> elementwise_arg_names = {"N"};
+
+static void ElementwiseSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(elementwise_arg_names);
+  // A BERT-base hidden state, its feed forward intermediate state and a ResNet-50 activation
+  b->Arg(128 * 768);
+  b->Arg(128 * 3072);
+  b->Arg(64 * 112 * 112);
+  b->Arg(1000);
+  b->Arg(15);
+}
+
+typedef void(MLASCALL* ELEMENTWISE_ROUTINE)(const float*, float*, size_t);
+
+void ELEMENTWISE(benchmark::State& state, ELEMENTWISE_ROUTINE routine, float min_value, float max_value) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  const auto input = RandomVectorUniform(N, min_value, max_value);
+  std::vector<float> output(N);
+
+  for (auto _ : state) {
+    routine(input.data(), output.data(), N);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+BENCHMARK_CAPTURE(ELEMENTWISE, Erf, MlasComputeErf, -4.0f, 4.0f)->Apply(ElementwiseSize)->UseRealTime();
+BENCHMARK_CAPTURE(ELEMENTWISE, Exp, MlasComputeExp, -20.0f, 20.0f)->Apply(ElementwiseSize)->UseRealTime();
+BENCHMARK_CAPTURE(ELEMENTWISE, Logistic, MlasComputeLogistic, -10.0f, 10.0f)->Apply(ElementwiseSize)->UseRealTime();
+BENCHMARK_CAPTURE(ELEMENTWISE, Tanh, MlasComputeTanh, -10.0f, 10.0f)->Apply(ElementwiseSize)->UseRealTime();
+
+static const std::vector<std::string> softmax_arg_names = {"N", "D", "Threads"};
+
+void SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+  auto tp = CreateBenchThreadPool(state.range(2));
+
+  const auto input = RandomVectorUniform(N * D, -10.0f, 10.0f);
+  std::vector<float> output(N * D);
+
+  for (auto _ : state) {
+    MlasComputeSoftmax(input.data(), output.data(), N, D, log_softmax, tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * D));
+}
+
+static void SoftmaxSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(softmax_arg_names);
+  // BERT-base attention probabilities (batch.heads.sequence rows) and an ImageNet classifier
+  ArgsProduct(b, {{12 * 128}, {128}, BenchThreadCounts()});
+  ArgsProduct(b, {{12 * 512}, {512}, BenchThreadCounts()});
+  ArgsProduct(b, {{1}, {1000}, {1}});
+  ArgsProduct(b, {{64}, {32128}, BenchThreadCounts()});
+}
+
+BENCHMARK_CAPTURE(SOFTMAX, Softmax, false)->Apply(SoftmaxSize)->UseRealTime();
+BENCHMARK_CAPTURE(SOFTMAX, LogSoftmax, true)->Apply(SoftmaxSize)->UseRealTime();
+
+static const std::vector<std::string> reduce_arg_names = {"Rows", "Columns"};
+
+void REDUCE_CONTIGUOUS(benchmark::State& state, MLAS_REDUCE_OPERATION operation) {
+  if (state.range(0) <= 0) throw std::invalid_argument("Rows must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("Columns must greater than 0!");
+  const size_t rows = static_cast<size_t>(state.range(0));
+  const size_t columns = static_cast<size_t>(state.range(1));
+
+  const auto input = RandomVectorUniform(rows * columns, -1.0f, 1.0f);
+  std::vector<float> output(rows);
+
+  for (auto _ : state) {
+    MlasReduceContiguous(operation, input.data(), output.data(), rows, columns);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(rows * columns));
+}
+
+void REDUCE_STRIDED(benchmark::State& state, MLAS_REDUCE_OPERATION operation) {
+  if (state.range(0) <= 0) throw std::invalid_argument("Rows must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("Columns must greater than 0!");
+  const size_t rows = static_cast<size_t>(state.range(0));
+  const size_t columns = static_cast<size_t>(state.range(1));
+
+  const auto input = RandomVectorUniform(rows * columns, -1.0f, 1.0f);
+  std::vector<float> output(columns);
+
+  for (auto _ : state) {
+    MlasReduceStrided(operation, input.data(), output.data(), rows, columns, columns);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(rows * columns));
+}
+
+static void ReduceSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(reduce_arg_names);
+  // BERT-base hidden states and a ResNet-50 global pooling
+  b->Args({128, 768});
+  b->Args({512, 1024});
+  b->Args({2048, 49});
+  b->Args({1, 100000});
+}
+
+BENCHMARK_CAPTURE(REDUCE_CONTIGUOUS, Sum, MlasReduceSum)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE_CONTIGUOUS, Maximum, MlasReduceMaximum)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE_STRIDED, Sum, MlasReduceSum)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE_STRIDED, Minimum, MlasReduceMinimum)->Apply(ReduceSize)->UseRealTime();
+
+void LAYER_NORMALIZATION(benchmark::State& state, bool with_skip, bool simplified) {
+  if (state.range(0) <= 0) throw std::invalid_argument("Rows must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("Columns must greater than 0!");
+  const size_t rows = static_cast<size_t>(state.range(0));
+  const size_t columns = static_cast<size_t>(state.range(1));
+
+  const auto input = RandomVectorUniform(rows * columns, -2.0f, 2.0f);
+  const auto skip = RandomVectorUniform(rows * columns, -2.0f, 2.0f);
+  const auto gamma = RandomVectorUniform(columns, 0.5f, 1.5f);
+  const auto beta = RandomVectorUniform(columns, -0.5f, 0.5f);
+  const auto bias = RandomVectorUniform(columns, -0.5f, 0.5f);
+  std::vector<float> output(rows * columns);
+
+  for (auto _ : state) {
+    for (size_t row = 0; row < rows; row++) {
+      MlasLayerNormalization(input.data() + row * columns,
+                             with_skip ? skip.data() + row * columns : nullptr,
+                             with_skip ? bias.data() : nullptr,
+                             gamma.data(), beta.data(),
+                             output.data() + row * columns,
+                             columns, 1e-5f, simplified, nullptr, nullptr);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(rows * columns));
+}
+
+BENCHMARK_CAPTURE(LAYER_NORMALIZATION, LayerNorm, false, false)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORMALIZATION, SkipLayerNorm, true, false)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORMALIZATION, SimplifiedLayerNorm, false, true)->Apply(ReduceSize)->UseRealTime();
+
+void HALF_LAYER_NORMALIZATION(benchmark::State& state, bool with_skip, bool simplified) {
+  if (state.range(0) <= 0) throw std::invalid_argument("Rows must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("Columns must greater than 0!");
+  const size_t rows = static_cast<size_t>(state.range(0));
+  const size_t columns = static_cast<size_t>(state.range(1));
+
+  auto to_half = [](const std::vector<float>& values) {
+    std::vector<uint16_t> half(values.size());
+    MlasConvertFloatToHalf(values.data(), half.data(), values.size());
+    return half;
+  };
+
+  const auto input = to_half(RandomVectorUniform(rows * columns, -2.0f, 2.0f));
+  const auto skip = to_half(RandomVectorUniform(rows * columns, -2.0f, 2.0f));
+  const auto gamma = to_half(RandomVectorUniform(columns, 0.5f, 1.5f));
+  const auto beta = to_half(RandomVectorUniform(columns, -0.5f, 0.5f));
+  const auto bias = to_half(RandomVectorUniform(columns, -0.5f, 0.5f));
+  std::vector<uint16_t> output(rows * columns);
+
+  for (auto _ : state) {
+    for (size_t row = 0; row < rows; row++) {
+      MlasHalfLayerNormalization(input.data() + row * columns,
+                                 with_skip ? skip.data() + row * columns : nullptr,
+                                 with_skip ? bias.data() : nullptr,
+                                 gamma.data(), beta.data(),
+                                 output.data() + row * columns,
+                                 columns, 1e-5f, simplified, nullptr, nullptr);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(rows * columns));
+}
+
+BENCHMARK_CAPTURE(HALF_LAYER_NORMALIZATION, LayerNorm, false, false)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALF_LAYER_NORMALIZATION, SkipLayerNorm, true, false)->Apply(ReduceSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALF_LAYER_NORMALIZATION, SimplifiedLayerNorm, false, true)->Apply(ReduceSize)->UseRealTime();
+
+void CONVERT_HALF(benchmark::State& state, bool to_float) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  const auto input = RandomVectorUniform(N, -100.0f, 100.0f);
+  std::vector<uint16_t> half(N);
+  std::vector<float> output(N);
+  MlasConvertFloatToHalf(input.data(), half.data(), N);
+
+  for (auto _ : state) {
+    if (to_float) {
+      MlasConvertHalfToFloatBuffer(half.data(), output.data(), N);
+    } else {
+      MlasConvertFloatToHalf(input.data(), half.data(), N);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+BENCHMARK_CAPTURE(CONVERT_HALF, HalfToFloat, true)->Apply(ElementwiseSize)->UseRealTime();
+BENCHMARK_CAPTURE(CONVERT_HALF, FloatToHalf, false)->Apply(ElementwiseSize)->UseRealTime();
+
+void CONVERT_BF16(benchmark::State& state, bool to_float) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  const auto input = RandomVectorUniform(N, -100.0f, 100.0f);
+  std::vector<uint16_t> bf16(N);
+  std::vector<float> output(N);
+  MlasConvertFloatToBf16(input.data(), bf16.data(), N);
+
+  for (auto _ : state) {
+    if (to_float) {
+      MlasConvertBf16ToFloat(bf16.data(), output.data(), N);
+    } else {
+      MlasConvertFloatToBf16(input.data(), bf16.data(), N);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+BENCHMARK_CAPTURE(CONVERT_BF16, Bf16ToFloat, true)->Apply(ElementwiseSize)->UseRealTime();
+BENCHMARK_CAPTURE(CONVERT_BF16, FloatToBf16, false)->Apply(ElementwiseSize)->UseRealTime();
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> halfgemm_bench_arg_names = {"M", "N", "K", "Batch", "Threads"};
+
+typedef void(MLASCALL* HALF_GEMM_ROUTINE)(CBLAS_TRANSPOSE, CBLAS_TRANSPOSE, size_t, size_t, size_t,
+                                          const MLAS_HALF_GEMM_DATA_PARAMS*, size_t, MLAS_THREADPOOL*);
+typedef void(MLASCALL* HALF_CONVERT_ROUTINE)(const float*, uint16_t*, size_t);
+
+void HALFGEMM(benchmark::State& state, HALF_GEMM_ROUTINE routine, HALF_CONVERT_ROUTINE convert, bool trans_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Batch must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t batch = static_cast<size_t>(state.range(3));
+  auto tp = CreateBenchThreadPool(state.range(4));
+
+  auto to_16bit = [convert](const std::vector<float>& values) {
+    std::vector<uint16_t> converted(values.size());
+    convert(values.data(), converted.data(), values.size());
+    return converted;
+  };
+
+  const auto A = to_16bit(RandomVectorUniform(static_cast<size_t>(M * K * batch), -1.0f, 1.0f));
+  const auto B = to_16bit(RandomVectorUniform(static_cast<size_t>(N * K * batch), -1.0f, 1.0f));
+  std::vector<uint16_t> C(static_cast<size_t>(M * N * batch));
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(batch);
+  for (size_t i = 0; i < batch; i++) {
+    data[i].A = A.data() + M * K * i;
+    data[i].lda = K;
+    data[i].B = B.data() + N * K * i;
+    data[i].ldb = trans_b ? K : N;
+    data[i].C = C.data() + M * N * i;
+    data[i].ldc = N;
+  }
+
+  const CBLAS_TRANSPOSE TransB = trans_b ? CblasTrans : CblasNoTrans;
+  routine(CblasNoTrans, TransB, M, N, K, data.data(), batch, tp.get());
+
+  for (auto _ : state) {
+    routine(CblasNoTrans, TransB, M, N, K, data.data(), batch, tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N * K * batch));
+}
+
+static void HalfGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(halfgemm_bench_arg_names);
+  // BERT-base projection and feed forward layers with a sequence length of 128
+  ArgsProduct(b, {{128}, {768}, {768}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{128}, {3072}, {768}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{128}, {768}, {3072}, {1}, BenchThreadCounts()});
+  // BERT-base attention scores and context per head
+  ArgsProduct(b, {{128}, {128}, {64}, {12}, BenchThreadCounts()});
+  ArgsProduct(b, {{128}, {64}, {128}, {12}, BenchThreadCounts()});
+  // token by token decoding
+  ArgsProduct(b, {{1}, {768}, {768}, {1}, BenchThreadCounts()});
+}
+
+BENCHMARK_CAPTURE(HALFGEMM, Fp16_NoTrans, MlasHalfGemmBatch, MlasConvertFloatToHalf, false)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, Fp16_TransB, MlasHalfGemmBatch, MlasConvertFloatToHalf, true)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, Bf16_NoTrans, MlasBf16GemmBatch, MlasConvertFloatToBf16, false)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, Bf16_TransB, MlasBf16GemmBatch, MlasConvertFloatToBf16, true)->Apply(HalfGemmSize)->UseRealTime();
@@ -0,0 +1,276 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static int64_t NchwcAlign(int64_t channels, int64_t block_size) {
+  return (channels + block_size - 1) & ~(block_size - 1);
+}
+
+static const std::vector<std::string> nchwc_conv_arg_names = {"C", "H", "W", "F", "K", "S", "Threads"};
+
+// The type of convolution is selected by MlasNchwcConv from the shape, so each benchmark only chooses the shapes
+// and the matching filter layout: NCHW input (C < block size), depthwise (F == C, one group per channel), or
+// NCHWc/pointwise input otherwise.
+void NCHWC_CONV(benchmark::State& state, bool depthwise) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  const int64_t filters = depthwise ? channels : state.range(3);
+  const int64_t kernel = state.range(4);
+  const int64_t stride = state.range(5);
+  auto tp = CreateBenchThreadPool(state.range(6));
+
+  if (channels <= 0 || height <= 0 || width <= 0 || filters <= 0) {
+    throw std::invalid_argument("C, H, W and F must greater than 0!");
+  }
+  if (kernel <= 0 || stride <= 0) throw std::invalid_argument("K and S must greater than 0!");
+
+  const int64_t group_count = depthwise ? channels : 1;
+  const bool nchw_input = !depthwise && channels < block_size;
+
+  const int64_t input_channels = nchw_input ? channels : NchwcAlign(channels, block_size);
+  const int64_t output_channels = NchwcAlign(filters, block_size);
+  const int64_t filter_input_channels = depthwise ? 1 : input_channels;
+
+  const int64_t pad = kernel / 2;
+  const int64_t output_height = (height + 2 * pad - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * pad - kernel) / stride + 1;
+
+  const int64_t input_shape[] = {1, input_channels, height, width};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {1, output_channels, output_height, output_width};
+
+  const auto input = RandomVectorUniform(static_cast<size_t>(input_channels * height * width), -1.0f, 1.0f);
+  const auto filter = RandomVectorUniform(static_cast<size_t>(output_channels * filter_input_channels * kernel * kernel), -1.0f, 1.0f);
+  const auto bias = RandomVectorUniform(static_cast<size_t>(output_channels), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(output_channels * output_height * output_width));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  for (auto _ : state) {
+    MlasNchwcConv(input_shape, kernel_shape, dilation_shape, padding, stride_shape, output_shape,
+                  static_cast<size_t>(group_count), input.data(), filter.data(), bias.data(), output.data(),
+                  &activation, true, tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * filters * output_height * output_width *
+                          (depthwise ? 1 : channels) * kernel * kernel);
+}
+
+static void NchwcConvSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(nchwc_conv_arg_names);
+  // ResNet-50 stem, 3x3 and bottleneck 1x1 convolutions
+  ArgsProduct(b, {{3}, {224}, {224}, {64}, {7}, {2}, BenchThreadCounts()});
+  ArgsProduct(b, {{64}, {56}, {56}, {64}, {3}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{256}, {56}, {56}, {64}, {1}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{512}, {28}, {28}, {128}, {1}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{256}, {14}, {14}, {256}, {3}, {1}, BenchThreadCounts()});
+}
+
+static void NchwcDepthwiseConvSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(nchwc_conv_arg_names);
+  // MobileNetV2 depthwise convolutions
+  ArgsProduct(b, {{32}, {112}, {112}, {32}, {3}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{144}, {56}, {56}, {144}, {3}, {2}, BenchThreadCounts()});
+  ArgsProduct(b, {{960}, {7}, {7}, {960}, {3}, {1}, BenchThreadCounts()});
+}
+
+BENCHMARK_CAPTURE(NCHWC_CONV, Conv, false)->Apply(NchwcConvSize)->UseRealTime();
+BENCHMARK_CAPTURE(NCHWC_CONV, Depthwise, true)->Apply(NchwcDepthwiseConvSize)->UseRealTime();
+
+static const std::vector<std::string> reorder_arg_names = {"C", "H", "W"};
+
+void REORDER_INPUT(benchmark::State& state, bool channels_last) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  if (channels <= 0 || height <= 0 || width <= 0) throw std::invalid_argument("C, H and W must greater than 0!");
+
+  const auto input = RandomVectorUniform(static_cast<size_t>(channels * height * width), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(NchwcAlign(channels, block_size) * height * width));
+
+  for (auto _ : state) {
+    if (channels_last) {
+      MlasReorderInputNhwc(input.data(), output.data(), static_cast<size_t>(channels),
+                           static_cast<size_t>(height * width), static_cast<size_t>(height * width));
+    } else {
+      MlasReorderInputNchw(input.data(), output.data(), static_cast<size_t>(channels),
+                           static_cast<size_t>(height * width));
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * channels * height * width *
+                          static_cast<int64_t>(sizeof(float)));
+}
+
+void REORDER_OUTPUT(benchmark::State& state, bool channels_last) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  if (channels <= 0 || height <= 0 || width <= 0) throw std::invalid_argument("C, H and W must greater than 0!");
+
+  const int64_t nchw_shape[] = {1, channels, height, width};
+  const int64_t nhwc_shape[] = {1, height, width, channels};
+
+  const auto input = RandomVectorUniform(static_cast<size_t>(NchwcAlign(channels, block_size) * height * width), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(channels * height * width));
+
+  for (auto _ : state) {
+    if (channels_last) {
+      MlasReorderOutputNhwc(nhwc_shape, input.data(), output.data());
+    } else {
+      MlasReorderOutputNchw(nchw_shape, input.data(), output.data());
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * channels * height * width *
+                          static_cast<int64_t>(sizeof(float)));
+}
+
+static void ReorderSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(reorder_arg_names);
+  // ResNet-50 and MobileNetV2 activations, including channel counts that are not a multiple of the block size
+  b->Args({64, 56, 56});
+  b->Args({2048, 7, 7});
+  b->Args({24, 56, 56});
+  b->Args({3, 224, 224});
+}
+
+BENCHMARK_CAPTURE(REORDER_INPUT, Nchw, false)->Apply(ReorderSize)->UseRealTime();
+BENCHMARK_CAPTURE(REORDER_INPUT, Nhwc, true)->Apply(ReorderSize)->UseRealTime();
+BENCHMARK_CAPTURE(REORDER_OUTPUT, Nchw, false)->Apply(ReorderSize)->UseRealTime();
+BENCHMARK_CAPTURE(REORDER_OUTPUT, Nhwc, true)->Apply(ReorderSize)->UseRealTime();
+
+static const std::vector<std::string> reorder_filter_arg_names = {"F", "C", "K"};
+
+void REORDER_FILTER(benchmark::State& state, bool block_input_channels) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t filters = state.range(0);
+  const int64_t channels = state.range(1);
+  const int64_t kernel = state.range(2);
+  if (filters <= 0 || channels <= 0 || kernel <= 0) throw std::invalid_argument("F, C and K must greater than 0!");
+
+  const int64_t filter_shape[] = {filters, channels, kernel, kernel};
+
+  const auto input = RandomVectorUniform(static_cast<size_t>(filters * channels * kernel * kernel), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(NchwcAlign(filters, block_size) *
+                                                (block_input_channels ? NchwcAlign(channels, block_size) : channels) *
+                                                kernel * kernel));
+
+  for (auto _ : state) {
+    if (block_input_channels) {
+      MlasReorderFilterOIHWBiBo(filter_shape, input.data(), output.data());
+    } else {
+      MlasReorderFilterOIHWBo(filter_shape, input.data(), output.data());
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * filters * channels * kernel * kernel *
+                          static_cast<int64_t>(sizeof(float)));
+}
+
+static void ReorderFilterSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(reorder_filter_arg_names);
+  // ResNet-50 3x3 and 1x1 filters and the stem filter
+  b->Args({256, 256, 3});
+  b->Args({2048, 512, 1});
+  b->Args({64, 3, 7});
+}
+
+BENCHMARK_CAPTURE(REORDER_FILTER, OIHWBiBo, true)->Apply(ReorderFilterSize)->UseRealTime();
+BENCHMARK_CAPTURE(REORDER_FILTER, OIHWBo, false)->Apply(ReorderFilterSize)->UseRealTime();
+
+static const std::vector<std::string> upsample_arg_names = {"C", "H", "W", "Scale"};
+
+void NCHWC_UPSAMPLE(benchmark::State& state, bool linear) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t channels = NchwcAlign(state.range(0), block_size);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  const int64_t scale = state.range(3);
+  if (channels <= 0 || height <= 0 || width <= 0 || scale <= 0) {
+    throw std::invalid_argument("C, H, W and Scale must greater than 0!");
+  }
+
+  const int64_t output_height = height * scale;
+  const int64_t output_width = width * scale;
+
+  const auto input = RandomVectorUniform(static_cast<size_t>(channels * height * width), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(channels * output_height * output_width));
+
+  // Interpolation coordinates of the linear mode, matching the asymmetric coordinate transform of Resize.
+  std::vector<float> interpolation_width(static_cast<size_t>(output_width));
+  for (int64_t ow = 0; ow < output_width; ow++) {
+    interpolation_width[static_cast<size_t>(ow)] = static_cast<float>(ow) / static_cast<float>(scale);
+  }
+
+  const int64_t input_shape[] = {1, channels, height, width};
+  const int64_t scales[] = {scale, scale};
+
+  for (auto _ : state) {
+    if (linear) {
+      for (int64_t c = 0; c < channels; c += block_size) {
+        const float* input_channels = input.data() + c * height * width;
+        float* output_channels = output.data() + c * output_height * output_width;
+        for (int64_t oh = 0; oh < output_height; oh++) {
+          MlasNchwcUpsampleLinear(static_cast<size_t>(height), static_cast<size_t>(width),
+                                  static_cast<size_t>(output_width),
+                                  static_cast<float>(oh) / static_cast<float>(scale),
+                                  interpolation_width.data(), input_channels,
+                                  output_channels + oh * output_width * block_size);
+        }
+      }
+    } else {
+      MlasNchwcUpsampleNearest(input_shape, scales, input.data(), output.data());
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * channels * output_height * output_width);
+}
+
+static void UpsampleSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(upsample_arg_names);
+  // Feature pyramid and YOLOv3 upsampling
+  b->Args({256, 13, 13, 2});
+  b->Args({128, 26, 26, 2});
+  b->Args({256, 32, 32, 2});
+}
+
+BENCHMARK_CAPTURE(NCHWC_UPSAMPLE, Nearest, false)->Apply(UpsampleSize)->UseRealTime();
+BENCHMARK_CAPTURE(NCHWC_UPSAMPLE, Linear, true)->Apply(UpsampleSize)->UseRealTime();
@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> pool_arg_names = {"N", "C", "H", "W", "K", "P", "S", "Threads"};
+
+struct PoolShape {
+  int64_t input_shape[4];
+  int64_t kernel_shape[2];
+  int64_t padding[4];
+  int64_t stride_shape[2];
+  int64_t output_shape[4];
+};
+
+static PoolShape GetPoolShape(benchmark::State& state, int64_t channels) {
+  const int64_t batch = state.range(0);
+  const int64_t height = state.range(2);
+  const int64_t width = state.range(3);
+  const int64_t kernel = state.range(4);
+  const int64_t pad = state.range(5);
+  const int64_t stride = state.range(6);
+
+  if (batch <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (channels <= 0) throw std::invalid_argument("C must greater than 0!");
+  if (height <= 0 || width <= 0) throw std::invalid_argument("H and W must greater than 0!");
+  if (kernel <= 0 || stride <= 0) throw std::invalid_argument("K and S must greater than 0!");
+
+  const int64_t output_height = (height + 2 * pad - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * pad - kernel) / stride + 1;
+
+  return PoolShape{{batch, channels, height, width},
+                   {kernel, kernel},
+                   {pad, pad, pad, pad},
+                   {stride, stride},
+                   {batch, channels, output_height, output_width}};
+}
+
+void POOL(benchmark::State& state, MLAS_POOLING_KIND kind) {
+  const PoolShape shape = GetPoolShape(state, state.range(1));
+  auto tp = CreateBenchThreadPool(state.range(7));
+
+  const size_t input_size = static_cast<size_t>(shape.input_shape[0] * shape.input_shape[1] *
+                                                shape.input_shape[2] * shape.input_shape[3]);
+  const size_t output_size = static_cast<size_t>(shape.output_shape[0] * shape.output_shape[1] *
+                                                 shape.output_shape[2] * shape.output_shape[3]);
+
+  const auto input = RandomVectorUniform(input_size, -1.0f, 1.0f);
+  std::vector<float> output(output_size);
+
+  for (auto _ : state) {
+    MlasPool(kind, 2, shape.input_shape, shape.kernel_shape, shape.padding, shape.stride_shape,
+             shape.output_shape, input.data(), output.data(), tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(input_size));
+}
+
+void NCHWC_POOL(benchmark::State& state, MLAS_POOLING_KIND kind) {
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("NCHWc is not supported on this platform");
+    return;
+  }
+
+  const int64_t nchwc_channels = (state.range(1) + block_size - 1) & ~(block_size - 1);
+  const PoolShape shape = GetPoolShape(state, nchwc_channels);
+  auto tp = CreateBenchThreadPool(state.range(7));
+
+  const size_t input_size = static_cast<size_t>(shape.input_shape[0] * shape.input_shape[1] *
+                                                shape.input_shape[2] * shape.input_shape[3]);
+  const size_t output_size = static_cast<size_t>(shape.output_shape[0] * shape.output_shape[1] *
+                                                 shape.output_shape[2] * shape.output_shape[3]);
+
+  const auto input = RandomVectorUniform(input_size, -1.0f, 1.0f);
+  std::vector<float> output(output_size);
+
+  for (auto _ : state) {
+    MlasNchwcPool(kind, shape.input_shape, shape.kernel_shape, nullptr, shape.padding, shape.stride_shape,
+                  shape.output_shape, input.data(), output.data(), tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(input_size));
+}
+
+static void PoolSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(pool_arg_names);
+  // ResNet-50 stem max pool, a 3x3 average pool of Inception and the global pools of ResNet-50 and MobileNetV2
+  ArgsProduct(b, {{1}, {64}, {112}, {112}, {3}, {1}, {2}, BenchThreadCounts()});
+  ArgsProduct(b, {{1}, {192}, {35}, {35}, {3}, {1}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{1}, {2048}, {7}, {7}, {7}, {0}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{1}, {1280}, {7}, {7}, {7}, {0}, {1}, BenchThreadCounts()});
+}
+
+BENCHMARK_CAPTURE(POOL, MaximumPool, MlasMaximumPooling)->Apply(PoolSize)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, AveragePoolExcludePad, MlasAveragePoolingExcludePad)->Apply(PoolSize)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, AveragePoolIncludePad, MlasAveragePoolingIncludePad)->Apply(PoolSize)->UseRealTime();
+BENCHMARK_CAPTURE(NCHWC_POOL, MaximumPool, MlasMaximumPooling)->Apply(PoolSize)->UseRealTime();
+BENCHMARK_CAPTURE(NCHWC_POOL, AveragePoolExcludePad, MlasAveragePoolingExcludePad)->Apply(PoolSize)->UseRealTime();
+
+static const std::vector<std::string> quant_pool_arg_names = {"C", "H", "W", "K", "S"};
+
+void QUANT_MAXIMUM_POOL(benchmark::State& state) {
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+
+  if (channels <= 0 || height <= 0 || width <= 0) throw std::invalid_argument("C, H and W must greater than 0!");
+  if (kernel <= 0 || stride <= 0) throw std::invalid_argument("K and S must greater than 0!");
+
+  const auto input = RandomVectorUniform<uint8_t>(static_cast<size_t>(channels * height * width), uint8_t(0), uint8_t(255));
+  const std::vector<uint8_t> padding_row(static_cast<size_t>(channels), 0);
+
+  int64_t output_count = 0;
+  const auto indirection = BenchIndirectionNhwc(input.data(), padding_row.data(), channels, height, width,
+                                                kernel, stride, output_count);
+  std::vector<uint8_t> output(static_cast<size_t>(output_count * channels));
+
+  for (auto _ : state) {
+    MlasMaximumPool(indirection.data(), output.data(), static_cast<size_t>(channels),
+                    static_cast<size_t>(output_count), static_cast<size_t>(kernel * kernel));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * output_count * channels);
+}
+
+BENCHMARK(QUANT_MAXIMUM_POOL)
+    ->ArgNames(quant_pool_arg_names)
+    ->Args({64, 112, 112, 3, 2})
+    ->Args({192, 35, 35, 3, 1})
+    ->UseRealTime();
+
+static const std::vector<std::string> quant_global_pool_arg_names = {"N", "C", "ImageSize"};
+
+void QLINEAR_GLOBAL_AVERAGE_POOL(benchmark::State& state, bool channels_last) {
+  const int64_t batch = state.range(0);
+  const int64_t channels = state.range(1);
+  const int64_t image_size = state.range(2);
+
+  if (batch <= 0 || channels <= 0 || image_size <= 0) {
+    throw std::invalid_argument("N, C and ImageSize must greater than 0!");
+  }
+
+  const auto input = RandomVectorUniform<uint8_t>(static_cast<size_t>(batch * channels * image_size), uint8_t(0), uint8_t(255));
+  std::vector<uint8_t> output(static_cast<size_t>(batch * channels));
+
+  const size_t accumulate_count = channels_last ? static_cast<size_t>(channels) : static_cast<size_t>(batch * channels);
+  std::vector<int32_t> accumulate(MlasQLinearSafePaddingElementCount(sizeof(int32_t), accumulate_count));
+  std::vector<uint8_t> zero(MlasQLinearSafePaddingElementCount(sizeof(uint8_t), static_cast<size_t>(channels)));
+
+  for (auto _ : state) {
+    if (channels_last) {
+      MlasQLinearGlobalAveragePoolNhwc(input.data(), 0.5f, 128, output.data(), 0.25f, 120,
+                                       static_cast<size_t>(batch), static_cast<size_t>(image_size),
+                                       static_cast<size_t>(channels), static_cast<size_t>(channels),
+                                       accumulate.data(), zero.data());
+    } else {
+      MlasQLinearGlobalAveragePoolNchw(input.data(), 0.5f, 128, output.data(), 0.25f, 120,
+                                       static_cast<size_t>(batch * channels), static_cast<size_t>(image_size),
+                                       accumulate.data());
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * batch * channels * image_size);
+}
+
+static void QuantGlobalPoolSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(quant_global_pool_arg_names);
+  // The global pools of MobileNetV2, ResNet-50 and an SE block of EfficientNet
+  b->Args({1, 1280, 7 * 7});
+  b->Args({1, 2048, 7 * 7});
+  b->Args({1, 96, 56 * 56});
+}
+
+BENCHMARK_CAPTURE(QLINEAR_GLOBAL_AVERAGE_POOL, Nchw, false)->Apply(QuantGlobalPoolSize)->UseRealTime();
+BENCHMARK_CAPTURE(QLINEAR_GLOBAL_AVERAGE_POOL, Nhwc, true)->Apply(QuantGlobalPoolSize)->UseRealTime();
@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> qconv_depthwise_arg_names = {"C", "H", "W", "K", "S"};
+
+static void QConvDepthwiseSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(qconv_depthwise_arg_names);
+  // MobileNetV2 depthwise convolutions
+  b->Args({32, 112, 112, 3, 1});
+  b->Args({144, 56, 56, 3, 2});
+  b->Args({384, 14, 14, 3, 1});
+  b->Args({960, 7, 7, 3, 1});
+}
+
+void QCONV_DEPTHWISE(benchmark::State& state) {
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+
+  if (channels <= 0 || height <= 0 || width <= 0) throw std::invalid_argument("C, H and W must greater than 0!");
+  if (kernel <= 0 || stride <= 0) throw std::invalid_argument("K and S must greater than 0!");
+
+  const auto input = RandomVectorUniform<uint8_t>(static_cast<size_t>(channels * height * width), uint8_t(0), uint8_t(255));
+  const auto filter = RandomVectorUniform<uint8_t>(static_cast<size_t>(channels * kernel * kernel), uint8_t(0), uint8_t(255));
+  const std::vector<uint8_t> padding_row(static_cast<size_t>(channels), 128);
+
+  int64_t output_count = 0;
+  const auto indirection = BenchIndirectionNhwc(input.data(), padding_row.data(), channels, height, width,
+                                                kernel, stride, output_count);
+  std::vector<int32_t> output(static_cast<size_t>(output_count * channels));
+
+  for (auto _ : state) {
+    MlasConvDepthwise(indirection.data(), 128, false, filter.data(), 120, false, output.data(),
+                      static_cast<size_t>(channels), static_cast<size_t>(output_count),
+                      static_cast<size_t>(kernel * kernel));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * output_count * channels * kernel * kernel);
+}
+
+BENCHMARK(QCONV_DEPTHWISE)->Apply(QConvDepthwiseSize)->UseRealTime();
+
+// The symmetric kernels are only available on some platforms. The convolution type follows the shape: C == 0
+// selects a depthwise convolution over F channels, otherwise a pointwise convolution with C input channels.
+static const std::vector<std::string> qconv_sym_arg_names = {"C", "F", "H", "W", "K", "S"};
+
+void QCONV_SYM(benchmark::State& state) {
+  const bool depthwise = state.range(0) == 0;
+  const int64_t input_channels = depthwise ? state.range(1) : state.range(0);
+  const int64_t output_channels = state.range(1);
+  const int64_t height = state.range(2);
+  const int64_t width = state.range(3);
+  const int64_t kernel = state.range(4);
+  const int64_t stride = state.range(5);
+
+  if (input_channels <= 0 || output_channels <= 0) throw std::invalid_argument("F must greater than 0!");
+  if (height <= 0 || width <= 0) throw std::invalid_argument("H and W must greater than 0!");
+  if (kernel <= 0 || stride <= 0) throw std::invalid_argument("K and S must greater than 0!");
+  if (!depthwise && kernel != 1) throw std::invalid_argument("K must be 1 for a pointwise convolution!");
+
+  const size_t group_count = depthwise ? static_cast<size_t>(output_channels) : 1;
+  const size_t kernel_size = static_cast<size_t>(kernel * kernel);
+  const size_t group_input_channels = depthwise ? 1 : static_cast<size_t>(input_channels);
+  const size_t group_output_channels = depthwise ? 1 : static_cast<size_t>(output_channels);
+
+  const size_t packed_w_size = MlasConvSymPackWSize(group_count, group_input_channels, group_output_channels, kernel_size);
+  if (packed_w_size == 0) {
+    state.SkipWithError("Symmetric quantized convolution is not supported for this shape on this platform");
+    return;
+  }
+
+  const auto filter = RandomVectorUniform<int8_t>(static_cast<size_t>(output_channels) * group_input_channels * kernel_size,
+                                                  int8_t(-127), int8_t(127));
+  std::vector<int8_t> packed_filter(packed_w_size);
+  MlasConvSymPackW(group_count, group_input_channels, group_output_channels, kernel_size,
+                   filter.data(), packed_filter.data(), packed_w_size);
+
+  const auto input = RandomVectorUniform<uint8_t>(static_cast<size_t>(input_channels * height * width), uint8_t(0), uint8_t(255));
+  const auto bias = RandomVectorUniform<int32_t>(static_cast<size_t>(output_channels), -1024, 1024);
+  const auto scale = RandomVectorUniform(static_cast<size_t>(output_channels), 0.0001f, 0.001f);
+  const std::vector<uint8_t> padding_row(static_cast<size_t>(input_channels), 128);
+
+  int64_t output_count = height * width;
+  std::vector<const uint8_t*> indirection;
+  if (depthwise) {
+    indirection = BenchIndirectionNhwc(input.data(), padding_row.data(), input_channels, height, width,
+                                       kernel, stride, output_count);
+  } else if (stride != 1) {
+    throw std::invalid_argument("S must be 1 for a pointwise convolution!");
+  }
+  std::vector<uint8_t> output(static_cast<size_t>(output_count * output_channels));
+
+  MLAS_CONV_SYM_PARAMS params = {};
+  if (depthwise) {
+    params.InputIndirection = indirection.data();
+  } else {
+    params.InputDirect = input.data();
+  }
+  params.Filter = packed_filter.data();
+  params.Output = output.data();
+  params.InputChannels = static_cast<size_t>(input_channels);
+  params.OutputChannels = static_cast<size_t>(output_channels);
+  params.OutputCount = static_cast<size_t>(output_count);
+  params.KernelSize = kernel_size;
+  params.Bias = bias.data();
+  params.Scale = scale.data();
+  params.PerChannelScale = true;
+  params.OutputZeroPoint = 128;
+
+  for (auto _ : state) {
+    if (depthwise) {
+      MlasConvSymDepthwise(params);
+    } else {
+      MlasConvSym(params);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * output_count * output_channels *
+                          static_cast<int64_t>(group_input_channels * kernel_size));
+}
+
+static void QConvSymSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(qconv_sym_arg_names);
+  // MobileNetV2 pointwise expansion and projection convolutions, and its depthwise convolutions
+  b->Args({32, 192, 56, 56, 1, 1});
+  b->Args({192, 64, 28, 28, 1, 1});
+  b->Args({320, 1280, 7, 7, 1, 1});
+  b->Args({0, 144, 56, 56, 3, 2});
+  b->Args({0, 960, 7, 7, 3, 1});
+}
+
+BENCHMARK(QCONV_SYM)->Apply(QConvSymSize)->UseRealTime();
@@ -3,7 +3,6 @@
 
 #include "mlas.h"
 #include "bench_util.h"
-#include "core/util/thread_utils.h"
 
 #include <stdexcept>
 #include <memory>
@@ -30,12 +29,7 @@ void QGEMM(benchmark::State& state, bool pack_b) {
   const size_t batch = static_cast<size_t>(state.range(3));
   const size_t threads = static_cast<size_t>(state.range(4));
   
-  OrtThreadPoolParams tpo;
-  tpo.thread_pool_size = int(threads);
-  tpo.auto_set_affinity = true;
-  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
-      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
-      tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+  auto tp = CreateBenchThreadPool(static_cast<int64_t>(threads));
 
   auto A_holder = RandomVectorUniform<uint8_t>(static_cast<size_t>(M * K * batch), uint8_t(-100), uint8_t(100));
   auto B_holder = RandomVectorUniform<uint8_t>(static_cast<size_t>(N * K * batch), uint8_t(-110), uint8_t(110));
@@ -44,7 +38,7 @@ void QGEMM(benchmark::State& state, bool pack_b) {
 
   size_t packed_b_size = 0;
   if (pack_b) {
-    packed_b_size = MlasGemmPackBSize(N, K, b_is_signed);
+    packed_b_size = MlasGemmPackBSize(N, K, false, b_is_signed);
     pack_b_holder.resize(packed_b_size * batch);
   }
 
@@ -68,7 +62,7 @@ void QGEMM(benchmark::State& state, bool pack_b) {
     gemm_params.ldb = gemm_shape.N;
     gemm_params.C = C_holder.data() + M * N * i;
     if (pack_b) {
-      MlasGemmPackB(N, K, (const uint8_t*)gemm_params.B, N, b_is_signed, (void*)(pack_b_holder.data() + packed_b_size * i));
+      MlasGemmPackB(N, K, (const uint8_t*)gemm_params.B, N, false, b_is_signed, (void*)(pack_b_holder.data() + packed_b_size * i));
       gemm_params.BIsPacked = true;
       gemm_params.B = (void*)(pack_b_holder.data() + packed_b_size * i);
     }
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> qnbitgemm_bench_arg_names = {"M", "N", "K", "BlkLen", "Threads"};
+
+// Quantized B with random elements, scales and zero points in the layout taken by MlasQNBitGemmPackB.
+struct QNBitGemmBenchWeights {
+  std::vector<uint8_t> data;
+  std::vector<float> scale;
+  std::vector<uint8_t> zero_point;
+
+  QNBitGemmBenchWeights(size_t N, size_t K, size_t BlkBitWidth, size_t BlkLen) {
+    const size_t block_count_k = (K + BlkLen - 1) / BlkLen;
+    const size_t zero_point_stride = (block_count_k * BlkBitWidth + 7) / 8;
+    data.resize(N * block_count_k * BlkLen * BlkBitWidth / 8);
+    zero_point.resize(N * zero_point_stride);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    for (size_t i = 0; i < zero_point.size(); i++) {
+      zero_point[i] = static_cast<uint8_t>(i * 13 + 7);
+    }
+    scale = RandomVectorUniform(N * block_count_k, 0.01f, 0.1f);
+  }
+};
+
+void QNBITGEMM_PACKB(benchmark::State& state, size_t BlkBitWidth) {
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t BlkLen = static_cast<size_t>(state.range(3));
+
+  if (!MlasIsQNBitGemmAvailable(BlkBitWidth, BlkLen)) {
+    state.SkipWithError("Block quantized GEMM is not supported for these parameters");
+    return;
+  }
+
+  const QNBitGemmBenchWeights weights(N, K, BlkBitWidth, BlkLen);
+  std::vector<uint8_t> packed_b(MlasQNBitGemmPackBSize(N, K, BlkBitWidth, BlkLen));
+
+  for (auto _ : state) {
+    MlasQNBitGemmPackB(N, K, BlkBitWidth, BlkLen, weights.data.data(), weights.scale.data(),
+                       weights.zero_point.data(), packed_b.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * K));
+}
+
+void QNBITGEMM(benchmark::State& state, size_t BlkBitWidth) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t BlkLen = static_cast<size_t>(state.range(3));
+
+  if (!MlasIsQNBitGemmAvailable(BlkBitWidth, BlkLen)) {
+    state.SkipWithError("Block quantized GEMM is not supported for these parameters");
+    return;
+  }
+
+  auto tp = CreateBenchThreadPool(state.range(4));
+
+  const QNBitGemmBenchWeights weights(N, K, BlkBitWidth, BlkLen);
+  std::vector<uint8_t> packed_b(MlasQNBitGemmPackBSize(N, K, BlkBitWidth, BlkLen));
+  MlasQNBitGemmPackB(N, K, BlkBitWidth, BlkLen, weights.data.data(), weights.scale.data(),
+                     weights.zero_point.data(), packed_b.data());
+
+  const auto A = RandomVectorUniform(static_cast<size_t>(M * K), -1.0f, 1.0f);
+  std::vector<float> C(static_cast<size_t>(M * N));
+
+  MLAS_QNBIT_GEMM_DATA_PARAMS data;
+  data.A = A.data();
+  data.lda = K;
+  data.PackedB = packed_b.data();
+  data.C = C.data();
+  data.ldc = N;
+
+  MlasQNBitGemmBatch(M, N, K, BlkBitWidth, BlkLen, &data, 1, tp.get());
+
+  for (auto _ : state) {
+    MlasQNBitGemmBatch(M, N, K, BlkBitWidth, BlkLen, &data, 1, tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N * K));
+}
+
+static void QNBitGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(qnbitgemm_bench_arg_names);
+  // token by token decoding and prompt processing with the projection and feed forward layers of a 4096 wide LLM
+  ArgsProduct(b, {{1, 128}, {4096}, {4096}, {32, 128}, BenchThreadCounts()});
+  ArgsProduct(b, {{1, 128}, {11008}, {4096}, {32, 128}, BenchThreadCounts()});
+  // BERT-base projection layer
+  ArgsProduct(b, {{128}, {768}, {768}, {32}, BenchThreadCounts()});
+}
+
+static void QNBitGemmPackBSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(qnbitgemm_bench_arg_names);
+  ArgsProduct(b, {{1}, {4096, 11008}, {4096}, {32, 128}, {1}});
+}
+
+BENCHMARK_CAPTURE(QNBITGEMM, Int4, 4)->Apply(QNBitGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(QNBITGEMM, Int8, 8)->Apply(QNBitGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(QNBITGEMM_PACKB, Int4, 4)->Apply(QNBitGemmPackBSize)->UseRealTime();
+BENCHMARK_CAPTURE(QNBITGEMM_PACKB, Int8, 8)->Apply(QNBitGemmPackBSize)->UseRealTime();
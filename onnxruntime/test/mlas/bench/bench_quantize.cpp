@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> quantize_arg_names = {"N"};
+
+static void QuantizeSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(quantize_arg_names);
+  // A BERT-base hidden state, its feed forward intermediate state and a ResNet-50 activation
+  b->Arg(128 * 768);
+  b->Arg(128 * 3072);
+  b->Arg(64 * 56 * 56);
+  b->Arg(15);
+}
+
+template <typename OutputType>
+void QUANTIZE_LINEAR(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  const auto input = RandomVectorUniform(N, -10.0f, 10.0f);
+  std::vector<OutputType> output(N);
+
+  for (auto _ : state) {
+    MlasQuantizeLinear(input.data(), output.data(), N, 0.08f, static_cast<OutputType>(3));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+BENCHMARK_TEMPLATE(QUANTIZE_LINEAR, uint8_t)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_TEMPLATE(QUANTIZE_LINEAR, int8_t)->Apply(QuantizeSize)->UseRealTime();
+
+void FIND_MIN_MAX_ELEMENT(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  const auto input = RandomVectorUniform(N, -10.0f, 10.0f);
+  float min_value;
+  float max_value;
+
+  for (auto _ : state) {
+    MlasFindMinMaxElement(input.data(), &min_value, &max_value, N);
+    benchmark::DoNotOptimize(min_value);
+    benchmark::DoNotOptimize(max_value);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+BENCHMARK(FIND_MIN_MAX_ELEMENT)->Apply(QuantizeSize)->UseRealTime();
+
+static const std::vector<std::string> requantize_arg_names = {"M", "N"};
+
+template <typename OutputType>
+void RequantizeOutput(benchmark::State& state, bool per_column_scale) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  const auto input = RandomVectorUniform<int32_t>(M * N, -65536, 65536);
+  const auto bias = RandomVectorUniform<int32_t>(N, -1024, 1024);
+  const auto scale = RandomVectorUniform(N, 0.0001f, 0.001f);
+  std::vector<OutputType> output(M * N);
+
+  for (auto _ : state) {
+    MlasRequantizeOutput(input.data(), N, output.data(), N, bias.data(), scale.data(), per_column_scale,
+                         static_cast<OutputType>(1), 0, 0, M, N);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N));
+}
+
+void REQUANTIZE_OUTPUT(benchmark::State& state, bool is_signed, bool per_column_scale) {
+  if (is_signed) {
+    RequantizeOutput<int8_t>(state, per_column_scale);
+  } else {
+    RequantizeOutput<uint8_t>(state, per_column_scale);
+  }
+}
+
+static void RequantizeSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(requantize_arg_names);
+  // The QGEMM outputs of the BERT-base projections and feed forward layers
+  b->Args({128, 768});
+  b->Args({128, 3072});
+  b->Args({1, 768});
+}
+
+BENCHMARK_CAPTURE(REQUANTIZE_OUTPUT, U8_PerTensor, false, false)->Apply(RequantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(REQUANTIZE_OUTPUT, U8_PerColumn, false, true)->Apply(RequantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(REQUANTIZE_OUTPUT, S8_PerTensor, true, false)->Apply(RequantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(REQUANTIZE_OUTPUT, S8_PerColumn, true, true)->Apply(RequantizeSize)->UseRealTime();
+
+template <typename DataType>
+void QLinearBinary(benchmark::State& state, bool is_add, bool is_scalar_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+
+  const auto a = RandomVectorUniform<DataType>(N);
+  const auto b = RandomVectorUniform<DataType>(is_scalar_b ? 1 : N);
+  std::vector<DataType> c(N);
+
+  const int32_t zero_point_a = static_cast<int32_t>(std::numeric_limits<DataType>::lowest()) + 10;
+  const int32_t zero_point_b = zero_point_a + 5;
+  const int32_t zero_point_c = zero_point_a + 20;
+
+  for (auto _ : state) {
+    if (is_add) {
+      MlasQLinearAdd(a.data(), 0.05f, zero_point_a, b.data(), 0.04f, zero_point_b, 0.1f, zero_point_c,
+                     c.data(), N, is_scalar_b);
+    } else {
+      MlasQLinearMul(a.data(), 0.05f, zero_point_a, b.data(), 0.04f, zero_point_b, 0.1f, zero_point_c,
+                     c.data(), N, is_scalar_b);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+void QLINEAR_BINARY(benchmark::State& state, bool is_signed, bool is_add, bool is_scalar_b) {
+  if (is_signed) {
+    QLinearBinary<int8_t>(state, is_add, is_scalar_b);
+  } else {
+    QLinearBinary<uint8_t>(state, is_add, is_scalar_b);
+  }
+}
+
+BENCHMARK_CAPTURE(QLINEAR_BINARY, Add_U8, false, true, false)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(QLINEAR_BINARY, Add_U8_ScalarB, false, true, true)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(QLINEAR_BINARY, Add_S8, true, true, false)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(QLINEAR_BINARY, Mul_U8, false, false, false)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(QLINEAR_BINARY, Mul_U8_ScalarB, false, false, true)->Apply(QuantizeSize)->UseRealTime();
+BENCHMARK_CAPTURE(QLINEAR_BINARY, Mul_S8, true, false, false)->Apply(QuantizeSize)->UseRealTime();
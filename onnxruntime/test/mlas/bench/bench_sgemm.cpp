@@ -118,3 +118,58 @@ BENCHMARK_CAPTURE(SGEMM, GEMV_ABTrans, false, true, true)->Apply(GemmSizeWithOne
 
 BENCHMARK_CAPTURE(SGEMM, PACKB_NoTransA, true, false, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, PACKB_TransA, true, true, false)->Apply(GemmSizeProducts)->UseRealTime();
+
+static const std::vector<std::string> sgemm_batch_arg_names = {"M", "N", "K", "Batch", "Threads"};
+
+void SGEMM_BATCH(benchmark::State& state, bool broadcast_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Batch must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t batch = static_cast<size_t>(state.range(3));
+  auto tp = CreateBenchThreadPool(state.range(4));
+
+  auto A = RandomVectorUniform(static_cast<size_t>(M * K * batch), -1.0f, 1.0f);
+  auto B = RandomVectorUniform(static_cast<size_t>(N * K * (broadcast_b ? 1 : batch)), -1.0f, 1.0f);
+  std::vector<float> C(static_cast<size_t>(M * N * batch));
+
+  MLAS_SGEMM_STRIDED_BATCH_PARAMS data;
+  data.A = A.data();
+  data.lda = K;
+  data.StrideA = M * K;
+  data.B = B.data();
+  data.ldb = N;
+  data.StrideB = broadcast_b ? 0 : N * K;
+  data.C = C.data();
+  data.ldc = N;
+  data.StrideC = M * N;
+
+  MlasGemmStridedBatch(CblasNoTrans, CblasNoTrans, M, N, K, data, batch, tp.get());
+
+  for (auto _ : state) {
+    MlasGemmStridedBatch(CblasNoTrans, CblasNoTrans, M, N, K, data, batch, tp.get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N * K * batch));
+}
+
+static void SGemmBatchSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_batch_arg_names);
+  // BERT-base projection and feed forward layers with a sequence length of 128
+  ArgsProduct(b, {{128}, {768}, {768}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{128}, {3072}, {768}, {1}, BenchThreadCounts()});
+  ArgsProduct(b, {{128}, {768}, {3072}, {1}, BenchThreadCounts()});
+  // BERT-base attention scores and context per head
+  ArgsProduct(b, {{128}, {128}, {64}, {12}, BenchThreadCounts()});
+  ArgsProduct(b, {{128}, {64}, {128}, {12}, BenchThreadCounts()});
+  // many tiny matrices, e.g. Einsum contractions and per head attention with short sequences
+  ArgsProduct(b, {{8}, {8}, {8}, {1024}, BenchThreadCounts()});
+  ArgsProduct(b, {{16}, {16}, {16}, {4096}, BenchThreadCounts()});
+  ArgsProduct(b, {{1}, {64}, {64}, {768}, BenchThreadCounts()});
+}
+
+BENCHMARK_CAPTURE(SGEMM_BATCH, Strided, false)->Apply(SGemmBatchSize)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM_BATCH, BroadcastB, true)->Apply(SGemmBatchSize)->UseRealTime();
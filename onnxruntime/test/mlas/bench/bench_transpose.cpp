@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> transpose_arg_names = {"M", "N"};
+
+template <typename ElementType>
+void TRANSPOSE(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  std::vector<ElementType> input(M * N);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<ElementType>(i);
+  }
+  std::vector<ElementType> output(M * N);
+
+  for (auto _ : state) {
+    MlasTranspose(input.data(), output.data(), M, N);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N * sizeof(ElementType)));
+}
+
+static void TransposeSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(transpose_arg_names);
+  // BERT-base weights and hidden states, and NCHW <-> NHWC transposes of ResNet-50 and MobileNetV2 activations
+  b->Args({768, 3072});
+  b->Args({128, 768});
+  b->Args({64, 56 * 56});
+  b->Args({112 * 112, 32});
+  b->Args({3, 224 * 224});
+}
+
+BENCHMARK_TEMPLATE(TRANSPOSE, uint8_t)->Apply(TransposeSize)->UseRealTime();
+BENCHMARK_TEMPLATE(TRANSPOSE, uint32_t)->Apply(TransposeSize)->UseRealTime();
+BENCHMARK_TEMPLATE(TRANSPOSE, float)->Apply(TransposeSize)->UseRealTime();
@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 #include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <algorithm>
 #include <numeric>
 #include <stdexcept>
+#include <thread>
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count) {
   std::vector<int64_t> shape;
@@ -49,3 +53,56 @@ void ArgsProduct(benchmark::internal::Benchmark* bench,
     } while (indices[arg++] == 0 && arg < arglists.size());
   }
 }
+
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(int64_t threads) {
+  if (threads <= 0) {
+    throw std::invalid_argument("Threads must greater than 0!");
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  return onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo,
+                                                    onnxruntime::concurrency::ThreadPoolType::INTRA_OP);
+}
+
+std::vector<int64_t> BenchThreadCounts() {
+  const int64_t max_threads = std::max<int64_t>(1, static_cast<int64_t>(std::thread::hardware_concurrency()));
+
+  std::vector<int64_t> threads;
+  for (int64_t t = 1; t < max_threads; t *= 2) {
+    threads.push_back(t);
+  }
+  threads.push_back(max_threads);
+  return threads;
+}
+
+std::vector<const uint8_t*> BenchIndirectionNhwc(const uint8_t* input, const uint8_t* padding_row, int64_t channels,
+                                                 int64_t height, int64_t width, int64_t kernel, int64_t stride,
+                                                 int64_t& output_count) {
+  const int64_t padding = kernel / 2;
+  const int64_t output_height = (height + 2 * padding - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * padding - kernel) / stride + 1;
+  output_count = output_height * output_width;
+
+  std::vector<const uint8_t*> indirection;
+  indirection.reserve(static_cast<size_t>(output_count * kernel * kernel));
+
+  for (int64_t oh = 0; oh < output_height; oh++) {
+    for (int64_t ow = 0; ow < output_width; ow++) {
+      for (int64_t kh = 0; kh < kernel; kh++) {
+        for (int64_t kw = 0; kw < kernel; kw++) {
+          const int64_t ih = oh * stride + kh - padding;
+          const int64_t iw = ow * stride + kw - padding;
+          if (ih < 0 || ih >= height || iw < 0 || iw >= width) {
+            indirection.push_back(padding_row);
+          } else {
+            indirection.push_back(input + (ih * width + iw) * channels);
+          }
+        }
+      }
+    }
+  }
+
+  return indirection;
+}
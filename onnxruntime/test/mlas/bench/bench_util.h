@@ -5,8 +5,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include <memory>
 #include <random>
 
+#include "core/platform/threadpool.h"
+
 
 void ArgsProduct(benchmark::internal::Benchmark* bench,
                  const std::vector<std::vector<int64_t>>& arglists);
@@ -32,3 +35,17 @@ std::vector<ElementType> RandomVectorUniform(
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value);
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count);
+
+// Creates an intra op thread pool with the given number of threads. Returns nullptr for a single thread,
+// which makes MLAS run the operation on the calling thread.
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(int64_t threads);
+
+// Thread counts for the thread sweeps: powers of two up to, and including, the hardware concurrency.
+std::vector<int64_t> BenchThreadCounts();
+
+// Builds the indirection buffer of a 2D NHWC convolution or pooling with a square kernel and "same" padding for
+// the quantized kernels that take one input pointer per output pixel and kernel tap. Padding taps point at
+// padding_row, which must hold at least the given number of channels.
+std::vector<const uint8_t*> BenchIndirectionNhwc(const uint8_t* input, const uint8_t* padding_row, int64_t channels,
+                                                 int64_t height, int64_t width, int64_t kernel, int64_t stride,
+                                                 int64_t& output_count);
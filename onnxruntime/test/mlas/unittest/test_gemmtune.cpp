@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasGemmTuningTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferFloatA;
+  MatrixGuardBuffer<float> BufferFloatB;
+  MatrixGuardBuffer<float> BufferFloatC;
+  MatrixGuardBuffer<float> BufferFloatCReference;
+  MatrixGuardBuffer<uint8_t> BufferQuantA;
+  MatrixGuardBuffer<uint8_t> BufferQuantB;
+  MatrixGuardBuffer<int32_t> BufferQuantC;
+  MatrixGuardBuffer<int32_t> BufferQuantCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  static const std::vector<std::pair<size_t, size_t>>& Partitions() {
+    static const std::vector<std::pair<size_t, size_t>> partitions{{1, 1}, {2, 1}, {1, 2}, {2, 2}, {3, 4}, {7, 1}};
+    return partitions;
+  }
+
+  void RunSgemm(size_t M, size_t N, size_t K, size_t BatchSize, float* C) {
+    const float* A = BufferFloatA.GetBuffer(BatchSize * M * K);
+    const float* B = BufferFloatB.GetBuffer(BatchSize * K * N);
+
+    std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      Data[b].A = A + b * M * K;
+      Data[b].lda = K;
+      Data[b].B = B + b * K * N;
+      Data[b].ldb = N;
+      Data[b].C = C + b * M * N;
+      Data[b].ldc = N;
+    }
+
+    std::fill_n(C, BatchSize * M * N, -0.5f);
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, Data.data(), BatchSize, threadpool_);
+  }
+
+  void RunQgemm(size_t M, size_t N, size_t K, size_t BatchSize, int32_t* C) {
+    const uint8_t* A = BufferQuantA.GetBuffer(BatchSize * M * K);
+    const uint8_t* B = BufferQuantB.GetBuffer(BatchSize * K * N);
+    const uint8_t ZeroPointB = 3;
+
+    MLAS_GEMM_U8X8_SHAPE_PARAMS Shape;
+    Shape.M = M;
+    Shape.N = N;
+    Shape.K = K;
+
+    std::vector<MLAS_GEMM_U8X8_DATA_PARAMS> Data(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      Data[b].A = A + b * M * K;
+      Data[b].lda = K;
+      Data[b].ZeroPointA = 7;
+      Data[b].B = B + b * K * N;
+      Data[b].ldb = N;
+      Data[b].ZeroPointB = &ZeroPointB;
+      Data[b].C = C + b * M * N;
+      Data[b].ldc = N;
+    }
+
+    std::fill_n(C, BatchSize * M * N, -1);
+    MlasGemmBatch(Shape, Data.data(), BatchSize, threadpool_);
+  }
+
+  void Test(MLAS_GEMM_TUNING_KIND Kind, size_t M, size_t N, size_t K, size_t BatchSize) {
+    MlasGemmTuningClear();
+
+    //
+    // Compute the reference output using the default partitioning.
+    //
+
+    float* FloatC = BufferFloatC.GetBuffer(BatchSize * M * N);
+    float* FloatCReference = BufferFloatCReference.GetBuffer(BatchSize * M * N);
+    int32_t* QuantC = BufferQuantC.GetBuffer(BatchSize * M * N);
+    int32_t* QuantCReference = BufferQuantCReference.GetBuffer(BatchSize * M * N);
+
+    auto Run = [&]() {
+      if (Kind == MlasGemmTuningSgemm) {
+        RunSgemm(M, N, K, BatchSize, FloatC);
+      } else {
+        RunQgemm(M, N, K, BatchSize, QuantC);
+      }
+    };
+
+    if (Kind == MlasGemmTuningSgemm) {
+      RunSgemm(M, N, K, BatchSize, FloatCReference);
+    } else {
+      RunQgemm(M, N, K, BatchSize, QuantCReference);
+    }
+
+    auto Check = [&](size_t ThreadCountM, size_t ThreadCountN) {
+      for (size_t n = 0; n < BatchSize * M * N; n++) {
+        if (Kind == MlasGemmTuningSgemm) {
+          ASSERT_EQ(FloatC[n], FloatCReference[n])
+              << " @" << n << " with shape (" << M << "," << N << "," << K << "," << BatchSize
+              << ") partition (" << ThreadCountM << "," << ThreadCountN << ")";
+        } else {
+          ASSERT_EQ(QuantC[n], QuantCReference[n])
+              << " @" << n << " with shape (" << M << "," << N << "," << K << "," << BatchSize
+              << ") partition (" << ThreadCountM << "," << ThreadCountN << ")";
+        }
+      }
+    };
+
+    //
+    // Tune the shape and verify the recorded partitioning.
+    //
+
+    MLAS_GEMM_TUNING_ENTRY Entry;
+    MlasGemmTune(Kind, M, N, K, BatchSize, threadpool_, &Entry);
+
+    ASSERT_EQ(MlasGemmTuningGetEntries(nullptr, 0), size_t(1));
+    ASSERT_EQ(Entry.Kind, Kind);
+    ASSERT_EQ(Entry.M, M);
+    ASSERT_EQ(Entry.N, N);
+    ASSERT_EQ(Entry.K, K);
+    ASSERT_EQ(Entry.BatchSize, BatchSize);
+    ASSERT_GE(Entry.ThreadCountM, size_t(1));
+    ASSERT_GE(Entry.ThreadCountN, size_t(1));
+    ASSERT_LE(Entry.ThreadCountM, M);
+    ASSERT_LE(Entry.ThreadCountM * Entry.ThreadCountN, Entry.MaximumThreadCount);
+
+    Run();
+    Check(Entry.ThreadCountM, Entry.ThreadCountN);
+
+    //
+    // Force a set of partitionings through the table, including ones that
+    // oversubscribe the thread pool.
+    //
+
+    for (const auto& Partition : Partitions()) {
+      if (Partition.first > M || Partition.second > (N + 15) / 16) {
+        continue;
+      }
+
+      Entry.ThreadCountM = Partition.first;
+      Entry.ThreadCountN = Partition.second;
+      MlasGemmTuningSetEntry(Entry);
+
+      MLAS_GEMM_TUNING_ENTRY Readback;
+      ASSERT_EQ(MlasGemmTuningGetEntries(&Readback, 1), size_t(1));
+      ASSERT_EQ(Readback.ThreadCountM, Partition.first);
+      ASSERT_EQ(Readback.ThreadCountN, Partition.second);
+
+      Run();
+      Check(Partition.first, Partition.second);
+    }
+
+    //
+    // Publish a set of entries at once. An entry for an existing key replaces it.
+    //
+
+    MLAS_GEMM_TUNING_ENTRY Entries[3] = {Entry, Entry, Entry};
+    Entries[1].BatchSize = BatchSize + 1;
+    Entries[2].ThreadCountM = 1;
+    Entries[2].ThreadCountN = 1;
+    MlasGemmTuningSetEntries(Entries, 3);
+
+    MLAS_GEMM_TUNING_ENTRY Readback[2];
+    ASSERT_EQ(MlasGemmTuningGetEntries(Readback, 2), size_t(2));
+    ASSERT_EQ(Readback[0].BatchSize, BatchSize);
+    ASSERT_EQ(Readback[0].ThreadCountM, size_t(1));
+    ASSERT_EQ(Readback[0].ThreadCountN, size_t(1));
+    ASSERT_EQ(Readback[1].BatchSize, BatchSize + 1);
+
+    Run();
+    Check(1, 1);
+
+    MlasGemmTuningClear();
+    ASSERT_EQ(MlasGemmTuningGetEntries(nullptr, 0), size_t(0));
+  }
+
+ public:
+  MlasGemmTuningTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "GemmTuning_Threaded" : "GemmTuning_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_GEMM_TUNING_KIND Kind : {MlasGemmTuningSgemm, MlasGemmTuningQgemm}) {
+      Test(Kind, 1, 1024, 256, 1);
+      Test(Kind, 4, 300, 64, 1);
+      Test(Kind, 8, 77, 129, 3);
+      Test(Kind, 64, 33, 17, 1);
+      Test(Kind, 3, 5, 7, 2);
+    }
+  }
+};
+
+template <> MlasGemmTuningTest<false>* MlasTestFixture<MlasGemmTuningTest<false>>::mlas_tester(nullptr);
+template <> MlasGemmTuningTest<true>* MlasTestFixture<MlasGemmTuningTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasGemmTuningTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasGemmTuningTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
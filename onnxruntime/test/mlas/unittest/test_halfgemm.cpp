@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+struct HalfGemmFp16Format {
+  static const char* Name() { return "HalfGemmFp16"; }
+  static float Tolerance() { return 1.0f / 1024.0f; }
+
+  static void ToFloat(const uint16_t* Source, float* Destination, size_t Count) {
+    MlasConvertHalfToFloatBuffer(Source, Destination, Count);
+  }
+
+  static void FromFloat(const float* Source, uint16_t* Destination, size_t Count) {
+    MlasConvertFloatToHalf(Source, Destination, Count);
+  }
+
+  static void GemmBatch(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K,
+                        const MLAS_HALF_GEMM_DATA_PARAMS* Data, size_t BatchSize) {
+    MlasHalfGemmBatch(TransA, TransB, M, N, K, Data, BatchSize, GetMlasThreadPool());
+  }
+
+  static bool IsNaN(uint16_t Value) { return (Value & 0x7C00) == 0x7C00 && (Value & 0x03FF) != 0; }
+};
+
+struct HalfGemmBf16Format {
+  static const char* Name() { return "HalfGemmBf16"; }
+  static float Tolerance() { return 1.0f / 128.0f; }
+
+  static void ToFloat(const uint16_t* Source, float* Destination, size_t Count) {
+    MlasConvertBf16ToFloat(Source, Destination, Count);
+  }
+
+  static void FromFloat(const float* Source, uint16_t* Destination, size_t Count) {
+    MlasConvertFloatToBf16(Source, Destination, Count);
+  }
+
+  static void GemmBatch(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K,
+                        const MLAS_HALF_GEMM_DATA_PARAMS* Data, size_t BatchSize) {
+    MlasBf16GemmBatch(TransA, TransB, M, N, K, Data, BatchSize, GetMlasThreadPool());
+  }
+
+  static bool IsNaN(uint16_t Value) { return (Value & 0x7F80) == 0x7F80 && (Value & 0x007F) != 0; }
+};
+
+template <typename Format>
+class MlasHalfGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint16_t> BufferA;
+  MatrixGuardBuffer<uint16_t> BufferB;
+  MatrixGuardBuffer<uint16_t> BufferC;
+  MatrixGuardBuffer<float> BufferFloatA;
+  MatrixGuardBuffer<float> BufferFloatB;
+  MatrixGuardBuffer<float> BufferFloatC;
+
+  void Fill(uint16_t* Buffer, size_t Count, std::default_random_engine& generator) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> values(Count);
+    for (auto& v : values) {
+      v = distribution(generator);
+    }
+    Format::FromFloat(values.data(), Buffer, Count);
+  }
+
+  void Test(bool TransA, bool TransB, size_t M, size_t N, size_t K, size_t BatchSize, float alpha, float beta) {
+    uint16_t* A = BufferA.GetBuffer(K * M * BatchSize);
+    uint16_t* B = BufferB.GetBuffer(N * K * BatchSize);
+    uint16_t* C = BufferC.GetBuffer(N * M * BatchSize);
+    float* FloatA = BufferFloatA.GetBuffer(K * M * BatchSize);
+    float* FloatB = BufferFloatB.GetBuffer(N * K * BatchSize);
+    float* FloatC = BufferFloatC.GetBuffer(N * M * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N * 17 + K));
+    Fill(A, K * M * BatchSize, generator);
+    Fill(B, N * K * BatchSize, generator);
+    Fill(C, N * M * BatchSize, generator);
+
+    Format::ToFloat(A, FloatA, K * M * BatchSize);
+    Format::ToFloat(B, FloatB, N * K * BatchSize);
+    Format::ToFloat(C, FloatC, N * M * BatchSize);
+
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+
+    std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(BatchSize);
+    for (size_t i = 0; i < BatchSize; i++) {
+      data[i].A = A + K * M * i;
+      data[i].lda = lda;
+      data[i].B = B + N * K * i;
+      data[i].ldb = ldb;
+      data[i].C = C + N * M * i;
+      data[i].ldc = N;
+      data[i].alpha = alpha;
+      data[i].beta = beta;
+    }
+
+    Format::GemmBatch(TransA ? CblasTrans : CblasNoTrans, TransB ? CblasTrans : CblasNoTrans, M, N, K,
+                      data.data(), BatchSize);
+
+    std::vector<float> Output(N * M * BatchSize);
+    Format::ToFloat(C, Output.data(), N * M * BatchSize);
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      const float* a = FloatA + K * M * batch;
+      const float* b = FloatB + N * K * batch;
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          double magnitude = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            const double product = double(TransA ? a[k * lda + m] : a[m * lda + k]) *
+                                   double(TransB ? b[n * ldb + k] : b[k * ldb + n]);
+            sum += product;
+            magnitude += std::fabs(product);
+          }
+
+          const size_t index = N * M * batch + m * N + n;
+          const double expected = alpha * sum + beta * double(FloatC[index]);
+          const double tolerance = Format::Tolerance() * (std::fabs(alpha) * magnitude + std::fabs(beta) + 1.0);
+
+          ASSERT_NEAR(Output[index], expected, tolerance)
+              << " @[" << batch << "," << m << "," << n << "], "
+              << "Batch=" << BatchSize << " TransA=" << TransA << " TransB=" << TransB
+              << " M=" << M << " N=" << N << " K=" << K << " alpha=" << alpha << " beta=" << beta;
+        }
+      }
+    }
+  }
+
+  void TestConversionRoundTrip() {
+    std::vector<uint16_t> Values(65536);
+    for (size_t i = 0; i < Values.size(); i++) {
+      Values[i] = static_cast<uint16_t>(i);
+    }
+
+    std::vector<float> FloatValues(Values.size());
+    std::vector<uint16_t> RoundTrip(Values.size());
+    Format::ToFloat(Values.data(), FloatValues.data(), Values.size());
+    Format::FromFloat(FloatValues.data(), RoundTrip.data(), Values.size());
+
+    for (size_t i = 0; i < Values.size(); i++) {
+      if (Format::IsNaN(Values[i])) {
+        ASSERT_TRUE(std::isnan(FloatValues[i])) << " for value " << i;
+        ASSERT_TRUE(Format::IsNaN(RoundTrip[i])) << " for value " << i;
+      } else {
+        ASSERT_EQ(RoundTrip[i], Values[i]) << " for value " << i;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Format::Name());
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    TestConversionRoundTrip();
+
+    static const size_t sizes[] = {1, 3, 16, 33, 67, 130};
+    for (bool trans_a : {false, true}) {
+      for (bool trans_b : {false, true}) {
+        for (size_t M : sizes) {
+          for (size_t N : sizes) {
+            Test(trans_a, trans_b, M, N, 31, 1, 1.0f, 0.0f);
+          }
+        }
+        Test(trans_a, trans_b, 1, 4096, 300, 1, 1.0f, 0.0f);
+        Test(trans_a, trans_b, 65, 129, 257, 3, 0.5f, 1.0f);
+        Test(trans_a, trans_b, 7, 9, 0, 1, 1.0f, 0.5f);
+      }
+    }
+  }
+};
+
+template <> MlasHalfGemmTest<HalfGemmFp16Format>* MlasTestFixture<MlasHalfGemmTest<HalfGemmFp16Format>>::mlas_tester(nullptr);
+template <> MlasHalfGemmTest<HalfGemmBf16Format>* MlasTestFixture<MlasHalfGemmTest<HalfGemmBf16Format>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest<HalfGemmFp16Format>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest<HalfGemmBf16Format>>::RegisterShortExecute();
+  }
+  return count;
+});
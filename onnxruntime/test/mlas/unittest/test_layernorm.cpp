@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<uint16_t> BufferHalf;
+
+  static void ReferenceLayerNorm(const float* Input, const float* Skip, const float* Bias, const float* Gamma,
+                                 const float* Beta, float* Output, size_t N, float Epsilon, bool Simplified,
+                                 float* Mean, float* InvStdDev) {
+    std::vector<double> Values(N);
+    double Sum = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      Values[n] = double(Input[n]) + (Skip != nullptr ? Skip[n] : 0.0f) + (Bias != nullptr ? Bias[n] : 0.0f);
+      Sum += Values[n];
+    }
+
+    double MeanValue = Simplified ? 0.0 : Sum / N;
+    double Variance = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      Variance += (Values[n] - MeanValue) * (Values[n] - MeanValue);
+    }
+    double InvStdDevValue = 1.0 / std::sqrt(Variance / N + Epsilon);
+
+    for (size_t n = 0; n < N; n++) {
+      double Value = (Values[n] - MeanValue) * InvStdDevValue * Gamma[n];
+      if (!Simplified && Beta != nullptr) {
+        Value += Beta[n];
+      }
+      Output[n] = float(Value);
+    }
+
+    *Mean = float(MeanValue);
+    *InvStdDev = float(InvStdDevValue);
+  }
+
+  void Test(size_t N, bool HasSkip, bool HasBias, bool HasBeta, bool Simplified, bool Half) {
+    float* Input = BufferInput.GetBuffer(N);
+    float* Skip = HasSkip ? BufferSkip.GetBuffer(N) : nullptr;
+    float* Bias = HasBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* Gamma = BufferGamma.GetBuffer(N);
+    float* Beta = HasBeta ? BufferBeta.GetBuffer(N) : nullptr;
+    float* Output = BufferOutput.GetBuffer(N);
+    float* OutputReference = BufferOutputReference.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-2.0f, 3.0f);
+
+    for (float* Buffer : {Input, Skip, Bias, Gamma, Beta}) {
+      if (Buffer != nullptr) {
+        for (size_t n = 0; n < N; n++) {
+          Buffer[n] = distribution(generator);
+        }
+      }
+    }
+
+    const float Epsilon = 1e-5f;
+    float Mean, InvStdDev;
+    float MeanReference, InvStdDevReference;
+    float Tolerance;
+
+    if (Half) {
+      //
+      // Round the inputs to half precision so that the reference sees the
+      // same values as the kernel.
+      //
+
+      uint16_t* HalfBuffer = BufferHalf.GetBuffer(N * 6);
+      uint16_t* HalfInputs[5] = {HalfBuffer, HalfBuffer + N, HalfBuffer + 2 * N, HalfBuffer + 3 * N, HalfBuffer + 4 * N};
+      float* Inputs[5] = {Input, Skip, Bias, Gamma, Beta};
+      for (size_t i = 0; i < 5; i++) {
+        if (Inputs[i] != nullptr) {
+          MlasConvertFloatToHalf(Inputs[i], HalfInputs[i], N);
+          MlasConvertHalfToFloatBuffer(HalfInputs[i], Inputs[i], N);
+        } else {
+          HalfInputs[i] = nullptr;
+        }
+      }
+
+      uint16_t* HalfOutput = HalfBuffer + 5 * N;
+      MlasHalfLayerNormalization(HalfInputs[0], HalfInputs[1], HalfInputs[2], HalfInputs[3], HalfInputs[4],
+                                 HalfOutput, N, Epsilon, Simplified, &Mean, &InvStdDev);
+      MlasConvertHalfToFloatBuffer(HalfOutput, Output, N);
+      Tolerance = 2e-2f;
+    } else {
+      MlasLayerNormalization(Input, Skip, Bias, Gamma, Beta, Output, N, Epsilon, Simplified, &Mean, &InvStdDev);
+      Tolerance = 1e-4f;
+    }
+
+    ReferenceLayerNorm(Input, Skip, Bias, Gamma, Beta, OutputReference, N, Epsilon, Simplified,
+                       &MeanReference, &InvStdDevReference);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_LE(std::fabs(Output[n] - OutputReference[n]), Tolerance * std::max(1.0f, std::fabs(OutputReference[n])))
+          << " @" << n << " with parameter (" << N << "," << HasSkip << "," << HasBias << "," << HasBeta << ","
+          << Simplified << "," << Half << ")";
+    }
+
+    ASSERT_LE(std::fabs(Mean - MeanReference), 1e-4f);
+    ASSERT_LE(std::fabs(InvStdDev - InvStdDevReference), 1e-4f * InvStdDevReference);
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LayerNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool Half : {false, true}) {
+      for (size_t n : {1, 3, 4, 7, 8, 15, 32, 67, 255, 256, 257, 768, 1031}) {
+        Test(n, false, false, true, false, Half);
+        Test(n, false, false, false, false, Half);
+        Test(n, true, false, true, false, Half);
+        Test(n, true, true, true, false, Half);
+        Test(n, true, true, false, false, Half);
+        Test(n, false, false, false, true, Half);
+        Test(n, true, true, false, true, Half);
+      }
+    }
+  }
+};
+
+template <> MlasLayerNormTest* MlasTestFixture<MlasLayerNormTest>::mlas_tester(nullptr);
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasLayerNormTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+//
+// Tests the quantized integer matrix/matrix multiply with a signed matrix A
+// (S8S8 and S8U8) against a reference implementation.
+//
+
+template <bool BIsSigned, bool Packed>
+class MlasQgemmS8X8Test : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<uint8_t> BufferZeroPointB;
+  MatrixGuardBuffer<int32_t> BufferC;
+
+  static int32_t BValue(uint8_t v) {
+    return BIsSigned ? int32_t(int8_t(v)) : int32_t(v);
+  }
+
+  void Test(size_t M, size_t N, size_t K, int8_t offa, uint8_t offb, bool PerColumnZeroPoints) {
+    uint8_t* A = BufferA.GetBuffer(M * K);
+    uint8_t* B = BufferB.GetBuffer(K * N);
+    uint8_t* ZeroPointB = BufferZeroPointB.GetBuffer(N);
+    int32_t* C = BufferC.GetBuffer(M * N);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N * 17 + K));
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t n = 0; n < N; n++) {
+      ZeroPointB[n] = PerColumnZeroPoints ? static_cast<uint8_t>(byte_distribution(generator)) : offb;
+    }
+
+    MLAS_GEMM_U8X8_SHAPE_PARAMS GemmShape;
+    GemmShape.M = M;
+    GemmShape.N = N;
+    GemmShape.K = K;
+    GemmShape.AIsSigned = true;
+    GemmShape.BIsSigned = BIsSigned;
+
+    MLAS_GEMM_U8X8_DATA_PARAMS GemmParameters;
+    GemmParameters.A = A;
+    GemmParameters.lda = K;
+    GemmParameters.ZeroPointA = static_cast<uint8_t>(offa);
+    GemmParameters.ZeroPointB = PerColumnZeroPoints ? ZeroPointB : &offb;
+    GemmParameters.PerColumnZeroPoints = PerColumnZeroPoints;
+    GemmParameters.C = C;
+    GemmParameters.ldc = N;
+
+    if (Packed) {
+      size_t PackedBSize = MlasGemmPackBSize(N, K, true, BIsSigned);
+      void* PackedB = BufferPackedB.GetBuffer(PackedBSize);
+      MlasGemmPackB(N, K, B, N, true, BIsSigned, PackedB);
+      GemmParameters.B = PackedB;
+      GemmParameters.BIsPacked = true;
+    } else {
+      GemmParameters.B = B;
+      GemmParameters.ldb = N;
+    }
+
+    MlasGemmBatch(GemmShape, &GemmParameters, 1, GetMlasThreadPool());
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        int32_t sum = 0;
+        for (size_t k = 0; k < K; k++) {
+          sum += (int32_t(int8_t(A[m * K + k])) - offa) * (BValue(B[k * N + n]) - BValue(ZeroPointB[n]));
+        }
+        ASSERT_EQ(C[m * N + n], sum)
+            << " @[" << m << "," << n << "], "
+            << "M=" << M << " N=" << N << " K=" << K
+            << " offa=" << int(offa) << " offb=" << int(offb) << " PerColumn=" << PerColumnZeroPoints;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("QGemmS8") + (BIsSigned ? "S8" : "U8") +
+                                          (Packed ? "_Packed" : "_NoPack");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t sizes[] = {1, 2, 3, 7, 16, 33};
+    for (size_t M : sizes) {
+      for (size_t N : sizes) {
+        for (size_t K : {size_t(1), size_t(5), size_t(16), size_t(35), size_t(67)}) {
+          Test(M, N, K, -3, 11, false);
+        }
+      }
+    }
+    for (int8_t offa : {int8_t(-128), int8_t(0), int8_t(127)}) {
+      Test(1, 37, 91, offa, 7, false);
+      Test(43, 160, 400, offa, 130, false);
+      Test(43, 160, 400, offa, 0, true);
+    }
+    Test(257, 129, 1031, 5, 3, true);
+  }
+};
+
+template <> MlasQgemmS8X8Test<true, false>* MlasTestFixture<MlasQgemmS8X8Test<true, false>>::mlas_tester(nullptr);
+template <> MlasQgemmS8X8Test<true, true>* MlasTestFixture<MlasQgemmS8X8Test<true, true>>::mlas_tester(nullptr);
+template <> MlasQgemmS8X8Test<false, false>* MlasTestFixture<MlasQgemmS8X8Test<false, false>>::mlas_tester(nullptr);
+template <> MlasQgemmS8X8Test<false, true>* MlasTestFixture<MlasQgemmS8X8Test<false, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQgemmS8X8Test<true, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQgemmS8X8Test<false, false>>::RegisterShortExecute();
+    if (MlasGemmPackBSize(128, 128, true, true) > 0) {
+      count += MlasDirectShortExecuteTests<MlasQgemmS8X8Test<true, true>>::RegisterShortExecute();
+    }
+    if (MlasGemmPackBSize(128, 128, true, false) > 0) {
+      count += MlasDirectShortExecuteTests<MlasQgemmS8X8Test<false, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <size_t BlkBitWidth, size_t BlkLen>
+class MlasQNBitGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferQuantBData;
+  MatrixGuardBuffer<float> BufferQuantBScale;
+  MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, bool WithZeroPoint) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointStride = (BlockCountK * BlkBitWidth + 7) / 8;
+
+    float* A = BufferA.GetBuffer(M * K * BatchSize);
+    uint8_t* QuantBData = BufferQuantBData.GetBuffer(N * BlockCountK * BlkDataSize);
+    float* QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+    uint8_t* QuantBZeroPoint = WithZeroPoint ? BufferQuantBZeroPoint.GetBuffer(N * ZeroPointStride) : nullptr;
+    float* C = BufferC.GetBuffer(M * N * BatchSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N * 17 + K));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+
+    for (size_t i = 0; i < M * K * BatchSize; i++) {
+      A[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < N * BlockCountK * BlkDataSize; i++) {
+      QuantBData[i] = static_cast<uint8_t>(byte_distribution(generator));
+    }
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      QuantBScale[i] = distribution(generator) / 16.0f;
+    }
+    if (WithZeroPoint) {
+      for (size_t i = 0; i < N * ZeroPointStride; i++) {
+        QuantBZeroPoint[i] = static_cast<uint8_t>(byte_distribution(generator));
+      }
+    }
+
+    //
+    // Dequantize matrix B to the reference K x N layout.
+    //
+
+    std::vector<float> B(K * N);
+    for (size_t n = 0; n < N; n++) {
+      for (size_t k = 0; k < K; k++) {
+        const size_t block = k / BlkLen;
+        const uint8_t* blk_data = QuantBData + (n * BlockCountK + block) * BlkDataSize;
+        const size_t index = k % BlkLen;
+
+        int value;
+        int zero_point = 1 << (BlkBitWidth - 1);
+        if (BlkBitWidth == 4) {
+          value = (index & 1) ? (blk_data[index / 2] >> 4) : (blk_data[index / 2] & 0x0F);
+          if (WithZeroPoint) {
+            const uint8_t zp = QuantBZeroPoint[n * ZeroPointStride + block / 2];
+            zero_point = (block & 1) ? (zp >> 4) : (zp & 0x0F);
+          }
+        } else {
+          value = blk_data[index];
+          if (WithZeroPoint) {
+            zero_point = QuantBZeroPoint[n * ZeroPointStride + block];
+          }
+        }
+
+        B[k * N + n] = float(value - zero_point) * QuantBScale[n * BlockCountK + block];
+      }
+    }
+
+    const size_t packed_b_size = MlasQNBitGemmPackBSize(N, K, BlkBitWidth, BlkLen);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(std::max(packed_b_size, size_t(1)));
+    MlasQNBitGemmPackB(N, K, BlkBitWidth, BlkLen, QuantBData, QuantBScale, QuantBZeroPoint, PackedB);
+
+    std::fill_n(C, M * N * BatchSize, -0.5f);
+
+    std::vector<MLAS_QNBIT_GEMM_DATA_PARAMS> data(BatchSize);
+    for (size_t i = 0; i < BatchSize; i++) {
+      data[i].A = A + M * K * i;
+      data[i].lda = K;
+      data[i].PackedB = PackedB;
+      data[i].C = C + M * N * i;
+      data[i].ldc = N;
+    }
+
+    MlasQNBitGemmBatch(M, N, K, BlkBitWidth, BlkLen, data.data(), BatchSize, GetMlasThreadPool());
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      const float* a = A + M * K * batch;
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          double magnitude = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            const double product = double(a[m * K + k]) * double(B[k * N + n]);
+            sum += product;
+            magnitude += std::fabs(product);
+          }
+
+          const size_t index = M * N * batch + m * N + n;
+          ASSERT_NEAR(C[index], sum, 1e-5 * (magnitude + 1.0))
+              << " @[" << batch << "," << m << "," << n << "], "
+              << "Batch=" << BatchSize << " M=" << M << " N=" << N << " K=" << K
+              << " BlkBitWidth=" << BlkBitWidth << " BlkLen=" << BlkLen << " ZeroPoint=" << WithZeroPoint;
+        }
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("QNBitGemm") +
+                                          "BlkBitWidth" + std::to_string(BlkBitWidth) +
+                                          "BlkLen" + std::to_string(BlkLen);
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t sizes[] = {1, 3, 16, 33, 67};
+    for (bool with_zero_point : {false, true}) {
+      for (size_t M : sizes) {
+        for (size_t N : sizes) {
+          Test(M, N, BlkLen * 2 + 3, 1, with_zero_point);
+        }
+      }
+      Test(1, 4096, 512, 1, with_zero_point);
+      Test(1, 96, 1027, 1, with_zero_point);
+      Test(65, 129, 300, 3, with_zero_point);
+      Test(7, 9, 0, 1, with_zero_point);
+    }
+  }
+};
+
+template <> MlasQNBitGemmTest<4, 16>* MlasTestFixture<MlasQNBitGemmTest<4, 16>>::mlas_tester(nullptr);
+template <> MlasQNBitGemmTest<4, 32>* MlasTestFixture<MlasQNBitGemmTest<4, 32>>::mlas_tester(nullptr);
+template <> MlasQNBitGemmTest<4, 128>* MlasTestFixture<MlasQNBitGemmTest<4, 128>>::mlas_tester(nullptr);
+template <> MlasQNBitGemmTest<4, 256>* MlasTestFixture<MlasQNBitGemmTest<4, 256>>::mlas_tester(nullptr);
+template <> MlasQNBitGemmTest<8, 32>* MlasTestFixture<MlasQNBitGemmTest<8, 32>>::mlas_tester(nullptr);
+template <> MlasQNBitGemmTest<8, 64>* MlasTestFixture<MlasQNBitGemmTest<8, 64>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQNBitGemmTest<4, 16>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQNBitGemmTest<4, 32>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQNBitGemmTest<4, 128>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQNBitGemmTest<4, 256>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQNBitGemmTest<8, 32>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQNBitGemmTest<8, 64>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  static float ReduceReference(MLAS_REDUCE_OPERATION Operation, float Accumulator, float Value) {
+    switch (Operation) {
+      case MlasReduceSum:
+        return Accumulator + Value;
+      case MlasReduceMaximum:
+        return std::max(Accumulator, Value);
+      default:
+        return std::min(Accumulator, Value);
+    }
+  }
+
+  void Test(MLAS_REDUCE_OPERATION Operation, size_t Rows, size_t Columns, size_t InputStride, bool Contiguous) {
+    const size_t InputSize = Contiguous ? Rows * Columns : (Rows - 1) * InputStride + Columns;
+    const size_t OutputSize = Contiguous ? Rows : Columns;
+
+    float* Input = BufferInput.GetBuffer(InputSize);
+    float* Output = BufferOutput.GetBuffer(OutputSize);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputSize);
+
+    std::default_random_engine generator(static_cast<unsigned>(Rows * 131 + Columns));
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+    for (size_t n = 0; n < InputSize; n++) {
+      Input[n] = distribution(generator);
+    }
+
+    if (Contiguous) {
+      for (size_t r = 0; r < Rows; r++) {
+        float Accumulator = Input[r * Columns];
+        for (size_t c = 1; c < Columns; c++) {
+          Accumulator = ReduceReference(Operation, Accumulator, Input[r * Columns + c]);
+        }
+        OutputReference[r] = Accumulator;
+      }
+      MlasReduceContiguous(Operation, Input, Output, Rows, Columns);
+    } else {
+      for (size_t c = 0; c < Columns; c++) {
+        float Accumulator = Input[c];
+        for (size_t r = 1; r < Rows; r++) {
+          Accumulator = ReduceReference(Operation, Accumulator, Input[r * InputStride + c]);
+        }
+        OutputReference[c] = Accumulator;
+      }
+      MlasReduceStrided(Operation, Input, Output, Rows, Columns, InputStride);
+    }
+
+    // The order of the additions differs from the reference.
+    const float epsilon = (Operation == MlasReduceSum) ? 1e-5f * 10.0f * (Contiguous ? Columns : Rows) : 0.0f;
+
+    for (size_t n = 0; n < OutputSize; n++) {
+      ASSERT_LE(std::fabs(Output[n] - OutputReference[n]), epsilon)
+          << " @" << n << " for operation " << Operation << " with parameter (" << Rows << "," << Columns << ","
+          << InputStride << "," << Contiguous << ")";
+    }
+  }
+
+  void TestInfinity(MLAS_REDUCE_OPERATION Operation, size_t Count) {
+    const float Value = (Operation == MlasReduceMaximum) ? -std::numeric_limits<float>::infinity()
+                                                         : std::numeric_limits<float>::infinity();
+
+    float* Input = BufferInput.GetBuffer(Count * Count);
+    float* Output = BufferOutput.GetBuffer(Count);
+
+    std::fill_n(Input, Count * Count, Value);
+
+    MlasReduceContiguous(Operation, Input, Output, Count, Count);
+    for (size_t n = 0; n < Count; n++) {
+      ASSERT_EQ(Output[n], Value) << " @" << n << " for contiguous operation " << Operation << " with count " << Count;
+    }
+
+    MlasReduceStrided(Operation, Input, Output, Count, Count, Count);
+    for (size_t n = 0; n < Count; n++) {
+      ASSERT_EQ(Output[n], Value) << " @" << n << " for strided operation " << Operation << " with count " << Count;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Reduce");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_REDUCE_OPERATION Operation : {MlasReduceSum, MlasReduceMaximum, MlasReduceMinimum}) {
+      for (size_t n = 1; n < 160; n++) {
+        Test(Operation, 3, n, 0, true);
+        Test(Operation, 5, n, n, false);
+        Test(Operation, 2, n, n + 3, false);
+      }
+      Test(Operation, 1, 1000, 0, true);
+      Test(Operation, 300, 17, 0, true);
+      Test(Operation, 300, 67, 67, false);
+    }
+    for (size_t n : {1, 7, 16, 35, 67}) {
+      TestInfinity(MlasReduceMaximum, n);
+      TestInfinity(MlasReduceMinimum, n);
+    }
+  }
+};
+
+template <> MlasReduceTest* MlasTestFixture<MlasReduceTest>::mlas_tester(nullptr);
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasReduceTest>::RegisterShortExecute() : 0;
+});
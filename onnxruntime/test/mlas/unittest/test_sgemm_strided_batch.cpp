@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmStridedBatchTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceSgemm(CBLAS_TRANSPOSE TransA,
+                      CBLAS_TRANSPOSE TransB,
+                      size_t M,
+                      size_t N,
+                      size_t K,
+                      float alpha,
+                      const float* A,
+                      size_t lda,
+                      const float* B,
+                      size_t ldb,
+                      float beta,
+                      float* C,
+                      size_t ldc) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+
+        for (size_t k = 0; k < K; k++) {
+          const float a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+          const float b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+          sum += a * b;
+        }
+
+        C[m * ldc + n] = (C[m * ldc + n] * beta) + (sum * alpha);
+      }
+    }
+  }
+
+  void Test(CBLAS_TRANSPOSE TransA,
+            CBLAS_TRANSPOSE TransB,
+            size_t M,
+            size_t N,
+            size_t K,
+            size_t BatchSize,
+            bool BroadcastA,
+            bool BroadcastB,
+            float alpha,
+            float beta) {
+    const size_t StrideA = BroadcastA ? 0 : M * K;
+    const size_t StrideB = BroadcastB ? 0 : K * N;
+    const size_t StrideC = M * N;
+
+    const float* A = BufferA.GetBuffer(BroadcastA ? M * K : M * K * BatchSize);
+    const float* B = BufferB.GetBuffer(BroadcastB ? K * N : K * N * BatchSize);
+    float* C = BufferC.GetBuffer(M * N * BatchSize);
+    float* CReference = BufferCReference.GetBuffer(M * N * BatchSize);
+
+    const size_t lda = (TransA == CblasNoTrans) ? K : M;
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      std::fill_n(CReference + batch * StrideC, StrideC, -0.5f);
+      ReferenceSgemm(TransA, TransB, M, N, K, alpha, A + batch * StrideA, lda,
+                     B + batch * StrideB, ldb, beta, CReference + batch * StrideC, N);
+    }
+
+    auto Check = [&](const char* Form) {
+      for (size_t f = 0; f < M * N * BatchSize; f++) {
+        // Sensitive to comparing positive/negative zero.
+        ASSERT_EQ(C[f], CReference[f])
+            << " Diff @" << f << ", " << Form << "/"
+            << (TransA == CblasTrans ? "TransA" : "A") << "/"
+            << (TransB == CblasTrans ? "TransB" : "B") << "/"
+            << "BatchSize" << BatchSize << "/M" << M << "xN" << N << "xK" << K << "/"
+            << (BroadcastA ? "BroadcastA" : "StridedA") << "/"
+            << (BroadcastB ? "BroadcastB" : "StridedB") << "/"
+            << "Alpha" << alpha << "/"
+            << "Beta" << beta;
+      }
+    };
+
+    //
+    // Strided batch descriptor.
+    //
+
+    MLAS_SGEMM_STRIDED_BATCH_PARAMS StridedData;
+    StridedData.A = A;
+    StridedData.lda = lda;
+    StridedData.StrideA = StrideA;
+    StridedData.B = B;
+    StridedData.ldb = ldb;
+    StridedData.StrideB = StrideB;
+    StridedData.C = C;
+    StridedData.ldc = N;
+    StridedData.StrideC = StrideC;
+    StridedData.alpha = alpha;
+    StridedData.beta = beta;
+
+    std::fill_n(C, M * N * BatchSize, -0.5f);
+    MlasGemmStridedBatch(TransA, TransB, M, N, K, StridedData, BatchSize, threadpool_);
+    Check("Strided");
+
+    //
+    // Pointer array descriptors of the same batch.
+    //
+
+    std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+    for (size_t batch = 0; batch < BatchSize; batch++) {
+      Data[batch].A = A + batch * StrideA;
+      Data[batch].lda = lda;
+      Data[batch].B = B + batch * StrideB;
+      Data[batch].ldb = ldb;
+      Data[batch].C = C + batch * StrideC;
+      Data[batch].ldc = N;
+      Data[batch].alpha = alpha;
+      Data[batch].beta = beta;
+    }
+
+    std::fill_n(C, M * N * BatchSize, -0.5f);
+    MlasGemmBatch(TransA, TransB, M, N, K, Data.data(), BatchSize, threadpool_);
+    Check("PointerArray");
+  }
+
+ public:
+  MlasSgemmStridedBatchTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SgemmStridedBatch_Threaded" : "SgemmStridedBatch_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const size_t shapes[][4] = {
+        // M, N, K, BatchSize
+        {1, 1, 1, 1},
+        {4, 4, 4, 2},
+        {1, 17, 9, 5},
+        {13, 1, 7, 5},
+        {8, 16, 32, 64},
+        {12, 20, 12, 96},
+        {5, 48, 300, 7},
+        {33, 129, 64, 3},
+        {16, 160, 160, 4},
+        {3, 5, 0, 4},
+    };
+
+    for (const auto& shape : shapes) {
+      for (CBLAS_TRANSPOSE TransA : {CblasNoTrans, CblasTrans}) {
+        for (CBLAS_TRANSPOSE TransB : {CblasNoTrans, CblasTrans}) {
+          for (bool BroadcastB : {false, true}) {
+            Test(TransA, TransB, shape[0], shape[1], shape[2], shape[3], false, BroadcastB, 1.0f, 0.0f);
+          }
+          Test(TransA, TransB, shape[0], shape[1], shape[2], shape[3], true, false, 0.5f, 1.0f);
+          Test(TransA, TransB, shape[0], shape[1], shape[2], shape[3], false, true, -1.0f, -0.5f);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasSgemmStridedBatchTest<false>* MlasTestFixture<MlasSgemmStridedBatchTest<false>>::mlas_tester(nullptr);
+template <> MlasSgemmStridedBatchTest<true>* MlasTestFixture<MlasSgemmStridedBatchTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmStridedBatchTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmStridedBatchTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "asserts.h"
+#include "core/graph/model.h"
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/optimizer/graph_transformer_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+#include "test/framework/test_utils.h"
+#include "test/util/include/inference_session_wrapper.h"
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void RunElementwiseFusionTest(const std::function<void(ModelTestBuilder& helper)>& build_test_case,
+                                     const std::function<void(InferenceSessionWrapper& session)>& check_graph) {
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    12 /*opset_version*/,
+                    1e-5 /*per_sample_tolerance*/,
+                    1e-5 /*relative_per_sample_tolerance*/,
+                    std::make_unique<ElementwiseFusion>());
+}
+
+TEST(ElementwiseFusionTests, Chain) {
+  // Y = Sigmoid((X + B) * S) * X
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 64}, -2.0f, 2.0f);
+    auto* bias_arg = builder.MakeInitializer<float>({64}, -1.0f, 1.0f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.5f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Mul", {add_out, scale_arg}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    builder.AddNode("Mul", {sigmoid_out, input_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+TEST(ElementwiseFusionTests, Tree) {
+  // Y = Tanh(X - Z) + Relu(W) * Z
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({4, 16, 32}, -2.0f, 2.0f);
+    auto* z_arg = builder.MakeInput<float>({1, 32}, -2.0f, 2.0f);
+    auto* w_arg = builder.MakeInput<float>({4, 16, 32}, -2.0f, 2.0f);
+    auto* sub_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sub", {x_arg, z_arg}, {sub_out});
+    builder.AddNode("Tanh", {sub_out}, {tanh_out});
+    builder.AddNode("Relu", {w_arg}, {relu_out});
+    builder.AddNode("Mul", {relu_out, z_arg}, {mul_out});
+    builder.AddNode("Add", {tanh_out, mul_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+TEST(ElementwiseFusionTests, SharedIntermediate) {
+  // The output of the Add is used twice, so only the Sigmoid and Mul are fused.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({8, 32}, -2.0f, 2.0f);
+    auto* y_arg = builder.MakeInput<float>({8, 32}, -2.0f, 2.0f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, y_arg}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Mul", {sigmoid_out, add_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+TEST(ElementwiseFusionTests, NonSuffixBroadcast) {
+  // Z broadcasts along the last dimension, which the fused kernel does not support.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({8, 32}, -2.0f, 2.0f);
+    auto* z_arg = builder.MakeInput<float>({8, 1}, -2.0f, 2.0f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, z_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+  };
+
+  RunElementwiseFusionTest(build_test_case, check_graph);
+}
+
+TEST(ElementwiseFusionTests, SessionOptionConfig) {
+  auto has_elementwise_fusion = [](const SessionOptions& session_options) {
+    CPUExecutionProvider cpu_ep(CPUExecutionProviderInfo{});
+    auto transformers = optimizer_utils::GenerateTransformers(TransformerLevel::Level2, session_options, cpu_ep, {});
+    return std::any_of(transformers.begin(), transformers.end(), [](const auto& transformer) {
+      return transformer->Name() == "ElementwiseFusion";
+    });
+  };
+
+  // ElementwiseFusion is not enabled by default.
+  SessionOptions session_options;
+  EXPECT_FALSE(has_elementwise_fusion(session_options));
+
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseFusion, "1"));
+  EXPECT_TRUE(has_elementwise_fusion(session_options));
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -107,6 +107,28 @@ TEST(OptimizerInitializerTest, LoadExternalData) {
   }
 }
 
+// initializers of a memory mapped ORT format model have their data in memory instead of in a file
+TEST(OptimizerInitializerTest, LoadExternalDataInMemory) {
+  std::vector<int32_t> tensor_data(100);
+  std::iota(tensor_data.begin(), tensor_data.end(), 0);
+
+  ONNX_NAMESPACE::TensorProto tensor_proto{};
+  tensor_proto.set_name("test");
+  tensor_proto.add_dims(tensor_data.size());
+  tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT32);
+  utils::SetExternalDataInMemory(tensor_data.data(), tensor_data.size() * sizeof(int32_t), tensor_proto);
+
+  // no model path is needed to read the data
+  Initializer i(tensor_proto, Path{});
+  const gsl::span<const int32_t> tensor_data_span = gsl::make_span(tensor_data);
+  EXPECT_EQ(gsl::make_span(i.data<int32_t>(), i.size()), tensor_data_span);
+
+  // bad length
+  tensor_proto.clear_dims();
+  tensor_proto.add_dims(tensor_data.size() + 1);
+  EXPECT_THROW(Initializer bad(tensor_proto, Path{}), OnnxRuntimeException);
+}
+
 template <typename T>
 ONNX_NAMESPACE::TensorProto_DataType GetTensorProtoDataType();
 
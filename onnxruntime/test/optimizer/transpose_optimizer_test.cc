@@ -0,0 +1,310 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/model.h"
+#include "core/optimizer/transpose_optimizer.h"
+
+#include "test/framework/test_utils.h"
+#include "test/util/include/inference_session_wrapper.h"
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+namespace onnxruntime {
+namespace test {
+
+// The optimizer is part of the default Level1 transformers, so compare against an unoptimized run. This also
+// lets constant folding remove the Transposes that are inserted for constant inputs.
+static void RunTransposeOptimizerTest(const std::function<void(ModelTestBuilder& helper)>& build_test_case,
+                                      const std::function<void(InferenceSessionWrapper& session)>& check_graph,
+                                      int opset_version = 12) {
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    opset_version,
+                    1e-5 /*per_sample_tolerance*/,
+                    1e-5 /*relative_per_sample_tolerance*/);
+}
+
+static Node& AddTransposeNode(ModelTestBuilder& builder, NodeArg* input_arg, NodeArg* output_arg,
+                              const std::vector<int64_t>& perm) {
+  Node& node = builder.AddNode("Transpose", {input_arg}, {output_arg});
+  node.AddAttribute("perm", perm);
+  return node;
+}
+
+TEST(TransposeOptimizerTests, CancelThroughElementwise) {
+  // Transpose -> Relu -> Add(bias) -> Transpose with the inverse permutation.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.0f, 1.0f);
+    auto* bias_arg = builder.MakeInitializer<float>({3}, -1.0f, 1.0f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {2, 0, 1});
+    builder.AddNode("Relu", {transpose_out}, {relu_out});
+    builder.AddNode("Add", {relu_out, bias_arg}, {add_out});
+    AddTransposeNode(builder, add_out, output_arg, {1, 2, 0});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, MergeWithTransposedInput) {
+  // Both inputs of the Mul are transposed the same way, so a single Transpose remains at the output.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({2, 3, 4, 5}, -1.0f, 1.0f);
+    auto* input2_arg = builder.MakeInput<float>({2, 3, 4, 5}, -1.0f, 1.0f);
+    auto* transpose1_out = builder.MakeIntermediate();
+    auto* transpose2_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input1_arg, transpose1_out, {0, 2, 3, 1});
+    AddTransposeNode(builder, input2_arg, transpose2_out, {0, 2, 3, 1});
+    builder.AddNode("Mul", {transpose1_out, transpose2_out}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 1);
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, ReduceWithoutKeepdims) {
+  // Reducing the swapped axis leaves the remaining axes in order, so no Transpose is needed.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 5, 6}, -1.0f, 1.0f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {1, 0, 2});
+    Node& reduce = builder.AddNode("ReduceMean", {transpose_out}, {output_arg});
+    reduce.AddAttribute("axes", std::vector<int64_t>{0});
+    reduce.AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["ReduceMean"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, ReduceSumAxesInput) {
+  // ReduceSum-13 takes the axes as an input, which is rewritten for the original layout.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.0f, 1.0f);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {2});
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* reduce_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {0, 2, 1});
+    Node& reduce = builder.AddNode("ReduceSum", {transpose_out, axes_arg}, {reduce_out});
+    reduce.AddAttribute("keepdims", static_cast<int64_t>(1));
+    AddTransposeNode(builder, reduce_out, output_arg, {0, 2, 1});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["ReduceSum"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph, 13);
+}
+
+TEST(TransposeOptimizerTests, Softmax13) {
+  // Softmax-13 normalizes along a single axis, so it can be computed in the original layout.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.0f, 1.0f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {0, 2, 1});
+    Node& softmax = builder.AddNode("Softmax", {transpose_out}, {softmax_out});
+    softmax.AddAttribute("axis", static_cast<int64_t>(-1));
+    AddTransposeNode(builder, softmax_out, output_arg, {0, 2, 1});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Softmax"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph, 13);
+}
+
+TEST(TransposeOptimizerTests, ArgMaxArgMin) {
+  // Reducing either swapped axis leaves the remaining axes in order, so no Transpose is needed.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({4, 5, 6}, -1.0f, 1.0f);
+    auto* input2_arg = builder.MakeInput<float>({4, 5, 6}, -1.0f, 1.0f);
+    auto* transpose1_out = builder.MakeIntermediate();
+    auto* transpose2_out = builder.MakeIntermediate();
+    auto* output1_arg = builder.MakeOutput();
+    auto* output2_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input1_arg, transpose1_out, {1, 0, 2});
+    Node& argmax = builder.AddNode("ArgMax", {transpose1_out}, {output1_arg});
+    argmax.AddAttribute("axis", static_cast<int64_t>(0));
+    argmax.AddAttribute("keepdims", static_cast<int64_t>(0));
+
+    AddTransposeNode(builder, input2_arg, transpose2_out, {1, 0, 2});
+    Node& argmin = builder.AddNode("ArgMin", {transpose2_out}, {output2_arg});
+    argmin.AddAttribute("axis", static_cast<int64_t>(1));
+    argmin.AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["ArgMax"], 1);
+    EXPECT_EQ(op_to_count["ArgMin"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph, 13);
+}
+
+TEST(TransposeOptimizerTests, Concat) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({2, 3, 4}, -1.0f, 1.0f);
+    auto* input2_arg = builder.MakeInput<float>({2, 5, 4}, -1.0f, 1.0f);
+    auto* transpose1_out = builder.MakeIntermediate();
+    auto* transpose2_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input1_arg, transpose1_out, {0, 2, 1});
+    AddTransposeNode(builder, input2_arg, transpose2_out, {0, 2, 1});
+    Node& concat = builder.AddNode("Concat", {transpose1_out, transpose2_out}, {concat_out});
+    concat.AddAttribute("axis", static_cast<int64_t>(-1));
+    AddTransposeNode(builder, concat_out, output_arg, {0, 2, 1});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Concat"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, Split) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 6}, -1.0f, 1.0f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* split1_out = builder.MakeIntermediate();
+    auto* split2_out = builder.MakeIntermediate();
+    auto* output1_arg = builder.MakeOutput();
+    auto* output2_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {0, 2, 1});
+    Node& split = builder.AddNode("Split", {transpose_out}, {split1_out, split2_out});
+    split.AddAttribute("axis", static_cast<int64_t>(1));
+    split.AddAttribute("split", std::vector<int64_t>{2, 4});
+    AddTransposeNode(builder, split1_out, output1_arg, {0, 2, 1});
+    AddTransposeNode(builder, split2_out, output2_arg, {0, 2, 1});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Split"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, PadAndSlice) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.0f, 1.0f);
+    auto* pads_arg = builder.MakeInitializer<int64_t>({6}, {0, 1, 2, 0, 2, 1});
+    auto* starts_arg = builder.MakeInitializer<int64_t>({1}, {1});
+    auto* ends_arg = builder.MakeInitializer<int64_t>({1}, {3});
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* pad_out = builder.MakeIntermediate();
+    auto* slice_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {2, 0, 1});
+    builder.AddNode("Pad", {transpose_out, pads_arg}, {pad_out});
+    builder.AddNode("Slice", {pad_out, starts_arg, ends_arg}, {slice_out});
+    AddTransposeNode(builder, slice_out, output_arg, {1, 2, 0});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Pad"], 1);
+    EXPECT_EQ(op_to_count["Slice"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, MergeConsecutive) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4, 5}, -1.0f, 1.0f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {0, 2, 3, 1});
+    AddTransposeNode(builder, transpose_out, output_arg, {0, 2, 1, 3});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+TEST(TransposeOptimizerTests, NoBenefit) {
+  // Pushing the Transpose past the Relu would need a Transpose at the graph output, so nothing changes.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 4}, -1.0f, 1.0f);
+    auto* other_arg = builder.MakeInput<float>({4, 2, 3}, -1.0f, 1.0f);
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    AddTransposeNode(builder, input_arg, transpose_out, {2, 0, 1});
+    builder.AddNode("Add", {transpose_out, other_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+  };
+
+  RunTransposeOptimizerTest(build_test_case, check_graph);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -401,6 +401,11 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     session_options.SetOptimizedModelFilePath(performance_test_config.run_config.optimized_model_path.c_str());
   if (performance_test_config.run_config.set_denormal_as_zero)
     session_options.AddConfigEntry(kOrtSessionOptionsConfigSetDenormalAsZero, "1");
+  if (!performance_test_config.run_config.gemm_tuning_file.empty()) {
+    session_options.AddConfigEntry(kOrtSessionOptionsConfigGemmTuningFile,
+                                   ToMBString(performance_test_config.run_config.gemm_tuning_file).c_str());
+    session_options.AddConfigEntry(kOrtSessionOptionsConfigGemmAutotune, "1");
+  }
   if (!performance_test_config.run_config.free_dim_name_overrides.empty()) {
     for (auto const& dim_override : performance_test_config.run_config.free_dim_name_overrides) {
       if (g_ort->AddFreeDimensionOverrideByName(session_options, ToMBString(dim_override.first).c_str(), dim_override.second) != nullptr) {
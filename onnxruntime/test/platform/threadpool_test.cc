@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -56,6 +57,26 @@ void CreateThreadPoolAndTest(const std::string&, int num_threads, const std::fun
   }
 }
 
+// As above, but with the given spin policy for idle workers.
+void CreateThreadPoolWithSpinPolicyAndTest(const std::string&, int num_threads,
+                                           onnxruntime::ThreadPoolSpinPolicy spin_policy,
+                                           const std::function<void(ThreadPool*)>& test_body) {
+  onnxruntime::ThreadOptions to;
+  to.spin_policy = spin_policy;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, num_threads, true);
+  test_body(tp.get());
+}
+
+// As above, but with the worker threads partitioned into the given
+// (simulated) NUMA domains.
+void CreatePartitionedThreadPoolAndTest(const std::string&, int num_threads, const std::vector<int>& domains,
+                                        const std::function<void(ThreadPool*)>& test_body) {
+  onnxruntime::ThreadOptions to;
+  to.domains = domains;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, num_threads, true);
+  test_body(tp.get());
+}
+
 void TestParallelFor(const std::string& name, int num_threads, int num_tasks) {
   auto test_data = CreateTestData(num_tasks);
   CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
@@ -216,6 +237,220 @@ void TestStagedMultiLoopSections(const std::string& name, int num_threads, int n
   }
 }
 
+// Test a thread pool partitioned into domains with the different kinds
+// of parallel loops, multi-loop sections, and tasks scheduled from
+// inside the pool (which stay within the scheduling worker's domain).
+void TestPartitionedPool(const std::string& name, int num_threads, const std::vector<int>& domains) {
+  for (int rep = 0; rep < 5; rep++) {
+    const int num_tasks = 1024;
+    auto test_data = CreateTestData(num_tasks);
+    std::atomic<int> ctr{0};
+    CreatePartitionedThreadPoolAndTest(name, num_threads, domains, [&](ThreadPool* tp) {
+      ThreadPool::TryParallelFor(tp, num_tasks, 1000.0, [&](std::ptrdiff_t s, std::ptrdiff_t e) {
+        for (std::ptrdiff_t i = s; i < e; i++) {
+          IncrementElement(*test_data, i);
+        }
+      });
+      ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+      {
+        ThreadPool::ParallelSection ps(tp);
+        for (int l = 0; l < 10; l++) {
+          ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+        }
+      }
+      ThreadPool::Schedule(tp, [&, tp]() {
+        for (int tasks = 0; tasks < num_tasks; tasks++) {
+          ThreadPool::Schedule(tp, [&]() {
+            ctr++;
+          });
+        }
+      });
+    });
+    ValidateTestData(*test_data, 12);
+    ASSERT_EQ(ctr, num_tasks);
+  }
+}
+
+// Test a thread pool with an adaptive spin policy, running loops both
+// back-to-back (so that workers learn a short inter-arrival time) and
+// after pauses, inside and outside StartRun/EndRun.
+void TestSpinPolicy(const std::string& name, int num_threads, onnxruntime::ThreadPoolSpinPolicy spin_policy) {
+  const int num_tasks = 1024;
+  auto test_data = CreateTestData(num_tasks);
+  std::atomic<int> ctr{0};
+  CreateThreadPoolWithSpinPolicyAndTest(name, num_threads, spin_policy, [&](ThreadPool* tp) {
+    ThreadPool::StartProfiling(tp);
+    for (int run = 0; run < 4; run++) {
+      const bool in_run = (run % 2) == 0;
+      if (in_run) {
+        ThreadPool::StartRun(tp);
+      }
+      for (int l = 0; l < 50; l++) {
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+      }
+      ThreadPool::Schedule(tp, [&]() { ctr++; });
+      if (in_run) {
+        ThreadPool::EndRun(tp);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::string profile = ThreadPool::StopProfiling(tp);
+    if (!profile.empty() && num_threads > 1) {
+      ASSERT_NE(profile.find("spin_budget_us"), std::string::npos);
+    }
+  });
+  ValidateTestData(*test_data, 200);
+  ASSERT_EQ(ctr, 4);
+}
+
+// Return the last spin budget logged by each worker in a thread pool
+// profile, or -1 for a worker that has not chosen one yet.
+std::vector<int64_t> GetSpinBudgets(const std::string& profile) {
+  std::vector<int64_t> budgets;
+  const std::string key = "\"spin_budget_us\": ";
+  for (auto pos = profile.find(key); pos != std::string::npos; pos = profile.find(key, pos)) {
+    pos += key.size();
+    budgets.push_back(std::stoll(profile.substr(pos)));
+  }
+  return budgets;
+}
+
+// Test that the adaptive spin budget follows the load: it grows while
+// loops arrive back-to-back and falls back to the minimum once they
+// arrive after long pauses.
+void TestSpinBudgetFollowsLoad(const std::string& name, int num_threads) {
+  CreateThreadPoolWithSpinPolicyAndTest(name, num_threads, onnxruntime::ThreadPoolSpinPolicy::Adaptive,
+                                        [&](ThreadPool* tp) {
+    auto run_loop = [&]() {
+      ThreadPool::TrySimpleParallelFor(tp, num_threads, [&](std::ptrdiff_t) {
+        const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(100);
+        while (std::chrono::steady_clock::now() < end) {
+        }
+      });
+    };
+
+    // Busy: about 100us between arrivals.  Give the workers time to go
+    // idle, and so log their budget, before reading the profile.
+    ThreadPool::StartProfiling(tp);
+    for (int l = 0; l < 200; l++) {
+      run_loop();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::vector<int64_t> busy_budgets = GetSpinBudgets(ThreadPool::StopProfiling(tp));
+
+    // Idle: 20ms between arrivals, beyond the longest budget.
+    ThreadPool::StartProfiling(tp);
+    for (int l = 0; l < 16; l++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      run_loop();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::vector<int64_t> idle_budgets = GetSpinBudgets(ThreadPool::StopProfiling(tp));
+
+    if (busy_budgets.empty()) {
+      // Profiling is not available in this build
+      return;
+    }
+
+    // A worker that did not run in the idle phase keeps its busy budget,
+    // so look at the smallest budget there.
+    const int64_t min_spin_us = 20;
+    const int64_t busy_budget = *std::max_element(busy_budgets.begin(), busy_budgets.end());
+    idle_budgets.erase(std::remove(idle_budgets.begin(), idle_budgets.end(), -1), idle_budgets.end());
+    ASSERT_FALSE(idle_budgets.empty());
+    const int64_t idle_budget = *std::min_element(idle_budgets.begin(), idle_budgets.end());
+    ASSERT_GT(busy_budget, min_spin_us);
+    ASSERT_EQ(idle_budget, min_spin_us);
+  });
+}
+
+// Test that a single worker serves high-priority work first.  The
+// worker is held in a task while we queue normal-priority tasks
+// followed by tasks submitted with the given priority and deadline,
+// which we expect to run before the normal-priority tasks if they are
+// treated as high priority.
+void TestPriorityOrder(const std::string& name, onnxruntime::ThreadPoolPriority priority,
+                       std::chrono::steady_clock::time_point deadline, bool expect_first) {
+  const int num_tasks = 8;
+  CreateThreadPoolAndTest(name, 2, [&](ThreadPool* tp) {
+    std::atomic<bool> release{false};
+    std::atomic<int> done{0};
+    std::vector<int> order;
+    onnxruntime::OrtMutex order_mutex;
+    auto record = [&](int i) {
+      std::lock_guard<onnxruntime::OrtMutex> lock(order_mutex);
+      order.push_back(i);
+      done++;
+    };
+
+    ThreadPool::Schedule(tp, [&]() {
+      while (!release) {
+        std::this_thread::yield();
+      }
+    });
+    for (int i = 0; i < num_tasks; i++) {
+      ThreadPool::Schedule(tp, [&, i]() { record(i); });
+    }
+    {
+      ThreadPool::PriorityScope scope(priority, deadline);
+      for (int i = num_tasks; i < 2 * num_tasks; i++) {
+        ThreadPool::Schedule(tp, [&, i]() { record(i); });
+      }
+    }
+    release = true;
+    while (done < 2 * num_tasks) {
+      std::this_thread::yield();
+    }
+
+    ASSERT_EQ(order.size(), static_cast<size_t>(2 * num_tasks));
+    if (expect_first) {
+      for (int i = 0; i < num_tasks; i++) {
+        ASSERT_GE(order[i], num_tasks);
+      }
+    } else {
+      for (int i = 0; i < 2 * num_tasks; i++) {
+        ASSERT_EQ(order[i], i);
+      }
+    }
+  });
+}
+
+// Test normal-priority parallel loops running concurrently with
+// high-priority loops and tasks, so that helper threads in the
+// normal-priority loops yield part-way through.  All of the loops
+// must still run all of their iterations.
+void TestConcurrentPriorities(const std::string& name, int num_threads) {
+  const int num_tasks = 4096;
+  const int num_loops = 50;
+  auto normal_data = CreateTestData(num_tasks);
+  auto high_data = CreateTestData(num_tasks);
+  std::atomic<int> ctr{0};
+  CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+    std::thread high_thread([&]() {
+      ThreadPool::PriorityScope scope(onnxruntime::ThreadPoolPriority::High);
+      for (int l = 0; l < num_loops; l++) {
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*high_data, i); });
+        ThreadPool::Schedule(tp, [&]() { ctr++; });
+      }
+    });
+    for (int l = 0; l < num_loops / 2; l++) {
+      ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*normal_data, i); });
+    }
+    {
+      ThreadPool::ParallelSection ps(tp);
+      for (int l = 0; l < num_loops / 2; l++) {
+        ThreadPool::TrySimpleParallelFor(tp, num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*normal_data, i); });
+      }
+    }
+    high_thread.join();
+    while (ctr < num_loops) {
+      std::this_thread::yield();
+    }
+  });
+  ValidateTestData(*normal_data, num_loops);
+  ValidateTestData(*high_data, num_loops);
+}
+
 }  // namespace
 
 namespace onnxruntime {
@@ -424,6 +659,70 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_10Loop) {
 TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
+
+TEST(ThreadPoolTest, TestPartitionedPool_4Thread_2Domain) {
+  TestPartitionedPool("TestPartitionedPool_4Thread_2Domain", 4, {0, 0, 1});
+}
+
+TEST(ThreadPoolTest, TestPartitionedPool_8Thread_2Domain) {
+  TestPartitionedPool("TestPartitionedPool_8Thread_2Domain", 8, {0, 0, 0, 0, 1, 1, 1});
+}
+
+TEST(ThreadPoolTest, TestPartitionedPool_8Thread_2InterleavedDomain) {
+  TestPartitionedPool("TestPartitionedPool_8Thread_2InterleavedDomain", 8, {1, 0, 1, 0, 1, 0, 1});
+}
+
+TEST(ThreadPoolTest, TestPartitionedPool_5Thread_4Domain) {
+  TestPartitionedPool("TestPartitionedPool_5Thread_4Domain", 5, {3, 2, 1, 0});
+}
+
+TEST(ThreadPoolTest, TestPartitionedPool_4Thread_1Domain) {
+  TestPartitionedPool("TestPartitionedPool_4Thread_1Domain", 4, {7, 7, 7, 7});
+}
+
+TEST(ThreadPoolTest, TestSpinPolicy_4Thread_Adaptive) {
+  TestSpinPolicy("TestSpinPolicy_4Thread_Adaptive", 4, ThreadPoolSpinPolicy::Adaptive);
+}
+
+TEST(ThreadPoolTest, TestSpinBudgetFollowsLoad_4Thread) {
+  TestSpinBudgetFollowsLoad("TestSpinBudgetFollowsLoad_4Thread", 4);
+}
+
+TEST(ThreadPoolTest, TestSpinPolicy_4Thread_DuringRun) {
+  TestSpinPolicy("TestSpinPolicy_4Thread_DuringRun", 4, ThreadPoolSpinPolicy::DuringRun);
+}
+
+TEST(ThreadPoolTest, TestSpinPolicy_1Thread_DuringRun) {
+  TestSpinPolicy("TestSpinPolicy_1Thread_DuringRun", 1, ThreadPoolSpinPolicy::DuringRun);
+}
+
+TEST(ThreadPoolTest, TestPriorityOrder_High) {
+  TestPriorityOrder("TestPriorityOrder_High", ThreadPoolPriority::High, std::chrono::steady_clock::time_point(),
+                    true);
+}
+
+TEST(ThreadPoolTest, TestPriorityOrder_Normal) {
+  TestPriorityOrder("TestPriorityOrder_Normal", ThreadPoolPriority::Normal, std::chrono::steady_clock::time_point(),
+                    false);
+}
+
+TEST(ThreadPoolTest, TestPriorityOrder_DeadlinePassed) {
+  TestPriorityOrder("TestPriorityOrder_DeadlinePassed", ThreadPoolPriority::Normal,
+                    std::chrono::steady_clock::now() - std::chrono::milliseconds(1), true);
+}
+
+TEST(ThreadPoolTest, TestPriorityOrder_DeadlineNotPassed) {
+  TestPriorityOrder("TestPriorityOrder_DeadlineNotPassed", ThreadPoolPriority::Normal,
+                    std::chrono::steady_clock::now() + std::chrono::hours(1), false);
+}
+
+TEST(ThreadPoolTest, TestConcurrentPriorities_4Thread) {
+  TestConcurrentPriorities("TestConcurrentPriorities_4Thread", 4);
+}
+
+TEST(ThreadPoolTest, TestConcurrentPriorities_8Thread) {
+  TestConcurrentPriorities("TestConcurrentPriorities_8Thread", 8);
+}
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -44,8 +44,6 @@ TEST(GemmOpTest, GemmNoTrans_double) {
   TestGemmNoTrans<double>();
 }
 
-// Only CUDA kernel has float 16 support
-#if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(GemmOpTest, GemmNoTrans_f16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -54,7 +52,7 @@ TEST(GemmOpTest, GemmNoTrans_f16) {
     return;
   }
 #endif
-  OpTester test("Gemm");
+  OpTester test("Gemm", 13);
 
   test.AddAttribute("transA", (int64_t)0);
   test.AddAttribute("transB", (int64_t)0);
@@ -83,7 +81,35 @@ TEST(GemmOpTest, GemmNoTrans_f16) {
   test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: fp16 is not supported
 }
-#endif
+
+TEST(GemmOpTest, GemmTransB_bf16) {
+  OpTester test("Gemm", 13);
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 0.5f);
+  test.AddAttribute("beta", 1.0f);
+
+  auto to_bf16 = [](const std::vector<float>& values) {
+    std::vector<BFloat16> result;
+    for (float value : values) {
+      result.push_back(BFloat16(value));
+    }
+    return result;
+  };
+
+  test.AddInput<BFloat16>("A", {2, 4}, to_bf16({1.0f, 2.0f, 3.0f, 4.0f,
+                                                -1.0f, -2.0f, -3.0f, -4.0f}));
+  test.AddInput<BFloat16>("B", {3, 4}, to_bf16(std::vector<float>(12, 1.0f)));
+  test.AddInput<BFloat16>("C", {3}, to_bf16({1.0f, 2.0f, 3.0f}));
+  test.AddOutput<BFloat16>("Y", {2, 3}, to_bf16({6.0f, 7.0f, 8.0f,
+                                                 -4.0f, -3.0f, -2.0f}));
+
+  // test the MLAS based CPU kernel
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
 
 template <typename T>
 void TestGemmBroadcast() {
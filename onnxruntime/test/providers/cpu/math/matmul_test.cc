@@ -162,6 +162,50 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
+// The inputs are integers up to 11 and the kernels accumulate in float, so the only rounding is the conversion of
+// the results. The expected values are at most 262 and even above 256, so they fit the 8 significant bits of bfloat16
+// and the comparison doesn't depend on how either side rounds. to_16bit checks this still holds for every value.
+template <typename T>
+void RunMatMul16BitTest() {
+  auto to_16bit = [](const std::vector<float>& values) {
+    std::vector<T> result;
+    result.reserve(values.size());
+    for (float value : values) {
+      result.push_back(T(value));
+      EXPECT_EQ(result.back().ToFloat(), value) << "test value is not exact in the 16-bit format";
+    }
+    return result;
+  };
+
+  std::vector<float> common_input_vals{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  for (auto t : GenerateTestCases<float>()) {
+    OpTester test("MatMul", 13);
+
+    int64_t size0 = TensorShape::ReinterpretBaseType(t.input0_dims).SizeHelper(0, t.input0_dims.size());
+    std::vector<float> input0_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size0);
+    test.AddInput<T>("A", t.input0_dims, to_16bit(input0_vals));
+
+    int64_t size1 = TensorShape::ReinterpretBaseType(t.input1_dims).SizeHelper(0, t.input1_dims.size());
+    std::vector<float> input1_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size1);
+    test.AddInput<T>("B", t.input1_dims, to_16bit(input1_vals));
+
+    test.AddOutput<T>("Y", t.expected_dims, to_16bit(t.expected_vals));
+
+    // test the MLAS based CPU kernel
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+TEST(MathOpTest, MatMulFloat16Type) {
+  RunMatMul16BitTest<MLFloat16>();
+}
+
+TEST(MathOpTest, MatMulBFloat16Type) {
+  RunMatMul16BitTest<BFloat16>();
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   OpTester test("MatMul");
@@ -495,7 +495,7 @@ class QLinearConvOpTester {
     abs_error = 1.0f;
 #endif
 
-    test.AddOutput<uint8_t>("y", Y_shape, Y_data, false /* sort_output */, 0.0f /* rel_error */, abs_error);
+    test.AddOutput<T1>("y", Y_shape, Y_data, false /* sort_output */, 0.0f /* rel_error */, abs_error);
 
     if (!pads_.empty()) {
       test.AddAttribute("pads", pads_);
@@ -518,7 +518,16 @@ class QLinearConvOpTester {
   }
 
   void GenerateRandomInput(const std::vector<int64_t>& shape, float scale, T1 zero_point) {
-    GenerateRandom(X_, shape, scale, zero_point, 0, 63);
+    if (std::is_signed<T1>::value) {
+      GenerateRandom(X_, shape, scale, zero_point, -63, 63);
+    } else {
+      GenerateRandom(X_, shape, scale, zero_point, 0, 63);
+    }
+  }
+
+  void GenerateRandomInput(const std::vector<int64_t>& shape, float scale, T1 zero_point,
+                           int32_t min_value, int32_t max_value) {
+    GenerateRandom(X_, shape, scale, zero_point, min_value, max_value);
   }
 
   void GenerateRandomWeights(const std::vector<int64_t>& shape, float scale, T2 zero_point) {
@@ -529,6 +538,11 @@ class QLinearConvOpTester {
     }
   }
 
+  void GenerateRandomWeights(const std::vector<int64_t>& shape, float scale, T2 zero_point,
+                             int32_t min_value, int32_t max_value) {
+    GenerateRandom(W_, shape, scale, zero_point, min_value, max_value);
+  }
+
   void SetWeightScales(const std::vector<float>& scales) {
     W_.scale_ = scales;
   }
@@ -958,6 +972,102 @@ TEST(QLinearConvTest, Conv2D_U8S8_Requantize_Bias_PerChannel) {
   }
 }
 
+TEST(QLinearConvTest, Conv2D_S8S8) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({3, 24, 15, 11}, .05f, -4);
+  test.GenerateRandomWeights({32, 24, 3, 3}, .125f, 0);
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetOutputScaleAndZeroPoint(.55f, -12);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8U8) {
+  QLinearConvOpTester<int8_t, uint8_t> test;
+  test.GenerateRandomInput({3, 24, 15, 11}, .05f, 7);
+  test.GenerateRandomWeights({32, 24, 3, 3}, .125f, 131);
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetOutputScaleAndZeroPoint(.55f, 5);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_Pointwise) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({3, 64, 11, 11}, .05f, -128);
+  test.GenerateRandomWeights({48, 64, 1, 1}, .125f, 3);
+  test.GenerateRandomBias();
+  test.SetOutputScaleAndZeroPoint(.55f, 17);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_Groups_PerChannel) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({1, 8, 13, 13}, .05f, 9);
+  test.GenerateRandomWeights({16, 4, 3, 3}, .125f, 0);
+  test.SetWeightScales({.125f, .125f, .120f, .115f, .110f, .105f, .100f, .095f,
+                        .090f, .085f, .080f, .075f, .070f, .065f, .060f, .055f});
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetGroups(2);
+  test.SetOutputScaleAndZeroPoint(.55f, -54);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_Depthwise) {
+  for (int8_t weight_zero_point : std::initializer_list<int8_t>{0, -2}) {
+    for (int64_t channels : std::initializer_list<int64_t>{7, 8, 9, 16, 25, 32, 64}) {
+      QLinearConvOpTester<int8_t, int8_t> test;
+      test.GenerateRandomInput({1, channels, 25, 25}, .03f, -12);
+      test.GenerateRandomWeights({channels, 1, 5, 5}, .10f, weight_zero_point);
+      test.GenerateRandomBias();
+      test.SetPads({2, 2, 2, 2});
+      test.SetGroups(channels);
+      test.SetOutputScaleAndZeroPoint(.76f, 8);
+      test.Run();
+    }
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_S8U8_Depthwise) {
+  for (int64_t channels : std::initializer_list<int64_t>{3, 8, 13, 24, 31, 64}) {
+    QLinearConvOpTester<int8_t, uint8_t> test;
+    test.GenerateRandomInput({1, channels, 25, 25}, .03f, 12);
+    test.GenerateRandomWeights({channels, 1, 3, 3}, .10f, 167);
+    test.GenerateRandomBias();
+    test.SetPads({2, 0, 2, 0});
+    test.SetGroups(channels);
+    test.SetOutputScaleAndZeroPoint(.76f, -88);
+    test.Run();
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_FullRange) {
+  // Both the activations and the weights span the full int8 range, so a kernel that multiplies
+  // pairs of bytes into saturating 16-bit sums would produce the wrong result.
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({2, 32, 9, 9}, .05f, -3, -128, 127);
+  test.GenerateRandomWeights({40, 32, 3, 3}, .125f, 0, -128, 127);
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetOutputScaleAndZeroPoint(8.f, 4);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_FullRange_PerChannel) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({1, 64, 7, 7}, .05f, 0, -128, 127);
+  test.GenerateRandomWeights({24, 64, 1, 1}, .125f, 0, -128, 127);
+  std::vector<float> weight_scales;
+  for (int64_t i = 0; i < 24; i++) {
+    weight_scales.push_back(.125f - .002f * static_cast<float>(i));
+  }
+  test.SetWeightScales(weight_scales);
+  test.GenerateRandomBias();
+  test.SetOutputScaleAndZeroPoint(4.f, -7);
+  test.Run();
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(QLinearConvTest, SharedPrepackedWeights) {
   QuantizedTensor X({0.45246148109436035f, 0.15498268604278564f, 0.11199361085891724f, -0.39421093463897705f,
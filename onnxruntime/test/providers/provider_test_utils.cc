@@ -292,6 +292,9 @@ struct TensorCheck<MLFloat16> {
 #if defined(USE_TENSORRT) || defined(ENABLE_TRAINING) || defined(USE_CUDA) || defined(USE_ROCM)
     threshold = 0.005f;
 #endif
+    if (params.absolute_error_.has_value()) {
+      threshold = *(params.absolute_error_);
+    }
     for (int i = 0; i < size; ++i) {
       if (std::isnan(f_expected[i])) {
         EXPECT_TRUE(std::isnan(f_expected[i])) << "Expected NaN. i:" << i << ", provider_type: " << provider_type;
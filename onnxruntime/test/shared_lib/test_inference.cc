@@ -242,6 +242,75 @@ TEST(CApiTest, dim_param) {
   ASSERT_EQ(strcmp(dim_param, ""), 0);
 }
 
+TEST(CApiTest, RunAsync) {
+  Ort::SessionOptions session_options;
+  // RunAsync needs a worker thread to run on
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<float> input_data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> input_dims = {3, 2};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  // start several runs before waiting for any of them
+  std::vector<std::future<std::vector<Ort::Value>>> results;
+  std::vector<Ort::Value> ort_inputs;
+  ort_inputs.reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    ort_inputs.emplace_back(Ort::Value::CreateTensor<float>(info, input_data.data(), input_data.size(),
+                                                            input_dims.data(), input_dims.size()));
+    results.push_back(session.RunAsync(Ort::RunOptions{nullptr}, input_names, &ort_inputs.back(), 1,
+                                       output_names, 1));
+  }
+
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  for (auto& result : results) {
+    auto outputs = result.get();
+    ASSERT_EQ(outputs.size(), 1u);
+    auto type_info = outputs[0].GetTensorTypeAndShapeInfo();
+    ASSERT_EQ(type_info.GetShape(), input_dims);
+    const float* y = outputs[0].GetTensorData<float>();
+    ASSERT_TRUE(std::equal(expected_values_y.cbegin(), expected_values_y.cend(), y));
+  }
+
+  // a failing run reports the error through the future
+  const char* bad_output_names[] = {"bad_name"};
+  auto failed = session.RunAsync(Ort::RunOptions{nullptr}, input_names, &ort_inputs.front(), 1, bad_output_names, 1);
+  ASSERT_THROW(failed.get(), Ort::Exception);
+}
+
+TEST(CApiTest, CloneSession) {
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions{});
+
+  // the clone gets its own thread pool and memory pattern settings
+  Ort::SessionOptions clone_options;
+  clone_options.SetIntraOpNumThreads(2);
+  clone_options.DisableMemPattern();
+  Ort::Session clone = session.Clone(*ort_env, clone_options);
+
+  ASSERT_EQ(clone.GetInputCount(), session.GetInputCount());
+  ASSERT_EQ(clone.GetOutputCount(), session.GetOutputCount());
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<float> input_data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> input_dims = {3, 2};
+  auto input_tensor = Ort::Value::CreateTensor<float>(info, input_data.data(), input_data.size(),
+                                                      input_dims.data(), input_dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  for (auto* s : {&clone, &session}) {
+    auto outputs = s->Run(Ort::RunOptions{nullptr}, input_names, &input_tensor, 1, output_names, 1);
+    ASSERT_EQ(outputs.size(), 1u);
+    ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), input_dims);
+    const float* y = outputs[0].GetTensorData<float>();
+    ASSERT_TRUE(std::equal(expected_values_y.cbegin(), expected_values_y.cend(), y));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(CApiTestWithProviders,
                          CApiTestWithProvider,
                          ::testing::Values(0, 1, 2, 3, 4));
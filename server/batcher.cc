@@ -0,0 +1,357 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+
+// Size in bytes of one element of a fixed size tensor type. Returns 0 for types that cannot be
+// concatenated with a plain memory copy (strings, undefined).
+size_t ElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+std::vector<Ort::Value> RunSession(Ort::Session& session,
+                                   const Ort::RunOptions& run_options,
+                                   const std::vector<std::string>& input_names,
+                                   const Ort::Value* input_values,
+                                   const std::vector<std::string>& output_names) {
+  std::vector<const char*> input_ptrs;
+  input_ptrs.reserve(input_names.size());
+  for (const auto& name : input_names) {
+    input_ptrs.push_back(name.c_str());
+  }
+
+  std::vector<const char*> output_ptrs;
+  output_ptrs.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    output_ptrs.push_back(name.c_str());
+  }
+
+  return session.Run(run_options, input_ptrs.data(), input_values, input_ptrs.size(),
+                     output_ptrs.data(), output_ptrs.size());
+}
+
+}  // namespace
+
+RequestBatcher::RequestBatcher(const Ort::Session& session, const BatchingOptions& options)
+    : session_(const_cast<Ort::Session&>(session)), options_(options) {
+  if (!options_.Enabled()) {
+    return;
+  }
+
+  // Only coalesce when every model input has a symbolic leading dimension.
+  batchable_model_ = session_.GetInputCount() > 0;
+  for (size_t i = 0, end = session_.GetInputCount(); i < end && batchable_model_; ++i) {
+    auto type_info = session_.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      batchable_model_ = false;
+      break;
+    }
+
+    auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+    batchable_model_ = !shape.empty() && shape[0] < 0;
+  }
+
+  if (!batchable_model_) {
+    return;
+  }
+
+  const size_t num_threads = std::max<size_t>(options_.num_batch_threads, 1);
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  queue_cv_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool RequestBatcher::CanQueue(const std::vector<Ort::Value>& input_values, int64_t& rows) const {
+  if (!batchable_model_ || input_values.empty()) {
+    return false;
+  }
+
+  rows = -1;
+  for (const auto& value : input_values) {
+    if (!value.IsTensor()) {
+      return false;
+    }
+
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (shape.empty() || ElementSize(info.GetElementType()) == 0) {
+      return false;
+    }
+
+    if (rows == -1) {
+      rows = shape[0];
+    } else if (rows != shape[0]) {
+      return false;
+    }
+  }
+
+  // A request that fills a batch on its own gains nothing from waiting.
+  return rows > 0 && static_cast<size_t>(rows) < options_.max_batch_size;
+}
+
+bool RequestBatcher::IsCompatible(const Task& a, const Task& b) {
+  if (*a.input_names != *b.input_names || *a.output_names != *b.output_names) {
+    return false;
+  }
+
+  // The batch is run with one set of options. The run tag only identifies the request in the logs, so it may differ.
+  if (a.run_options->GetRunLogSeverityLevel() != b.run_options->GetRunLogSeverityLevel() ||
+      a.run_options->GetRunLogVerbosityLevel() != b.run_options->GetRunLogVerbosityLevel()) {
+    return false;
+  }
+
+  for (size_t i = 0, end = a.input_values->size(); i < end; ++i) {
+    auto a_info = (*a.input_values)[i].GetTensorTypeAndShapeInfo();
+    auto b_info = (*b.input_values)[i].GetTensorTypeAndShapeInfo();
+    if (a_info.GetElementType() != b_info.GetElementType()) {
+      return false;
+    }
+
+    // All dimensions except the batch dimension must agree.
+    auto a_shape = a_info.GetShape();
+    auto b_shape = b_info.GetShape();
+    if (a_shape.size() != b_shape.size() ||
+        !std::equal(a_shape.begin() + 1, a_shape.end(), b_shape.begin() + 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<Ort::Value> RequestBatcher::Run(const Ort::RunOptions& run_options,
+                                            const std::vector<std::string>& input_names,
+                                            std::vector<Ort::Value>& input_values,
+                                            const std::vector<std::string>& output_names) {
+  int64_t rows = 0;
+  if (!CanQueue(input_values, rows)) {
+    ++run_count_;
+    return RunSession(session_, run_options, input_names, input_values.data(), output_names);
+  }
+
+  Task task{&run_options, &input_names, &input_values, &output_names, rows, std::chrono::steady_clock::now(), {}};
+  auto result = task.result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(&task);
+  }
+  queue_cv_.notify_all();
+
+  return result.get();
+}
+
+void RequestBatcher::WorkerLoop() {
+  std::vector<Task*> batch;
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    queue_cv_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      // shutdown_ was requested and nothing is left to serve
+      return;
+    }
+
+    // Wait for more requests until the batch could be full or the oldest request hits its deadline.
+    // Only requests that would be taken into the batch of the oldest one count towards it.
+    const auto deadline = queue_.front()->enqueue_time + options_.max_queue_delay;
+    queue_cv_.wait_until(lock, deadline, [this]() {
+      if (shutdown_ || queue_.empty()) {
+        return true;
+      }
+      const Task& first = *queue_.front();
+      int64_t batch_rows = first.rows;
+      for (auto it = queue_.begin() + 1; it != queue_.end(); ++it) {
+        if (static_cast<size_t>(batch_rows + (*it)->rows) <= options_.max_batch_size && IsCompatible(first, **it)) {
+          batch_rows += (*it)->rows;
+        }
+      }
+      return static_cast<size_t>(batch_rows) >= options_.max_batch_size;
+    });
+
+    if (queue_.empty()) {
+      // another worker took the requests while we were waiting
+      continue;
+    }
+
+    // Take the oldest request plus every compatible request that still fits.
+    batch.clear();
+    batch.push_back(queue_.front());
+    queue_.pop_front();
+    int64_t batch_rows = batch.front()->rows;
+    for (auto it = queue_.begin(); it != queue_.end();) {
+      if (static_cast<size_t>(batch_rows + (*it)->rows) <= options_.max_batch_size &&
+          IsCompatible(*batch.front(), **it)) {
+        batch_rows += (*it)->rows;
+        batch.push_back(*it);
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    const bool has_leftovers = !queue_.empty();
+    lock.unlock();
+    if (has_leftovers) {
+      queue_cv_.notify_one();
+    }
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+void RequestBatcher::RunBatch(std::vector<Task*>& batch) {
+  const Task& first = *batch.front();
+
+  if (batch.size() == 1) {
+    try {
+      ++run_count_;
+      batch.front()->result.set_value(
+          RunSession(session_, *first.run_options, *first.input_names, first.input_values->data(), *first.output_names));
+    } catch (...) {
+      batch.front()->result.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  int64_t total_rows = 0;
+  for (const auto* task : batch) {
+    total_rows += task->rows;
+  }
+
+  std::vector<Ort::Value> outputs;
+  try {
+    Ort::AllocatorWithDefaultOptions allocator;
+
+    // Concatenate every input along the batch dimension.
+    std::vector<Ort::Value> batched_inputs;
+    batched_inputs.reserve(first.input_values->size());
+    for (size_t i = 0, end = first.input_values->size(); i < end; ++i) {
+      auto info = (*first.input_values)[i].GetTensorTypeAndShapeInfo();
+      auto shape = info.GetShape();
+      shape[0] = total_rows;
+
+      auto batched = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+      auto* dst = batched.GetTensorMutableData<uint8_t>();
+      const size_t element_size = ElementSize(info.GetElementType());
+      for (auto* task : batch) {
+        auto& value = (*task->input_values)[i];
+        const size_t bytes = value.GetTensorTypeAndShapeInfo().GetElementCount() * element_size;
+        memcpy(dst, value.GetTensorMutableData<uint8_t>(), bytes);
+        dst += bytes;
+      }
+
+      batched_inputs.push_back(std::move(batched));
+    }
+
+    // Every request in the batch logs at the same levels as the first one. A fresh instance keeps a terminate
+    // request on one caller's options from failing the other requests.
+    Ort::RunOptions batch_run_options;
+    batch_run_options.SetRunLogSeverityLevel(first.run_options->GetRunLogSeverityLevel());
+    batch_run_options.SetRunLogVerbosityLevel(first.run_options->GetRunLogVerbosityLevel());
+    batch_run_options.SetRunTag(first.run_options->GetRunTag());
+
+    ++run_count_;
+    outputs = RunSession(session_, batch_run_options, *first.input_names, batched_inputs.data(), *first.output_names);
+
+    // Every output has to be splittable along the same batch dimension.
+    bool splittable = true;
+    for (auto& output : outputs) {
+      if (!output.IsTensor()) {
+        splittable = false;
+        break;
+      }
+      auto info = output.GetTensorTypeAndShapeInfo();
+      auto shape = info.GetShape();
+      if (shape.empty() || shape[0] != total_rows || ElementSize(info.GetElementType()) == 0) {
+        splittable = false;
+        break;
+      }
+    }
+
+    if (!splittable) {
+      // The model does not map input rows to output rows. Serve the requests one by one instead.
+      for (auto* task : batch) {
+        try {
+          ++run_count_;
+          task->result.set_value(
+              RunSession(session_, *task->run_options, *task->input_names, task->input_values->data(), *task->output_names));
+        } catch (...) {
+          task->result.set_exception(std::current_exception());
+        }
+      }
+      return;
+    }
+
+    // Scatter the output rows back to the callers.
+    std::vector<std::vector<Ort::Value>> results(batch.size());
+    std::vector<size_t> src_offsets(outputs.size(), 0);
+    for (size_t t = 0; t < batch.size(); ++t) {
+      results[t].reserve(outputs.size());
+      for (size_t o = 0; o < outputs.size(); ++o) {
+        auto info = outputs[o].GetTensorTypeAndShapeInfo();
+        auto shape = info.GetShape();
+        const size_t row_bytes = info.GetElementCount() / static_cast<size_t>(total_rows) * ElementSize(info.GetElementType());
+        shape[0] = batch[t]->rows;
+
+        auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+        const size_t bytes = row_bytes * static_cast<size_t>(batch[t]->rows);
+        memcpy(value.GetTensorMutableData<uint8_t>(), outputs[o].GetTensorMutableData<uint8_t>() + src_offsets[o], bytes);
+        src_offsets[o] += bytes;
+        results[t].push_back(std::move(value));
+      }
+    }
+
+    for (size_t t = 0; t < batch.size(); ++t) {
+      batch[t]->result.set_value(std::move(results[t]));
+    }
+  } catch (...) {
+    auto error = std::current_exception();
+    for (auto* task : batch) {
+      task->result.set_exception(error);
+    }
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct BatchingOptions {
+  // Maximum number of rows (sum of dim 0 over all coalesced requests) in one Run.
+  // A value of 0 or 1 disables batching.
+  size_t max_batch_size = 0;
+
+  // How long the first request of a batch may wait for others to arrive.
+  std::chrono::microseconds max_queue_delay{1000};
+
+  // Number of threads draining the queue. Each one can have a batch in flight.
+  size_t num_batch_threads = 1;
+
+  bool Enabled() const { return max_batch_size > 1; }
+};
+
+// Coalesces concurrent requests for one model along the batch (first) dimension,
+// runs them as a single Ort::Session::Run and scatters the output rows back to each caller.
+//
+// A request is only queued if every input is a non-string tensor with rank >= 1 and the model
+// declares a symbolic first dimension for all of its inputs. Anything else is run directly on
+// the calling thread, so the batcher is transparent to callers.
+class RequestBatcher {
+ public:
+  RequestBatcher(const Ort::Session& session, const BatchingOptions& options);
+  ~RequestBatcher();
+  RequestBatcher(const RequestBatcher&) = delete;
+  RequestBatcher& operator=(const RequestBatcher&) = delete;
+
+  // Blocks until the run containing this request has completed. Throws Ort::Exception on failure.
+  // A request is only coalesced with requests whose run options log at the same levels. A request that ends up
+  // in a batch of its own is run with the caller's run options.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+  // Whether the model's inputs allow coalescing at all.
+  bool IsBatchable() const { return batchable_model_; }
+
+  // Number of Session::Run calls made so far, including requests that were run directly.
+  size_t RunCount() const { return run_count_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Task {
+    const Ort::RunOptions* run_options;
+    const std::vector<std::string>* input_names;
+    std::vector<Ort::Value>* input_values;
+    const std::vector<std::string>* output_names;
+    int64_t rows;
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<std::vector<Ort::Value>> result;
+  };
+
+  bool CanQueue(const std::vector<Ort::Value>& input_values, int64_t& rows) const;
+  static bool IsCompatible(const Task& a, const Task& b);
+
+  void WorkerLoop();
+  void RunBatch(std::vector<Task*>& batch);
+
+  Ort::Session& session_;
+  const BatchingOptions options_;
+  bool batchable_model_{false};
+  std::atomic<size_t> run_count_{0};
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<Task*> queue_;
+  bool shutdown_{false};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -93,6 +93,20 @@ void ServerEnvironment::InitializeModel(const std::string& model_path, const std
     (iterator->second).output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (batching_options_.Enabled()) {
+    auto batcher = std::make_unique<RequestBatcher>((iterator->second).session, batching_options_);
+    if (batcher->IsBatchable()) {
+      (iterator->second).batcher = std::move(batcher);
+    } else {
+      default_logger_->warn("Request batching disabled for model {} version {}: inputs need a symbolic batch dimension",
+                            model_name, model_version);
+    }
+  }
+}
+
+void ServerEnvironment::SetBatchingOptions(const BatchingOptions& options) {
+  batching_options_ = options;
 }
 
 const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
@@ -119,6 +133,16 @@ const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name,
   return it->second.session;
 }
 
+RequestBatcher* ServerEnvironment::GetBatcher(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.batcher.get();
+}
+
 std::shared_ptr<spdlog::logger> ServerEnvironment::GetLogger(const std::string& request_id) const {
   auto logger = std::make_shared<spdlog::logger>(request_id, sink_.begin(), sink_.end());
   spdlog::initialize_logger(logger);
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
+#include "batcher.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
@@ -23,6 +24,10 @@ class ServerEnvironment {
   OrtLoggingLevel GetLogSeverity() const;
 
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
+  // Returns nullptr if request batching is disabled for the model
+  RequestBatcher* GetBatcher(const std::string& model_name, const std::string& model_version) const;
+  // Applies to models initialized after the call
+  void SetBatchingOptions(const BatchingOptions& options);
   void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
@@ -38,10 +43,13 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  BatchingOptions batching_options_;
 
   struct SessionHolder {
     Ort::Session session;
     std::vector<std::string> output_names;
+    // declared after session so that it is stopped before the session is released
+    std::unique_ptr<RequestBatcher> batcher;
     explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
       session = Ort::Session(env, path.c_str(), options);
     };
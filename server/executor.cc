@@ -23,6 +23,16 @@ protobufutil::Status Executor::SetMLValue(const onnx::TensorProto& input_tensor,
                                           /* out */ Ort::Value& ml_value) {
   auto logger = env_->GetLogger(request_id_);
 
+  // raw_data that is already laid out as the tensor expects is handed to the session as is
+  try {
+    if (onnxruntime::server::TryWrapRawDataAsMLValue(input_tensor, *cpu_memory_info, ml_value)) {
+      return protobufutil::Status::OK;
+    }
+  } catch (const Ort::Exception& e) {
+    logger->error("TryWrapRawDataAsMLValue() failed. Error Message: {}", e.what());
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
   size_t cpu_tensor_length = 0;
   try {
     onnxruntime::server::GetSizeInBytesFromTensorProto<0>(input_tensor, &cpu_tensor_length);
@@ -130,14 +140,25 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
 
   std::vector<Ort::Value> outputs;
   try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    auto* batcher = env_->GetBatcher(model_name, model_version);
+    if (batcher != nullptr) {
+      outputs = batcher->Run(run_options, input_names, input_values, output_names);
+    } else {
+      outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    }
   } catch (const Ort::Exception& e) {
     return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
   }
 
-  // Build the response
+  // Build the response. Each output is serialized straight into the response map entry.
+  auto* response_outputs = response.mutable_outputs();
   for (size_t i = 0, sz = outputs.size(); i < sz; ++i) {
-    onnx::TensorProto output_tensor{};
+    if (response_outputs->find(output_names[i]) != response_outputs->end()) {
+      logger->error("SetNameMLValueMap() failed. Output name: {}. Trying to overwrite existing output value", output_names[i]);
+      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "SetNameMLValueMap() failed: Cannot have two outputs with the same name");
+    }
+
+    onnx::TensorProto& output_tensor = (*response_outputs)[output_names[i]];
     try {
       MLValueToTensorProto(outputs[i], using_raw_data_, logger, output_tensor);
     } catch (const Ort::Exception& e) {
@@ -145,13 +166,6 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
       logger->error("MLValueToTensorProto() failed. Output name: {}. Error Message: {}", output_names[i], e.what());
       return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
     }
-
-    auto insertion_result = response.mutable_outputs()->insert({output_names[i], output_tensor});
-
-    if (!insertion_result.second) {
-      logger->error("SetNameMLValueMap() failed. Output name: {}. Trying to overwrite existing output value", output_names[i]);
-      return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "SetNameMLValueMap() failed: Cannot have two outputs with the same name");
-    }
   }
 
   return protobufutil::Status::OK;
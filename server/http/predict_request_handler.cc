@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/stubs/status.h>
 
 #include "environment.h"
@@ -53,9 +54,14 @@ void Predict(const std::string& name,
     GenerateErrorResponse(logger, http::status::bad_request, "Unknown 'Accept' header field in the request", context);
   }
 
+  // Request and response messages live on one arena so that the many small tensor/map
+  // allocations are released in one go when the handler returns.
+  google::protobuf::ArenaOptions arena_options;
+  arena_options.start_block_size = context.request.body().size() + 4096;
+  google::protobuf::Arena arena(arena_options);
+
   // Deserialize the payload
-  auto body = context.request.body();
-  PredictRequest predict_request{};
+  auto& predict_request = *google::protobuf::Arena::CreateMessage<PredictRequest>(&arena);
   http::status error_code;
   std::string error_message;
   bool parse_succeeded = ParseRequestPayload(context, request_type, predict_request, error_code, error_message);
@@ -66,7 +72,7 @@ void Predict(const std::string& name,
 
   // Run Prediction
   Executor executor(env.get(), context.request_id);
-  PredictResponse predict_response{};
+  auto& predict_response = *google::protobuf::Arena::CreateMessage<PredictResponse>(&arena);
   auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
   if (!status.ok()) {
     GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
@@ -96,12 +102,12 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
-  auto body = context.request.body();
+  const auto& body = context.request.body();
   protobufutil::Status status;
   switch (request_type) {
     case SupportedContentType::Json: {
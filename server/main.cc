@@ -64,6 +64,15 @@ int main(int argc, char* argv[]) {
   logger->info("Model name: {}", config.model_name);
   logger->info("Model version: {}", config.model_version);
 
+  if (config.max_batch_size > 1) {
+    server::BatchingOptions batching_options;
+    batching_options.max_batch_size = static_cast<size_t>(config.max_batch_size);
+    batching_options.max_queue_delay = std::chrono::microseconds(config.batch_timeout_micros);
+    batching_options.num_batch_threads = static_cast<size_t>(config.num_batch_threads);
+    env->SetBatchingOptions(batching_options);
+    logger->info("Request batching: max batch size {}, timeout {}us", config.max_batch_size, config.batch_timeout_micros);
+  }
+
   try {
     env->InitializeModel(config.model_path, config.model_name, config.model_version);
     logger->debug("Initialize Model Successfully!");
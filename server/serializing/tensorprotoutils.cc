@@ -378,6 +378,54 @@ void TensorProtoToMLValue(const onnx::TensorProto& tensor_proto, const MemBuffer
   value = Ort::Value::CreateTensor(&allocator, tensor_data, m.GetLen(), tensor_shape_vec.data(), tensor_shape_vec.size(), (ONNXTensorElementDataType)tensor_proto.data_type());
   return;
 }
+bool TryWrapRawDataAsMLValue(const onnx::TensorProto& tensor_proto, const OrtMemoryInfo& memory_info, Ort::Value& value) {
+  if (!IsLittleEndianOrder() || !tensor_proto.has_raw_data() ||
+      tensor_proto.data_location() == onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL) {
+    return false;
+  }
+
+  size_t element_size = 0;
+  switch (tensor_proto.data_type()) {
+    case onnx::TensorProto_DataType_BOOL:
+    case onnx::TensorProto_DataType_INT8:
+    case onnx::TensorProto_DataType_UINT8:
+      element_size = 1;
+      break;
+    case onnx::TensorProto_DataType_INT16:
+    case onnx::TensorProto_DataType_UINT16:
+      element_size = 2;
+      break;
+    case onnx::TensorProto_DataType_FLOAT:
+    case onnx::TensorProto_DataType_INT32:
+    case onnx::TensorProto_DataType_UINT32:
+      element_size = 4;
+      break;
+    case onnx::TensorProto_DataType_DOUBLE:
+    case onnx::TensorProto_DataType_INT64:
+    case onnx::TensorProto_DataType_UINT64:
+      element_size = 8;
+      break;
+    default:
+      return false;
+  }
+
+  size_t size_in_bytes = 0;
+  GetSizeInBytesFromTensorProto<0>(tensor_proto, &size_in_bytes);
+
+  const auto& raw_data = tensor_proto.raw_data();
+  if (raw_data.size() != size_in_bytes ||
+      reinterpret_cast<uintptr_t>(raw_data.data()) % element_size != 0) {
+    // Let the copying path produce the error or realign the data.
+    return false;
+  }
+
+  std::vector<int64_t> tensor_shape_vec = GetTensorShapeFromTensorProto(tensor_proto);
+  value = Ort::Value::CreateTensor(&memory_info, const_cast<char*>(raw_data.data()), raw_data.size(),
+                                   tensor_shape_vec.data(), tensor_shape_vec.size(),
+                                   (ONNXTensorElementDataType)tensor_proto.data_type());
+  return true;
+}
+
 template void GetSizeInBytesFromTensorProto<256>(const onnx::TensorProto& tensor_proto,
                                                  size_t* out);
 template void GetSizeInBytesFromTensorProto<0>(const onnx::TensorProto& tensor_proto, size_t* out);
@@ -27,6 +27,15 @@ void GetSizeInBytesFromTensorProto(const onnx::TensorProto& tensor_proto, size_t
  */
 void TensorProtoToMLValue(const onnx::TensorProto& input, const server::MemBuffer& m, /* out */ Ort::Value& value);
 
+/**
+ * Wrap the raw_data bytes of a TensorProto as an Ort::Value without copying them.
+ * Returns false if the tensor has no raw_data, is a string tensor, the data is not suitably aligned
+ * or the host is big endian; the caller should fall back to TensorProtoToMLValue in that case.
+ * The returned value refers to memory owned by tensor_proto, which must outlive it.
+ */
+bool TryWrapRawDataAsMLValue(const onnx::TensorProto& tensor_proto, const OrtMemoryInfo& memory_info,
+                             /* out */ Ort::Value& value);
+
 template <typename T>
 void UnpackTensor(const onnx::TensorProto& tensor, const void* raw_data, size_t raw_data_len,
                   /*out*/ T* p_data, int64_t expected_size);
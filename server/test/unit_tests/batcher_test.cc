@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "batcher.h"
+#include "executor.h"
+#include "http/json_handling.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+class BatcherTest : public ::testing::Test {
+ protected:
+  virtual BatchingOptions Options() const {
+    BatchingOptions options;
+    options.max_batch_size = 8;
+    options.max_queue_delay = std::chrono::microseconds(2000);
+    options.num_batch_threads = 2;
+    return options;
+  }
+
+  void SetUp() override {
+    // Y = X * X with a symbolic batch dimension, so requests for it are queued.
+    const static auto model_file = "testdata/mul_batch.onnx";
+
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->SetBatchingOptions(Options());
+    env->InitializeModel(model_file, "Batched", "version");
+  }
+
+  void TearDown() override {
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->UnloadModel("Batched", "version");
+    env->SetBatchingOptions(BatchingOptions{});
+  }
+};
+
+TEST_F(BatcherTest, ConcurrentRequestsGetTheirOwnResults) {
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+  const static auto expected = R"({"outputs":{"Y":{"dims":["3","2"],"dataType":1,"floatData":[1,4,9,16,25,36]}}})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  constexpr int num_requests = 16;
+  std::vector<std::string> bodies(num_requests);
+  std::vector<char> succeeded(num_requests, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([env, i, &bodies, &succeeded]() {
+      onnxruntime::server::Executor executor(env, "RequestId" + std::to_string(i));
+      onnxruntime::server::PredictRequest request{};
+      onnxruntime::server::PredictResponse response{};
+
+      if (!onnxruntime::server::GetRequestFromJson(input_json, request).ok()) {
+        return;
+      }
+
+      succeeded[i] = executor.Predict("Batched", "version", request, response).ok() &&
+                     GenerateResponseInJson(response, bodies[i]).ok();
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_TRUE(succeeded[i]) << "request " << i;
+    EXPECT_EQ(expected, bodies[i]) << "request " << i;
+  }
+}
+
+// Two requests of 3 rows fill a batch, and the long queue delay means only a full batch gets run before the
+// requests time out. That makes the number of Session::Run calls deterministic.
+class CoalescingBatcherTest : public BatcherTest {
+ protected:
+  BatchingOptions Options() const override {
+    BatchingOptions options;
+    options.max_batch_size = 6;
+    options.max_queue_delay = std::chrono::microseconds(2000000);
+    options.num_batch_threads = 2;
+    return options;
+  }
+
+  // Runs concurrent 3x2 requests through the batcher, one per run options, and checks that each caller gets
+  // Y = X * X for its own X. The last request is started after last_request_delay.
+  static void RunRequests(RequestBatcher& batcher, const std::vector<const Ort::RunOptions*>& options,
+                          std::chrono::milliseconds last_request_delay = std::chrono::milliseconds(0)) {
+    const size_t num_requests = options.size();
+    std::vector<std::vector<float>> inputs(num_requests);
+    for (size_t i = 0; i < num_requests; ++i) {
+      for (int j = 0; j < 6; ++j) {
+        inputs[i].push_back(static_cast<float>(i * 6 + j + 1));
+      }
+    }
+    std::vector<std::vector<float>> results(num_requests);
+
+    auto run_request = [&batcher, &options, &inputs, &results](size_t i) {
+      auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+      const std::vector<int64_t> shape{3, 2};
+      std::vector<Ort::Value> input_values;
+      input_values.push_back(Ort::Value::CreateTensor<float>(memory_info, inputs[i].data(), inputs[i].size(),
+                                                             shape.data(), shape.size()));
+      const std::vector<std::string> input_names{"X"};
+      const std::vector<std::string> output_names{"Y"};
+
+      auto outputs = batcher.Run(*options[i], input_names, input_values, output_names);
+      const float* y = outputs[0].GetTensorData<float>();
+      results[i].assign(y, y + outputs[0].GetTensorTypeAndShapeInfo().GetElementCount());
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + 1 < num_requests; ++i) {
+      threads.emplace_back(run_request, i);
+    }
+    std::this_thread::sleep_for(last_request_delay);
+    threads.emplace_back(run_request, num_requests - 1);
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (size_t i = 0; i < num_requests; ++i) {
+      ASSERT_EQ(results[i].size(), inputs[i].size()) << "request " << i;
+      for (size_t j = 0; j < results[i].size(); ++j) {
+        EXPECT_EQ(results[i][j], inputs[i][j] * inputs[i][j]) << "request " << i << ", element " << j;
+      }
+    }
+  }
+};
+
+TEST_F(CoalescingBatcherTest, CompatibleRequestsShareOneRun) {
+  auto* batcher = ServerEnv()->GetBatcher("Batched", "version");
+  ASSERT_NE(batcher, nullptr);
+
+  Ort::RunOptions options1;
+  options1.SetRunTag("RequestId1");
+  Ort::RunOptions options2;
+  options2.SetRunTag("RequestId2");
+
+  const size_t run_count = batcher->RunCount();
+  RunRequests(*batcher, {&options1, &options2});
+  EXPECT_EQ(batcher->RunCount() - run_count, 1u);
+}
+
+TEST_F(CoalescingBatcherTest, RequestsWithDifferentLogLevelsAreNotCoalesced) {
+  auto* batcher = ServerEnv()->GetBatcher("Batched", "version");
+  ASSERT_NE(batcher, nullptr);
+
+  Ort::RunOptions options1;
+  options1.SetRunLogSeverityLevel(ORT_LOGGING_LEVEL_WARNING);
+  Ort::RunOptions options2;
+  options2.SetRunLogSeverityLevel(ORT_LOGGING_LEVEL_VERBOSE);
+
+  const size_t run_count = batcher->RunCount();
+  RunRequests(*batcher, {&options1, &options2});
+  EXPECT_EQ(batcher->RunCount() - run_count, 2u);
+}
+
+TEST_F(CoalescingBatcherTest, IncompatibleRequestsDoNotFillABatch) {
+  auto* batcher = ServerEnv()->GetBatcher("Batched", "version");
+  ASSERT_NE(batcher, nullptr);
+
+  // the first two requests have enough rows between them to fill a batch, but can't share one. the first request
+  // has to keep waiting for the third one, which arrives well within the queue delay.
+  Ort::RunOptions options1;
+  options1.SetRunLogSeverityLevel(ORT_LOGGING_LEVEL_WARNING);
+  Ort::RunOptions options2;
+  options2.SetRunLogSeverityLevel(ORT_LOGGING_LEVEL_VERBOSE);
+  Ort::RunOptions options3;
+  options3.SetRunLogSeverityLevel(ORT_LOGGING_LEVEL_WARNING);
+
+  const size_t run_count = batcher->RunCount();
+  RunRequests(*batcher, {&options1, &options2, &options3}, std::chrono::milliseconds(200));
+  EXPECT_EQ(batcher->RunCount() - run_count, 2u);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
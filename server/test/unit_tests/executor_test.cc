@@ -52,6 +52,36 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestMul_1_RawData) {
+  const std::vector<float> input{1, 2, 3, 4, 5, 6};
+  const std::vector<float> expected{1, 4, 9, 16, 25, 36};
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  onnx::TensorProto& tensor = (*request.mutable_inputs())["X"];
+  tensor.add_dims(3);
+  tensor.add_dims(2);
+  tensor.set_data_type(onnx::TensorProto_DataType_FLOAT);
+  tensor.set_raw_data(input.data(), input.size() * sizeof(float));
+  request.add_output_filter("Y");
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  ASSERT_TRUE(prediction_res.ok());
+
+  // the input bytes are used in place and must not be modified by the run
+  const auto* input_data = reinterpret_cast<const float*>(request.inputs().at("X").raw_data().data());
+  EXPECT_EQ(input, std::vector<float>(input_data, input_data + input.size()));
+
+  const auto& output = response.outputs().at("Y");
+  ASSERT_EQ(output.raw_data().size(), expected.size() * sizeof(float));
+  const auto* output_data = reinterpret_cast<const float*>(output.raw_data().data());
+  EXPECT_EQ(expected, std::vector<float>(output_data, output_data + expected.size()));
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime